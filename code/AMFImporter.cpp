@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "fast_atof.h"
 #include <assimp/DefaultIOSystem.h>
+#include <assimp/Importer.hpp>
 
 // Header files, stdlib.
 #include <memory>
@@ -409,8 +410,7 @@ void AMFImporter::ParseFile(const std::string& pFile, IOSystem* pIOHandler)
 	if(file.get() == NULL) throw DeadlyImportError("Failed to open AMF file " + pFile + ".");
 
 	// generate a XML reader for it
-	std::unique_ptr<CIrrXML_IOStreamReader> mIOWrapper(new CIrrXML_IOStreamReader(file.get()));
-	mReader = irr::io::createIrrXMLReader(mIOWrapper.get());
+	mReader = CreateXmlReader(file.get(), mUsePullReader);
 	if(!mReader) throw DeadlyImportError("Failed to create XML reader for file" + pFile + ".");
 	//
 	// start reading
@@ -686,6 +686,11 @@ void AMFImporter::GetExtensionList(std::set<std::string>& pExtensionList)
 	pExtensionList.insert("amf");
 }
 
+void AMFImporter::SetupProperties(const Importer* pImp)
+{
+	mUsePullReader = pImp->GetPropertyBool(AI_CONFIG_IMPORT_AMF_PULL_READER, pImp->GetPropertyBool(AI_CONFIG_IMPORT_XML_PULL_READER, false));
+}
+
 const aiImporterDesc* AMFImporter::GetInfo () const
 {
 	return &Description;
@@ -57,7 +57,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/importerdesc.h>
 #include "assimp/types.h"
 #include "BaseImporter.h"
-#include "irrXMLWrapper.h"
+#include "XmlPullReader.h"
 
 // Header files, stdlib.
 #include <set>
@@ -173,6 +173,7 @@ private:
     CAMFImporter_NodeElement* mNodeElement_Cur;///< Current element.
     std::list<CAMFImporter_NodeElement*> mNodeElement_List;///< All elements of scene graph.
 	irr::io::IrrXMLReader* mReader;///< Pointer to XML-reader object
+	bool mUsePullReader;///< Use XmlPullReader instead of irrXML, see AI_CONFIG_IMPORT_AMF_PULL_READER.
 	std::string mUnit;
 	std::list<SPP_Material> mMaterial_Converted;///< List of converted materials for postprocessing step.
 	std::list<SPP_Texture> mTexture_Converted;///< List of converted textures for postprocessing step.
@@ -529,7 +530,7 @@ public:
 	/// \fn AMFImporter()
 	/// Default constructor.
 	AMFImporter()
-		: mNodeElement_Cur(nullptr), mReader(nullptr)
+		: mNodeElement_Cur(nullptr), mReader(nullptr), mUsePullReader(false)
 	{}
 
 	/// \fn ~AMFImporter()
@@ -554,6 +555,7 @@ public:
 	bool CanRead(const std::string& pFile, IOSystem* pIOHandler, bool pCheckSig) const;
 	void GetExtensionList(std::set<std::string>& pExtensionList);
 	void InternReadFile(const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler);
+	void SetupProperties(const Importer* pImp);
 	const aiImporterDesc* GetInfo ()const;
 
 };// class AMFImporter
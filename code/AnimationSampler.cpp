@@ -0,0 +1,421 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the AnimationSampler helper class
+ */
+
+#include <assimp/AnimationSampler.h>
+#include <assimp/scene.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Coefficients of the polynomial slerp approximation, see David Eberly, "A Fast and Accurate
+// Algorithm for Computing SLERP", JGT 15(3), 2011. The series is truncated after 12 terms, the
+// last term is scaled to compensate for the truncation, which gives a maximum error < 1e-6.
+const unsigned int SlerpTerms = 12;
+const ai_real SlerpMu = static_cast<ai_real>( 1.895 );
+const ai_real SlerpU[ SlerpTerms ] = {
+    ai_real( 1.0 / ( 1 * 3 ) ), ai_real( 1.0 / ( 2 * 5 ) ), ai_real( 1.0 / ( 3 * 7 ) ), ai_real( 1.0 / ( 4 * 9 ) ),
+    ai_real( 1.0 / ( 5 * 11 ) ), ai_real( 1.0 / ( 6 * 13 ) ), ai_real( 1.0 / ( 7 * 15 ) ), ai_real( 1.0 / ( 8 * 17 ) ),
+    ai_real( 1.0 / ( 9 * 19 ) ), ai_real( 1.0 / ( 10 * 21 ) ), ai_real( 1.0 / ( 11 * 23 ) ), SlerpMu / ( 12 * 25 )
+};
+const ai_real SlerpV[ SlerpTerms ] = {
+    ai_real( 1.0 / 3 ), ai_real( 2.0 / 5 ), ai_real( 3.0 / 7 ), ai_real( 4.0 / 9 ),
+    ai_real( 5.0 / 11 ), ai_real( 6.0 / 13 ), ai_real( 7.0 / 15 ), ai_real( 8.0 / 17 ),
+    ai_real( 9.0 / 19 ), ai_real( 10.0 / 21 ), ai_real( 11.0 / 23 ), SlerpMu * 12 / 25
+};
+
+// ------------------------------------------------------------------------------------------------
+// How a time stamp relates to the key range of a track
+enum TimeMode {
+    // time lies within the key range (possibly after wrapping it)
+    TimeMode_Inside,
+    // use the node's default transformation
+    TimeMode_Default,
+    // extrapolate from the first or last two keys
+    TimeMode_Extrapolate
+};
+
+// ------------------------------------------------------------------------------------------------
+TimeMode ResolveTime( double& time, double first, double last, aiAnimBehaviour pre, aiAnimBehaviour post ) {
+    if ( time >= first && time <= last ) {
+        return TimeMode_Inside;
+    }
+
+    const aiAnimBehaviour b = time < first ? pre : post;
+    switch ( b ) {
+        case aiAnimBehaviour_DEFAULT:
+            return TimeMode_Default;
+
+        case aiAnimBehaviour_LINEAR:
+            return TimeMode_Extrapolate;
+
+        case aiAnimBehaviour_REPEAT:
+            if ( last > first ) {
+                const double span = last - first;
+                double t = std::fmod( time - first, span );
+                if ( t < 0.0 ) {
+                    t += span;
+                }
+                time = first + t;
+                return TimeMode_Inside;
+            }
+            // fallthrough
+
+        default: // aiAnimBehaviour_CONSTANT
+            time = time < first ? first : last;
+            return TimeMode_Inside;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Find the key interval [i,i+1] containing a time stamp, num must be at least 2 and time must be
+// inside the key range. The last interval found is cached in 'cursor' and checked first, which
+// turns the search into O(1) for monotonic sampling.
+template <typename KeyType>
+unsigned int FindKey( const KeyType* keys, unsigned int num, double time, unsigned int& cursor ) {
+    unsigned int i = cursor;
+    if ( i + 1 < num && keys[ i ].mTime <= time ) {
+        if ( time <= keys[ i + 1 ].mTime ) {
+            return i;
+        }
+        if ( i + 2 < num && time <= keys[ i + 2 ].mTime ) {
+            return cursor = i + 1;
+        }
+    }
+
+    const KeyType* it = std::upper_bound( keys, keys + num, time,
+        []( double t, const KeyType& k ) { return t < k.mTime; } );
+    i = static_cast<unsigned int>( it - keys );
+    i = i ? i - 1 : 0;
+    return cursor = std::min( i, num - 2 );
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename KeyType>
+ai_real KeyFactor( const KeyType* keys, unsigned int i, double time ) {
+    const double diff = keys[ i + 1 ].mTime - keys[ i ].mTime;
+    return diff > 0.0 ? static_cast<ai_real>( ( time - keys[ i ].mTime ) / diff ) : ai_real( 0.0 );
+}
+
+// ------------------------------------------------------------------------------------------------
+aiVector3D EvaluateVectorTrack( const aiVectorKey* keys, unsigned int num, double time,
+        aiAnimBehaviour pre, aiAnimBehaviour post, const aiVector3D& def, unsigned int& cursor ) {
+    if ( !num ) {
+        return def;
+    }
+    if ( num == 1 ) {
+        return keys[ 0 ].mValue;
+    }
+
+    unsigned int i;
+    switch ( ResolveTime( time, keys[ 0 ].mTime, keys[ num - 1 ].mTime, pre, post ) ) {
+        case TimeMode_Default:
+            return def;
+        case TimeMode_Extrapolate:
+            i = time < keys[ 0 ].mTime ? 0 : num - 2;
+            break;
+        default:
+            i = FindKey( keys, num, time, cursor );
+    }
+
+    const aiVector3D& a = keys[ i ].mValue;
+    return a + ( keys[ i + 1 ].mValue - a ) * KeyFactor( keys, i, time );
+}
+
+// ------------------------------------------------------------------------------------------------
+void EvaluateQuatTrack( const aiQuatKey* keys, unsigned int num, double time,
+        aiAnimBehaviour pre, aiAnimBehaviour post, const aiQuaternion& def, unsigned int& cursor,
+        aiQuaternion& start, aiQuaternion& end, ai_real& factor ) {
+    factor = 0.0;
+    if ( !num ) {
+        start = end = def;
+        return;
+    }
+    if ( num == 1 ) {
+        start = end = keys[ 0 ].mValue;
+        return;
+    }
+
+    // rotations are never extrapolated, aiAnimBehaviour_LINEAR clamps just like
+    // aiAnimBehaviour_CONSTANT does.
+    const TimeMode mode = ResolveTime( time, keys[ 0 ].mTime, keys[ num - 1 ].mTime, pre, post );
+    if ( mode == TimeMode_Default ) {
+        start = end = def;
+        return;
+    }
+    if ( mode == TimeMode_Extrapolate ) {
+        start = end = keys[ time < keys[ 0 ].mTime ? 0 : num - 1 ].mValue;
+        return;
+    }
+
+    const unsigned int i = FindKey( keys, num, time, cursor );
+    start = keys[ i ].mValue;
+    end = keys[ i + 1 ].mValue;
+    factor = KeyFactor( keys, i, time );
+}
+
+// ------------------------------------------------------------------------------------------------
+// Build scaling, rotation, translation into a matrix. Note that the respective aiMatrix4x4
+// constructor applies the scaling after the rotation, which is not what we need here.
+void ComposeMatrix( aiMatrix4x4& out, const aiVector3D& scaling, const aiQuaternion& rotation,
+        const aiVector3D& position ) {
+    out = aiMatrix4x4( rotation.GetMatrix() );
+    out.a1 *= scaling.x; out.b1 *= scaling.x; out.c1 *= scaling.x;
+    out.a2 *= scaling.y; out.b2 *= scaling.y; out.c2 *= scaling.y;
+    out.a3 *= scaling.z; out.b3 *= scaling.z; out.c3 *= scaling.z;
+    out.a4 = position.x; out.b4 = position.y; out.c4 = position.z;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+AnimationSampler::AnimationSampler( const aiNode* root, const aiAnimation* anim )
+: mAnim( anim ) {
+    Setup( root, anim );
+}
+
+// ------------------------------------------------------------------------------------------------
+AnimationSampler::AnimationSampler( const aiScene* scene, unsigned int animIndex )
+: mAnim( NULL ) {
+    ai_assert( NULL != scene );
+    ai_assert( animIndex < scene->mNumAnimations );
+    mAnim = scene->mAnimations[ animIndex ];
+    Setup( scene->mRootNode, mAnim );
+}
+
+// ------------------------------------------------------------------------------------------------
+AnimationSampler::~AnimationSampler() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Setup( const aiNode* root, const aiAnimation* anim ) {
+    ai_assert( NULL != root );
+    ai_assert( NULL != anim );
+
+    // flatten the hierarchy breadth-first, so parents always precede their children
+    mNodes.push_back( root );
+    mParents.push_back( UINT_MAX );
+    for ( unsigned int i = 0; i < mNodes.size(); ++i ) {
+        const aiNode* nd = mNodes[ i ];
+        mNodesByName.insert( std::make_pair( std::string( nd->mName.data ), i ) );
+        for ( unsigned int c = 0; c < nd->mNumChildren; ++c ) {
+            mNodes.push_back( nd->mChildren[ c ] );
+            mParents.push_back( i );
+        }
+    }
+
+    mChannels.reserve( anim->mNumChannels );
+    for ( unsigned int a = 0; a < anim->mNumChannels; ++a ) {
+        const aiNodeAnim* na = anim->mChannels[ a ];
+        const unsigned int node = GetNodeIndex( na->mNodeName );
+        if ( node == UINT_MAX ) {
+            continue;
+        }
+
+        Channel ch;
+        ch.anim = na;
+        ch.node = node;
+        ch.lastPosition = ch.lastRotation = ch.lastScaling = 0;
+        mNodes[ node ]->mTransformation.Decompose( ch.defScaling, ch.defRotation, ch.defPosition );
+        mChannels.push_back( ch );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationSampler::GetNodeCount() const {
+    return static_cast<unsigned int>( mNodes.size() );
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiNode* AnimationSampler::GetNode( unsigned int index ) const {
+    ai_assert( index < mNodes.size() );
+    return mNodes[ index ];
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationSampler::GetParentIndex( unsigned int index ) const {
+    ai_assert( index < mParents.size() );
+    return mParents[ index ];
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationSampler::GetNodeIndex( const aiString& name ) const {
+    std::map<std::string, unsigned int>::const_iterator it = mNodesByName.find( std::string( name.data ) );
+    return it == mNodesByName.end() ? UINT_MAX : ( *it ).second;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Sample( double time, aiMatrix4x4* local, aiMatrix4x4* global ) {
+    SampleBatch( &time, 1, local, global );
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::SampleBatch( const double* times, unsigned int numTimes,
+        aiMatrix4x4* local, aiMatrix4x4* global ) {
+    ai_assert( NULL != times );
+    if ( !numTimes || ( !local && !global ) ) {
+        return;
+    }
+
+    const size_t numNodes = mNodes.size();
+    if ( !local ) {
+        mLocalScratch.resize( numNodes * numTimes );
+        local = &mLocalScratch[ 0 ];
+    }
+
+    // evaluate all tracks of all channels for all time stamps. The work items are laid out
+    // channel after channel, so all rotations can be interpolated in a single batch.
+    const size_t numItems = mChannels.size() * numTimes;
+    mPositions.resize( numItems );
+    mScalings.resize( numItems );
+    mRotStart.resize( numItems );
+    mRotEnd.resize( numItems );
+    mRotFactors.resize( numItems );
+    mRotations.resize( numItems );
+    for ( unsigned int c = 0; c < mChannels.size(); ++c ) {
+        EvaluateChannels( times, numTimes, c );
+    }
+    if ( numItems ) {
+        InterpolateQuaternions( &mRotStart[ 0 ], &mRotEnd[ 0 ], &mRotFactors[ 0 ], &mRotations[ 0 ],
+            static_cast<unsigned int>( numItems ) );
+    }
+
+    BuildLocalTransforms( numTimes, local );
+    if ( global ) {
+        for ( unsigned int t = 0; t < numTimes; ++t ) {
+            ComputeGlobalTransforms( local + t * numNodes, global + t * numNodes );
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::EvaluateChannels( const double* times, unsigned int numTimes, unsigned int channel ) {
+    Channel& ch = mChannels[ channel ];
+    const aiNodeAnim* na = ch.anim;
+    const size_t base = static_cast<size_t>( channel ) * numTimes;
+
+    for ( unsigned int t = 0; t < numTimes; ++t ) {
+        const size_t item = base + t;
+        mPositions[ item ] = EvaluateVectorTrack( na->mPositionKeys, na->mNumPositionKeys, times[ t ],
+            na->mPreState, na->mPostState, ch.defPosition, ch.lastPosition );
+        mScalings[ item ] = EvaluateVectorTrack( na->mScalingKeys, na->mNumScalingKeys, times[ t ],
+            na->mPreState, na->mPostState, ch.defScaling, ch.lastScaling );
+        EvaluateQuatTrack( na->mRotationKeys, na->mNumRotationKeys, times[ t ],
+            na->mPreState, na->mPostState, ch.defRotation, ch.lastRotation,
+            mRotStart[ item ], mRotEnd[ item ], mRotFactors[ item ] );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::BuildLocalTransforms( unsigned int numTimes, aiMatrix4x4* local ) {
+    const size_t numNodes = mNodes.size();
+    for ( unsigned int t = 0; t < numTimes; ++t ) {
+        aiMatrix4x4* out = local + t * numNodes;
+        for ( size_t n = 0; n < numNodes; ++n ) {
+            out[ n ] = mNodes[ n ]->mTransformation;
+        }
+        for ( unsigned int c = 0; c < mChannels.size(); ++c ) {
+            const size_t item = static_cast<size_t>( c ) * numTimes + t;
+            ComposeMatrix( out[ mChannels[ c ].node ], mScalings[ item ], mRotations[ item ], mPositions[ item ] );
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::ComputeGlobalTransforms( const aiMatrix4x4* local, aiMatrix4x4* global ) const {
+    ai_assert( local != global );
+    if ( mNodes.empty() ) {
+        return;
+    }
+
+    global[ 0 ] = local[ 0 ];
+    for ( size_t n = 1; n < mNodes.size(); ++n ) {
+        global[ n ] = global[ mParents[ n ] ] * local[ n ];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::InterpolateQuaternions( const aiQuaternion* start, const aiQuaternion* end,
+        const ai_real* factors, aiQuaternion* out, unsigned int count ) {
+    // No branches and no transcendental functions in the loop body, so compilers can
+    // process several quaternions per iteration with SIMD instructions.
+    for ( unsigned int i = 0; i < count; ++i ) {
+        const aiQuaternion& q0 = start[ i ];
+        const aiQuaternion& q1 = end[ i ];
+        const ai_real t = factors[ i ];
+
+        // take the shorter arc
+        const ai_real dot = q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w;
+        const ai_real sign = dot < 0 ? ai_real( -1.0 ) : ai_real( 1.0 );
+        const ai_real xm1 = dot * sign - ai_real( 1.0 );
+
+        const ai_real d = ai_real( 1.0 ) - t;
+        const ai_real sqrT = t * t, sqrD = d * d;
+
+        ai_real cT = ai_real( 1.0 ), cD = ai_real( 1.0 );
+        for ( int k = SlerpTerms - 1; k >= 0; --k ) {
+            cT = ai_real( 1.0 ) + ( SlerpU[ k ] * sqrT - SlerpV[ k ] ) * xm1 * cT;
+            cD = ai_real( 1.0 ) + ( SlerpU[ k ] * sqrD - SlerpV[ k ] ) * xm1 * cD;
+        }
+        cT *= t * sign;
+        cD *= d;
+
+        const ai_real x = cD * q0.x + cT * q1.x;
+        const ai_real y = cD * q0.y + cT * q1.y;
+        const ai_real z = cD * q0.z + cT * q1.z;
+        const ai_real w = cD * q0.w + cT * q1.w;
+        out[ i ].x = x;
+        out[ i ].y = y;
+        out[ i ].z = z;
+        out[ i ].w = w;
+    }
+}
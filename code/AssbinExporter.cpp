@@ -451,18 +451,55 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
                 }
                 c |= ASSBIN_MESH_HAS_COLOR(n);
             }
+
+            // quantized streams replace the float ones, except in shortened dumps
+            const aiQuantizedVertices* qv = shortened ? NULL : mesh->mQuantizedVertices;
+            if (qv) {
+                c |= ASSBIN_MESH_HAS_QUANTIZED_VERTICES;
+            }
             Write<unsigned int>(&chunk,c);
 
+            if (qv) {
+                unsigned int q = 0;
+                if (qv->mPositions) {
+                    q |= ASSBIN_MESH_HAS_POSITIONS;
+                }
+                if (qv->mNormals) {
+                    q |= ASSBIN_MESH_HAS_NORMALS;
+                }
+                for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS;++n) {
+                    if (qv->mTextureCoords[n]) {
+                        q |= ASSBIN_MESH_HAS_TEXCOORD(n);
+                    }
+                }
+                Write<unsigned int>(&chunk,q);
+
+                if (qv->mPositions) {
+                    Write<unsigned int>(&chunk,qv->mPositionBits);
+                    Write<aiVector3D>(&chunk,qv->mPositionOffset);
+                    Write<aiVector3D>(&chunk,qv->mPositionScale);
+                }
+                if (qv->mNormals) {
+                    Write<unsigned int>(&chunk,qv->mNormalBits);
+                }
+            }
+
             aiVector3D minVec, maxVec;
             if (mesh->mVertices) {
                 if (shortened) {
                     WriteBounds(&chunk,mesh->mVertices,mesh->mNumVertices);
+                }
+                else if (qv && qv->mPositions) {
+                    WriteArray<uint16_t>(&chunk,qv->mPositions,3*mesh->mNumVertices);
                 } // else write as usual
                 else WriteArray<aiVector3D>(&chunk,mesh->mVertices,mesh->mNumVertices);
             }
             if (mesh->mNormals) {
                 if (shortened) {
                     WriteBounds(&chunk,mesh->mNormals,mesh->mNumVertices);
+                }
+                else if (qv && qv->mNormals) {
+                    WriteArray<int16_t>(&chunk,qv->mNormals,2*mesh->mNumVertices);
                 } // else write as usual
                 else WriteArray<aiVector3D>(&chunk,mesh->mNormals,mesh->mNumVertices);
             }
@@ -494,6 +531,9 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
                 if (shortened) {
                     WriteBounds(&chunk,mesh->mTextureCoords[n],mesh->mNumVertices);
+                }
+                else if (qv && qv->mTextureCoords[n]) {
+                    WriteArray<uint16_t>(&chunk,qv->mTextureCoords[n],mesh->mNumUVComponents[n]*mesh->mNumVertices);
                 } // else write as usual
                 else WriteArray<aiVector3D>(&chunk,mesh->mTextureCoords[n],mesh->mNumVertices);
             }
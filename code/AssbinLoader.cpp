@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AssbinLoader.h"
 #include "assbin_chunks.h"
 #include "MemoryIOWrapper.h"
+#include "VertexQuantization.h"
 #include <assimp/mesh.h>
 #include <assimp/anim.h>
 #include <assimp/scene.h>
@@ -63,6 +64,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #   include <contrib/zlib/zlib.h>
 #endif
 
+#include <limits>
+
 using namespace Assimp;
 
 static const aiImporterDesc desc = {
@@ -310,10 +313,38 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
     // first of all, write bits for all existent vertex components
     unsigned int c = Read<unsigned int>(stream);
 
+    // quantized streams are stored instead of the float ones
+    unsigned int q = 0;
+    aiQuantizedVertices* qv = NULL;
+    if (c & ASSBIN_MESH_HAS_QUANTIZED_VERTICES)
+    {
+        // the quantized streams hold up to three values per vertex
+        if (mesh->mNumVertices > std::numeric_limits<unsigned int>::max() / 3) {
+            throw DeadlyImportError( "Too many vertices for quantized vertex streams" );
+        }
+        qv = mesh->mQuantizedVertices = new aiQuantizedVertices();
+        q = Read<unsigned int>(stream);
+        if (q & ASSBIN_MESH_HAS_POSITIONS)
+        {
+            qv->mPositionBits = Read<unsigned int>(stream);
+            qv->mPositionOffset = Read<aiVector3D>(stream);
+            qv->mPositionScale = Read<aiVector3D>(stream);
+        }
+        if (q & ASSBIN_MESH_HAS_NORMALS)
+        {
+            qv->mNormalBits = Read<unsigned int>(stream);
+        }
+    }
+
     if (c & ASSBIN_MESH_HAS_POSITIONS)
     {
         if (shortened) {
             ReadBounds(stream,mesh->mVertices,mesh->mNumVertices);
+        }
+        else if (q & ASSBIN_MESH_HAS_POSITIONS)
+        {
+            qv->mPositions = new unsigned short[3*mesh->mNumVertices];
+            ReadArray<uint16_t>(stream,qv->mPositions,3*mesh->mNumVertices);
         } // else write as usual
         else
         {
@@ -325,6 +356,11 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
     {
         if (shortened) {
             ReadBounds(stream,mesh->mNormals,mesh->mNumVertices);
+        }
+        else if (q & ASSBIN_MESH_HAS_NORMALS)
+        {
+            qv->mNormals = new short[2*mesh->mNumVertices];
+            ReadArray<int16_t>(stream,qv->mNormals,2*mesh->mNumVertices);
         } // else write as usual
         else
         {
@@ -371,6 +407,15 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
 
         if (shortened) {
             ReadBounds(stream,mesh->mTextureCoords[n],mesh->mNumVertices);
+        }
+        else if (q & ASSBIN_MESH_HAS_TEXCOORD(n))
+        {
+            // the component count sizes the stream, so check it before allocating
+            if (mesh->mNumUVComponents[n] < 1 || mesh->mNumUVComponents[n] > 3) {
+                throw DeadlyImportError( "Invalid number of UV components in quantized texture coordinates" );
+            }
+            qv->mTextureCoords[n] = new unsigned short[mesh->mNumUVComponents[n]*mesh->mNumVertices];
+            ReadArray<uint16_t>(stream,qv->mTextureCoords[n],mesh->mNumUVComponents[n]*mesh->mNumVertices);
         } // else write as usual
         else
         {
@@ -379,6 +424,9 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         }
     }
 
+    // restore the float streams from the quantized ones
+    DequantizeVertices(mesh);
+
     // write faces. There are no floating-point calculations involved
     // in these, so we can write a simple hash over the face data
     // to the dump file. We generate a single 32 Bit hash for 512 faces
@@ -684,8 +732,8 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 
     stream->Seek( 44, aiOrigin_CUR ); // signature
 
-    /*unsigned int versionMajor =*/ Read<unsigned int>(stream);
-    /*unsigned int versionMinor =*/ Read<unsigned int>(stream);
+    const unsigned int versionMajor = Read<unsigned int>(stream);
+    const unsigned int versionMinor = Read<unsigned int>(stream);
     /*unsigned int versionRevision =*/ Read<unsigned int>(stream);
     /*unsigned int compileFlags =*/ Read<unsigned int>(stream);
 
@@ -695,6 +743,12 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
     if (shortened)
         throw DeadlyImportError( "Shortened binaries are not supported!" );
 
+    // newer files may store data in a layout unknown to this reader
+    if (versionMajor > ASSBIN_VERSION_MAJOR || (versionMajor == ASSBIN_VERSION_MAJOR && versionMinor > ASSBIN_VERSION_MINOR)) {
+        pIOHandler->Close(stream);
+        throw DeadlyImportError( "Unsupported binary file version, written by a newer version of Assimp" );
+    }
+
     stream->Seek( 256, aiOrigin_CUR ); // original filename
     stream->Seek( 128, aiOrigin_CUR ); // options
     stream->Seek( 64, aiOrigin_CUR ); // padding
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdarg.h>
 #include <assimp/version.h>
 #include "ProcessHelper.h"
+#include "TextStreamWriter.h"
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
@@ -67,26 +68,42 @@ namespace Assimp    {
 namespace AssxmlExport  {
 
 // -----------------------------------------------------------------------------------
-static int ioprintf( IOStream * io, const char *format, ... ) {
+static int ioprintf( TextStreamWriter& io, const char *format, ... ) {
 	using namespace std;
-    if ( nullptr == io ) {
-        return -1;
-    }
-
     static const int Size = 4096;
     char sz[ Size ];
-    ::memset( sz, '\0', Size );
     va_list va;
     va_start( va, format );
     const unsigned int nSize = vsnprintf( sz, Size-1, format, va );
     ai_assert( nSize < Size );
     va_end( va );
 
-    io->Write( sz, sizeof(char), nSize );
+    io.Write( sz, nSize );
 
     return nSize;
 }
 
+// -----------------------------------------------------------------------------------
+// Write a line of vertex components, same output as ioprintf(io,"\t\t%0 8f ... %0 8f\n",...)
+// but without the detour through printf for each value.
+static void WriteComponents(TextStreamWriter& io, const ai_real* v, unsigned int num) {
+    io << "\t\t";
+    for (unsigned int i = 0; i < num; ++i) {
+        if (i) {
+            io << ' ';
+        }
+        if (!std::isfinite(v[i])) {
+            ioprintf(io,"%0 8f",v[i]);
+            continue;
+        }
+        if (!std::signbit(v[i])) {
+            io << ' ';
+        }
+        io.PutFixed(v[i], 6);
+    }
+    io << '\n';
+}
+
 // -----------------------------------------------------------------------------------
 // Convert a name to standard XML format
 static void ConvertName(aiString& out, const aiString& in) {
@@ -112,7 +129,7 @@ static void ConvertName(aiString& out, const aiString& in) {
 
 // -----------------------------------------------------------------------------------
 // Write a single node as text dump
-static void WriteNode(const aiNode* node, IOStream * io, unsigned int depth) {
+static void WriteNode(const aiNode* node, TextStreamWriter& io, unsigned int depth) {
     char prefix[512];
     for (unsigned int i = 0; i < depth;++i)
         prefix[i] = '\t';
@@ -180,7 +197,9 @@ static std::string encodeXML(const std::string& data) {
 // -----------------------------------------------------------------------------------
 // Write a text model dump
 static
-void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
+void WriteDump(const aiScene* scene, IOStream* stream, bool shortened) {
+    TextStreamWriter io(stream);
+
     time_t tt = ::time( NULL );
     tm* p     = ::gmtime( &tt );
     ai_assert( nullptr != p );
@@ -528,10 +547,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
                 ioprintf(io,"\t\t<Positions num=\"%i\" set=\"0\" num_components=\"3\"> \n",mesh->mNumVertices);
                 if (!shortened) {
                     for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                            mesh->mVertices[n].x,
-                            mesh->mVertices[n].y,
-                            mesh->mVertices[n].z);
+                        WriteComponents(io, &mesh->mVertices[n].x, 3);
                     }
                 }
                 ioprintf(io,"\t\t</Positions>\n");
@@ -542,10 +558,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
                 ioprintf(io,"\t\t<Normals num=\"%i\" set=\"0\" num_components=\"3\"> \n",mesh->mNumVertices);
                 if (!shortened) {
                     for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                            mesh->mNormals[n].x,
-                            mesh->mNormals[n].y,
-                            mesh->mNormals[n].z);
+                        WriteComponents(io, &mesh->mNormals[n].x, 3);
                     }
                 }
                 else {
@@ -558,10 +571,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
                 ioprintf(io,"\t\t<Tangents num=\"%i\" set=\"0\" num_components=\"3\"> \n",mesh->mNumVertices);
                 if (!shortened) {
                     for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                            mesh->mTangents[n].x,
-                            mesh->mTangents[n].y,
-                            mesh->mTangents[n].z);
+                        WriteComponents(io, &mesh->mTangents[n].x, 3);
                     }
                 }
                 ioprintf(io,"\t\t</Tangents>\n");
@@ -569,10 +579,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
                 ioprintf(io,"\t\t<Bitangents num=\"%i\" set=\"0\" num_components=\"3\"> \n",mesh->mNumVertices);
                 if (!shortened) {
                     for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                            mesh->mBitangents[n].x,
-                            mesh->mBitangents[n].y,
-                            mesh->mBitangents[n].z);
+                        WriteComponents(io, &mesh->mBitangents[n].x, 3);
                     }
                 }
                 ioprintf(io,"\t\t</Bitangents>\n");
@@ -589,17 +596,12 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
                 if (!shortened) {
                     if (mesh->mNumUVComponents[a] == 3) {
                         for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                            ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                                mesh->mTextureCoords[a][n].x,
-                                mesh->mTextureCoords[a][n].y,
-                                mesh->mTextureCoords[a][n].z);
+                            WriteComponents(io, &mesh->mTextureCoords[a][n].x, 3);
                         }
                     }
                     else {
                         for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                            ioprintf(io,"\t\t%0 8f %0 8f\n",
-                                mesh->mTextureCoords[a][n].x,
-                                mesh->mTextureCoords[a][n].y);
+                            WriteComponents(io, &mesh->mTextureCoords[a][n].x, 2);
                         }
                     }
                 }
@@ -613,11 +615,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
                 ioprintf(io,"\t\t<Colors num=\"%i\" set=\"%i\" num_components=\"4\"> \n",mesh->mNumVertices,a);
                 if (!shortened) {
                     for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f %0 8f\n",
-                            mesh->mColors[a][n].r,
-                            mesh->mColors[a][n].g,
-                            mesh->mColors[a][n].b,
-                            mesh->mColors[a][n].a);
+                        WriteComponents(io, &mesh->mColors[a][n].r, 4);
                     }
                 }
                 ioprintf(io,"\t\t</Colors>\n");
@@ -627,6 +625,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
         ioprintf(io,"</MeshList>\n");
     }
     ioprintf(io,"</Scene>\n</ASSIMP>");
+    io.Flush();
 }
 
 } // end of namespace AssxmlExport
@@ -199,6 +199,7 @@ private:
 
 
 #define AI_SPP_SPATIAL_SORT "$Spat"
+#define AI_SPP_BONE_WEIGHTS "$BoneW"
 
 // ---------------------------------------------------------------------------
 /** The BaseProcess defines a common interface for all post processing steps.
@@ -0,0 +1,536 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  BlenderBlockLoader.cpp
+ *  @brief Implementation of the streaming input classes and of the
+ *    reachability-driven file block loader for BLEND files.
+ */
+
+#ifndef ASSIMP_BUILD_NO_BLEND_IMPORTER
+#include "BlenderBlockLoader.h"
+#include "ByteSwapper.h"
+#include "MemoryIOWrapper.h"
+#include "TinyFormatter.h"
+#include <algorithm>
+
+using namespace Assimp;
+using namespace Assimp::Blender;
+using namespace Assimp::Formatter;
+
+namespace {
+
+    // size of the `BLENDER-v279` file header
+    const size_t FileHeaderSize = 12;
+
+    // size of the windows used for streaming decompression
+    const size_t WindowSize = 1 << 16;
+
+    // ------------------------------------------------------------------------------------------------
+    uint32_t ReadU4(const uint8_t* data, bool swap) {
+        uint32_t v;
+        ::memcpy(&v,data,4);
+        if (swap) {
+            ByteSwap::Swap4(&v);
+        }
+        return v;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    uint64_t ReadU8(const uint8_t* data, bool swap) {
+        uint64_t v;
+        ::memcpy(&v,data,8);
+        if (swap) {
+            ByteSwap::Swap8(&v);
+        }
+        return v;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+RawBlendInput::RawBlendInput(std::shared_ptr<IOStream> stream)
+: stream(stream)
+{
+    ai_assert(stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+void RawBlendInput::Read(void* out, size_t size)
+{
+    if (size && stream->Read(out,1,size) != size) {
+        throw DeadlyImportError("BLEND: Unexpected end of file");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void RawBlendInput::Skip(size_t size)
+{
+    if (size && stream->Seek(size,aiOrigin_CUR) != aiReturn_SUCCESS) {
+        throw DeadlyImportError("BLEND: Unexpected end of file");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void RawBlendInput::Rewind()
+{
+    stream->Seek(0,aiOrigin_SET);
+}
+
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
+
+// ------------------------------------------------------------------------------------------------
+GzipBlendInput::GzipBlendInput(std::shared_ptr<IOStream> stream)
+: stream(stream)
+, in(WindowSize)
+, window(WindowSize)
+, window_pos()
+, window_end()
+, finished()
+, size_hint()
+{
+    ai_assert(stream);
+
+    // http://www.gzip.org/zlib/rfc-gzip.html#header-trailer, ISIZE is the last member
+    const size_t file_size = stream->FileSize();
+    if (file_size >= 4) {
+        uint8_t trailer[4];
+        stream->Seek(file_size - 4,aiOrigin_SET);
+        if (stream->Read(trailer,1,4) == 4) {
+#ifdef AI_BUILD_BIG_ENDIAN
+            size_hint = ReadU4(trailer,true);
+#else
+            size_hint = ReadU4(trailer,false);
+#endif
+        }
+    }
+    stream->Seek(0,aiOrigin_SET);
+
+    // build a zlib stream
+    zstream.opaque = Z_NULL;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree  = Z_NULL;
+    zstream.data_type = Z_BINARY;
+    zstream.next_in = Z_NULL;
+    zstream.avail_in = 0;
+
+    // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
+    if (inflateInit2(&zstream, 16+MAX_WBITS) != Z_OK) {
+        throw DeadlyImportError("BLEND: Failed to initialize zlib");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+GzipBlendInput::~GzipBlendInput()
+{
+    inflateEnd(&zstream);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GzipBlendInput::Fill()
+{
+    window_pos = window_end = 0;
+    if (finished) {
+        return false;
+    }
+
+    zstream.next_out  = &window[0];
+    zstream.avail_out = static_cast<uInt>(window.size());
+
+    // loop until we got at least some output
+    while (zstream.avail_out == window.size()) {
+        if (!zstream.avail_in) {
+            const size_t read = stream->Read(&in[0],1,in.size());
+            if (!read) {
+                throw DeadlyImportError("BLEND: Unexpected end of the compressed file");
+            }
+            zstream.next_in  = &in[0];
+            zstream.avail_in = static_cast<uInt>(read);
+        }
+
+        const int ret = inflate(&zstream, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            finished = true;
+            break;
+        }
+        if (ret != Z_OK && ret != Z_BUF_ERROR) {
+            throw DeadlyImportError("BLEND: Failure decompressing this file using gzip, seemingly it is NOT a compressed .BLEND file");
+        }
+    }
+
+    window_end = window.size() - zstream.avail_out;
+    return window_end > 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipBlendInput::Read(void* out, size_t size)
+{
+    uint8_t* cursor = static_cast<uint8_t*>(out);
+    while (size) {
+        if (window_pos == window_end && !Fill()) {
+            throw DeadlyImportError("BLEND: Unexpected end of file");
+        }
+
+        const size_t n = std::min(size, window_end - window_pos);
+        if (cursor) {
+            ::memcpy(cursor,&window[window_pos],n);
+            cursor += n;
+        }
+        window_pos += n;
+        size -= n;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipBlendInput::Skip(size_t size)
+{
+    Read(NULL,size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipBlendInput::Rewind()
+{
+    inflateReset(&zstream);
+    stream->Seek(0,aiOrigin_SET);
+
+    zstream.avail_in = 0;
+    window_pos = window_end = 0;
+    finished = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipBlendInput::ReadToEnd(std::vector<uint8_t>& out)
+{
+    out.reserve(out.size() + size_hint);
+    while (window_pos < window_end || Fill()) {
+        out.insert(out.end(),window.begin() + window_pos,window.begin() + window_end);
+        window_pos = window_end;
+    }
+}
+
+#endif // !! ASSIMP_BUILD_NO_COMPRESSED_BLEND
+
+// ------------------------------------------------------------------------------------------------
+LazyBlockLoader::LazyBlockLoader(BlendInput& input, FileDatabase& db)
+: input(input)
+, db(db)
+, pending()
+{
+#ifdef AI_BUILD_BIG_ENDIAN
+    swap = db.little;
+#else
+    swap = !db.little;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void LazyBlockLoader::Load()
+{
+    IndexBlocks();
+
+    // we need a scene somewhere to start with. Like BlenderImporter::ExtractScene,
+    // take the one with the lowest address.
+    std::map<std::string,size_t>::const_iterator it = db.dna.indices.find("Scene");
+    if (it == db.dna.indices.end()) {
+        throw DeadlyImportError("BLEND: There is no `Scene` structure record");
+    }
+
+    const Block* scene = NULL;
+    for(size_t idx : by_address) {
+        if (blocks[idx].head.dna_index == (*it).second) {
+            scene = &blocks[idx];
+            break;
+        }
+    }
+    if (!scene) {
+        throw DeadlyImportError("BLEND: There is not a single `Scene` record to load");
+    }
+    MarkTarget(scene->head.address.val,false);
+
+    LoadNeededBlocks();
+
+    size_t loaded = 0;
+    uint64_t total = 0;
+    for(const Block& b : blocks) {
+        total += b.head.size;
+        if (b.loaded) {
+            ++loaded;
+        }
+    }
+
+    DefaultLogger::get()->info((format(),"BLEND: Loaded ",loaded," of ",blocks.size(),
+        " file blocks (",image.size()," of ",total," bytes)"));
+
+    db.entries.reserve(loaded);
+    for(const Block& b : blocks) {
+        if (b.loaded) {
+            db.entries.push_back(b.head);
+            db.entries.back().start = static_cast<StreamReaderAny::pos>(b.image_offset);
+        }
+    }
+    std::sort(db.entries.begin(),db.entries.end());
+
+    if (image.empty()) {
+        throw DeadlyImportError("BLEND: None of the needed file blocks holds any data");
+    }
+
+    // the stream reader keeps its own copy of the data
+    db.reader = std::shared_ptr<StreamReaderAny>(new StreamReaderAny(
+        std::shared_ptr<IOStream>(new MemoryIOStream(image.data(),image.size())),db.little));
+    std::vector<uint8_t>().swap(image);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LazyBlockLoader::ParseHeader(const uint8_t* data, FileBlockHead& out) const
+{
+    const char* tmp = reinterpret_cast<const char*>(data);
+    out.id = std::string(tmp,tmp[3]?4:tmp[2]?3:tmp[1]?2:1);
+
+    out.size = ReadU4(data+4,swap);
+    data += 8;
+
+    out.address.val = ReadPointer(data);
+    data += db.i64bit ? 8 : 4;
+
+    out.dna_index = ReadU4(data,swap);
+    out.num = ReadU4(data+4,swap);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LazyBlockLoader::IndexBlocks()
+{
+    const size_t head_size = db.i64bit ? 24 : 20;
+    uint8_t head[24];
+
+    bool have_dna = false;
+    uint64_t pos = FileHeaderSize;
+    for(;;) {
+        input.Read(head,head_size);
+        pos += head_size;
+
+        Block b;
+        ParseHeader(head,b.head);
+        if (b.head.id == "ENDB") {
+            break; // only valid end of the file
+        }
+
+        if (b.head.id == "DNA1") {
+            if (!b.head.size) {
+                throw DeadlyImportError("BLEND: Empty SDNA block");
+            }
+            std::vector<uint8_t> dna(b.head.size);
+            input.Read(&dna[0],dna.size());
+            pos += dna.size();
+
+            db.reader = std::shared_ptr<StreamReaderAny>(new StreamReaderAny(
+                std::shared_ptr<IOStream>(new MemoryIOStream(&dna[0],dna.size())),db.little));
+
+            DNAParser(db).Parse();
+            have_dna = true;
+            continue;
+        }
+
+        b.file_offset = pos;
+        b.image_offset = 0;
+        b.needed = b.loaded = b.pointer_array = false;
+        blocks.push_back(b);
+
+        input.Skip(b.head.size);
+        pos += b.head.size;
+    }
+
+    if (!have_dna) {
+        throw DeadlyImportError("BLEND: SDNA not found");
+    }
+
+    by_address.resize(blocks.size());
+    for(size_t i = 0; i < blocks.size(); ++i) {
+        by_address[i] = i;
+    }
+    std::sort(by_address.begin(),by_address.end(),[this](size_t a, size_t b) {
+        return blocks[a].head.address.val < blocks[b].head.address.val;
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void LazyBlockLoader::LoadNeededBlocks()
+{
+    unsigned int passes = 0;
+    while (pending) {
+        input.Rewind();
+        input.Skip(FileHeaderSize);
+        ++passes;
+
+        // blocks marked while scanning are picked up by this
+        // pass if they are located further down in the file.
+        uint64_t pos = FileHeaderSize;
+        for(Block& b : blocks) {
+            if (!b.needed || b.loaded) {
+                continue;
+            }
+
+            input.Skip(static_cast<size_t>(b.file_offset - pos));
+
+            b.image_offset = image.size();
+            image.resize(image.size() + b.head.size);
+            if (b.head.size) {
+                input.Read(&image[b.image_offset],b.head.size);
+            }
+            pos = b.file_offset + b.head.size;
+
+            b.loaded = true;
+            --pending;
+
+            ScanBlock(b);
+        }
+    }
+
+    DefaultLogger::get()->debug((format(),"BLEND: Needed ",passes," pass(es) to load all reachable file blocks"));
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t LazyBlockLoader::ReadPointer(const uint8_t* data) const
+{
+    return db.i64bit ? ReadU8(data,swap) : ReadU4(data,swap);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LazyBlockLoader::MarkTarget(uint64_t ptr, bool pointer_array)
+{
+    if (!ptr) {
+        return;
+    }
+
+    // find the block containing this address, pointers to
+    // nowhere are not our business, the converter decides.
+    std::vector<size_t>::const_iterator it = std::upper_bound(by_address.begin(),by_address.end(),ptr,
+        [this](uint64_t p, size_t idx) {
+            return p < blocks[idx].head.address.val;
+        });
+
+    if (it == by_address.begin()) {
+        return;
+    }
+
+    Block& b = blocks[*--it];
+    if (ptr >= b.head.address.val + b.head.size) {
+        return;
+    }
+
+    if (pointer_array && !b.pointer_array) {
+        b.pointer_array = true;
+        if (b.loaded) {
+            ScanBlock(b);
+        }
+    }
+
+    if (!b.needed) {
+        b.needed = true;
+        ++pending;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LazyBlockLoader::ScanBlock(const Block& b)
+{
+    if (!b.head.size) {
+        return;
+    }
+    const uint8_t* data = &image[b.image_offset];
+
+    if (b.pointer_array) {
+        // array of pointers, i.e. Object::mat
+        const size_t ptr_size = db.i64bit ? 8 : 4;
+        for(size_t i = 0; i + ptr_size <= b.head.size; i += ptr_size) {
+            MarkTarget(ReadPointer(data + i),false);
+        }
+        return;
+    }
+
+    if (b.head.dna_index >= db.dna.structures.size()) {
+        return;
+    }
+
+    // untyped data is written as `Link`, its contents is meaningless here.
+    const Structure& s = db.dna.structures[b.head.dna_index];
+    if (!s.size || s.name == "Link") {
+        return;
+    }
+
+    for(size_t i = 0; i + s.size <= b.head.size; i += s.size) {
+        ScanStructure(s,data + i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LazyBlockLoader::ScanStructure(const Structure& s, const uint8_t* data, unsigned int depth)
+{
+    if (s.name == "ID") {
+        return;
+    }
+
+    // a corrupt DNA may declare a structure which contains itself
+    if (depth > MaxStructureDepth) {
+        throw DeadlyImportError("BLEND: Structure `" + s.name + "` is nested too deeply, the DNA is probably corrupt");
+    }
+
+    const size_t ptr_size = db.i64bit ? 8 : 4;
+    for(const Field& f : s.fields) {
+        if (f.offset + f.size > s.size) {
+            continue;
+        }
+
+        const size_t count = (f.flags & FieldFlag_Array) ? f.array_sizes[0] * f.array_sizes[1] : 1;
+        if (f.flags & FieldFlag_Pointer) {
+            // double indirection means the target is an array of pointers
+            const bool pointer_array = f.name.length() > 1 && f.name[1] == '*';
+            for(size_t i = 0; i < count && (i+1) * ptr_size <= f.size; ++i) {
+                MarkTarget(ReadPointer(data + f.offset + i * ptr_size),pointer_array);
+            }
+        }
+        else if (f.type_structure && !f.type_structure->fields.empty()) {
+            const Structure& sub = *f.type_structure;
+            for(size_t i = 0; i < count && (i+1) * sub.size <= f.size; ++i) {
+                ScanStructure(sub,data + f.offset + i * sub.size,depth + 1);
+            }
+        }
+    }
+}
+
+#endif // ASSIMP_BUILD_NO_BLEND_IMPORTER
@@ -0,0 +1,224 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  BlenderBlockLoader.h
+ *  @brief Sequential (optionally gzip-compressed) input for BLEND files and
+ *    a loader which reads only the file blocks reachable from the scene.
+ */
+#ifndef INCLUDED_AI_BLEND_BLOCK_LOADER_H
+#define INCLUDED_AI_BLEND_BLOCK_LOADER_H
+
+#include "BlenderDNA.h"
+#include <assimp/IOStream.hpp>
+#include <memory>
+#include <vector>
+
+// zlib is needed for compressed blend files
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
+#   ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#       include <zlib.h>
+#   else
+#       include "../contrib/zlib/zlib.h"
+#   endif
+#endif
+
+namespace Assimp    {
+namespace Blender {
+
+// -------------------------------------------------------------------------------
+/** Forward-only view on the uncompressed contents of a BLEND file. Going
+ *  back is only possible by restarting at the beginning of the file. */
+// -------------------------------------------------------------------------------
+class BlendInput
+{
+public:
+    virtual ~BlendInput() {}
+
+public:
+    // --------------------------------------------------------
+    /** Read exactly `size` bytes.
+     *  @throw DeadlyImportError if the end of the file is reached. */
+    virtual void Read(void* out, size_t size) = 0;
+
+    // --------------------------------------------------------
+    /** Skip `size` bytes.
+     *  @throw DeadlyImportError if the end of the file is reached. */
+    virtual void Skip(size_t size) = 0;
+
+    // --------------------------------------------------------
+    /** Restart at the first byte of the file. */
+    virtual void Rewind() = 0;
+};
+
+// -------------------------------------------------------------------------------
+/** BlendInput for uncompressed files, skipping is done by seeking. */
+// -------------------------------------------------------------------------------
+class RawBlendInput : public BlendInput
+{
+public:
+    RawBlendInput(std::shared_ptr<IOStream> stream);
+
+public:
+    void Read(void* out, size_t size);
+    void Skip(size_t size);
+    void Rewind();
+
+private:
+    std::shared_ptr<IOStream> stream;
+};
+
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
+
+// -------------------------------------------------------------------------------
+/** BlendInput for gzip-compressed files. Both the compressed input and the
+ *  decompressed output pass through fixed-size windows, so memory usage is
+ *  independent of the file size. Rewinding restarts decompression. */
+// -------------------------------------------------------------------------------
+class GzipBlendInput : public BlendInput
+{
+public:
+    /** @param stream Compressed input, must start with the gzip header. */
+    GzipBlendInput(std::shared_ptr<IOStream> stream);
+    ~GzipBlendInput();
+
+public:
+    void Read(void* out, size_t size);
+    void Skip(size_t size);
+    void Rewind();
+
+    // --------------------------------------------------------
+    /** Decompress everything from the current position to the end
+     *  of the file and append it to `out`. */
+    void ReadToEnd(std::vector<uint8_t>& out);
+
+    // --------------------------------------------------------
+    /** Uncompressed size as stored in the gzip trailer. This is
+     *  only taken modulo 2^32, so use it as a hint only. */
+    size_t GetSizeHint() const {
+        return size_hint;
+    }
+
+private:
+    // decompress the next chunk into the output window,
+    // returns false at the end of the compressed stream.
+    bool Fill();
+
+private:
+    std::shared_ptr<IOStream> stream;
+    z_stream zstream;
+
+    std::vector<Bytef> in, window;
+    size_t window_pos, window_end;
+    bool finished;
+    size_t size_hint;
+};
+
+#endif // !! ASSIMP_BUILD_NO_COMPRESSED_BLEND
+
+// -------------------------------------------------------------------------------
+/** Builds a #FileDatabase which contains only the file blocks reachable from
+ *  the scene. A first pass over the input collects all block headers and the
+ *  DNA while skipping block contents. Then, starting with the scene block,
+ *  blocks are read and scanned for pointers using the DNA, which marks the
+ *  blocks they point to as needed. Blocks referenced from earlier positions
+ *  in the file require another pass, which is cheap for uncompressed input.
+ *
+ *  Pointers in `ID` records (the global lists of data blocks and custom
+ *  properties) are not followed since the converters never use them; this
+ *  is what keeps unused data blocks out of memory. */
+// -------------------------------------------------------------------------------
+class LazyBlockLoader
+{
+public:
+    /** @param input Input stream, must point right after the 12 byte
+     *    file header. `db.i64bit` and `db.little` must be set.
+     *  @param db Database to be filled. */
+    LazyBlockLoader(BlendInput& input, FileDatabase& db);
+
+public:
+    // --------------------------------------------------------
+    /** Index the file, load all needed blocks and setup `db`.
+     *  @throw DeadlyImportError if the file is invalid. */
+    void Load();
+
+private:
+    struct Block {
+        FileBlockHead head;
+
+        // offset of the block contents in the uncompressed file
+        uint64_t file_offset;
+
+        // offset of the block contents in the compacted image
+        size_t image_offset;
+
+        bool needed, loaded, pointer_array;
+    };
+
+    void IndexBlocks();
+    void LoadNeededBlocks();
+    void ParseHeader(const uint8_t* data, FileBlockHead& out) const;
+
+    void MarkTarget(uint64_t ptr, bool pointer_array);
+    void ScanBlock(const Block& block);
+    void ScanStructure(const Structure& s, const uint8_t* data, unsigned int depth = 0);
+    uint64_t ReadPointer(const uint8_t* data) const;
+
+    // nesting limit for structures embedded by value, real files stay
+    // far below. Exceeding it means the DNA is cyclic.
+    static const unsigned int MaxStructureDepth = 64;
+
+private:
+    BlendInput& input;
+    FileDatabase& db;
+
+    // blocks in file order and their indices sorted by address
+    std::vector<Block> blocks;
+    std::vector<size_t> by_address;
+
+    std::vector<uint8_t> image;
+    size_t pending;
+    bool swap;
+};
+
+    } // end Blend
+} // end Assimp
+
+#endif
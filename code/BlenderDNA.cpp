@@ -218,6 +218,7 @@ void DNAParser::Parse ()
 #endif
 
     dna.AddPrimitiveStructures();
+    dna.ResolveFieldTypes();
     dna.RegisterConverters();
 }
 
@@ -342,6 +343,17 @@ void DNA :: AddPrimitiveStructures()
     // no long, seemingly.
 }
 
+// ------------------------------------------------------------------------------------------------
+void DNA :: ResolveFieldTypes()
+{
+    // the structure list is final now, so pointers into it stay valid
+    for(Structure& s : structures) {
+        for(Field& f : s.fields) {
+            f.type_structure = Get(f.type);
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void SectionParser :: Next()
 {
@@ -70,6 +70,7 @@ namespace Blender {
 class  FileDatabase;
 struct FileBlockHead;
 
+class  Structure;
 template <template <typename> class TOUT>
 class ObjectCache;
 
@@ -176,6 +177,11 @@ struct Field {
 
     /** Any of the #FieldFlags enumerated values */
     unsigned int flags;
+
+    /** Structure definition for #type, filled in by
+     *  DNA::ResolveFieldTypes once the DNA is complete.
+     *  NULL if the type is not contained in the DNA. */
+    const Structure* type_structure;
 };
 
 // -------------------------------------------------------------------------------
@@ -209,7 +215,8 @@ class Structure {
 
 public:
     Structure()
-    : cache_idx(static_cast<size_t>(-1) ){
+    : plan_cursor()
+    , cache_idx(static_cast<size_t>(-1) ){
         // empty
     }
 
@@ -324,6 +331,30 @@ private:
         const Pointer & ptrval,
         const FileDatabase& db) const;
 
+    // --------------------------------------------------------
+    /** Look up a field through the compiled access plan of this
+     *  structure. The plan caches the resolved field for each
+     *  distinct `name` pointer, so `name` must refer to storage
+     *  which outlives the DNA (the generated converters pass
+     *  string literals). The string map is only consulted the
+     *  first time a name is requested.
+     *  @throw Error if the structure has no such field. */
+    inline const Field& LookupField(const char* name) const;
+
+    // --------------------------------------------------------
+    /** Look up the structure definition for the type of a field.
+     *  @throw Error if the type is not contained in the DNA. */
+    inline const Structure& LookupFieldType(const Field& f,
+        const FileDatabase& db) const;
+
+    // --------------------------------------------------------
+    /** Copy `num` primitive values verbatim from the stream if
+     *  `s` is stored exactly like `T` in host byte order.
+     *  @return false if a per-element conversion is required. */
+    template <typename T>
+    bool ReadPrimitiveArray(T* out, size_t num, const Structure& s,
+        const FileDatabase& db) const;
+
 private:
 
     // ------------------------------------------------------------------------------
@@ -366,6 +397,18 @@ private:
 
 private:
 
+    // Entry of the compiled access plan, see #LookupField
+    struct PlanEntry {
+        const char* name;
+        const Field* field;
+    };
+
+    // converters request their fields in the same order for every
+    // instance, so the plan is kept in request order and plan_cursor
+    // points to the entry which is most likely requested next.
+    mutable std::vector<PlanEntry> plan;
+    mutable size_t plan_cursor;
+
     mutable size_t cache_idx;
 };
 
@@ -445,6 +488,12 @@ public:
      *  i.e. integer, short, char, float */
     void AddPrimitiveStructures();
 
+    // --------------------------------------------------------
+    /** Resolve the type of each field to its structure
+     *  definition so converters need not look it up by name.
+     *  Must be called after all structures have been added. */
+    void ResolveFieldTypes();
+
     // --------------------------------------------------------
     /** Fill the @c converters member with converters for all
      *  known data types. The implementation of this method is
@@ -84,6 +84,51 @@ const Field& Structure :: operator [] (const size_t i) const
     return fields[i];
 }
 
+//--------------------------------------------------------------------------------
+const Field& Structure :: LookupField(const char* ss) const
+{
+    if (plan_cursor >= plan.size()) {
+        plan_cursor = 0;
+    }
+
+    const Field* f = NULL;
+    if (plan_cursor < plan.size() && plan[plan_cursor].name == ss) {
+        f = plan[plan_cursor++].field;
+    }
+    else {
+        size_t i = 0;
+        for (; i < plan.size(); ++i) {
+            if (plan[i].name == ss) {
+                break;
+            }
+        }
+
+        if (i == plan.size()) {
+            // first request for this name, resolve it once
+            PlanEntry e;
+            e.name = ss;
+            e.field = Get(ss);
+            plan.push_back(e);
+        }
+        f = plan[i].field;
+        plan_cursor = i+1;
+    }
+
+    if (!f) {
+        throw Error((Formatter::format(),
+            "BlendDNA: Did not find a field named `",ss,"` in structure `",name,"`"
+            ));
+    }
+    return *f;
+}
+
+//--------------------------------------------------------------------------------
+const Structure& Structure :: LookupFieldType(const Field& f, const FileDatabase& db) const
+{
+    // fall back to the name lookup, which raises the appropriate error
+    return f.type_structure ? *f.type_structure : db.dna[f.type];
+}
+
 //--------------------------------------------------------------------------------
 template <typename T> std::shared_ptr<ElemBase> Structure :: Allocate() const
 {
@@ -104,8 +149,8 @@ void Structure :: ReadFieldArray(T (& out)[M], const char* name, const FileDatab
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        const Structure& s = db.dna[f.type];
+        const Field& f = LookupField(name);
+        const Structure& s = LookupFieldType(f,db);
 
         // is the input actually an array?
         if (!(f.flags & FieldFlag_Array)) {
@@ -118,7 +163,11 @@ void Structure :: ReadFieldArray(T (& out)[M], const char* name, const FileDatab
 
         // size conversions are always allowed, regardless of error_policy
         unsigned int i = 0;
-        for(; i < std::min(f.array_sizes[0],M); ++i) {
+        const size_t num = std::min(f.array_sizes[0],M);
+        if (ReadPrimitiveArray(out,num,s,db)) {
+            i = static_cast<unsigned int>(num);
+        }
+        for(; i < num; ++i) {
             s.Convert(out[i],db);
         }
         for(; i < M; ++i) {
@@ -143,8 +192,8 @@ void Structure :: ReadFieldArray2(T (& out)[M][N], const char* name, const FileD
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        const Structure& s = db.dna[f.type];
+        const Field& f = LookupField(name);
+        const Structure& s = LookupFieldType(f,db);
 
         // is the input actually an array?
         if (!(f.flags & FieldFlag_Array)) {
@@ -157,6 +206,9 @@ void Structure :: ReadFieldArray2(T (& out)[M][N], const char* name, const FileD
 
         // size conversions are always allowed, regardless of error_policy
         unsigned int i = 0;
+        if (f.array_sizes[0] == M && f.array_sizes[1] == N && ReadPrimitiveArray(&out[0][0],M*N,s,db)) {
+            i = M;
+        }
         for(; i < std::min(f.array_sizes[0],M); ++i) {
             unsigned int j = 0;
             for(; j < std::min(f.array_sizes[1],N); ++j) {
@@ -191,7 +243,7 @@ bool Structure :: ReadFieldPtr(TOUT<T>& out, const char* name, const FileDatabas
     Pointer ptrval;
     const Field* f;
     try {
-        f = &(*this)[name];
+        f = &LookupField(name);
 
         // sanity check, should never happen if the genblenddna script is right
         if (!(f->flags & FieldFlag_Pointer)) {
@@ -236,7 +288,7 @@ bool Structure :: ReadFieldPtr(TOUT<T> (&out)[N], const char* name,
     Pointer ptrval[N];
     const Field* f;
     try {
-        f = &(*this)[name];
+        f = &LookupField(name);
 
         // sanity check, should never happen if the genblenddna script is right
         if ((FieldFlag_Pointer|FieldFlag_Pointer) != (f->flags & (FieldFlag_Pointer|FieldFlag_Pointer))) {
@@ -286,9 +338,9 @@ void Structure :: ReadField(T& out, const char* name, const FileDatabase& db) co
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
+        const Field& f = LookupField(name);
         // find the structure definition pertaining to this field
-        const Structure& s = db.dna[f.type];
+        const Structure& s = LookupFieldType(f,db);
 
         db.reader->IncPtr(f.offset);
         s.Convert(out,db);
@@ -316,7 +368,7 @@ bool Structure :: ResolvePointer(TOUT<T>& out, const Pointer & ptrval, const Fil
     if (!ptrval.val) {
         return false;
     }
-    const Structure& s = db.dna[f.type];
+    const Structure& s = LookupFieldType(f,db);
     // find the file block the pointer is pointing to
     const FileBlockHead* block = LocateFileBlockForAddress(ptrval,db);
 
@@ -555,6 +607,37 @@ template <> struct static_cast_silent<double> {
     }
 };
 
+// ------------------------------------------------------------------------------------------------
+// Name of the DNA primitive whose file representation is bit-identical to T
+// (apart from byte order), NULL if there is none.
+template <typename T> struct PrimitiveName { static const char* get() { return NULL; } };
+template <> struct PrimitiveName<int>    { static const char* get() { return "int"; } };
+template <> struct PrimitiveName<short>  { static const char* get() { return "short"; } };
+template <> struct PrimitiveName<char>   { static const char* get() { return "char"; } };
+template <> struct PrimitiveName<float>  { static const char* get() { return "float"; } };
+template <> struct PrimitiveName<double> { static const char* get() { return "double"; } };
+
+//--------------------------------------------------------------------------------
+template <typename T>
+bool Structure :: ReadPrimitiveArray(T* out, size_t num, const Structure& s, const FileDatabase& db) const
+{
+    const char* prim = PrimitiveName<T>::get();
+    if (!prim || s.size != sizeof(T) || s.name != prim) {
+        return false;
+    }
+
+#ifdef AI_BUILD_BIG_ENDIAN
+    if (db.little) {
+#else
+    if (!db.little) {
+#endif
+        return false;
+    }
+
+    db.reader->CopyAndAdvance(out,num*sizeof(T));
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 template <typename T> inline void ConvertDispatcher(T& out, const Structure& in,const FileDatabase& db)
 {
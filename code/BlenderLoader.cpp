@@ -53,9 +53,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BlenderIntermediate.h"
 #include "BlenderModifier.h"
 #include "BlenderBMesh.h"
+#include "BlenderBlockLoader.h"
 #include "StringUtils.h"
 #include <assimp/scene.h>
 #include <assimp/importerdesc.h>
+#include <assimp/Importer.hpp>
 
 #include "StringComparison.h"
 #include "StreamReader.h"
@@ -64,15 +66,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cctype>
 
 
-// zlib is needed for compressed blend files
-#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-#   ifdef ASSIMP_BUILD_NO_OWN_ZLIB
-#       include <zlib.h>
-#   else
-#       include "../contrib/zlib/zlib.h"
-#   endif
-#endif
-
 namespace Assimp {
     template<> const std::string LogFunctions<BlenderImporter>::log_prefix = "BLEND: ";
 }
@@ -98,7 +91,8 @@ static const aiImporterDesc blenderDesc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BlenderImporter::BlenderImporter()
-: modifier_cache(new BlenderModifierShowcase()) {
+: modifier_cache(new BlenderModifierShowcase())
+, lazy_blocks() {
     // empty
 }
 
@@ -144,37 +138,28 @@ const aiImporterDesc* BlenderImporter::GetInfo () const
 
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties for the loader
-void BlenderImporter::SetupProperties(const Importer* /*pImp*/)
+void BlenderImporter::SetupProperties(const Importer* pImp)
 {
-    // nothing to be done for the moment
+    lazy_blocks = pImp->GetPropertyBool(AI_CONFIG_IMPORT_BLEND_LAZY_BLOCKS,false);
 }
 
-struct free_it {
-    free_it(void* free) : free(free) {}
-    ~free_it() {
-        ::free(this->free);
-    }
-
-    void* free;
-};
-
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure.
 void BlenderImporter::InternReadFile( const std::string& pFile,
     aiScene* pScene, IOSystem* pIOHandler)
 {
-#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-    Bytef* dest = NULL;
-    free_it free_it_really(dest);
-#endif
-
-
     FileDatabase file;
     std::shared_ptr<IOStream> stream(pIOHandler->Open(pFile,"rb"));
     if (!stream) {
         ThrowException("Could not open file for reading");
     }
 
+    // only set if the file blocks are loaded on demand
+    std::unique_ptr<BlendInput> input;
+
+    // decompressed file contents, if we need to keep them in memory
+    std::vector<uint8_t> uncompressed;
+
     char magic[8] = {0};
     stream->Read(magic,7,1);
     if (strcmp(magic, Tokens[0] )) {
@@ -194,70 +179,58 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
             ThrowException("Unsupported GZIP compression method");
         }
 
-        // http://www.gzip.org/zlib/rfc-gzip.html#header-trailer
-        stream->Seek(0L,aiOrigin_SET);
-        std::shared_ptr<StreamReaderLE> reader = std::shared_ptr<StreamReaderLE>(new StreamReaderLE(stream));
-
-        // build a zlib stream
-        z_stream zstream;
-        zstream.opaque = Z_NULL;
-        zstream.zalloc = Z_NULL;
-        zstream.zfree  = Z_NULL;
-        zstream.data_type = Z_BINARY;
-
-        // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
-        inflateInit2(&zstream, 16+MAX_WBITS);
-
-        zstream.next_in   = reinterpret_cast<Bytef*>( reader->GetPtr() );
-        zstream.avail_in  = reader->GetRemainingSize();
-
-        size_t total = 0l;
-
-        // and decompress the data .... do 1k chunks in the hope that we won't kill the stack
-#define MYBLOCK 1024
-        Bytef block[MYBLOCK];
-        int ret;
-        do {
-            zstream.avail_out = MYBLOCK;
-            zstream.next_out = block;
-            ret = inflate(&zstream, Z_NO_FLUSH);
-
-            if (ret != Z_STREAM_END && ret != Z_OK) {
-                ThrowException("Failure decompressing this file using gzip, seemingly it is NOT a compressed .BLEND file");
+        std::unique_ptr<GzipBlendInput> gzip(new GzipBlendInput(stream));
+        if (lazy_blocks) {
+            // keep streaming from the compressed file
+            gzip->Read(magic,7);
+            input.reset(gzip.release());
+        }
+        else {
+            // replace the input stream with a memory stream
+            gzip->ReadToEnd(uncompressed);
+            if (uncompressed.size() < 7) {
+                ThrowException("Found no BLENDER magic word in decompressed GZIP file");
             }
-            const size_t have = MYBLOCK - zstream.avail_out;
-            total += have;
-            dest = reinterpret_cast<Bytef*>( realloc(dest,total) );
-            memcpy(dest + total - have,block,have);
+            stream.reset(new MemoryIOStream(&uncompressed[0],uncompressed.size()));
+            stream->Read(magic,7,1);
         }
-        while (ret != Z_STREAM_END);
-
-        // terminate zlib
-        inflateEnd(&zstream);
-
-        // replace the input stream with a memory stream
-        stream.reset(new MemoryIOStream(reinterpret_cast<uint8_t*>(dest),total));
 
         // .. and retry
-        stream->Read(magic,7,1);
         if (strcmp(magic,"BLENDER")) {
             ThrowException("Found no BLENDER magic word in decompressed GZIP file");
         }
 #endif
     }
+    else if (lazy_blocks) {
+        input.reset(new RawBlendInput(stream));
+    }
 
-    file.i64bit = (stream->Read(magic,1,1),magic[0]=='-');
-    file.little = (stream->Read(magic,1,1),magic[0]=='v');
+    char header[5];
+    if (input) {
+        input->Read(header,5);
+    }
+    else if (stream->Read(header,5,1) != 1) {
+        ThrowException("Unexpected end of file");
+    }
 
-    stream->Read(magic,3,1);
-    magic[3] = '\0';
+    file.i64bit = header[0]=='-';
+    file.little = header[1]=='v';
 
-    LogInfo((format(),"Blender version is ",magic[0],".",magic+1,
+    const char version[4] = {header[2],header[3],header[4],'\0'};
+    LogInfo((format(),"Blender version is ",version[0],".",version+1,
         " (64bit: ",file.i64bit?"true":"false",
         ", little endian: ",file.little?"true":"false",")"
     ));
 
-    ParseBlendFile(file,stream);
+    if (input) {
+        LazyBlockLoader(*input,file).Load();
+    }
+    else {
+        ParseBlendFile(file,stream);
+
+        // the stream reader has its own copy by now
+        std::vector<uint8_t>().swap(uncompressed);
+    }
 
     Scene scene;
     ExtractScene(scene,file);
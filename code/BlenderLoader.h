@@ -233,6 +233,9 @@ private:
 
     Blender::BlenderModifierShowcase* modifier_cache;
 
+    // AI_CONFIG_IMPORT_BLEND_LAZY_BLOCKS
+    bool lazy_blocks;
+
 }; // !class BlenderImporter
 
 } // end of namespace Assimp
@@ -56,7 +56,8 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 CalcTangentsProcess::CalcTangentsProcess()
 : configMaxAngle( AI_DEG_TO_RAD(45.f) )
-, configSourceUV( 0 ) {
+, configSourceUV( 0 )
+, configSpatialSortGrid( false ) {
     // nothing to do here
 }
 
@@ -86,6 +87,8 @@ void CalcTangentsProcess::SetupProperties(const Importer* pImp)
     configMaxAngle = AI_DEG_TO_RAD(configMaxAngle);
 
     configSourceUV = pImp->GetPropertyInteger(AI_CONFIG_PP_CT_TEXTURE_CHANNEL_INDEX,0);
+
+    configSpatialSortGrid = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_GRID,0));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -251,6 +254,7 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     }
     if (!vertexFinder)
     {
+        _vertexFinder.SetGridEnabled(configSpatialSortGrid);
         _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
         vertexFinder = &_vertexFinder;
         posEpsilon = ComputePositionEpsilon(pMesh);
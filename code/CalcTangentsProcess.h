@@ -109,6 +109,9 @@ private:
     /** Configuration option: maximum smoothing angle, in radians*/
     float configMaxAngle;
     unsigned int configSourceUV;
+
+    /** Configuration option: grid index for vertex lookups, see #AI_CONFIG_PP_SPATIAL_SORT_GRID */
+    bool configSpatialSortGrid;
 };
 
 } // end of namespace Assimp
@@ -55,6 +55,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <map>
 
 #include "StringUtils.h"
+#include "TextStreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -68,7 +69,7 @@ class ColladaExporter
 {
 public:
     /// Constructor for a specific scene to export
-    ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file);
+    ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, const char* pOutfile);
 
     /// Destructor
     virtual ~ColladaExporter();
@@ -135,11 +136,10 @@ protected:
         return std::string( "meshId" ) + to_string(pIndex);
     }
 
-public:
-    /// Stringstream to write all output into
-    std::stringstream mOutput;
-
 protected:
+    /// Buffered writer for all output
+    TextStreamWriter mOutput;
+
     /// The IOSystem for output
     IOSystem* mIOSystem;
 
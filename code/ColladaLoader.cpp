@@ -62,6 +62,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "math.h"
 #include <algorithm>
 #include <numeric>
+#include <iterator>
 #include <assimp/Defines.h>
 
 using namespace Assimp;
@@ -94,6 +95,7 @@ ColladaLoader::ColladaLoader()
 	, mAnims()
 	, noSkeletonMesh( false )
     , ignoreUpDirection(false)
+    , usePullReader(false)
     , mNodeNameCounter( 0 )
 {}
 
@@ -130,6 +132,7 @@ void ColladaLoader::SetupProperties(const Importer* pImp)
 {
     noSkeletonMesh = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NO_SKELETON_MESHES,0) != 0;
     ignoreUpDirection = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_IGNORE_UP_DIRECTION,0) != 0;
+    usePullReader = pImp->GetPropertyBool(AI_CONFIG_IMPORT_COLLADA_PULL_READER,pImp->GetPropertyBool(AI_CONFIG_IMPORT_XML_PULL_READER,false));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -155,13 +158,18 @@ void ColladaLoader::InternReadFile( const std::string& pFile, aiScene* pScene, I
     mCameras.clear();
     mTextures.clear();
     mAnims.clear();
+    mNodeByName.clear();
+    mNodeBySID.clear();
 
     // parse the input file
-    ColladaParser parser( pIOHandler, pFile);
+    ColladaParser parser( pIOHandler, pFile, usePullReader);
 
     if( !parser.mRootNode)
         throw DeadlyImportError( "Collada: File came out empty. Something is wrong here.");
 
+    // index the node hierarchy for resolving references by name, ID or SID
+    BuildNodeIndex( parser.mRootNode);
+
     // reserve some storage to avoid unnecessary reallocs
     newMats.reserve(parser.mMaterialLibrary.size()*2);
     mMeshes.reserve(parser.mMeshLibrary.size()*2);
@@ -288,7 +296,7 @@ void ColladaLoader::ResolveNodeInstances( const ColladaParser& pParser, const Co
         // need to check for both name and ID to catch all. To avoid breaking valid files,
         // the workaround is only enabled when the first attempt to resolve the node has failed.
         if (!nd) {
-            nd = FindNode(pParser.mRootNode, nodeInst.mNode);
+            nd = FindNode(nodeInst.mNode);
         }
         if (!nd)
             DefaultLogger::get()->error("Collada: Unable to resolve reference to instanced node " + nodeInst.mNode);
@@ -863,9 +871,9 @@ aiMesh* ColladaLoader::CreateMesh( const ColladaParser& pParser, const Collada::
             // Therefore I added a little name replacement here: I search for the bone's node by either name, ID or SID,
             // and replace the bone's name by the node's name so that the user can use the standard
             // find-by-name method to associate nodes with bones.
-            const Collada::Node* bnode = FindNode( pParser.mRootNode, bone->mName.data);
+            const Collada::Node* bnode = FindNode( bone->mName.data);
             if( !bnode)
-                bnode = FindNodeBySID( pParser.mRootNode, bone->mName.data);
+                bnode = FindNodeBySID( bone->mName.data);
 
             // assign the name that we would have assigned for the source node
             if( bnode)
@@ -1106,6 +1114,22 @@ void ColladaLoader::CreateAnimation( aiScene* pScene, const ColladaParser& pPars
     std::vector<aiNodeAnim*> anims;
     std::vector<aiMeshMorphAnim*> morphAnims;
 
+    // group the channels by the node ID in front of the slash in their target, so each
+    // node only needs to look at its own channels. Targets without slash are matched
+    // by substring search below, so they are candidates for every node.
+    std::unordered_map<std::string, std::vector<size_t> > channelsByTarget;
+    std::vector<size_t> untargetedChannels;
+    for( size_t a = 0; a < pSrcAnim->mChannels.size(); ++a)
+    {
+        const std::string& target = pSrcAnim->mChannels[a].mTarget;
+        std::string::size_type slashPos = target.find( '/');
+        if( slashPos == std::string::npos)
+            untargetedChannels.push_back( a);
+        else
+            channelsByTarget[target.substr( 0, slashPos)].push_back( a);
+    }
+
+    std::vector<size_t> channels;
     for( std::vector<const aiNode*>::const_iterator nit = nodes.begin(); nit != nodes.end(); ++nit)
     {
         // find all the collada anim channels which refer to the current node
@@ -1113,16 +1137,23 @@ void ColladaLoader::CreateAnimation( aiScene* pScene, const ColladaParser& pPars
         std::string nodeName = (*nit)->mName.data;
 
         // find the collada node corresponding to the aiNode
-        const Collada::Node* srcNode = FindNode( pParser.mRootNode, nodeName);
+        const Collada::Node* srcNode = FindNode( nodeName);
 //      ai_assert( srcNode != NULL);
         if( !srcNode)
             continue;
 
-        // now check all channels if they affect the current node
-        for( std::vector<Collada::AnimationChannel>::const_iterator cit = pSrcAnim->mChannels.begin();
-            cit != pSrcAnim->mChannels.end(); ++cit)
+        // now check all candidate channels if they affect the current node, in file order
+        channels.clear();
+        std::unordered_map<std::string, std::vector<size_t> >::const_iterator targetIt = channelsByTarget.find( srcNode->mID);
+        if( targetIt != channelsByTarget.end())
+            std::merge( untargetedChannels.begin(), untargetedChannels.end(), targetIt->second.begin(),
+                targetIt->second.end(), std::back_inserter( channels));
+        else
+            channels = untargetedChannels;
+
+        for( size_t channelIndex : channels)
         {
-            const Collada::AnimationChannel& srcChannel = *cit;
+            const Collada::AnimationChannel& srcChannel = pSrcAnim->mChannels[channelIndex];
             Collada::ChannelEntry entry;
 
             // we expect the animation target to be of type "nodeName/transformID.subElement". Ignore all others
@@ -1135,7 +1166,7 @@ void ColladaLoader::CreateAnimation( aiScene* pScene, const ColladaParser& pPars
                     continue;
 
                 // not node transform, but something else. store as unknown animation channel for now
-                entry.mChannel = &(*cit);
+                entry.mChannel = &srcChannel;
                 entry.mTargetId = srcChannel.mTarget.substr(targetPos + pSrcAnim->mName.length(),
                                         srcChannel.mTarget.length() - targetPos - pSrcAnim->mName.length());
                 if (entry.mTargetId.front() == '-')
@@ -1232,7 +1263,7 @@ void ColladaLoader::CreateAnimation( aiScene* pScene, const ColladaParser& pPars
                     continue;
             }
 
-            entry.mChannel = &(*cit);
+            entry.mChannel = &srcChannel;
             entries.push_back( entry);
         }
 
@@ -1869,37 +1900,32 @@ void ColladaLoader::CollectNodes( const aiNode* pNode, std::vector<const aiNode*
 }
 
 // ------------------------------------------------------------------------------------------------
-// Finds a node in the collada scene by the given name
-const Collada::Node* ColladaLoader::FindNode( const Collada::Node* pNode, const std::string& pName) const
+// Recursively adds a node and its children to the node lookup tables
+void ColladaLoader::BuildNodeIndex( const Collada::Node* pNode)
 {
-    if( pNode->mName == pName || pNode->mID == pName)
-        return pNode;
+    // insert() keeps existing entries, so the first node in hierarchy order wins
+    mNodeByName.insert( std::make_pair( pNode->mName, pNode));
+    mNodeByName.insert( std::make_pair( pNode->mID, pNode));
+    mNodeBySID.insert( std::make_pair( pNode->mSID, pNode));
 
     for( size_t a = 0; a < pNode->mChildren.size(); ++a)
-    {
-        const Collada::Node* node = FindNode( pNode->mChildren[a], pName);
-        if( node)
-            return node;
-    }
+        BuildNodeIndex( pNode->mChildren[a]);
+}
 
-    return NULL;
+// ------------------------------------------------------------------------------------------------
+// Finds a node in the collada scene by the given name or ID
+const Collada::Node* ColladaLoader::FindNode( const std::string& pName) const
+{
+    std::unordered_map<std::string, const Collada::Node*>::const_iterator it = mNodeByName.find( pName);
+    return it == mNodeByName.end() ? NULL : it->second;
 }
 
 // ------------------------------------------------------------------------------------------------
 // Finds a node in the collada scene by the given SID
-const Collada::Node* ColladaLoader::FindNodeBySID( const Collada::Node* pNode, const std::string& pSID) const
+const Collada::Node* ColladaLoader::FindNodeBySID( const std::string& pSID) const
 {
-  if( pNode->mSID == pSID)
-    return pNode;
-
-  for( size_t a = 0; a < pNode->mChildren.size(); ++a)
-  {
-    const Collada::Node* node = FindNodeBySID( pNode->mChildren[a], pSID);
-    if( node)
-      return node;
-  }
-
-  return NULL;
+    std::unordered_map<std::string, const Collada::Node*>::const_iterator it = mNodeBySID.find( pSID);
+    return it == mNodeBySID.end() ? NULL : it->second;
 }
 
 // ------------------------------------------------------------------------------------------------
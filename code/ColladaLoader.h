@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseImporter.h"
 #include "ColladaParser.h"
+#include <unordered_map>
 
 struct aiNode;
 struct aiCamera;
@@ -206,10 +207,13 @@ protected:
     /** Recursively collects all nodes into the given array */
     void CollectNodes( const aiNode* pNode, std::vector<const aiNode*>& poNodes) const;
 
-    /** Finds a node in the collada scene by the given name */
-    const Collada::Node* FindNode( const Collada::Node* pNode, const std::string& pName) const;
+    /** Recursively adds a node and its children to the node lookup tables */
+    void BuildNodeIndex( const Collada::Node* pNode);
+
+    /** Finds a node in the collada scene by the given name or ID */
+    const Collada::Node* FindNode( const std::string& pName) const;
     /** Finds a node in the collada scene by the given SID */
-    const Collada::Node* FindNodeBySID( const Collada::Node* pNode, const std::string& pSID) const;
+    const Collada::Node* FindNodeBySID( const std::string& pSID) const;
 
     /** Finds a proper name for a node derived from the collada-node's properties */
     std::string FindNameForNode( const Collada::Node* pNode);
@@ -245,8 +249,14 @@ protected:
     /** Accumulated animations for the target scene */
     std::vector<aiAnimation*> mAnims;
 
+    /** Collada nodes by name and ID, and by SID. If several nodes share a key,
+     *  the first one in hierarchy order is stored. */
+    std::unordered_map<std::string, const Collada::Node*> mNodeByName;
+    std::unordered_map<std::string, const Collada::Node*> mNodeBySID;
+
     bool noSkeletonMesh;
     bool ignoreUpDirection;
+    bool usePullReader;
 
     /** Used by FindNameForNode() to generate unique node names */
     unsigned int mNodeNameCounter;
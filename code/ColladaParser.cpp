@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ColladaParser.h"
 #include "fast_atof.h"
 #include "ParsingUtils.h"
+#include "NumberArrayParser.h"
 #include "StringUtils.h"
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
@@ -65,7 +66,7 @@ using namespace Assimp::Formatter;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
+ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile, bool pullReader)
     : mFileName( pFile )
     , mReader( NULL )
     , mDataLibrary()
@@ -96,8 +97,7 @@ ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
     }
 
     // generate a XML reader for it
-    std::unique_ptr<CIrrXML_IOStreamReader> mIOWrapper(new CIrrXML_IOStreamReader(file.get()));
-    mReader = irr::io::createIrrXMLReader( mIOWrapper.get());
+    mReader = CreateXmlReader( file.get(), pullReader);
     if (!mReader) {
         ThrowException("Collada: Unable to open file.");
     }
@@ -1977,20 +1977,9 @@ void ColladaParser::ReadDataArray()
             }
         } else
         {
-            data.mValues.reserve( count);
-
-            for( unsigned int a = 0; a < count; a++)
-            {
-                if( *content == 0)
-                    ThrowException( "Expected more values while reading float_array contents.");
-
-                ai_real value;
-                // read a number
-                content = fast_atoreal_move<ai_real>( content, value);
-                data.mValues.push_back( value);
-                // skip whitespace after it
-                SkipSpacesAndLineEnd( &content);
-            }
+            data.mValues.resize( count);
+            if( count > 0 && ReadRealArray( content, &data.mValues[0], count) < count)
+                ThrowException( "Expected more values while reading float_array contents.");
         }
     }
 
@@ -2324,21 +2313,15 @@ size_t ColladaParser::ReadPrimitives( Mesh* pMesh, std::vector<InputChannel>& pP
 
     // and read all indices into a temporary array
     std::vector<size_t> indices;
-    if( expectedPointCount > 0)
-        indices.reserve( expectedPointCount * numOffsets);
 
     if (pNumPrimitives > 0) // It is possible to not contain any indices
     {
         const char* content = GetTextContent();
-        while( *content != 0)
-        {
-            // read a value.
-            // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
-            int value = std::max( 0, strtol10( content, &content));
-            indices.push_back( size_t( value));
-            // skip whitespace after it
-            SkipSpacesAndLineEnd( &content);
-        }
+        // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
+        // ReadIntegerArray clamps them to zero for us.
+        ReadIntegerArray( content, indices, expectedPointCount * numOffsets);
+        if( *content != 0)
+            ThrowException( "Unexpected character in <p> element.");
     }
 
 	// complain if the index count doesn't fit
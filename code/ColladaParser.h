@@ -46,7 +46,7 @@
 #ifndef AI_COLLADAPARSER_H_INC
 #define AI_COLLADAPARSER_H_INC
 
-#include "irrXMLWrapper.h"
+#include "XmlPullReader.h"
 #include "ColladaHelper.h"
 #include <assimp/ai_assert.h>
 #include "TinyFormatter.h"
@@ -65,8 +65,9 @@ namespace Assimp
         friend class ColladaLoader;
 
     protected:
-        /** Constructor from XML file */
-        ColladaParser( IOSystem* pIOHandler, const std::string& pFile);
+        /** Constructor from XML file
+         *  @param pullReader Use XmlPullReader instead of irrXML */
+        ColladaParser( IOSystem* pIOHandler, const std::string& pFile, bool pullReader = false);
 
         /** Destructor */
         ~ColladaParser();
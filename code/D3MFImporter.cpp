@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOSystem.hpp>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/importerdesc.h>
+#include <assimp/Importer.hpp>
 #include "StringComparison.h"
 #include "StringUtils.h"
 
@@ -58,7 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "D3MFOpcPackage.h"
 #include <contrib/unzip/unzip.h>
-#include "irrXMLWrapper.h"
+#include "XmlPullReader.h"
 
 namespace Assimp {
 namespace D3MF {
@@ -325,6 +326,7 @@ static const aiImporterDesc desc = {
 
 
 D3MFImporter::D3MFImporter()
+: mUsePullReader(false)
 {
 
 }
@@ -350,7 +352,7 @@ bool D3MFImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool
 
 void D3MFImporter::SetupProperties(const Importer *pImp)
 {
-
+    mUsePullReader = pImp->GetPropertyBool(AI_CONFIG_IMPORT_3MF_PULL_READER, pImp->GetPropertyBool(AI_CONFIG_IMPORT_XML_PULL_READER, false));
 }
 
 const aiImporterDesc *D3MFImporter::GetInfo() const
@@ -362,8 +364,7 @@ void D3MFImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOS
 {
     D3MF::D3MFOpcPackage opcPackage(pIOHandler, pFile);
 
-    std::unique_ptr<CIrrXML_IOStreamReader> xmlStream(new CIrrXML_IOStreamReader(opcPackage.RootStream()));
-    std::unique_ptr<D3MF::XmlReader> xmlReader(irr::io::createIrrXMLReader(xmlStream.get()));
+    std::unique_ptr<D3MF::XmlReader> xmlReader(CreateXmlReader(opcPackage.RootStream(), mUsePullReader));
 
     D3MF::XmlSerializer xmlSerializer(xmlReader.get());
 
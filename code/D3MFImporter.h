@@ -61,6 +61,9 @@ public:
 protected:
     void InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler);
 
+private:
+    // AI_CONFIG_IMPORT_3MF_PULL_READER
+    bool mUsePullReader;
 };
 }
 #endif // AI_D3MFLOADER_H_INCLUDED
@@ -153,6 +153,9 @@ void DeboneProcess::Execute( aiScene* pScene)
                 }
 
                 // and destroy the source mesh. It should be completely contained inside the new submeshes
+                if (BoneWeightTableCache* cache = GetBoneWeightTableCache(shared)) {
+                    cache->Remove(srcMesh);
+                }
                 delete srcMesh;
             }
             else    {
@@ -194,15 +197,19 @@ bool DeboneProcess::ConsiderMesh(const aiMesh* pMesh)
     const unsigned int cUnowned = UINT_MAX;
     const unsigned int cCoowned = UINT_MAX-1;
 
-    for(unsigned int i=0;i<pMesh->mNumBones;i++)    {
-        for(unsigned int j=0;j<pMesh->mBones[i]->mNumWeights;j++)   {
-            float w = pMesh->mBones[i]->mWeights[j].mWeight;
+    // walk the shared per-vertex weight table, the weights of each vertex come in bone order
+    BoneWeightTable localTable;
+    const BoneWeightTable& table = GetBoneWeightTable(GetBoneWeightTableCache(shared),pMesh,localTable);
+
+    for(unsigned int vid=0;vid<pMesh->mNumVertices;vid++)   {
+        for(const PerVertexWeight* it = table.Begin(vid), *end = table.End(vid); it != end; ++it)   {
+            const unsigned int i = it->first;
+            float w = it->second;
 
             if(w==0.0f) {
                 continue;
             }
 
-            unsigned int vid = pMesh->mBones[i]->mWeights[j].mVertexId;
             if(w>=mThreshold)   {
 
                 if(vertexBones[vid]!=cUnowned)  {
@@ -222,7 +229,9 @@ bool DeboneProcess::ConsiderMesh(const aiMesh* pMesh)
                 isBoneNecessary[i] = w<mThreshold;
             }
         }
+    }
 
+    for(unsigned int i=0;i<pMesh->mNumBones;i++)    {
         if(!isBoneNecessary[i])  {
             isInterstitialRequired = true;
         }
@@ -266,16 +275,18 @@ void DeboneProcess::SplitMesh( const aiMesh* pMesh, std::vector< std::pair< aiMe
     const unsigned int cUnowned = UINT_MAX;
     const unsigned int cCoowned = UINT_MAX-1;
 
-    for(unsigned int i=0;i<pMesh->mNumBones;i++)    {
-        for(unsigned int j=0;j<pMesh->mBones[i]->mNumWeights;j++)   {
-            float w = pMesh->mBones[i]->mWeights[j].mWeight;
+    BoneWeightTable localTable;
+    const BoneWeightTable& table = GetBoneWeightTable(GetBoneWeightTableCache(shared),pMesh,localTable);
+
+    for(unsigned int vid=0;vid<pMesh->mNumVertices;vid++)   {
+        for(const PerVertexWeight* it = table.Begin(vid), *end = table.End(vid); it != end; ++it)   {
+            const unsigned int i = it->first;
+            float w = it->second;
 
             if(w==0.0f) {
                 continue;
             }
 
-            unsigned int vid = pMesh->mBones[i]->mWeights[j].mVertexId;
-
             if(w>=mThreshold) {
                 if(vertexBones[vid]!=cUnowned)  {
                     if(vertexBones[vid]==i) //double entry
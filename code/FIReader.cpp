@@ -57,6 +57,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
 
 namespace Assimp {
 
@@ -104,6 +106,14 @@ static size_t parseMagic(const uint8_t *data, const uint8_t *dataEnd) {
     }
 }
 
+// Element-wise conversion backing the typed accessors of the numeric values.
+template <typename Src, typename Dst>
+static inline bool convertArray(const std::vector<Src> &src, std::vector<Dst> &dst) {
+    dst.resize(src.size());
+    std::transform(src.begin(), src.end(), dst.begin(), [](Src v) { return static_cast<Dst>(v); });
+    return true;
+}
+
 static std::string parseUTF8String(const uint8_t *data, size_t len) {
     return std::string((char*)data, len);
 }
@@ -208,6 +218,9 @@ struct FIShortValueImpl: public FIShortValue {
     mutable std::string strValue;
     mutable bool strValueValid;
     inline FIShortValueImpl(std::vector<int16_t> &&value_): strValueValid(false) { value = std::move(value_); }
+    virtual bool toFloatArray(std::vector<float> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toIntArray(std::vector<int32_t> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toBoolArray(std::vector<bool> &out) const /*override*/ { return convertArray(value, out); }
     virtual const std::string &toString() const /*override*/ {
         if (!strValueValid) {
             strValueValid = true;
@@ -228,6 +241,9 @@ struct FIIntValueImpl: public FIIntValue {
     mutable std::string strValue;
     mutable bool strValueValid;
     inline FIIntValueImpl(std::vector<int32_t> &&value_): strValueValid(false) { value = std::move(value_); }
+    virtual bool toFloatArray(std::vector<float> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toIntArray(std::vector<int32_t> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toBoolArray(std::vector<bool> &out) const /*override*/ { return convertArray(value, out); }
     virtual const std::string &toString() const /*override*/ {
         if (!strValueValid) {
             strValueValid = true;
@@ -248,6 +264,9 @@ struct FILongValueImpl: public FILongValue {
     mutable std::string strValue;
     mutable bool strValueValid;
     inline FILongValueImpl(std::vector<int64_t> &&value_): strValueValid(false) { value = std::move(value_); }
+    virtual bool toFloatArray(std::vector<float> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toIntArray(std::vector<int32_t> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toBoolArray(std::vector<bool> &out) const /*override*/ { return convertArray(value, out); }
     virtual const std::string &toString() const /*override*/ {
         if (!strValueValid) {
             strValueValid = true;
@@ -268,6 +287,9 @@ struct FIBoolValueImpl: public FIBoolValue {
     mutable std::string strValue;
     mutable bool strValueValid;
     inline FIBoolValueImpl(std::vector<bool> &&value_): strValueValid(false) { value = std::move(value_); }
+    virtual bool toFloatArray(std::vector<float> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toIntArray(std::vector<int32_t> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toBoolArray(std::vector<bool> &out) const /*override*/ { return convertArray(value, out); }
     virtual const std::string &toString() const /*override*/ {
         if (!strValueValid) {
             strValueValid = true;
@@ -289,6 +311,9 @@ struct FIFloatValueImpl: public FIFloatValue {
     mutable std::string strValue;
     mutable bool strValueValid;
     inline FIFloatValueImpl(std::vector<float> &&value_): strValueValid(false) { value = std::move(value_); }
+    virtual bool toFloatArray(std::vector<float> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toIntArray(std::vector<int32_t> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toBoolArray(std::vector<bool> &out) const /*override*/ { return convertArray(value, out); }
     virtual const std::string &toString() const /*override*/ {
         if (!strValueValid) {
             strValueValid = true;
@@ -309,6 +334,9 @@ struct FIDoubleValueImpl: public FIDoubleValue {
     mutable std::string strValue;
     mutable bool strValueValid;
     inline FIDoubleValueImpl(std::vector<double> &&value_): strValueValid(false) { value = std::move(value_); }
+    virtual bool toFloatArray(std::vector<float> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toIntArray(std::vector<int32_t> &out) const /*override*/ { return convertArray(value, out); }
+    virtual bool toBoolArray(std::vector<bool> &out) const /*override*/ { return convertArray(value, out); }
     virtual const std::string &toString() const /*override*/ {
         if (!strValueValid) {
             strValueValid = true;
@@ -455,6 +483,9 @@ struct FIBoolDecoder: public FIDecoder {
         std::vector<bool> value;
         uint8_t b = *data++;
         size_t unusedBits = b >> 4;
+        if (unusedBits > (len * 8) - 4) {
+            throw DeadlyImportError(parseErrorMessage);
+        }
         size_t numBools = (len * 8) - 4 - unusedBits;
         value.reserve(numBools);
         uint8_t mask = 1 << 3;
@@ -464,6 +495,7 @@ struct FIBoolDecoder: public FIDecoder {
                 b = *data++;
             }
             value.push_back((b & mask) != 0);
+            mask >>= 1;
         }
         return FIBoolValue::create(std::move(value));
     }
@@ -478,8 +510,10 @@ struct FIFloatDecoder: public FIDecoder {
         size_t numFloats = len / 4;
         value.reserve(numFloats);
         for (size_t i = 0; i < numFloats; ++i) {
-            int v = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
-            value.push_back(*(float*)&v);
+            uint32_t v = (uint32_t(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+            float f;
+            memcpy(&f, &v, sizeof f);
+            value.push_back(f);
             data += 4;
         }
         return FIFloatValue::create(std::move(value));
@@ -497,7 +531,9 @@ struct FIDoubleDecoder: public FIDecoder {
         for (size_t i = 0; i < numDoubles; ++i) {
             long long b0 = data[0], b1 = data[1], b2 = data[2], b3 = data[3], b4 = data[4], b5 = data[5], b6 = data[6], b7 = data[7];
             long long v = (b0 << 56) | (b1 << 48) | (b2 << 40) | (b3 << 32) | (b4 << 24) | (b5 << 16) | (b6 << 8) | b7;
-            value.push_back(*(double*)&v);
+            double d;
+            memcpy(&d, &v, sizeof d);
+            value.push_back(d);
             data += 8;
         }
         return FIDoubleValue::create(std::move(value));
@@ -675,9 +711,9 @@ public:
         if (!attr) {
             return 0;
         }
-        std::shared_ptr<const FIIntValue> intValue = std::dynamic_pointer_cast<const FIIntValue>(attr->value);
-        if (intValue) {
-            return intValue->value.size() == 1 ? intValue->value.front() : 0;
+        std::vector<int32_t> intValue;
+        if (attr->value->toIntArray(intValue)) {
+            return intValue.size() == 1 ? intValue.front() : 0;
         }
         return stoi(attr->value->toString());
     }
@@ -686,9 +722,9 @@ public:
         if (idx < 0 || idx >= (int)attributes.size()) {
             return 0;
         }
-        std::shared_ptr<const FIIntValue> intValue = std::dynamic_pointer_cast<const FIIntValue>(attributes[idx].value);
-        if (intValue) {
-            return intValue->value.size() == 1 ? intValue->value.front() : 0;
+        std::vector<int32_t> intValue;
+        if (attributes[idx].value->toIntArray(intValue)) {
+            return intValue.size() == 1 ? intValue.front() : 0;
         }
         return stoi(attributes[idx].value->toString());
     }
@@ -698,9 +734,9 @@ public:
         if (!attr) {
             return 0;
         }
-        std::shared_ptr<const FIFloatValue> floatValue = std::dynamic_pointer_cast<const FIFloatValue>(attr->value);
-        if (floatValue) {
-            return floatValue->value.size() == 1 ? floatValue->value.front() : 0;
+        std::vector<float> floatValue;
+        if (attr->value->toFloatArray(floatValue)) {
+            return floatValue.size() == 1 ? floatValue.front() : 0;
         }
         return stof(attr->value->toString());
     }
@@ -709,9 +745,9 @@ public:
         if (idx < 0 || idx >= (int)attributes.size()) {
             return 0;
         }
-        std::shared_ptr<const FIFloatValue> floatValue = std::dynamic_pointer_cast<const FIFloatValue>(attributes[idx].value);
-        if (floatValue) {
-            return floatValue->value.size() == 1 ? floatValue->value.front() : 0;
+        std::vector<float> floatValue;
+        if (attributes[idx].value->toFloatArray(floatValue)) {
+            return floatValue.size() == 1 ? floatValue.front() : 0;
         }
         return stof(attributes[idx].value->toString());
     }
@@ -751,6 +787,18 @@ public:
         return attr->value;
     }
 
+    virtual bool getAttributeValueAsFloatArray(int idx, std::vector<float> &value) const /*override*/ {
+        return idx >= 0 && idx < (int)attributes.size() && attributes[idx].value->toFloatArray(value);
+    }
+
+    virtual bool getAttributeValueAsIntArray(int idx, std::vector<int32_t> &value) const /*override*/ {
+        return idx >= 0 && idx < (int)attributes.size() && attributes[idx].value->toIntArray(value);
+    }
+
+    virtual bool getAttributeValueAsBoolArray(int idx, std::vector<bool> &value) const /*override*/ {
+        return idx >= 0 && idx < (int)attributes.size() && attributes[idx].value->toBoolArray(value);
+    }
+
     virtual void registerDecoder(const std::string &algorithmUri, std::unique_ptr<FIDecoder> decoder) /*override*/ {
         decoderMap[algorithmUri] = std::move(decoder);
     }
@@ -1778,6 +1826,18 @@ public:
         return nullptr;
     }
 
+    virtual bool getAttributeValueAsFloatArray(int /*idx*/, std::vector<float> &/*value*/) const /*override*/ {
+        return false;
+    }
+
+    virtual bool getAttributeValueAsIntArray(int /*idx*/, std::vector<int32_t> &/*value*/) const /*override*/ {
+        return false;
+    }
+
+    virtual bool getAttributeValueAsBoolArray(int /*idx*/, std::vector<bool> &/*value*/) const /*override*/ {
+        return false;
+    }
+
     virtual void registerDecoder(const std::string &algorithmUri, std::unique_ptr<FIDecoder> decoder) /*override*/ {}
 
     virtual void registerVocabulary(const std::string &vocabularyUri, const FIVocabulary *vocabulary) /*override*/ {}
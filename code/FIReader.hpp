@@ -56,6 +56,11 @@ namespace Assimp {
 
 struct FIValue {
     virtual const std::string &toString() const = 0;
+    // Typed access to numeric payloads (short, int, long, boolean, float and double encodings),
+    // converting element-wise. Return false for values which only have a textual representation.
+    virtual bool toFloatArray(std::vector<float> &) const { return false; }
+    virtual bool toIntArray(std::vector<int32_t> &) const { return false; }
+    virtual bool toBoolArray(std::vector<bool> &) const { return false; }
 };
 
 struct FIStringValue: public FIValue {
@@ -159,6 +164,15 @@ public:
 
     virtual std::shared_ptr<const FIValue> getAttributeEncodedValue(const char *name) const = 0;
 
+    // Decoded binary attribute values without a round-trip through their string representation.
+    // Return false if the attribute was not encoded with a numeric algorithm (or the input is plain XML);
+    // the caller then has to parse getAttributeValue() instead.
+    virtual bool getAttributeValueAsFloatArray(int idx, std::vector<float> &value) const = 0;
+
+    virtual bool getAttributeValueAsIntArray(int idx, std::vector<int32_t> &value) const = 0;
+
+    virtual bool getAttributeValueAsBoolArray(int idx, std::vector<bool> &value) const = 0;
+
     virtual void registerDecoder(const std::string &algorithmUri, std::unique_ptr<FIDecoder> decoder) = 0;
 
     virtual void registerVocabulary(const std::string &vocabularyUri, const FIVocabulary *vocabulary) = 0;
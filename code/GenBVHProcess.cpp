@@ -0,0 +1,499 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenBVHProcess.cpp
+ *  @brief Implementation of the aiProcess_GenBVH step
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENBVH_PROCESS
+
+#include "GenBVHProcess.h"
+#include "ParallelFor.h"
+#include "StringUtils.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <stdio.h>
+
+using namespace Assimp;
+
+namespace {
+
+    // Number of candidate split planes per axis is one less
+    const unsigned int NumBins = 16;
+
+    // Upper bound for the number of primitives per leaf
+    const unsigned int MaxLeafSizeLimit = 64;
+
+    // Cost of visiting a node, relative to the cost of testing a primitive
+    const ai_real TraversalCost = ai_real(1.0);
+
+    // --------------------------------------------------------------------------------------------
+    // Axis-aligned bounding box, empty by default
+    struct Box {
+        aiVector3D mMin, mMax;
+
+        Box()
+        : mMin(std::numeric_limits<ai_real>::max())
+        , mMax(-std::numeric_limits<ai_real>::max()) {
+            // empty
+        }
+
+        void Grow(const aiVector3D& p) {
+            mMin.x = std::min(mMin.x, p.x);
+            mMin.y = std::min(mMin.y, p.y);
+            mMin.z = std::min(mMin.z, p.z);
+            mMax.x = std::max(mMax.x, p.x);
+            mMax.y = std::max(mMax.y, p.y);
+            mMax.z = std::max(mMax.z, p.z);
+        }
+
+        void Grow(const Box& b) {
+            mMin.x = std::min(mMin.x, b.mMin.x);
+            mMin.y = std::min(mMin.y, b.mMin.y);
+            mMin.z = std::min(mMin.z, b.mMin.z);
+            mMax.x = std::max(mMax.x, b.mMax.x);
+            mMax.y = std::max(mMax.y, b.mMax.y);
+            mMax.z = std::max(mMax.z, b.mMax.z);
+        }
+
+        bool IsEmpty() const {
+            return mMin.x > mMax.x;
+        }
+
+        aiVector3D Center() const {
+            return (mMin + mMax) * ai_real(0.5);
+        }
+
+        // Half of the surface area, proportional to the probability of a ray hitting the box
+        ai_real HalfArea() const {
+            if (IsEmpty()) {
+                return 0;
+            }
+            const aiVector3D d = mMax - mMin;
+            return d.x * d.y + d.y * d.z + d.z * d.x;
+        }
+    };
+
+    // --------------------------------------------------------------------------------------------
+    // Bounding box of a vertex array. The loop is kept free of branches so the compiler can vectorize it.
+    Box ComputeBounds(const aiVector3D* vertices, unsigned int numVertices) {
+        Box box;
+        ai_real minX = box.mMin.x, minY = box.mMin.y, minZ = box.mMin.z;
+        ai_real maxX = box.mMax.x, maxY = box.mMax.y, maxZ = box.mMax.z;
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            const aiVector3D& v = vertices[i];
+            minX = std::min(minX, v.x);
+            minY = std::min(minY, v.y);
+            minZ = std::min(minZ, v.z);
+            maxX = std::max(maxX, v.x);
+            maxY = std::max(maxY, v.y);
+            maxZ = std::max(maxZ, v.z);
+        }
+        box.mMin = aiVector3D(minX, minY, minZ);
+        box.mMax = aiVector3D(maxX, maxY, maxZ);
+        return box;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Bounding box of a transformed box
+    Box TransformBox(const Box& box, const aiMatrix4x4& m) {
+        Box out;
+        for (unsigned int i = 0; i < 8; ++i) {
+            const aiVector3D corner((i & 1) ? box.mMax.x : box.mMin.x,
+                (i & 2) ? box.mMax.y : box.mMin.y,
+                (i & 4) ? box.mMax.z : box.mMin.z);
+            out.Grow(m * corner);
+        }
+        return out;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    inline unsigned int BinIndex(ai_real center, ai_real min, ai_real scale) {
+        const ai_real bin = (center - min) * scale;
+        return bin > 0 ? std::min(static_cast<unsigned int>(bin), NumBins - 1) : 0;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // A box to build the hierarchy over, with its center and original index
+    struct Primitive {
+        Box mBox;
+        aiVector3D mCenter;
+        unsigned int mIndex;
+    };
+
+    // --------------------------------------------------------------------------------------------
+    // Bounds of the primitives and their centers which fall into a bin along one axis
+    struct Bin {
+        Box mBox, mCenters;
+        unsigned int mCount;
+
+        Bin() : mCount(0) {}
+
+        void Grow(const Bin& b) {
+            mBox.Grow(b.mBox);
+            mCenters.Grow(b.mCenters);
+            mCount += b.mCount;
+        }
+    };
+
+    // --------------------------------------------------------------------------------------------
+    // Range of primitives still to be placed below a node
+    struct Task {
+        unsigned int mNode, mBegin, mEnd;
+        Box mBox, mCenters;
+    };
+
+    // --------------------------------------------------------------------------------------------
+    Task MakeTask(unsigned int node, unsigned int begin, unsigned int end, const std::vector<Primitive>& prims) {
+        Task task;
+        task.mNode = node;
+        task.mBegin = begin;
+        task.mEnd = end;
+        for (unsigned int i = begin; i < end; ++i) {
+            task.mBox.Grow(prims[i].mBox);
+            task.mCenters.Grow(prims[i].mCenter);
+        }
+        return task;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Builds a hierarchy over a set of boxes. On return, order lists the box indices in the
+    // order the leaves reference them.
+    void BuildBVH(const std::vector<Box>& boxes, unsigned int maxLeafSize,
+        std::vector<aiBVHNode>& nodes, std::vector<unsigned int>& order)
+    {
+        // the primitives are moved along with the partitioning, so all passes read them in order
+        const unsigned int num = static_cast<unsigned int>(boxes.size());
+        std::vector<Primitive> prims(num);
+        for (unsigned int i = 0; i < num; ++i) {
+            prims[i].mBox = boxes[i];
+            prims[i].mCenter = boxes[i].Center();
+            prims[i].mIndex = i;
+        }
+
+        std::vector<Task> stack;
+        nodes.clear();
+        nodes.reserve(2 * num);
+        nodes.push_back(aiBVHNode());
+        stack.push_back(MakeTask(0, 0, num, prims));
+
+        while (!stack.empty()) {
+            const Task task = stack.back();
+            stack.pop_back();
+            const unsigned int count = task.mEnd - task.mBegin;
+            nodes[task.mNode].mMin = task.mBox.mMin;
+            nodes[task.mNode].mMax = task.mBox.mMax;
+
+            // sort the primitives into bins along all axes at once
+            Bin bins[3][NumBins];
+            ai_real scale[3];
+            for (unsigned int axis = 0; axis < 3; ++axis) {
+                const ai_real extent = task.mCenters.mMax[axis] - task.mCenters.mMin[axis];
+                scale[axis] = extent > 0 ? NumBins / extent : 0;
+            }
+            if (count > 1) {
+                for (unsigned int i = task.mBegin; i < task.mEnd; ++i) {
+                    const Primitive& prim = prims[i];
+                    for (unsigned int axis = 0; axis < 3; ++axis) {
+                        Bin& bin = bins[axis][BinIndex(prim.mCenter[axis], task.mCenters.mMin[axis], scale[axis])];
+                        bin.mBox.Grow(prim.mBox);
+                        bin.mCenters.Grow(prim.mCenter);
+                        ++bin.mCount;
+                    }
+                }
+            }
+
+            // evaluate the surface area heuristic for the planes between the bins
+            ai_real bestCost = std::numeric_limits<ai_real>::max();
+            unsigned int bestAxis = 3, bestBin = 0;
+            Bin bestLeft, bestRight;
+            for (unsigned int axis = 0; axis < 3 && count > 1; ++axis) {
+                if (scale[axis] <= 0) {
+                    continue;
+                }
+                Bin right[NumBins];
+                for (unsigned int b = NumBins - 1; b > 0; --b) {
+                    right[b - 1] = b < NumBins - 1 ? right[b] : Bin();
+                    right[b - 1].Grow(bins[axis][b]);
+                }
+
+                Bin left;
+                for (unsigned int b = 0; b < NumBins - 1; ++b) {
+                    left.Grow(bins[axis][b]);
+                    if (!left.mCount || !right[b].mCount) {
+                        continue;
+                    }
+                    const ai_real cost = left.mBox.HalfArea() * left.mCount + right[b].mBox.HalfArea() * right[b].mCount;
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin = b;
+                        bestLeft = left;
+                        bestRight = right[b];
+                    }
+                }
+            }
+
+            // split nodes with too many primitives and those where it is cheaper
+            bool split = count > maxLeafSize;
+            if (!split && bestAxis < 3) {
+                const ai_real area = task.mBox.HalfArea();
+                split = area > 0 && TraversalCost + bestCost / area < count;
+            }
+            if (!split) {
+                nodes[task.mNode].mFirst = task.mBegin;
+                nodes[task.mNode].mCount = count;
+                continue;
+            }
+
+            const unsigned int first = static_cast<unsigned int>(nodes.size());
+            nodes.resize(first + 2);
+            nodes[task.mNode].mFirst = first;
+            nodes[task.mNode].mCount = 0;
+
+            if (bestAxis < 3) {
+                const ai_real min = task.mCenters.mMin[bestAxis], s = scale[bestAxis];
+                const unsigned int mid = static_cast<unsigned int>(std::partition(prims.begin() + task.mBegin,
+                    prims.begin() + task.mEnd, [=](const Primitive& prim) {
+                        return BinIndex(prim.mCenter[bestAxis], min, s) <= bestBin;
+                    }) - prims.begin());
+
+                Task leftTask = { first, task.mBegin, mid, bestLeft.mBox, bestLeft.mCenters };
+                Task rightTask = { first + 1, mid, task.mEnd, bestRight.mBox, bestRight.mCenters };
+                stack.push_back(rightTask);
+                stack.push_back(leftTask);
+            }
+            else {
+                // all centers coincide, split in the middle
+                const unsigned int mid = task.mBegin + count / 2;
+                stack.push_back(MakeTask(first + 1, mid, task.mEnd, prims));
+                stack.push_back(MakeTask(first, task.mBegin, mid, prims));
+            }
+        }
+
+        order.resize(num);
+        for (unsigned int i = 0; i < num; ++i) {
+            order[i] = prims[i].mIndex;
+        }
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Collects the mesh references of a node and its children
+    void CollectInstances(aiNode* node, const aiMatrix4x4& parent, std::vector<aiBVHInstance>& instances) {
+        const aiMatrix4x4 transformation = parent * node->mTransformation;
+        for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+            aiBVHInstance instance;
+            instance.mTransformation = transformation;
+            instance.mNode = node;
+            instance.mMesh = node->mMeshes[i];
+            instances.push_back(instance);
+        }
+        for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+            CollectInstances(node->mChildren[i], transformation, instances);
+        }
+    }
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenBVHProcess::GenBVHProcess()
+: mMaxLeafSize(PP_BVH_MAX_LEAF_SIZE)
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenBVHProcess::~GenBVHProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool GenBVHProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_GenBVH) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void GenBVHProcess::SetupProperties(const Importer* pImp)
+{
+    SetMaxLeafSize(pImp->GetPropertyInteger(AI_CONFIG_PP_BVH_MAX_LEAF_SIZE,PP_BVH_MAX_LEAF_SIZE));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenBVHProcess::SetMaxLeafSize(unsigned int maxLeafSize)
+{
+    mMaxLeafSize = std::min(std::max(maxLeafSize, 1u), MaxLeafSizeLimit);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenBVHProcess::Execute( aiScene* pScene)
+{
+    DefaultLogger::get()->debug("GenBVHProcess begin");
+
+    // the meshes are independent of each other
+    ParallelFor(0, pScene->mNumMeshes, 1, [this, pScene](unsigned int first, unsigned int last) {
+        for (unsigned int a = first; a < last; ++a) {
+            ProcessMesh(pScene->mMeshes[a]);
+        }
+    });
+    ProcessScene(pScene);
+
+    if (!DefaultLogger::isNullLogger()) {
+        unsigned int numMeshes = 0, numNodes = 0;
+        for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+            if (pScene->mMeshes[a]->HasBVH()) {
+                ++numMeshes;
+                numNodes += pScene->mMeshes[a]->mNumBVHNodes;
+            }
+        }
+        char szBuff[256];
+        ai_snprintf(szBuff, 256, "GenBVHProcess finished. Built hierarchies with %u nodes for %u meshes "
+            "and one with %u nodes over %u mesh instances",
+            numNodes, numMeshes, pScene->mNumBVHNodes, pScene->mNumBVHInstances);
+        DefaultLogger::get()->info(szBuff);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds the hierarchy of a single mesh
+bool GenBVHProcess::ProcessMesh( aiMesh* pMesh) const
+{
+    ai_assert(NULL != pMesh);
+
+    // drop the results of a previous run
+    delete[] pMesh->mBVHNodes;
+    delete[] pMesh->mBVHFaces;
+    pMesh->mBVHNodes = NULL;
+    pMesh->mBVHFaces = NULL;
+    pMesh->mNumBVHNodes = 0;
+
+    if (!pMesh->HasFaces() || !pMesh->HasPositions()) {
+        return false;
+    }
+
+    std::vector<Box> boxes(pMesh->mNumFaces);
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        const aiFace& face = pMesh->mFaces[i];
+        for (unsigned int k = 0; k < face.mNumIndices; ++k) {
+            boxes[i].Grow(pMesh->mVertices[face.mIndices[k]]);
+        }
+    }
+
+    std::vector<aiBVHNode> nodes;
+    std::vector<unsigned int> order;
+    BuildBVH(boxes, mMaxLeafSize, nodes, order);
+
+    pMesh->mNumBVHNodes = static_cast<unsigned int>(nodes.size());
+    pMesh->mBVHNodes = new aiBVHNode[pMesh->mNumBVHNodes];
+    std::copy(nodes.begin(), nodes.end(), pMesh->mBVHNodes);
+    pMesh->mBVHFaces = new unsigned int[pMesh->mNumFaces];
+    std::copy(order.begin(), order.end(), pMesh->mBVHFaces);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds the hierarchy over the mesh instances
+void GenBVHProcess::ProcessScene( aiScene* pScene) const
+{
+    ai_assert(NULL != pScene);
+
+    delete[] pScene->mBVHNodes;
+    delete[] pScene->mBVHInstances;
+    pScene->mBVHNodes = NULL;
+    pScene->mBVHInstances = NULL;
+    pScene->mNumBVHNodes = pScene->mNumBVHInstances = 0;
+
+    if (!pScene->mRootNode) {
+        return;
+    }
+    std::vector<aiBVHInstance> instances;
+    CollectInstances(pScene->mRootNode, aiMatrix4x4(), instances);
+    if (instances.empty()) {
+        return;
+    }
+
+    // the root of the hierarchy of a mesh holds its bounds
+    std::vector<Box> meshBounds(pScene->mNumMeshes);
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        const aiMesh* mesh = pScene->mMeshes[a];
+        if (mesh->HasBVH()) {
+            meshBounds[a].mMin = mesh->mBVHNodes[0].mMin;
+            meshBounds[a].mMax = mesh->mBVHNodes[0].mMax;
+        }
+        else {
+            meshBounds[a] = ComputeBounds(mesh->mVertices, mesh->mNumVertices);
+        }
+    }
+
+    std::vector<Box> boxes(instances.size());
+    for (unsigned int i = 0; i < instances.size(); ++i) {
+        const Box& bounds = meshBounds[instances[i].mMesh];
+        if (!bounds.IsEmpty()) {
+            boxes[i] = TransformBox(bounds, instances[i].mTransformation);
+        }
+    }
+
+    std::vector<aiBVHNode> nodes;
+    std::vector<unsigned int> order;
+    BuildBVH(boxes, mMaxLeafSize, nodes, order);
+
+    pScene->mNumBVHNodes = static_cast<unsigned int>(nodes.size());
+    pScene->mBVHNodes = new aiBVHNode[pScene->mNumBVHNodes];
+    std::copy(nodes.begin(), nodes.end(), pScene->mBVHNodes);
+    pScene->mNumBVHInstances = static_cast<unsigned int>(instances.size());
+    pScene->mBVHInstances = new aiBVHInstance[pScene->mNumBVHInstances];
+    for (unsigned int i = 0; i < order.size(); ++i) {
+        pScene->mBVHInstances[i] = instances[order[i]];
+    }
+}
+
+#endif // !! ASSIMP_BUILD_NO_GENBVH_PROCESS
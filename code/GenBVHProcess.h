@@ -0,0 +1,114 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file GenBVHProcess.h
+ *  @brief Declares a post processing step to build bounding volume hierarchies
+ */
+#ifndef AI_GENBVHPROCESS_H_INC
+#define AI_GENBVHPROCESS_H_INC
+
+#include "BaseProcess.h"
+#include <assimp/types.h>
+
+struct aiMesh;
+struct aiScene;
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** The GenBVHProcess builds a bounding volume hierarchy over the faces of
+ *  every mesh and one over the mesh instances of the scene, see
+ *  #aiProcess_GenBVH.
+ *
+ *  The hierarchies are built top-down. Each node is split at the cheapest
+ *  plane according to the surface area heuristic, evaluated for a fixed
+ *  number of bins along each axis of the bounding box of the primitive
+ *  centers. The meshes are processed in parallel.
+ */
+class ASSIMP_API GenBVHProcess : public BaseProcess
+{
+public:
+
+    GenBVHProcess();
+    ~GenBVHProcess();
+
+public:
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is active
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    // Executes the pp step on a given scene
+    void Execute( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    // Configures the pp step
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    /** Set the maximum number of primitives per leaf. The value is clamped
+     *  as documented for the config property. */
+    void SetMaxLeafSize(unsigned int maxLeafSize);
+
+    // -------------------------------------------------------------------
+    /** Builds the hierarchy over the faces of a mesh.
+     * @param pMesh The mesh to process.
+     * @return false if the mesh was skipped
+     */
+    bool ProcessMesh( aiMesh* pMesh) const;
+
+    // -------------------------------------------------------------------
+    /** Builds the hierarchy over the mesh instances of a scene. Uses the
+     *  hierarchies of the meshes for their bounds where present.
+     * @param pScene The scene to process.
+     */
+    void ProcessScene( aiScene* pScene) const;
+
+private:
+    //! Configuration parameter: the maximum number of primitives per leaf
+    unsigned int mMaxLeafSize;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENBVHPROCESS_H_INC
@@ -0,0 +1,364 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenMeshletsProcess.cpp
+ *  @brief Implementation of the aiProcess_GenMeshlets step
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "GenMeshletsProcess.h"
+#include "VertexTriangleAdjacency.h"
+#include "StringUtils.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <stdio.h>
+
+using namespace Assimp;
+
+namespace {
+
+    // Marks vertices and faces not assigned to the current meshlet
+    const unsigned int Unassigned = ~0u;
+
+    // Smallest cosine between the face normals and the cone axis for which
+    // a normal cone is computed. Below, the apex moves out too far.
+    const ai_real MinConeCosine = ai_real(0.1);
+
+    // --------------------------------------------------------------------------------------------
+    inline unsigned int Clamp(unsigned int v, unsigned int lo, unsigned int hi) {
+        return std::min(std::max(v, lo), hi);
+    }
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenMeshletsProcess::GenMeshletsProcess()
+: mMaxVertices(PP_GM_MAX_VERTICES)
+, mMaxTriangles(PP_GM_MAX_TRIANGLES)
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenMeshletsProcess::~GenMeshletsProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool GenMeshletsProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_GenMeshlets) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void GenMeshletsProcess::SetupProperties(const Importer* pImp)
+{
+    SetLimits(pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES,PP_GM_MAX_VERTICES),
+        pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_TRIANGLES,PP_GM_MAX_TRIANGLES));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::SetLimits(unsigned int maxVertices, unsigned int maxTriangles)
+{
+    mMaxVertices = Clamp(maxVertices, 3, 256);
+    mMaxTriangles = Clamp(maxTriangles, 1, 512);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenMeshletsProcess::Execute( aiScene* pScene)
+{
+    DefaultLogger::get()->debug("GenMeshletsProcess begin");
+
+    unsigned int numMeshes = 0, numMeshlets = 0, numFaces = 0, numVertices = 0;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        const aiMesh* mesh = pScene->mMeshes[a];
+        if (ProcessMesh(pScene->mMeshes[a])) {
+            ++numMeshes;
+            numMeshlets += mesh->mNumMeshlets;
+            numFaces += mesh->mNumFaces;
+            numVertices += mesh->mNumMeshletVertices;
+        }
+    }
+
+    if (!DefaultLogger::isNullLogger()) {
+        if (numMeshlets) {
+            char szBuff[256];
+            ai_snprintf(szBuff, 256, "GenMeshletsProcess finished. Built %u meshlets for %u meshes, "
+                "%.1f triangles and %.1f vertices per meshlet on average",
+                numMeshlets, numMeshes, float(numFaces) / numMeshlets, float(numVertices) / numMeshlets);
+            DefaultLogger::get()->info(szBuff);
+        }
+        else {
+            DefaultLogger::get()->debug("GenMeshletsProcess finished. There are no triangle meshes");
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Partitions a single mesh
+bool GenMeshletsProcess::ProcessMesh( aiMesh* pMesh)
+{
+    ai_assert(NULL != pMesh);
+
+    if (!pMesh->HasFaces() || !pMesh->HasPositions()) {
+        return false;
+    }
+    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        DefaultLogger::get()->debug("GenMeshletsProcess: skipping mesh with non-triangle primitives");
+        return false;
+    }
+
+    // drop the results of a previous run
+    delete[] pMesh->mMeshlets;
+    delete[] pMesh->mMeshletVertices;
+    pMesh->mMeshlets = NULL;
+    pMesh->mMeshletVertices = NULL;
+    pMesh->mNumMeshlets = pMesh->mNumMeshletVertices = 0;
+
+    const unsigned int numFaces = pMesh->mNumFaces;
+    VertexTriangleAdjacency adj(pMesh->mFaces, numFaces, pMesh->mNumVertices, true);
+
+    std::vector<bool> done(numFaces, false);
+    std::vector<unsigned int> faceOrder;
+    faceOrder.reserve(numFaces);
+    std::vector<unsigned int> meshletVertices;
+    meshletVertices.reserve(numFaces);
+    std::vector<aiMeshlet> meshlets;
+    meshlets.reserve(numFaces / mMaxTriangles + 1);
+
+    // slot of each vertex in the current meshlet, Unassigned if it isn't part of it
+    std::vector<unsigned int> slot(pMesh->mNumVertices, Unassigned);
+
+    unsigned int nextSeed = 0;
+    while (faceOrder.size() < numFaces) {
+        aiMeshlet meshlet;
+        meshlet.mFaceOffset = static_cast<unsigned int>(faceOrder.size());
+        meshlet.mVertexOffset = static_cast<unsigned int>(meshletVertices.size());
+
+        unsigned int face = Unassigned;
+        for (;;) {
+            if (face == Unassigned) {
+                // no adjacent face fits, so continue with the next free face in face order
+                while (nextSeed < numFaces && done[nextSeed]) {
+                    ++nextSeed;
+                }
+                if (nextSeed == numFaces) {
+                    break;
+                }
+                unsigned int extra = 0;
+                const aiFace& f = pMesh->mFaces[nextSeed];
+                for (unsigned int i = 0; i < 3; ++i) {
+                    extra += slot[f.mIndices[i]] == Unassigned;
+                }
+                if (meshlet.mNumVertices + extra > mMaxVertices) {
+                    break;
+                }
+                face = nextSeed;
+            }
+
+            // add the face and its new vertices to the meshlet
+            const aiFace& f = pMesh->mFaces[face];
+            for (unsigned int i = 0; i < 3; ++i) {
+                const unsigned int v = f.mIndices[i];
+                if (slot[v] == Unassigned) {
+                    slot[v] = meshlet.mNumVertices++;
+                    meshletVertices.push_back(v);
+                }
+            }
+            done[face] = true;
+            faceOrder.push_back(face);
+            if (++meshlet.mNumFaces == mMaxTriangles) {
+                break;
+            }
+
+            // pick the adjacent free face adding the fewest vertices. Vertices are visited in the
+            // order they were added, which keeps the meshlet compact.
+            face = Unassigned;
+            unsigned int bestExtra = 3;
+            for (unsigned int i = meshlet.mVertexOffset; i < meshletVertices.size() && bestExtra; ++i) {
+                const unsigned int v = meshletVertices[i];
+                const unsigned int* tris = adj.GetAdjacentTriangles(v);
+                const unsigned int numTris = adj.GetNumTrianglesPtr(v);
+                for (unsigned int t = 0; t < numTris; ++t) {
+                    if (done[tris[t]]) {
+                        continue;
+                    }
+                    const aiFace& cand = pMesh->mFaces[tris[t]];
+                    unsigned int extra = 0;
+                    for (unsigned int k = 0; k < 3; ++k) {
+                        extra += slot[cand.mIndices[k]] == Unassigned;
+                    }
+                    if (extra < bestExtra && meshlet.mNumVertices + extra <= mMaxVertices) {
+                        face = tris[t];
+                        bestExtra = extra;
+                        if (!extra) {
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (unsigned int i = meshlet.mVertexOffset; i < meshletVertices.size(); ++i) {
+            slot[meshletVertices[i]] = Unassigned;
+        }
+        meshlets.push_back(meshlet);
+    }
+
+    // move the faces into meshlet order. aiFace's assignment copies the
+    // index array, so hand the pointers over instead.
+    aiFace* faces = new aiFace[numFaces];
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        aiFace& src = pMesh->mFaces[faceOrder[i]];
+        faces[i].mNumIndices = src.mNumIndices;
+        faces[i].mIndices = src.mIndices;
+        src.mNumIndices = 0;
+        src.mIndices = NULL;
+    }
+    delete[] pMesh->mFaces;
+    pMesh->mFaces = faces;
+
+    pMesh->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+    pMesh->mMeshlets = new aiMeshlet[meshlets.size()];
+    std::copy(meshlets.begin(), meshlets.end(), pMesh->mMeshlets);
+
+    pMesh->mNumMeshletVertices = static_cast<unsigned int>(meshletVertices.size());
+    pMesh->mMeshletVertices = new unsigned int[meshletVertices.size()];
+    std::copy(meshletVertices.begin(), meshletVertices.end(), pMesh->mMeshletVertices);
+
+    for (unsigned int i = 0; i < pMesh->mNumMeshlets; ++i) {
+        ComputeBounds(pMesh, pMesh->mMeshlets[i]);
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Computes bounding sphere and normal cone of a meshlet
+void GenMeshletsProcess::ComputeBounds(const aiMesh* pMesh, aiMeshlet& meshlet)
+{
+    // bounding sphere around the center of the bounding box
+    const unsigned int* verts = pMesh->mMeshletVertices + meshlet.mVertexOffset;
+    aiVector3D minVec = pMesh->mVertices[verts[0]], maxVec = minVec;
+    for (unsigned int i = 1; i < meshlet.mNumVertices; ++i) {
+        const aiVector3D& v = pMesh->mVertices[verts[i]];
+        minVec.x = std::min(minVec.x, v.x);
+        minVec.y = std::min(minVec.y, v.y);
+        minVec.z = std::min(minVec.z, v.z);
+        maxVec.x = std::max(maxVec.x, v.x);
+        maxVec.y = std::max(maxVec.y, v.y);
+        maxVec.z = std::max(maxVec.z, v.z);
+    }
+    meshlet.mCenter = (minVec + maxVec) * ai_real(0.5);
+    ai_real radiusSq = 0;
+    for (unsigned int i = 0; i < meshlet.mNumVertices; ++i) {
+        radiusSq = std::max(radiusSq, (pMesh->mVertices[verts[i]] - meshlet.mCenter).SquareLength());
+    }
+    meshlet.mRadius = std::sqrt(radiusSq);
+
+    // the cone axis is the average face normal, degenerate faces don't count
+    std::vector<aiVector3D> normals;
+    normals.reserve(meshlet.mNumFaces);
+    aiVector3D axis;
+    for (unsigned int i = 0; i < meshlet.mNumFaces; ++i) {
+        const aiFace& f = pMesh->mFaces[meshlet.mFaceOffset + i];
+        const aiVector3D& p0 = pMesh->mVertices[f.mIndices[0]];
+        aiVector3D n = (pMesh->mVertices[f.mIndices[1]] - p0) ^ (pMesh->mVertices[f.mIndices[2]] - p0);
+        const ai_real len = n.Length();
+        if (len > 0 && std::isfinite(len)) {
+            n /= len;
+            axis += n;
+            normals.push_back(n);
+        }
+        else {
+            normals.push_back(aiVector3D());
+        }
+    }
+
+    meshlet.mConeApex = meshlet.mCenter;
+    meshlet.mConeAxis = aiVector3D();
+    meshlet.mConeCutoff = 1;
+
+    const ai_real axisLen = axis.Length();
+    if (!(axisLen > 0)) {
+        return;
+    }
+    axis /= axisLen;
+
+    ai_real minDot = 1;
+    for (const aiVector3D& n : normals) {
+        if (n.x != 0 || n.y != 0 || n.z != 0) {
+            minDot = std::min(minDot, n * axis);
+        }
+    }
+    if (minDot < MinConeCosine) {
+        return;
+    }
+
+    // Move the apex back along the axis until it lies behind all face planes, which
+    // makes the cone test against it conservative.
+    ai_real maxT = 0;
+    for (unsigned int i = 0; i < meshlet.mNumFaces; ++i) {
+        const aiVector3D& n = normals[i];
+        if (n.x == 0 && n.y == 0 && n.z == 0) {
+            continue;
+        }
+        const aiVector3D& p0 = pMesh->mVertices[pMesh->mFaces[meshlet.mFaceOffset + i].mIndices[0]];
+        maxT = std::max(maxT, ((meshlet.mCenter - p0) * n) / (axis * n));
+    }
+
+    meshlet.mConeApex = meshlet.mCenter - axis * maxT;
+    meshlet.mConeAxis = axis;
+    meshlet.mConeCutoff = std::sqrt(std::max(ai_real(0), 1 - minDot * minDot));
+}
+
+#endif // !! ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
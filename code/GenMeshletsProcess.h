@@ -0,0 +1,115 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file GenMeshletsProcess.h
+ *  @brief Declares a post processing step to partition meshes into meshlets
+ */
+#ifndef AI_GENMESHLETSPROCESS_H_INC
+#define AI_GENMESHLETSPROCESS_H_INC
+
+#include "BaseProcess.h"
+#include <assimp/types.h>
+
+struct aiMesh;
+struct aiMeshlet;
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** The GenMeshletsProcess partitions triangle meshes into meshlets with a
+ *  limited number of vertices and triangles, see #aiProcess_GenMeshlets.
+ *
+ *  Meshlets are grown greedily: starting at the first free face in the
+ *  current face order, the step keeps adding the adjacent free face which
+ *  introduces the fewest new vertices. If no adjacent face fits anymore,
+ *  the next free face in face order is taken, so meshes without shared
+ *  vertices still end up in full meshlets. The faces are then reordered
+ *  meshlet by meshlet.
+ *
+ *  @note This step expects triangulated input data.
+ */
+class ASSIMP_API GenMeshletsProcess : public BaseProcess
+{
+public:
+
+    GenMeshletsProcess();
+    ~GenMeshletsProcess();
+
+public:
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is active
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    // Executes the pp step on a given scene
+    void Execute( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    // Configures the pp step
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    /** Set the maximum number of vertices and triangles per meshlet.
+     *  The values are clamped as documented for the config properties. */
+    void SetLimits(unsigned int maxVertices, unsigned int maxTriangles);
+
+    // -------------------------------------------------------------------
+    /** Executes the postprocessing step on the given mesh
+     * @param pMesh The mesh to process.
+     * @return false if the mesh was skipped
+     */
+    bool ProcessMesh( aiMesh* pMesh);
+
+    // -------------------------------------------------------------------
+    /** Computes bounding sphere and normal cone of a meshlet whose face
+     *  and vertex ranges are already set. */
+    static void ComputeBounds(const aiMesh* pMesh, aiMeshlet& meshlet);
+
+private:
+    //! Configuration parameters: the meshlet size limits
+    unsigned int mMaxVertices;
+    unsigned int mMaxTriangles;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENMESHLETSPROCESS_H_INC
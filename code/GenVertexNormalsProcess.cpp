@@ -49,15 +49,64 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "GenVertexNormalsProcess.h"
 #include "ProcessHelper.h"
+#include "ParallelFor.h"
 #include "Exceptional.h"
+#include "Hash.h"
 #include "qnan.h"
 
 using namespace Assimp;
 
+namespace {
+
+// Minimum number of vertices per chunk for the parallel loops
+const unsigned int NormalsChunkSize = 16384;
+
+// ------------------------------------------------------------------------------------------------
+// Assign each vertex the index of the group of vertices sharing exactly its position, using an
+// open-addressing hash table. Returns the number of groups.
+unsigned int GroupIdenticalPositions(const aiVector3D* positions, unsigned int numVertices,
+    std::vector<unsigned int>& groupOf)
+{
+    unsigned int tableSize = 16;
+    while (tableSize < numVertices * 2) {
+        tableSize <<= 1;
+    }
+    const unsigned int mask = tableSize - 1;
+    std::vector<unsigned int> table(tableSize, UINT_MAX);
+
+    groupOf.resize(numVertices);
+    unsigned int numGroups = 0;
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        // -0 and +0 compare equal, so they need to be hashed the same
+        const aiVector3D& p = positions[i];
+        const ai_real key[3] = { p.x + ai_real(0.0), p.y + ai_real(0.0), p.z + ai_real(0.0) };
+        unsigned int slot = SuperFastHash(reinterpret_cast<const char*>(key), sizeof(key)) & mask;
+
+        for (;;) {
+            const unsigned int rep = table[slot];
+            if (rep == UINT_MAX) {
+                table[slot] = i;
+                groupOf[i] = numGroups++;
+                break;
+            }
+            if (positions[rep] == p) {
+                groupOf[i] = groupOf[rep];
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+    return numGroups;
+}
+
+} // Namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 GenVertexNormalsProcess::GenVertexNormalsProcess()
-: configMaxAngle( AI_DEG_TO_RAD( 175.f ) ) {
+: configMaxAngle( AI_DEG_TO_RAD( 175.f ) )
+, configExactPositions( false )
+, configSpatialSortGrid( false ) {
     // empty
 }
 
@@ -81,6 +130,12 @@ void GenVertexNormalsProcess::SetupProperties(const Importer* pImp)
     // Get the current value of the AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE property
     configMaxAngle = pImp->GetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE,(ai_real)175.0);
     configMaxAngle = AI_DEG_TO_RAD(std::max(std::min(configMaxAngle,(ai_real)175.0),(ai_real)0.0));
+
+    // AI_CONFIG_PP_GSN_EXACT_POSITIONS
+    configExactPositions = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_GSN_EXACT_POSITIONS,0));
+
+    // AI_CONFIG_PP_SPATIAL_SORT_GRID
+    configSpatialSortGrid = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_GRID,0));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -151,6 +206,11 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
         }
     }
 
+    if (configExactPositions) {
+        GenMeshVertexNormalsExact(pMesh);
+        return true;
+    }
+
     // Set up a SpatialSort to quickly find all vertices close to a given position
     // check whether we can reuse the SpatialSort of a previous step.
     SpatialSort* vertexFinder = NULL;
@@ -167,6 +227,7 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
         }
     }
     if (!vertexFinder)  {
+        _vertexFinder.SetGridEnabled(configSpatialSortGrid);
         _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
         vertexFinder = &_vertexFinder;
         posEpsilon = ComputePositionEpsilon(pMesh);
@@ -234,3 +295,77 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
 
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Smooths the face normals stored per vertex, considering only vertices with identical positions.
+void GenVertexNormalsProcess::GenMeshVertexNormalsExact (aiMesh* pMesh)
+{
+    const unsigned int numVertices = pMesh->mNumVertices;
+    const aiVector3D* const faceNormals = pMesh->mNormals;
+
+    std::vector<unsigned int> groupOf;
+    const unsigned int numGroups = GroupIdenticalPositions(pMesh->mVertices, numVertices, groupOf);
+    aiVector3D* pcNew = new aiVector3D[numVertices];
+
+    if (configMaxAngle >= AI_DEG_TO_RAD( 175.f ))   {
+        // No angle limit, so all vertices of a group get the (area-weighted) sum of
+        // their face normals. That's a single linear pass to sum up ...
+        std::vector<aiVector3D> sums(numGroups);
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            const aiVector3D& v = faceNormals[i];
+            if (is_not_qnan(v.x)) {
+                sums[groupOf[i]] += v;
+            }
+        }
+
+        // ... and an independent one to write the results back
+        ParallelFor(0, numGroups, NormalsChunkSize, [&](unsigned int first, unsigned int last) {
+            for (unsigned int g = first; g < last; ++g) {
+                sums[g].NormalizeSafe();
+            }
+        });
+        ParallelFor(0, numVertices, NormalsChunkSize, [&](unsigned int first, unsigned int last) {
+            for (unsigned int i = first; i < last; ++i) {
+                pcNew[i] = sums[groupOf[i]];
+            }
+        });
+    }
+    else {
+        // Sort the vertices by group, so each vertex only needs to look at the
+        // members of its own group.
+        std::vector<unsigned int> offsets(numGroups + 1, 0);
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            ++offsets[groupOf[i] + 1];
+        }
+        for (unsigned int g = 0; g < numGroups; ++g) {
+            offsets[g + 1] += offsets[g];
+        }
+        std::vector<unsigned int> members(numVertices);
+        std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            members[cursor[groupOf[i]]++] = i;
+        }
+
+        const ai_real fLimit = std::cos(configMaxAngle);
+        ParallelFor(0, numVertices, NormalsChunkSize, [&](unsigned int first, unsigned int last) {
+            for (unsigned int i = first; i < last; ++i) {
+                const aiVector3D& vr = faceNormals[i];
+                const ai_real vrlen = vr.Length();
+
+                aiVector3D pcNor;
+                const unsigned int g = groupOf[i];
+                for (unsigned int m = offsets[g]; m < offsets[g + 1]; ++m) {
+                    const aiVector3D& v = faceNormals[members[m]];
+
+                    // see GenMeshVertexNormals() for qnan handling
+                    if (v * vr >= fLimit * vrlen * v.Length())
+                        pcNor += v;
+                }
+                pcNew[i] = pcNor.NormalizeSafe();
+            }
+        });
+    }
+
+    delete[] pMesh->mNormals;
+    pMesh->mNormals = pcNew;
+}
@@ -92,6 +92,12 @@ public:
         configMaxAngle =f;
     }
 
+    // setter for configExactPositions
+    inline void SetExactPositions(bool b)
+    {
+        configExactPositions = b;
+    }
+
 public:
 
     // -------------------------------------------------------------------
@@ -104,8 +110,23 @@ public:
 
 private:
 
+    // -------------------------------------------------------------------
+    /** Smooths the per-face normals stored in the mesh's normal array,
+    *  taking only vertices with bit-identical positions into account.
+    *  This runs in linear time and is used if #AI_CONFIG_PP_GSN_EXACT_POSITIONS
+    *  is set.
+    *  @param pcMesh Mesh
+    */
+    void GenMeshVertexNormalsExact (aiMesh* pcMesh);
+
     /** Configuration option: maximum smoothing angle, in radians*/
     ai_real configMaxAngle;
+
+    /** Configuration option: smooth identical positions only, see #AI_CONFIG_PP_GSN_EXACT_POSITIONS */
+    bool configExactPositions;
+
+    /** Configuration option: grid index for vertex lookups, see #AI_CONFIG_PP_SPATIAL_SORT_GRID */
+    bool configSpatialSortGrid;
 };
 
 } // end of namespace Assimp
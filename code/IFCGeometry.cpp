@@ -859,6 +859,15 @@ void PopulateMeshCache(const IfcRepresentationItem& item,
     conv.cached_meshes[idx] = mesh_indices;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool IsMeshCacheUsable(const ConversionData& conv)
+{
+    // geometry generated while openings are being collected or applied depends on
+    // the element currently being processed, so it must neither be taken from nor
+    // be put into any of the caches.
+    return !conv.collect_openings && (!conv.apply_openings || conv.apply_openings->empty());
+}
+
 // ------------------------------------------------------------------------------------------------
 bool ProcessRepresentationItem(const IfcRepresentationItem& item, unsigned int matid,
     std::vector<unsigned int>& mesh_indices,
@@ -867,9 +876,10 @@ bool ProcessRepresentationItem(const IfcRepresentationItem& item, unsigned int m
     // determine material
     unsigned int localmatid = ProcessMaterials(item.GetID(), matid, conv, true);
 
-    if (!TryQueryMeshCache(item,mesh_indices,localmatid,conv)) {
+    const bool use_cache = IsMeshCacheUsable(conv);
+    if (!use_cache || !TryQueryMeshCache(item,mesh_indices,localmatid,conv)) {
         if(ProcessGeometricItem(item,localmatid,mesh_indices,conv)) {
-            if(mesh_indices.size()) {
+            if(use_cache && mesh_indices.size()) {
                 PopulateMeshCache(item,mesh_indices,localmatid,conv);
             }
         }
@@ -311,6 +311,8 @@ void IFCImporter::InternReadFile( const std::string& pFile,
 
     // this must be last because objects are evaluated lazily as we process them
     if ( !DefaultLogger::isNullLogger() ){
+        LogDebug((Formatter::format(),"converted ",conv.converted_representation_maps," representation maps, took ",
+            conv.reused_representation_maps," further IfcMappedItem instances from the cache"));
         LogDebug((Formatter::format(),"STEP: evaluated ",db->GetEvaluatedObjectCount()," object records"));
     }
 }
@@ -446,16 +448,37 @@ bool ProcessMappedItem(const IfcMappedItem& mapped, aiNode* nd_src, std::vector<
     unsigned int localmatid = ProcessMaterials(mapped.GetID(),matid,conv,false);
     const IfcRepresentation& repr = mapped.MappingSource->MappedRepresentation;
 
-    bool got = false;
-    for(const IfcRepresentationItem& item : repr.Items) {
-        if(!ProcessRepresentationItem(item,localmatid,meshes,conv)) {
-            IFCImporter::LogWarn("skipping mapped entity of type " + item.GetClassName() + ", no representations could be generated");
-        }
-        else got = true;
+    // repeated instances of the same representation map (i.e. doors, bolts, fixtures ...)
+    // don't need to be tessellated again, they simply reference the meshes we got
+    // for the first instance.
+    const bool use_cache = IsMeshCacheUsable(conv);
+    const ConversionData::RepresentationMapCacheIndex cache_idx(mapped.MappingSource->GetID(), localmatid);
+    ConversionData::RepresentationMapCache::const_iterator cached = conv.cached_representation_maps.end();
+    if (use_cache) {
+        cached = conv.cached_representation_maps.find(cache_idx);
     }
 
-    if (!got) {
-        return false;
+    if (cached != conv.cached_representation_maps.end()) {
+        meshes = (*cached).second;
+        ++conv.reused_representation_maps;
+    }
+    else {
+        bool got = false;
+        for(const IfcRepresentationItem& item : repr.Items) {
+            if(!ProcessRepresentationItem(item,localmatid,meshes,conv)) {
+                IFCImporter::LogWarn("skipping mapped entity of type " + item.GetClassName() + ", no representations could be generated");
+            }
+            else got = true;
+        }
+
+        if (!got) {
+            return false;
+        }
+
+        if (use_cache && !meshes.empty()) {
+            conv.cached_representation_maps[cache_idx] = meshes;
+        }
+        ++conv.converted_representation_maps;
     }
 
     AssignAddedMeshes(meshes,nd.get(),conv);
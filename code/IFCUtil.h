@@ -181,6 +181,8 @@ struct ConversionData
         , proj(proj)
         , out(out)
         , settings(settings)
+        , converted_representation_maps()
+        , reused_representation_maps()
         , apply_openings()
         , collect_openings()
     {}
@@ -211,11 +213,28 @@ struct ConversionData
     typedef std::map<MeshCacheIndex, std::vector<unsigned int> > MeshCache;
     MeshCache cached_meshes;
 
+    // Meshes generated for a whole IfcRepresentationMap, keyed by the entity id of the
+    // map and the material it was converted with. IfcMappedItem instances sharing a
+    // source thus share their aiMesh'es and differ only in their node transformation.
+    struct RepresentationMapCacheIndex {
+        uint64_t id; unsigned int matindex;
+        RepresentationMapCacheIndex() : id(), matindex(0) { }
+        RepresentationMapCacheIndex(uint64_t id, unsigned int mi) : id(id), matindex(mi) { }
+        bool operator == (const RepresentationMapCacheIndex& o) const { return id == o.id && matindex == o.matindex; }
+        bool operator < (const RepresentationMapCacheIndex& o) const { return id < o.id || (id == o.id && matindex < o.matindex); }
+    };
+    typedef std::map<RepresentationMapCacheIndex, std::vector<unsigned int> > RepresentationMapCache;
+    RepresentationMapCache cached_representation_maps;
+
     typedef std::map<const IFC::IfcSurfaceStyle*, unsigned int> MaterialCache;
     MaterialCache cached_materials;
 
     const IFCImporter::Settings& settings;
 
+    // statistics on the representation map cache, the number of maps which had to be
+    // converted and the number of mapped items which were satisfied from the cache.
+    unsigned int converted_representation_maps, reused_representation_maps;
+
     // Intermediate arrays used to resolve openings in walls: only one of them
     // can be given at a time. apply_openings if present if the current element
     // is a wall and needs its openings to be poured into its geometry while
@@ -285,6 +304,7 @@ unsigned int ProcessMaterials(uint64_t id, unsigned int prevMatId, ConversionDat
 // IFCGeometry.cpp
 IfcMatrix3 DerivePlaneCoordinateSpace(const TempMesh& curmesh, bool& ok, IfcVector3& norOut);
 bool ProcessRepresentationItem(const IfcRepresentationItem& item, unsigned int matid, std::vector<unsigned int>& mesh_indices, ConversionData& conv);
+bool IsMeshCacheUsable(const ConversionData& conv);
 void AssignAddedMeshes(std::vector<unsigned int>& mesh_indices,aiNode* nd,ConversionData& /*conv*/);
 
 void ProcessSweptAreaSolid(const IfcSweptAreaSolid& swept, TempMesh& meshout,
@@ -90,7 +90,9 @@ static const aiImporterDesc desc = {
 IRRImporter::IRRImporter()
     : fps(),
     configSpeedFlag()
-{}
+{
+    usePullReader = false;
+}
 
 // ------------------------------------------------------------------------------------------------
 // Destructor, private as well
@@ -133,6 +135,7 @@ void IRRImporter::SetupProperties(const Importer* pImp)
 {
     // read the output frame rate of all node animation channels
     fps = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_IRR_ANIM_FPS,100);
+    usePullReader = pImp->GetPropertyBool(AI_CONFIG_IMPORT_IRR_PULL_READER,pImp->GetPropertyBool(AI_CONFIG_IMPORT_XML_PULL_READER,false));
     if (fps < 10.)  {
         DefaultLogger::get()->error("IRR: Invalid FPS configuration");
         fps = 100;
@@ -910,9 +913,8 @@ void IRRImporter::InternReadFile( const std::string& pFile,
     if( file.get() == NULL)
         throw DeadlyImportError( "Failed to open IRR file " + pFile + "");
 
-    // Construct the irrXML parser
-    CIrrXML_IOStreamReader st(file.get());
-    reader = createIrrXMLReader((IFileReadCallBack*) &st);
+    // Construct the XML parser
+    reader = CreateXmlReader(file.get(), usePullReader);
 
     // The root node of the scene
     Node* root = new Node(Node::DUMMY);
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fast_atof.h"
 #include <memory>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
 #include <assimp/mesh.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/material.h>
@@ -78,7 +79,9 @@ static const aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 IRRMeshImporter::IRRMeshImporter()
-{}
+{
+    usePullReader = false;
+}
 
 // ------------------------------------------------------------------------------------------------
 // Destructor, private as well
@@ -117,6 +120,13 @@ const aiImporterDesc* IRRMeshImporter::GetInfo () const
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the loader
+void IRRMeshImporter::SetupProperties(const Importer* pImp)
+{
+    usePullReader = pImp->GetPropertyBool(AI_CONFIG_IMPORT_IRRMESH_PULL_READER,pImp->GetPropertyBool(AI_CONFIG_IMPORT_XML_PULL_READER,false));
+}
+
 static void releaseMaterial( aiMaterial **mat ) {
     if(*mat!= nullptr) {
         delete *mat;
@@ -142,9 +152,8 @@ void IRRMeshImporter::InternReadFile( const std::string& pFile,
     if( file.get() == NULL)
         throw DeadlyImportError( "Failed to open IRRMESH file " + pFile + "");
 
-    // Construct the irrXML parser
-    CIrrXML_IOStreamReader st(file.get());
-    reader = createIrrXMLReader((IFileReadCallBack*) &st);
+    // Construct the XML parser
+    reader = CreateXmlReader(file.get(), usePullReader);
 
     // final data
     std::vector<aiMaterial*> materials;
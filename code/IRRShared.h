@@ -7,7 +7,7 @@
 #ifndef INCLUDED_AI_IRRSHARED_H
 #define INCLUDED_AI_IRRSHARED_H
 
-#include "irrXMLWrapper.h"
+#include "XmlPullReader.h"
 #include "BaseImporter.h"
 #include <stdint.h>
 
@@ -82,6 +82,10 @@ protected:
      */
   irr::io::IrrXMLReader* reader;
 
+    /** Configuration option: parse with XmlPullReader instead of irrXML
+     */
+    bool usePullReader;
+
     // -------------------------------------------------------------------
     /** Parse a material description from the XML
      *  @return The created material
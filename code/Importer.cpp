@@ -1147,6 +1147,22 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
             }
         }
         in.meshes += (sizeof(aiFace) + 3 * sizeof(unsigned int))*mScene->mMeshes[i]->mNumFaces;
+        in.meshes += sizeof(aiMeshlet) * mScene->mMeshes[i]->mNumMeshlets;
+        in.meshes += sizeof(unsigned int) * mScene->mMeshes[i]->mNumMeshletVertices;
+        if (mScene->mMeshes[i]->HasBVH()) {
+            in.meshes += sizeof(aiBVHNode) * mScene->mMeshes[i]->mNumBVHNodes;
+            in.meshes += sizeof(unsigned int) * mScene->mMeshes[i]->mNumFaces;
+        }
+        if (mScene->mMeshes[i]->HasQuantizedVertices()) {
+            const aiQuantizedVertices* qv = mScene->mMeshes[i]->mQuantizedVertices;
+            unsigned int values = (qv->mPositions ? 3 : 0) + (qv->mNormals ? 2 : 0);
+            for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+                if (qv->mTextureCoords[a]) {
+                    values += mScene->mMeshes[i]->mNumUVComponents[a];
+                }
+            }
+            in.meshes += sizeof(aiQuantizedVertices) + sizeof(unsigned short) * values * mScene->mMeshes[i]->mNumVertices;
+        }
     }
     in.total += in.meshes;
 
@@ -1183,6 +1199,8 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
 
     // add all nodes
     AddNodeWeight(in.nodes,mScene->mRootNode);
+    in.nodes += sizeof(aiBVHNode) * mScene->mNumBVHNodes;
+    in.nodes += sizeof(aiBVHInstance) * mScene->mNumBVHInstances;
     in.total += in.nodes;
 
     // add all materials
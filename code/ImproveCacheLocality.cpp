@@ -58,13 +58,49 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <stdio.h>
 #include <stack>
+#include <algorithm>
+#include <cmath>
 
 using namespace Assimp;
 
+namespace {
+
+    // Marks vertices not referenced yet
+    const unsigned int Unused = ~0u;
+
+    // ------------------------------------------------------------------------------------------------
+    // Reorders a vertex stream, order[i] is the old index of new vertex i
+    template <typename T>
+    void ReorderArray(T*& data, const std::vector<unsigned int>& order)
+    {
+        if (!data) {
+            return;
+        }
+        T* out = new T[order.size()];
+        for (size_t i = 0; i < order.size(); ++i) {
+            out[i] = data[order[i]];
+        }
+        delete[] data;
+        data = out;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Area weighted centroid and normal of a range of faces
+    struct FaceCluster {
+        unsigned int mBegin, mEnd;
+        aiVector3D mCentroid, mNormal;
+        ai_real mArea, mSortKey;
+    };
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ImproveCacheLocalityProcess::ImproveCacheLocalityProcess() {
-    configCacheDepth = PP_ICL_PTCACHE_SIZE;
+ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
+: configCacheDepth(PP_ICL_PTCACHE_SIZE)
+, configOverdrawThreshold(0.f)
+, configVertexFetch(false)
+{
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -87,6 +123,12 @@ void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp)
 {
     // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
     configCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
+
+    // AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD enables the overdraw optimization
+    configOverdrawThreshold = pImp->GetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD,0.f);
+
+    // AI_CONFIG_PP_ICL_VERTEX_FETCH enables the vertex fetch optimization
+    configVertexFetch = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_VERTEX_FETCH,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -102,20 +144,51 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
 
     float out = 0.f;
     unsigned int numf = 0, numm = 0;
+    unsigned int numClusters = 0, numFetchVertices = 0;
+    float fetchIn = 0.f, fetchOut = 0.f;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++){
-        const float res = ProcessMesh( pScene->mMeshes[a],a);
+        aiMesh* mesh = pScene->mMeshes[a];
+        const float res = ProcessMesh( mesh,a);
         if (res) {
-            numf += pScene->mMeshes[a]->mNumFaces;
+            numf += mesh->mNumFaces;
             out  += res;
             ++numm;
         }
+
+        if (!mesh->HasFaces() || !mesh->HasPositions() || mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+            continue;
+        }
+        if (configOverdrawThreshold >= 1.f) {
+            numClusters += OptimizeOverdraw(mesh,configOverdrawThreshold);
+        }
+        if (configVertexFetch) {
+            const bool stats = !DefaultLogger::isNullLogger();
+            if (stats) {
+                fetchIn += ComputeOverfetch(mesh) * mesh->mNumVertices;
+            }
+            OptimizeVertexFetch(mesh);
+            if (stats) {
+                fetchOut += ComputeOverfetch(mesh) * mesh->mNumVertices;
+            }
+            numFetchVertices += mesh->mNumVertices;
+        }
     }
     if (!DefaultLogger::isNullLogger()) {
         char szBuff[128]; // should be sufficiently large in every case
         ai_snprintf(szBuff,128,"Cache relevant are %u meshes (%u faces). Average output ACMR is %f",
             numm,numf,out/numf);
-
         DefaultLogger::get()->info(szBuff);
+
+        if (configOverdrawThreshold >= 1.f) {
+            ai_snprintf(szBuff,128,"Ordered %u face clusters for reduced overdraw",numClusters);
+            DefaultLogger::get()->info(szBuff);
+        }
+        if (numFetchVertices) {
+            ai_snprintf(szBuff,128,"Reordered %u vertices for vertex fetch. Average overfetch in: %f out: %f",
+                numFetchVertices,fetchIn/numFetchVertices,fetchOut/numFetchVertices);
+            DefaultLogger::get()->info(szBuff);
+        }
+
         DefaultLogger::get()->debug("ImproveCacheLocalityProcess finished. ");
     }
 }
@@ -385,3 +458,245 @@ float ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int mesh
 
     return fACMR2;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Splits the faces into clusters and sorts them for reduced overdraw, following the second half
+// of the paper: runs without shared cached vertices are hard cluster boundaries, and each run is
+// cut further whenever its ACMR so far drops below the threshold. Clusters at the outside of the
+// mesh which face outwards are likely to occlude others, so they are drawn first.
+unsigned int ImproveCacheLocalityProcess::OptimizeOverdraw( aiMesh* pMesh, float fThreshold) const
+{
+    const unsigned int numFaces = pMesh->mNumFaces;
+
+    // simulate the FIFO post-transform cache, using time stamps as ProcessMesh does
+    std::vector<unsigned int> stamps(pMesh->mNumVertices, 0);
+    unsigned int stamp = configCacheDepth + 1;
+    const auto countMisses = [&](unsigned int face) {
+        unsigned int misses = 0;
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int v = pMesh->mFaces[face].mIndices[i];
+            if (stamp - stamps[v] > configCacheDepth) {
+                stamps[v] = stamp++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+    const auto flushCache = [&]() {
+        stamp += configCacheDepth + 1;
+    };
+
+    // hard boundaries: faces missing the cache with all vertices
+    std::vector<unsigned int> hard;
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        if (countMisses(f) == 3) {
+            hard.push_back(f);
+        }
+    }
+    hard.push_back(numFaces);
+    if (hard.front() != 0) {
+        hard.insert(hard.begin(), 0);
+    }
+
+    // soft boundaries
+    std::vector<FaceCluster> clusters;
+    for (size_t h = 0; h + 1 < hard.size(); ++h) {
+        const unsigned int begin = hard[h], end = hard[h + 1];
+
+        flushCache();
+        unsigned int misses = 0;
+        for (unsigned int f = begin; f < end; ++f) {
+            misses += countMisses(f);
+        }
+        const float target = fThreshold * misses / (end - begin);
+
+        flushCache();
+        FaceCluster cluster = FaceCluster();
+        cluster.mBegin = begin;
+        unsigned int runMisses = 0, runFaces = 0;
+        for (unsigned int f = begin; f < end; ++f) {
+            runMisses += countMisses(f);
+            ++runFaces;
+            if (f + 1 < end && runMisses <= target * runFaces) {
+                cluster.mEnd = f + 1;
+                clusters.push_back(cluster);
+                cluster.mBegin = f + 1;
+                flushCache();
+                runMisses = runFaces = 0;
+            }
+        }
+        cluster.mEnd = end;
+        clusters.push_back(cluster);
+    }
+
+    // area weighted centroids and normals
+    aiVector3D meshCentroid;
+    ai_real meshArea = 0;
+    for (FaceCluster& cluster : clusters) {
+        cluster.mCentroid = cluster.mNormal = aiVector3D();
+        cluster.mArea = 0;
+        for (unsigned int f = cluster.mBegin; f < cluster.mEnd; ++f) {
+            const unsigned int* idx = pMesh->mFaces[f].mIndices;
+            const aiVector3D& p0 = pMesh->mVertices[idx[0]];
+            const aiVector3D& p1 = pMesh->mVertices[idx[1]];
+            const aiVector3D& p2 = pMesh->mVertices[idx[2]];
+            const aiVector3D n = (p1 - p0) ^ (p2 - p0);
+            const ai_real area = n.Length();
+            cluster.mCentroid += (p0 + p1 + p2) * (area / 3);
+            cluster.mNormal += n;
+            cluster.mArea += area;
+        }
+        meshCentroid += cluster.mCentroid;
+        meshArea += cluster.mArea;
+        if (cluster.mArea > 0) {
+            cluster.mCentroid /= cluster.mArea;
+        }
+    }
+    if (meshArea > 0) {
+        meshCentroid /= meshArea;
+    }
+    for (FaceCluster& cluster : clusters) {
+        const ai_real len = cluster.mNormal.Length();
+        cluster.mSortKey = len > 0 ? ((cluster.mCentroid - meshCentroid) * cluster.mNormal) / len : 0;
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const FaceCluster& a, const FaceCluster& b) {
+        return a.mSortKey > b.mSortKey;
+    });
+
+    // write the faces back in cluster order
+    std::vector<unsigned int> indices;
+    indices.reserve(numFaces * 3);
+    for (const FaceCluster& cluster : clusters) {
+        for (unsigned int f = cluster.mBegin; f < cluster.mEnd; ++f) {
+            indices.insert(indices.end(), pMesh->mFaces[f].mIndices, pMesh->mFaces[f].mIndices + 3);
+        }
+    }
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        std::copy(&indices[f * 3], &indices[f * 3] + 3, pMesh->mFaces[f].mIndices);
+    }
+    return static_cast<unsigned int>(clusters.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reorders the vertices into the order of their first use
+void ImproveCacheLocalityProcess::OptimizeVertexFetch( aiMesh* pMesh)
+{
+    const unsigned int numVertices = pMesh->mNumVertices;
+    std::vector<unsigned int> newIndex(numVertices, Unused), order;
+    order.reserve(numVertices);
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            const unsigned int v = face.mIndices[i];
+            if (newIndex[v] == Unused) {
+                newIndex[v] = static_cast<unsigned int>(order.size());
+                order.push_back(v);
+            }
+        }
+    }
+
+    // keep unreferenced vertices at the end
+    bool identity = true;
+    for (unsigned int v = 0; v < numVertices; ++v) {
+        if (newIndex[v] == Unused) {
+            newIndex[v] = static_cast<unsigned int>(order.size());
+            order.push_back(v);
+        }
+        identity = identity && newIndex[v] == v;
+    }
+    if (identity) {
+        return;
+    }
+
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            face.mIndices[i] = newIndex[face.mIndices[i]];
+        }
+    }
+
+    ReorderArray(pMesh->mVertices, order);
+    ReorderArray(pMesh->mNormals, order);
+    ReorderArray(pMesh->mTangents, order);
+    ReorderArray(pMesh->mBitangents, order);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        ReorderArray(pMesh->mColors[i], order);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        ReorderArray(pMesh->mTextureCoords[i], order);
+    }
+
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+        aiAnimMesh* anim = pMesh->mAnimMeshes[a];
+        ReorderArray(anim->mVertices, order);
+        ReorderArray(anim->mNormals, order);
+        ReorderArray(anim->mTangents, order);
+        ReorderArray(anim->mBitangents, order);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            ReorderArray(anim->mColors[i], order);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            ReorderArray(anim->mTextureCoords[i], order);
+        }
+    }
+
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        aiBone* bone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            bone->mWeights[w].mVertexId = newIndex[bone->mWeights[w].mVertexId];
+        }
+    }
+
+    for (unsigned int i = 0; i < pMesh->mNumMeshletVertices; ++i) {
+        pMesh->mMeshletVertices[i] = newIndex[pMesh->mMeshletVertices[i]];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Simulates the memory traffic of the vertex fetches of a mesh
+float ImproveCacheLocalityProcess::ComputeOverfetch( const aiMesh* pMesh) const
+{
+    static const unsigned int LineSize = 64, NumLines = 16384 / LineSize;
+
+    // size of an interleaved vertex
+    size_t stride = sizeof(aiVector3D);
+    if (pMesh->HasNormals()) {
+        stride += sizeof(aiVector3D);
+    }
+    if (pMesh->HasTangentsAndBitangents()) {
+        stride += 2 * sizeof(aiVector3D);
+    }
+    stride += pMesh->GetNumColorChannels() * sizeof(aiColor4D);
+    stride += pMesh->GetNumUVChannels() * sizeof(aiVector3D);
+
+    std::vector<unsigned int> vertexStamps(pMesh->mNumVertices, 0);
+    std::vector<unsigned int> lineStamps(pMesh->mNumVertices * stride / LineSize + 1, 0);
+    std::vector<bool> referenced(pMesh->mNumVertices, false);
+    unsigned int vertexStamp = configCacheDepth + 1, lineStamp = NumLines + 1;
+    size_t misses = 0, numReferenced = 0;
+
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            const unsigned int v = face.mIndices[i];
+            if (!referenced[v]) {
+                referenced[v] = true;
+                ++numReferenced;
+            }
+            if (vertexStamp - vertexStamps[v] <= configCacheDepth) {
+                continue;
+            }
+            vertexStamps[v] = vertexStamp++;
+
+            const size_t first = v * stride / LineSize, last = ((v + 1) * stride - 1) / LineSize;
+            for (size_t line = first; line <= last; ++line) {
+                if (lineStamp - lineStamps[line] > NumLines) {
+                    lineStamps[line] = lineStamp++;
+                    ++misses;
+                }
+            }
+        }
+    }
+    return numReferenced ? float(misses * LineSize) / float(numReferenced * stride) : 0.f;
+}
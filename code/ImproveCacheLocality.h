@@ -57,9 +57,13 @@ namespace Assimp
  *  cache locality. It tries to arrange all faces to fans and to render
  *  faces which share vertices directly one after the other.
  *
+ *  Optionally, the faces are then ordered to reduce overdraw, and the
+ *  vertices are reordered to match the face order for better vertex
+ *  fetch locality.
+ *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess
+class ASSIMP_API ImproveCacheLocalityProcess : public BaseProcess
 {
 public:
 
@@ -80,6 +84,31 @@ public:
     // Configures the pp step
     void SetupProperties(const Importer* pImp);
 
+    // -------------------------------------------------------------------
+    /** Sorts the faces of a cache optimized mesh into clusters ordered
+     *  for reduced overdraw, see #AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD.
+     * @param pMesh The mesh to process, must consist of triangles.
+     * @param fThreshold Maximum ACMR increase factor per cluster, >= 1.
+     * @return Number of clusters
+     */
+    unsigned int OptimizeOverdraw( aiMesh* pMesh, float fThreshold) const;
+
+    // -------------------------------------------------------------------
+    /** Reorders the vertices of a mesh into the order of their first
+     *  use by the faces, see #AI_CONFIG_PP_ICL_VERTEX_FETCH.
+     * @param pMesh The mesh to process, must consist of triangles.
+     */
+    static void OptimizeVertexFetch( aiMesh* pMesh);
+
+    // -------------------------------------------------------------------
+    /** Simulates the vertex fetches of a triangle mesh behind a post
+     *  transform cache of the configured size and returns the overfetch,
+     *  the number of bytes loaded into a 16kb cache with 64 byte lines
+     *  divided by the size of all referenced vertices. The vertices are
+     *  assumed to be interleaved in one buffer.
+     */
+    float ComputeOverfetch( const aiMesh* pMesh) const;
+
 protected:
     // -------------------------------------------------------------------
     /** Executes the postprocessing step on the given mesh
@@ -92,6 +121,13 @@ private:
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int configCacheDepth;
+
+    //! Configuration parameter: ACMR threshold for the overdraw
+    //! optimization, 0 if disabled.
+    float configOverdrawThreshold;
+
+    //! Configuration parameter: reorder the vertices for vertex fetch
+    bool configVertexFetch;
 };
 
 } // end of namespace Assimp
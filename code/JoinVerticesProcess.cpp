@@ -57,6 +57,7 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 JoinVerticesProcess::JoinVerticesProcess()
+: configSpatialSortGrid(false)
 {
     // nothing to do here
 }
@@ -74,6 +75,13 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 {
     return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup import configuration
+void JoinVerticesProcess::SetupProperties(const Importer* pImp)
+{
+    configSpatialSortGrid = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_GRID,0));
+}
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene)
@@ -156,6 +164,7 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     }
     if (!vertexFinder)  {
         // bad, need to compute it.
+        _vertexFinder.SetGridEnabled(configSpatialSortGrid);
         _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
         vertexFinder = &_vertexFinder;
         // posEpsilonSqr = ComputePositionEpsilon(pMesh);
@@ -356,7 +365,10 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         }
     }
 
-    // adjust bone vertex weights.
+    // adjust bone vertex weights. A shared weight table is outdated now.
+    if (BoneWeightTableCache* cache = GetBoneWeightTableCache(shared)) {
+        cache->Remove(pMesh);
+    }
     for( int a = 0; a < (int)pMesh->mNumBones; a++) {
         aiBone* bone = pMesh->mBones[a];
         std::vector<aiVertexWeight> newWeights;
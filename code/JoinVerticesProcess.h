@@ -82,6 +82,13 @@ public:
     */
     void Execute( aiScene* pScene);
 
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
 public:
     // -------------------------------------------------------------------
     /** Unites identical vertices in the given mesh.
@@ -91,6 +98,8 @@ public:
     int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
 
 private:
+    /** Configuration option: grid index for vertex lookups, see #AI_CONFIG_PP_SPATIAL_SORT_GRID */
+    bool configSpatialSortGrid;
 };
 
 } // end of namespace Assimp
@@ -43,14 +43,23 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "LimitBoneWeightsProcess.h"
+#include "ProcessHelper.h"
 #include "StringUtils.h"
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include <stdio.h>
+#include <algorithm>
 
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Orders bone weights by bone index
+static bool CompareBone( const LimitBoneWeightsProcess::Weight& a, const LimitBoneWeightsProcess::Weight& b)
+{
+    return a.mBone < b.mBone;
+}
+
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
@@ -99,104 +108,117 @@ void LimitBoneWeightsProcess::ProcessMesh( aiMesh* pMesh)
     if( !pMesh->HasBones())
         return;
 
-    // collect all bone weights per vertex
-    typedef std::vector< std::vector< Weight > > WeightsPerVertex;
-    WeightsPerVertex vertexWeights( pMesh->mNumVertices);
+    // get all bone weights per vertex, shared with the other bone steps if possible
+    BoneWeightTableCache* cache = GetBoneWeightTableCache(shared);
+    BoneWeightTable localTable;
+    const BoneWeightTable& vertexWeights = GetBoneWeightTable( cache, pMesh, localTable);
 
-    // collect all weights per vertex
-    for( unsigned int a = 0; a < pMesh->mNumBones; a++)
-    {
-        const aiBone* bone = pMesh->mBones[a];
-        for( unsigned int b = 0; b < bone->mNumWeights; b++)
-        {
-            const aiVertexWeight& w = bone->mWeights[b];
-            vertexWeights[w.mVertexId].push_back( Weight( a, w.mWeight));
-        }
-    }
+    // early out if no vertex exceeds the maximum
+    bool bChanged = false;
+    for( unsigned int a = 0; a < pMesh->mNumVertices && !bChanged; a++)
+        bChanged = vertexWeights.mOffsets[a+1] - vertexWeights.mOffsets[a] > mMaxWeights;
+
+    if (!bChanged)
+        return;
 
     unsigned int removed = 0, old_bones = pMesh->mNumBones;
 
-    // now cut the weight count if it exceeds the maximum
-    bool bChanged = false;
-    for( WeightsPerVertex::iterator vit = vertexWeights.begin(); vit != vertexWeights.end(); ++vit)
+    // now cut the weight count if it exceeds the maximum, building the new table as we go
+    BoneWeightTable* limited = new BoneWeightTable;
+    limited->mOffsets.resize( pMesh->mNumVertices + 1, 0);
+    limited->mEntries.reserve( vertexWeights.mEntries.size());
+
+    std::vector<Weight> weights;
+    for( unsigned int a = 0; a < pMesh->mNumVertices; a++)
     {
-        if( vit->size() <= mMaxWeights)
+        const PerVertexWeight* begin = vertexWeights.Begin( a), *end = vertexWeights.End( a);
+        const unsigned int m = static_cast<unsigned int>(end - begin);
+        if( m <= mMaxWeights)
+        {
+            limited->mEntries.insert( limited->mEntries.end(), begin, end);
+            limited->mOffsets[a+1] = static_cast<unsigned int>(limited->mEntries.size());
             continue;
-
-        bChanged = true;
+        }
 
         // more than the defined maximum -> first sort by weight in descending order. That's
         // why we defined the < operator in such a weird way.
-        std::sort( vit->begin(), vit->end());
+        weights.clear();
+        for( const PerVertexWeight* it = begin; it != end; ++it)
+            weights.push_back( Weight( it->first, it->second));
+        std::sort( weights.begin(), weights.end());
 
         // now kill everything beyond the maximum count
-        unsigned int m = static_cast<unsigned int>(vit->size());
-        vit->erase( vit->begin() + mMaxWeights, vit->end());
-        removed += static_cast<unsigned int>(m-vit->size());
+        weights.erase( weights.begin() + mMaxWeights, weights.end());
+        removed += static_cast<unsigned int>(m-weights.size());
 
         // and renormalize the weights
         float sum = 0.0f;
-        for( std::vector<Weight>::const_iterator it = vit->begin(); it != vit->end(); ++it ) {
+        for( std::vector<Weight>::const_iterator it = weights.begin(); it != weights.end(); ++it ) {
             sum += it->mWeight;
         }
         if( 0.0f != sum ) {
             const float invSum = 1.0f / sum;
-            for( std::vector<Weight>::iterator it = vit->begin(); it != vit->end(); ++it ) {
+            for( std::vector<Weight>::iterator it = weights.begin(); it != weights.end(); ++it ) {
                 it->mWeight *= invSum;
             }
         }
+
+        // the table keeps the weights of a vertex in bone order
+        std::stable_sort( weights.begin(), weights.end(), CompareBone);
+        for( std::vector<Weight>::const_iterator it = weights.begin(); it != weights.end(); ++it ) {
+            limited->mEntries.push_back( PerVertexWeight( it->mBone, it->mWeight));
+        }
+        limited->mOffsets[a+1] = static_cast<unsigned int>(limited->mEntries.size());
     }
 
-    if (bChanged)   {
-        // rebuild the vertex weight array for all bones
-        typedef std::vector< std::vector< aiVertexWeight > > WeightsPerBone;
-        WeightsPerBone boneWeights( pMesh->mNumBones);
-        for( unsigned int a = 0; a < vertexWeights.size(); a++)
+    // count the remaining weights per bone
+    std::vector<unsigned int> boneWeights( pMesh->mNumBones, 0);
+    for( std::vector<PerVertexWeight>::const_iterator it = limited->mEntries.begin(); it != limited->mEntries.end(); ++it)
+        boneWeights[it->first]++;
+
+    // remove bones without any weights left. The number of new bones is smaller than
+    // before, so we can reuse the old array. For the others, there should always be
+    // less weights than before, so we don't need a new allocation either.
+    std::vector<unsigned int> newBoneIndex( pMesh->mNumBones);
+    unsigned int numBones = 0;
+    for( unsigned int a = 0; a < pMesh->mNumBones; a++)
+    {
+        aiBone* bone = pMesh->mBones[a];
+        if( !boneWeights[a] )
         {
-            const std::vector<Weight>& vw = vertexWeights[a];
-            for( std::vector<Weight>::const_iterator it = vw.begin(); it != vw.end(); ++it)
-                boneWeights[it->mBone].push_back( aiVertexWeight( a, it->mWeight));
+            delete bone;
+            continue;
         }
 
-        // and finally copy the vertex weight list over to the mesh's bones
-        std::vector<bool> abNoNeed(pMesh->mNumBones,false);
-        bChanged = false;
+        ai_assert( boneWeights[a] <= bone->mNumWeights);
+        bone->mNumWeights = 0;
+        newBoneIndex[a] = numBones;
+        pMesh->mBones[numBones++] = bone;
+    }
+    pMesh->mNumBones = numBones;
 
-        for( unsigned int a = 0; a < pMesh->mNumBones; a++)
+    // and finally copy the vertex weight lists over to the mesh's bones
+    for( unsigned int a = 0; a < pMesh->mNumVertices; a++)
+    {
+        for( unsigned int e = limited->mOffsets[a]; e < limited->mOffsets[a+1]; e++)
         {
-            const std::vector<aiVertexWeight>& bw = boneWeights[a];
-            aiBone* bone = pMesh->mBones[a];
-
-            if ( bw.empty() )
-            {
-                abNoNeed[a] = bChanged = true;
-                continue;
-            }
+            PerVertexWeight& w = limited->mEntries[e];
+            w.first = newBoneIndex[w.first];
 
-            // copy the weight list. should always be less weights than before, so we don't need a new allocation
-            ai_assert( bw.size() <= bone->mNumWeights);
-            bone->mNumWeights = static_cast<unsigned int>( bw.size() );
-            ::memcpy( bone->mWeights, &bw[0], bw.size() * sizeof( aiVertexWeight));
+            aiBone* bone = pMesh->mBones[w.first];
+            bone->mWeights[bone->mNumWeights++] = aiVertexWeight( a, w.second);
         }
+    }
 
-        if (bChanged)   {
-            // the number of new bones is smaller than before, so we can reuse the old array
-            aiBone** ppcCur = pMesh->mBones;aiBone** ppcSrc = ppcCur;
-
-            for (std::vector<bool>::const_iterator iter  = abNoNeed.begin();iter != abNoNeed.end()  ;++iter)    {
-                if (*iter)  {
-                    delete *ppcSrc;
-                    --pMesh->mNumBones;
-                }
-                else *ppcCur++ = *ppcSrc;
-                ++ppcSrc;
-            }
-        }
+    // the new table replaces the shared one, which is invalid now
+    if( cache )
+        cache->Set( pMesh, limited);
+    else
+        delete limited;
 
-        if (!DefaultLogger::isNullLogger()) {
-            char buffer[1024];
-            ai_snprintf(buffer,1024,"Removed %u weights. Input bones: %u. Output bones: %u",removed,old_bones,pMesh->mNumBones);
-            DefaultLogger::get()->info(buffer);
-        }
+    if (!DefaultLogger::isNullLogger()) {
+        char buffer[1024];
+        ai_snprintf(buffer,1024,"Removed %u weights. Input bones: %u. Output bones: %u",removed,old_bones,pMesh->mNumBones);
+        DefaultLogger::get()->info(buffer);
     }
 }
@@ -79,6 +79,10 @@ public:
     // -------------------------------------------------------------------
     // Read from stream
     size_t Read(void* pvBuffer, size_t pSize, size_t pCount)    {
+        if (!pSize) {
+            // e.g. empty strings
+            return 0;
+        }
         const size_t cnt = std::min(pCount,(length-pos)/pSize),ofs = pSize*cnt;
 
         memcpy(pvBuffer,buffer+pos,ofs);
@@ -0,0 +1,258 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the BoneInfluenceTable and MeshSkinner helper classes
+ */
+
+#include <assimp/MeshSkinner.h>
+#include <assimp/AnimationSampler.h>
+#include <assimp/mesh.h>
+#include <assimp/ai_assert.h>
+#include "ProcessHelper.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// A single influence while building the table. Sorts by descending weight, ties are broken by the
+// bone index so the result does not depend on the sort implementation.
+struct Influence {
+    unsigned int mBone;
+    ai_real mWeight;
+
+    bool operator < ( const Influence& o ) const {
+        return mWeight > o.mWeight || ( mWeight == o.mWeight && mBone < o.mBone );
+    }
+};
+
+// Number of vertices skinned at once when only bounds are needed
+const unsigned int BoundsChunkSize = 1024;
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+BoneInfluenceTable::BoneInfluenceTable( const aiMesh* mesh, unsigned int maxInfluences )
+: mNumVertices( 0 )
+, mStride( 0 ) {
+    ai_assert( NULL != mesh );
+    mNumVertices = mesh->mNumVertices;
+    if ( !mesh->HasBones() || !maxInfluences ) {
+        return;
+    }
+
+    // the per-vertex lists come from the same transpose the bone post-processing steps share
+    BoneWeightTable table;
+    table.Build( mesh );
+    for ( unsigned int v = 0; v < mNumVertices; ++v ) {
+        mStride = std::max( mStride, static_cast<unsigned int>( table.End( v ) - table.Begin( v ) ) );
+    }
+    mStride = std::min( mStride, maxInfluences );
+    if ( !mStride ) {
+        return;
+    }
+
+    // now pack them with a fixed stride, keeping only the largest influences
+    mBones.resize( static_cast<size_t>( mNumVertices ) * mStride, 0 );
+    mWeights.resize( static_cast<size_t>( mNumVertices ) * mStride, ai_real( 0.0 ) );
+    std::vector<Influence> influences;
+    for ( unsigned int v = 0; v < mNumVertices; ++v ) {
+        influences.clear();
+        for ( const PerVertexWeight* it = table.Begin( v ), *end = table.End( v ); it != end; ++it ) {
+            Influence inf;
+            inf.mBone = it->first;
+            inf.mWeight = it->second;
+            influences.push_back( inf );
+        }
+        std::sort( influences.begin(), influences.end() );
+
+        const unsigned int count = static_cast<unsigned int>( influences.size() );
+        const unsigned int kept = std::min( count, mStride );
+        ai_real scale = ai_real( 1.0 );
+        if ( kept < count ) {
+            // renormalize the remaining weights
+            ai_real sum = ai_real( 0.0 );
+            for ( unsigned int i = 0; i < kept; ++i ) {
+                sum += influences[ i ].mWeight;
+            }
+            if ( sum != ai_real( 0.0 ) ) {
+                scale = ai_real( 1.0 ) / sum;
+            }
+        }
+
+        const size_t base = static_cast<size_t>( v ) * mStride;
+        for ( unsigned int i = 0; i < kept; ++i ) {
+            mBones[ base + i ] = influences[ i ].mBone;
+            mWeights[ base + i ] = influences[ i ].mWeight * scale;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshSkinner::MeshSkinner( const aiMesh* mesh, unsigned int maxInfluences )
+: mMesh( mesh )
+, mInfluences( mesh, maxInfluences ) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSkinner::ComputeBoneMatrices( const AnimationSampler& sampler, const aiMatrix4x4* global,
+        unsigned int meshNode, aiMatrix4x4* out ) const {
+    ai_assert( NULL != global );
+    ai_assert( meshNode < sampler.GetNodeCount() );
+
+    const aiMatrix4x4 meshInverse = aiMatrix4x4( global[ meshNode ] ).Inverse();
+    for ( unsigned int b = 0; b < mMesh->mNumBones; ++b ) {
+        const aiBone* bone = mMesh->mBones[ b ];
+        const unsigned int node = sampler.GetNodeIndex( bone->mName );
+        if ( node == UINT_MAX ) {
+            out[ b ] = aiMatrix4x4();
+            continue;
+        }
+        out[ b ] = meshInverse * global[ node ] * bone->mOffsetMatrix;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSkinner::Skin( const aiMatrix4x4* bones, aiVector3D* positions, aiVector3D* normals ) const {
+    SkinRange( bones, 0, mMesh->mNumVertices, positions, normals );
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSkinner::SkinRange( const aiMatrix4x4* bones, unsigned int begin, unsigned int end,
+        aiVector3D* positions, aiVector3D* normals ) const {
+    ai_assert( NULL != positions );
+    const unsigned int stride = mInfluences.GetStride();
+    const unsigned int* boneIdx = mInfluences.GetBoneIndices();
+    const ai_real* weights = mInfluences.GetWeights();
+    const aiVector3D* srcPos = mMesh->mVertices;
+    const aiVector3D* srcNor = normals ? mMesh->mNormals : NULL;
+
+    for ( unsigned int v = begin; v < end; ++v ) {
+        aiVector3D* const outPos = positions + ( v - begin );
+
+        // blend the upper 3x4 part of the bone matrices. All slots are processed, unused
+        // slots carry a zero weight, which keeps the inner loop free of branches.
+        ai_real m[ 12 ] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        ai_real sum = ai_real( 0.0 );
+        const size_t base = static_cast<size_t>( v ) * stride;
+        for ( unsigned int i = 0; i < stride; ++i ) {
+            const ai_real w = weights[ base + i ];
+            const ai_real* bm = bones[ boneIdx[ base + i ] ][ 0 ];
+            for ( unsigned int k = 0; k < 12; ++k ) {
+                m[ k ] += w * bm[ k ];
+            }
+            sum += w;
+        }
+
+        const aiVector3D& p = srcPos[ v ];
+        if ( sum == ai_real( 0.0 ) ) {
+            *outPos = p;
+            if ( srcNor ) {
+                normals[ v - begin ] = srcNor[ v ];
+            }
+            continue;
+        }
+
+        outPos->x = m[ 0 ] * p.x + m[ 1 ] * p.y + m[ 2 ] * p.z + m[ 3 ];
+        outPos->y = m[ 4 ] * p.x + m[ 5 ] * p.y + m[ 6 ] * p.z + m[ 7 ];
+        outPos->z = m[ 8 ] * p.x + m[ 9 ] * p.y + m[ 10 ] * p.z + m[ 11 ];
+        if ( srcNor ) {
+            // use the blended matrix for the normal as well, which is exact for rigid bones
+            // and the usual approximation otherwise
+            const aiVector3D& n = srcNor[ v ];
+            aiVector3D& outNor = normals[ v - begin ];
+            outNor.x = m[ 0 ] * n.x + m[ 1 ] * n.y + m[ 2 ] * n.z;
+            outNor.y = m[ 4 ] * n.x + m[ 5 ] * n.y + m[ 6 ] * n.z;
+            outNor.z = m[ 8 ] * n.x + m[ 9 ] * n.y + m[ 10 ] * n.z;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSkinner::ComputeBounds( const aiMatrix4x4* bones, aiVector3D& min, aiVector3D& max ) const {
+    const ai_real big = std::numeric_limits<ai_real>::max();
+    min = aiVector3D( big, big, big );
+    max = aiVector3D( -big, -big, -big );
+
+    std::vector<aiVector3D> chunk( std::min( BoundsChunkSize, mMesh->mNumVertices ) );
+    for ( unsigned int begin = 0; begin < mMesh->mNumVertices; begin += BoundsChunkSize ) {
+        const unsigned int end = std::min( begin + BoundsChunkSize, mMesh->mNumVertices );
+        SkinRange( bones, begin, end, &chunk[ 0 ], NULL );
+        for ( unsigned int i = 0; i < end - begin; ++i ) {
+            const aiVector3D& p = chunk[ i ];
+            min.x = std::min( min.x, p.x );
+            min.y = std::min( min.y, p.y );
+            min.z = std::min( min.z, p.z );
+            max.x = std::max( max.x, p.x );
+            max.y = std::max( max.y, p.y );
+            max.z = std::max( max.z, p.z );
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSkinner::ComputeAnimatedBounds( AnimationSampler& sampler, const double* times, unsigned int numTimes,
+        unsigned int meshNode, aiVector3D& min, aiVector3D& max ) const {
+    const ai_real big = std::numeric_limits<ai_real>::max();
+    min = aiVector3D( big, big, big );
+    max = aiVector3D( -big, -big, -big );
+
+    std::vector<aiMatrix4x4> global( sampler.GetNodeCount() );
+    std::vector<aiMatrix4x4> bones( std::max( mMesh->mNumBones, 1u ) );
+    for ( unsigned int t = 0; t < numTimes; ++t ) {
+        sampler.Sample( times[ t ], NULL, &global[ 0 ] );
+        ComputeBoneMatrices( sampler, &global[ 0 ], meshNode, &bones[ 0 ] );
+
+        aiVector3D fmin, fmax;
+        ComputeBounds( &bones[ 0 ], fmin, fmax );
+        min.x = std::min( min.x, fmin.x );
+        min.y = std::min( min.y, fmin.y );
+        min.z = std::min( min.z, fmin.z );
+        max.x = std::max( max.x, fmax.x );
+        max.y = std::max( max.y, fmax.y );
+        max.z = std::max( max.z, fmax.z );
+    }
+}
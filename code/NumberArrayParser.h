@@ -0,0 +1,269 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file NumberArrayParser.h
+ *  @brief Bulk parsing of whitespace separated number lists, as found in
+ *    Collada <float_array> and <p> elements.
+ *
+ *  Digit runs are classified and converted eight characters at a time
+ *  within a 64 bit register. Anything unusual (exponents, decimal commas,
+ *  nan/inf, very long numbers) goes through fast_atoreal_move resp.
+ *  strtol10, so results are bit-identical to parsing value by value.
+ */
+#ifndef AI_NUMBER_ARRAY_PARSER_H_INC
+#define AI_NUMBER_ARRAY_PARSER_H_INC
+
+#include "fast_atof.h"
+#include <assimp/defs.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+namespace Assimp {
+namespace NumberArray {
+
+// ---------------------------------------------------------------------------------
+/** Any ASCII white space separates two numbers, i.e. blanks, tabs, line
+ *  feeds, vertical tabs, form feeds and carriage returns. */
+AI_FORCE_INLINE bool IsSeparator( char c )
+{
+    return c == ' ' || ( c >= '\t' && c <= '\r' );
+}
+
+// ---------------------------------------------------------------------------------
+AI_FORCE_INLINE const char* SkipSeparators( const char* in )
+{
+    while( IsSeparator( *in ) ) {
+        ++in;
+    }
+    return in;
+}
+
+#ifndef AI_BUILD_BIG_ENDIAN
+
+// ---------------------------------------------------------------------------------
+/** Number of leading decimal digits in eight characters loaded little-endian.
+ *  Non-digit bytes get their high bit set; borrows and carries only ever
+ *  leak from a non-digit byte into the bytes after it, so the first flagged
+ *  byte is exact. */
+AI_FORCE_INLINE unsigned int CountDigits8( uint64_t chunk )
+{
+    const uint64_t flags = ( chunk | ( chunk + 0x4646464646464646ull ) |
+        ( chunk - 0x3030303030303030ull ) ) & 0x8080808080808080ull;
+    if( !flags ) {
+        return 8;
+    }
+#if defined( __GNUC__ ) || defined( __clang__ )
+    return static_cast<unsigned int>( __builtin_ctzll( flags ) ) >> 3;
+#else
+    unsigned int n = 0;
+    while( !( flags & ( 0x80ull << ( n * 8 ) ) ) ) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// ---------------------------------------------------------------------------------
+/** Value of the first num (1..8) digits of a chunk. */
+AI_FORCE_INLINE uint32_t ConvertDigits8( uint64_t chunk, unsigned int num )
+{
+    chunk &= 0x0F0F0F0F0F0F0F0Full;
+    if( num < 8 ) {
+        // move the digits to the top, the cleared bytes act as leading zeros
+        chunk <<= ( 8 - num ) * 8;
+    }
+    chunk = ( chunk * 2561 ) >> 8;
+    chunk = ( ( chunk & 0x00FF00FF00FF00FFull ) * 6553601 ) >> 16;
+    return static_cast<uint32_t>( ( ( chunk & 0x0000FFFF0000FFFFull ) * 42949672960001ull ) >> 32 );
+}
+
+// ---------------------------------------------------------------------------------
+/** Load eight characters and drop a leading minus sign, which leaves at
+ *  most seven digits for CountDigits8. Keeping the sign test off the
+ *  load-to-load dependency chain is what makes the fast paths fast. */
+AI_FORCE_INLINE uint64_t LoadSigned8( const char* in, bool& inv )
+{
+    uint64_t chunk;
+    ::memcpy( &chunk, in, 8 );
+    inv = ( chunk & 0xff ) == '-';
+    return chunk >> ( inv ? 8 : 0 );
+}
+
+#endif // !AI_BUILD_BIG_ENDIAN
+
+// ---------------------------------------------------------------------------------
+/** Parse one real with the exact semantics of fast_atoreal_move. */
+template <typename Real>
+AI_FORCE_INLINE const char* ReadReal( const char* in, const char* end, Real& out )
+{
+#ifndef AI_BUILD_BIG_ENDIAN
+    // fast path: [-]digits[.digits] with up to seven digits each
+    if( end - in >= 17 ) {
+        bool inv;
+        uint64_t chunk = LoadSigned8( in, inv );
+        const unsigned int numWhole = CountDigits8( chunk );
+        const char* cur = in + inv + numWhole;
+
+        uint32_t fraction = 0;
+        unsigned int numFraction = 0;
+        if( *cur == '.' ) {
+            ::memcpy( &chunk, cur + 1, 8 );
+            numFraction = CountDigits8( chunk );
+            if( numFraction && numFraction < 8 ) {
+                fraction = ConvertDigits8( chunk, numFraction );
+                cur += numFraction + 1;
+            }
+            else {
+                // trailing dot or too many decimals
+                numFraction = 8;
+            }
+        }
+        if( numWhole < 8 && numFraction < 8 && ( numWhole || numFraction ) && ( !*cur || IsSeparator( *cur ) ) ) {
+            ::memcpy( &chunk, in + inv, 8 );
+            Real f = static_cast<Real>( numWhole ? ConvertDigits8( chunk, numWhole ) : 0 );
+            if( numFraction ) {
+                double pl = static_cast<double>( fraction );
+                pl *= fast_atof_table[ numFraction ];
+                f += static_cast<Real>( pl );
+            }
+            out = inv ? -f : f;
+            return cur;
+        }
+    }
+#else
+    (void)end;
+#endif
+    return fast_atoreal_move<Real>( in, out );
+}
+
+// ---------------------------------------------------------------------------------
+/** Parse one integer with the exact semantics of strtol10.
+ *  @return NULL if in does not point to a number. */
+AI_FORCE_INLINE const char* ReadInt( const char* in, const char* end, int& out )
+{
+#ifndef AI_BUILD_BIG_ENDIAN
+    // fast path: [-]digits with up to seven digits
+    if( end - in >= 8 ) {
+        bool inv;
+        const uint64_t chunk = LoadSigned8( in, inv );
+        const unsigned int num = CountDigits8( chunk );
+        if( num && num < 8 ) {
+            const int value = static_cast<int>( ConvertDigits8( chunk, num ) );
+            out = inv ? -value : value;
+            return in + inv + num;
+        }
+    }
+#else
+    (void)end;
+#endif
+    const char* cur = in + ( *in == '-' || *in == '+' );
+    if( *cur < '0' || *cur > '9' ) {
+        return NULL;
+    }
+    out = strtol10( in, &cur );
+    return cur;
+}
+
+} // namespace NumberArray
+
+// ---------------------------------------------------------------------------------
+/** Read up to maxCount whitespace separated real numbers.
+ *
+ *  Each value is parsed exactly as fast_atoreal_move would parse it.
+ *  @param in Zero-terminated input, receives the position after the last
+ *    value read.
+ *  @param out Receives the values, must hold maxCount elements
+ *  @return Number of values read, less than maxCount if the input ends early.
+ */
+template <typename Real>
+inline size_t ReadRealArray( const char*& in, Real* out, size_t maxCount )
+{
+    const char* end = in + ::strlen( in );
+    const char* cur = NumberArray::SkipSeparators( in );
+
+    size_t num = 0;
+    while( num < maxCount && *cur ) {
+        cur = NumberArray::ReadReal( cur, end, out[ num++ ] );
+        cur = NumberArray::SkipSeparators( cur );
+    }
+    in = cur;
+    return num;
+}
+
+// ---------------------------------------------------------------------------------
+/** Read whitespace separated integers up to the end of the string and
+ *  append them to a vector.
+ *
+ *  Each value is parsed exactly as strtol10 would parse it. Negative values
+ *  are clamped to zero for unsigned element types, which is what all index
+ *  lists want. Parsing stops at the first token that is not a number.
+ *  @param in Zero-terminated input, receives the position where parsing
+ *    stopped, which points to the terminator if all input was consumed.
+ *  @param out Receives the values
+ *  @param sizeHint Number of values expected, used to presize out.
+ */
+template <typename TInt>
+inline void ReadIntegerArray( const char*& in, std::vector<TInt>& out, size_t sizeHint = 0 )
+{
+    const char* end = in + ::strlen( in );
+    const char* cur = NumberArray::SkipSeparators( in );
+
+    out.reserve( out.size() + sizeHint );
+    while( *cur ) {
+        int value;
+        const char* next = NumberArray::ReadInt( cur, end, value );
+        if( !next || ( *next && !NumberArray::IsSeparator( *next ) ) ) {
+            break;
+        }
+        if( std::is_unsigned<TInt>::value && value < 0 ) {
+            value = 0;
+        }
+        out.push_back( static_cast<TInt>( value ) );
+        cur = NumberArray::SkipSeparators( next );
+    }
+    in = cur;
+}
+
+} // namespace Assimp
+
+#endif // AI_NUMBER_ARRAY_PARSER_H_INC
@@ -59,24 +59,8 @@ namespace Assimp {
 // ------------------------------------------------------------------------------------------------
 // Worker function for exporting a scene to Wavefront OBJ. Prototyped and registered in Exporter.cpp
 void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties) {
-    // invoke the exporter
-    ObjExporter exporter(pFile, pScene);
-
-    // we're still here - export successfully completed. Write both the main OBJ file and the material script
-    {
-        std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-        if(outfile == NULL) {
-            throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
-        }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
-    }
-    {
-        std::unique_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
-        if(outfile == NULL) {
-            throw DeadlyExportError("could not open output .mtl file: " + std::string(exporter.GetMaterialLibFileName()));
-        }
-        outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
-    }
+    // invoke the exporter, which writes both the main OBJ file and the material script
+    ObjExporter exporter(pFile, pScene, pIOSystem);
 }
 
 } // end of namespace Assimp
@@ -84,8 +68,10 @@ void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 static const std::string MaterialExt = ".mtl";
 
 // ------------------------------------------------------------------------------------------------
-ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene)
-: filename(_filename)
+ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, IOSystem* pIOSystem)
+: mOutput(pIOSystem, _filename, "wt")
+, mOutputMat(pIOSystem, GetMaterialLibFileName(_filename), "wt")
+, filename(_filename)
 , pScene(pScene)
 , vp()
 , vn()
@@ -97,15 +83,11 @@ ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene)
 , vcMap()
 , meshes()
 , endl("\n") {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(16);
-    mOutputMat.imbue(l);
-    mOutputMat.precision(16);
-
     WriteGeometryFile();
     WriteMaterialFile();
+
+    mOutput.Flush();
+    mOutputMat.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -128,6 +110,11 @@ std::string ObjExporter :: GetMaterialLibName()
 
 // ------------------------------------------------------------------------------------------------
 std::string ObjExporter::GetMaterialLibFileName() {
+    return GetMaterialLibFileName(filename);
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ObjExporter::GetMaterialLibFileName(const std::string& filename) {
     // Remove existing .obj file extention so that the final material file name will be fileName.mtl and not fileName.obj.mtl
     size_t lastdot = filename.find_last_of('.');
     if (lastdot != std::string::npos)
@@ -137,7 +124,7 @@ std::string ObjExporter::GetMaterialLibFileName() {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter :: WriteHeader(std::ostringstream& out) {
+void ObjExporter :: WriteHeader(TextStreamWriter& out) {
     out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
     out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.' << aiGetVersionRevision() << ")" << endl  << endl;
 }
@@ -45,8 +45,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_OBJEXPORTER_H_INC
 #define AI_OBJEXPORTER_H_INC
 
+#include "TextStreamWriter.h"
 #include <assimp/types.h>
-#include <sstream>
 #include <vector>
 #include <map>
 
@@ -61,14 +61,17 @@ namespace Assimp {
 // ------------------------------------------------------------------------------------------------
 class ObjExporter {
 public:
-    /// Constructor for a specific scene to export
-    ObjExporter(const char* filename, const aiScene* pScene);
+    /// Constructor for a specific scene to export, writes the geometry
+    /// to filename and the material library next to it
+    ObjExporter(const char* filename, const aiScene* pScene, IOSystem* pIOSystem);
     ~ObjExporter();
     std::string GetMaterialLibName();
     std::string GetMaterialLibFileName();
-    
-    /// public string-streams to write all output into
-    std::ostringstream mOutput, mOutputMat;
+    static std::string GetMaterialLibFileName(const std::string& filename);
+
+private:
+    /// buffered writers for the OBJ file and the material library
+    TextStreamWriter mOutput, mOutputMat;
 
 private:
     // intermediate data structures
@@ -95,7 +98,7 @@ private:
         std::vector<Face> faces;
     };
 
-    void WriteHeader(std::ostringstream& out);
+    void WriteHeader(TextStreamWriter& out);
     void WriteMaterialFile();
     void WriteGeometryFile();
     std::string GetMaterialName(unsigned int index);
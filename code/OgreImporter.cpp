@@ -75,6 +75,7 @@ void OgreImporter::SetupProperties(const Importer* pImp)
 {
     m_userDefinedMaterialLibFile = pImp->GetPropertyString(AI_CONFIG_IMPORT_OGRE_MATERIAL_FILE, "Scene.material");
     m_detectTextureTypeFromFilename = pImp->GetPropertyBool(AI_CONFIG_IMPORT_OGRE_TEXTURETYPE_FROM_FILENAME, false);
+    m_usePullReader = pImp->GetPropertyBool(AI_CONFIG_IMPORT_OGRE_PULL_READER, pImp->GetPropertyBool(AI_CONFIG_IMPORT_XML_PULL_READER, false));
 }
 
 bool OgreImporter::CanRead(const std::string &pFile, Assimp::IOSystem *pIOHandler, bool checkSig) const
@@ -126,8 +127,7 @@ void OgreImporter::InternReadFile(const std::string &pFile, aiScene *pScene, Ass
     {
         /// @note XmlReader does not take ownership of f, hence the scoped ptr.
         std::unique_ptr<IOStream> scopedFile(f);
-        std::unique_ptr<CIrrXML_IOStreamReader> xmlStream(new CIrrXML_IOStreamReader(scopedFile.get()));
-        std::unique_ptr<XmlReader> reader(irr::io::createIrrXMLReader(xmlStream.get()));
+        std::unique_ptr<XmlReader> reader(CreateXmlReader(scopedFile.get(), m_usePullReader));
 
         // Import mesh
         std::unique_ptr<MeshXml> mesh(OgreXmlSerializer::ImportMesh(reader.get()));
@@ -91,6 +91,7 @@ private:
 
     std::string m_userDefinedMaterialLibFile;
     bool m_detectTextureTypeFromFilename;
+    bool m_usePullReader;
 
     std::map<aiTextureType, unsigned int> m_textures;
 };
@@ -0,0 +1,288 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file OptimizeAnimations.cpp
+ *  @brief Implementation of the aiProcess_OptimizeAnimations step
+ */
+
+#ifndef ASSIMP_BUILD_NO_OPTIMIZEANIMS_PROCESS
+
+#include "OptimizeAnimations.h"
+#include "StringUtils.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <stdio.h>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Interpolation factor of a time stamp between two keys
+template <typename KeyType>
+inline ai_real Factor(const KeyType& a, const KeyType& b, double time)
+{
+    const double diff = b.mTime - a.mTime;
+    return diff > 0.0 ? static_cast<ai_real>((time - a.mTime) / diff) : ai_real(0.0);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Error of a vector key against the interpolation of two other keys
+inline ai_real KeyError(const aiVectorKey& a, const aiVectorKey& b, const aiVectorKey& k)
+{
+    const aiVector3D v = a.mValue + (b.mValue - a.mValue) * Factor(a,b,k.mTime);
+    return (v - k.mValue).Length();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Angle between two rotations, in radians. Computed from the chord length between the normalized
+// quaternions instead of acos(dot), which is too imprecise for small angles.
+inline ai_real Angle(aiQuaternion a, aiQuaternion b)
+{
+    const ai_real la = std::sqrt(a.x*a.x + a.y*a.y + a.z*a.z + a.w*a.w);
+    const ai_real lb = std::sqrt(b.x*b.x + b.y*b.y + b.z*b.z + b.w*b.w);
+    if (la == 0 || lb == 0) {
+        return ai_real(0.0);
+    }
+    if (a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w < 0) {
+        // q and -q are the same rotation
+        b.x = -b.x; b.y = -b.y; b.z = -b.z; b.w = -b.w;
+    }
+
+    const ai_real dx = a.x/la - b.x/lb, dy = a.y/la - b.y/lb, dz = a.z/la - b.z/lb, dw = a.w/la - b.w/lb;
+    const ai_real chord = std::sqrt(dx*dx + dy*dy + dz*dz + dw*dw);
+    return ai_real(4.0) * std::asin(std::min(chord * ai_real(0.5), ai_real(1.0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Error of a quaternion key against the interpolation of two other keys
+inline ai_real KeyError(const aiQuatKey& a, const aiQuatKey& b, const aiQuatKey& k)
+{
+    aiQuaternion q;
+    aiQuaternion::Interpolate(q, a.mValue, b.mValue, Factor(a,b,k.mTime));
+    return Angle(q, k.mValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Greedy key reduction: collect the indices of all keys which must be kept. Every extension of a
+// segment re-checks all keys it covers, so segments are limited to maxSpan keys to keep the cost
+// linear in the number of keys.
+template <typename KeyType>
+void ReduceKeys(const std::vector<KeyType>& keys, ai_real tolerance, unsigned int maxSpan,
+    std::vector<unsigned int>& kept)
+{
+    const unsigned int num = static_cast<unsigned int>(keys.size());
+    kept.clear();
+    kept.push_back(0);
+
+    unsigned int anchor = 0;
+    for (unsigned int end = 2; end < num; ++end) {
+        bool keep = maxSpan && end - anchor > maxSpan;
+        for (unsigned int k = anchor + 1; !keep && k < end; ++k) {
+            keep = KeyError(keys[anchor], keys[end], keys[k]) > tolerance;
+        }
+        if (keep) {
+            // the previous key can't be dropped
+            anchor = end - 1;
+            kept.push_back(anchor);
+        }
+    }
+    if (num > 1) {
+        kept.push_back(num - 1);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reduce a single key track, returns the maximum error measured at the time stamps
+// of the original keys.
+template <typename KeyType>
+ai_real ProcessTrack(KeyType*& keys, unsigned int& num, ai_real tolerance, unsigned int maxSpan)
+{
+    if (num < 2) {
+        return ai_real(0.0);
+    }
+
+    const std::vector<KeyType> original(keys, keys + num);
+    std::vector<unsigned int> kept;
+    ReduceKeys(original, tolerance, maxSpan, kept);
+
+    if (kept.size() != num) {
+        // the key count is lower than before, we need a new allocation anyway to release the memory
+        delete[] keys;
+        num = static_cast<unsigned int>(kept.size());
+        keys = new KeyType[num];
+        for (unsigned int i = 0; i < num; ++i) {
+            keys[i] = original[kept[i]];
+        }
+    }
+
+    // measure the error we actually introduced
+    ai_real error = ai_real(0.0);
+    unsigned int seg = 0;
+    for (unsigned int i = 0; i < original.size(); ++i) {
+        const KeyType& k = original[i];
+        while (seg + 2 < num && keys[seg + 1].mTime < k.mTime) {
+            ++seg;
+        }
+        error = std::max(error, num > 1 ? KeyError(keys[seg], keys[seg + 1], k) : KeyError(keys[0], keys[0], k));
+    }
+    return error;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::Stats::Merge(const Stats& o)
+{
+    mKeysIn += o.mKeysIn;
+    mKeysOut += o.mKeysOut;
+    mPositionError = std::max(mPositionError, o.mPositionError);
+    mRotationError = std::max(mRotationError, o.mRotationError);
+    mScalingError = std::max(mScalingError, o.mScalingError);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+OptimizeAnimationsProcess::OptimizeAnimationsProcess()
+    : mPositionError(AI_OA_DEFAULT_POSITION_ERROR)
+    , mRotationError(AI_OA_DEFAULT_ROTATION_ERROR)
+    , mScalingError(AI_OA_DEFAULT_SCALING_ERROR)
+    , mMaxKeySpan(AI_OA_DEFAULT_MAX_KEY_SPAN)
+{
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+OptimizeAnimationsProcess::~OptimizeAnimationsProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool OptimizeAnimationsProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_OptimizeAnimations) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void OptimizeAnimationsProcess::SetupProperties(const Importer* pImp)
+{
+    SetTolerances(pImp->GetPropertyFloat(AI_CONFIG_PP_OA_POSITION_ERROR,AI_OA_DEFAULT_POSITION_ERROR),
+        pImp->GetPropertyFloat(AI_CONFIG_PP_OA_ROTATION_ERROR,AI_OA_DEFAULT_ROTATION_ERROR),
+        pImp->GetPropertyFloat(AI_CONFIG_PP_OA_SCALING_ERROR,AI_OA_DEFAULT_SCALING_ERROR));
+    SetMaxKeySpan(pImp->GetPropertyInteger(AI_CONFIG_PP_OA_MAX_KEY_SPAN,AI_OA_DEFAULT_MAX_KEY_SPAN));
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::SetTolerances(ai_real position, ai_real rotation, ai_real scaling)
+{
+    mPositionError = std::max(position, ai_real(0.0));
+    mRotationError = std::max(rotation, ai_real(0.0));
+    mScalingError = std::max(scaling, ai_real(0.0));
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::SetMaxKeySpan(unsigned int span)
+{
+    // a segment spans at least the two keys it interpolates between
+    mMaxKeySpan = span ? std::max(span, 2u) : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void OptimizeAnimationsProcess::Execute( aiScene* pScene)
+{
+    if (!pScene->mNumAnimations) {
+        DefaultLogger::get()->debug("OptimizeAnimationsProcess skipped; there are no animations");
+        return;
+    }
+
+    DefaultLogger::get()->debug("OptimizeAnimationsProcess begin");
+
+    Stats stats;
+    for (unsigned int a = 0; a < pScene->mNumAnimations; ++a) {
+        const aiAnimation* anim = pScene->mAnimations[a];
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+            stats.Merge(ProcessChannel(anim->mChannels[c]));
+        }
+    }
+
+    if (!DefaultLogger::isNullLogger()) {
+        char szBuff[256];
+        ai_snprintf(szBuff,256,"OptimizeAnimationsProcess: reduced %u keys to %u (%.2fx). Max. errors: "
+            "position %f, rotation %f deg, scaling %f",
+            stats.mKeysIn,stats.mKeysOut,stats.mKeysOut ? float(stats.mKeysIn) / stats.mKeysOut : 0.f,
+            stats.mPositionError,stats.mRotationError,stats.mScalingError);
+
+        DefaultLogger::get()->info(szBuff);
+        DefaultLogger::get()->debug("OptimizeAnimationsProcess finished");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+OptimizeAnimationsProcess::Stats OptimizeAnimationsProcess::ProcessChannel( aiNodeAnim* channel)
+{
+    ai_assert(NULL != channel);
+
+    Stats stats;
+    stats.mKeysIn = channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+
+    stats.mPositionError = ProcessTrack(channel->mPositionKeys,channel->mNumPositionKeys,mPositionError,
+        mMaxKeySpan);
+    stats.mScalingError = ProcessTrack(channel->mScalingKeys,channel->mNumScalingKeys,mScalingError,
+        mMaxKeySpan);
+    stats.mRotationError = AI_RAD_TO_DEG(ProcessTrack(channel->mRotationKeys,channel->mNumRotationKeys,
+        AI_DEG_TO_RAD(mRotationError),mMaxKeySpan));
+
+    stats.mKeysOut = channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+    return stats;
+}
+
+#endif // !! ASSIMP_BUILD_NO_OPTIMIZEANIMS_PROCESS
@@ -0,0 +1,131 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file OptimizeAnimations.h
+ *  @brief Declares a post processing step to remove redundant animation keys
+ */
+#ifndef AI_OPTIMIZEANIMATIONS_H_INC
+#define AI_OPTIMIZEANIMATIONS_H_INC
+
+#include "BaseProcess.h"
+#include <assimp/types.h>
+
+struct aiNodeAnim;
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** The OptimizeAnimationsProcess removes all animation keys which can be
+ *  reconstructed from their neighbours by interpolation within a given
+ *  tolerance.
+ *
+ *  Key reduction is greedy: starting at a kept key, the segment to the next
+ *  kept key is extended as long as all keys in between are matched by the
+ *  linear interpolation (slerp for rotations) of the segment's end points.
+ *  Segments span at most a configurable number of keys, which bounds the
+ *  cost of the reduction to O(keys * span) per track.
+ *  Position and scaling errors are measured as euclidean distance,
+ *  rotation errors as the angle between the two rotations.
+ */
+class ASSIMP_API OptimizeAnimationsProcess : public BaseProcess
+{
+public:
+
+    OptimizeAnimationsProcess();
+    ~OptimizeAnimationsProcess();
+
+    // -------------------------------------------------------------------
+    /** Statistics for a processed channel or scene. The errors are the
+     *  maximum errors measured at the time stamps of the removed keys
+     *  after reduction. The rotation error is given in
+     *  degrees. */
+    struct Stats {
+        Stats()
+            : mKeysIn()
+            , mKeysOut()
+            , mPositionError()
+            , mRotationError()
+            , mScalingError() {}
+
+        unsigned int mKeysIn, mKeysOut;
+        ai_real mPositionError, mRotationError, mScalingError;
+
+        void Merge(const Stats& o);
+    };
+
+public:
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is active
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    // Executes the pp step on a given scene
+    void Execute( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    // Configures the pp step
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    /** Set the tolerances, the rotation tolerance is in degrees. */
+    void SetTolerances(ai_real position, ai_real rotation, ai_real scaling);
+
+    // -------------------------------------------------------------------
+    /** Set the maximum number of keys between two kept keys, 0 for no limit. */
+    void SetMaxKeySpan(unsigned int span);
+
+    // -------------------------------------------------------------------
+    /** Executes the postprocessing step on the given animation channel.
+     * @param channel The channel to process.
+     * @return Statistics for the channel. */
+    Stats ProcessChannel( aiNodeAnim* channel);
+
+private:
+    ai_real mPositionError;
+    ai_real mRotationError;
+    ai_real mScalingError;
+    unsigned int mMaxKeySpan;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_OPTIMIZEANIMATIONS_H_INC
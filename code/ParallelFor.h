@@ -0,0 +1,157 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ParallelFor.h
+ *  @brief Helper to run independent work on index ranges in parallel
+ */
+#ifndef AI_PARALLELFOR_H_INC
+#define AI_PARALLELFOR_H_INC
+
+#include <assimp/defs.h>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <thread>
+#   include <exception>
+#   include <vector>
+#   include <algorithm>
+#endif
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** @brief Split [begin,end) into at most maxThreads contiguous chunks and
+ *  call func(first,last) for each of them, one chunk per thread.
+ *
+ *  The calling thread processes the first chunk itself. An exception thrown
+ *  by func is rethrown once all chunks are done. If the library is built
+ *  with ASSIMP_BUILD_SINGLETHREADED (the default, see the
+ *  ASSIMP_BUILD_MULTITHREADED CMake option), func is called once for the
+ *  whole range.
+ *
+ *  @param begin First index
+ *  @param end One past the last index
+ *  @param minChunk Minimum number of indices per chunk. Ranges smaller
+ *    than twice this value are never split.
+ *  @param maxThreads Maximum number of chunks and threads.
+ *  @param func Callable taking (unsigned int first, unsigned int last).
+ */
+template <typename Func>
+inline void ParallelForThreads(unsigned int begin, unsigned int end, unsigned int minChunk, unsigned int maxThreads, Func func)
+{
+    if (begin >= end) {
+        return;
+    }
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    const unsigned int count = end - begin;
+    unsigned int numThreads = maxThreads;
+    if (minChunk) {
+        numThreads = std::min(numThreads, count / minChunk);
+    }
+    if (numThreads > 1) {
+        const unsigned int chunk = (count + numThreads - 1) / numThreads;
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors(numThreads);
+        threads.reserve(numThreads - 1);
+
+        for (unsigned int t = 1; t < numThreads; ++t) {
+            const unsigned int first = begin + t * chunk;
+            const unsigned int last = std::min(end, first + chunk);
+            if (first >= last) {
+                break;
+            }
+            std::exception_ptr* error = &errors[t];
+            threads.push_back(std::thread([=, &func]() {
+                try {
+                    func(first, last);
+                }
+                catch (...) {
+                    *error = std::current_exception();
+                }
+            }));
+        }
+
+        try {
+            func(begin, std::min(end, begin + chunk));
+        }
+        catch (...) {
+            errors[0] = std::current_exception();
+        }
+
+        for (std::thread& th : threads) {
+            th.join();
+        }
+        for (const std::exception_ptr& e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+        return;
+    }
+#else
+    (void)minChunk;
+    (void)maxThreads;
+#endif
+
+    func(begin, end);
+}
+
+// ---------------------------------------------------------------------------
+/** @brief Split [begin,end) into contiguous chunks and call func(first,last)
+ *  for each of them, using one thread per hardware thread.
+ *
+ *  Callers must not rely on any particular chunking; func may only write
+ *  data owned by its own range. See ParallelForThreads().
+ */
+template <typename Func>
+inline void ParallelFor(unsigned int begin, unsigned int end, unsigned int minChunk, Func func)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    const unsigned int maxThreads = std::thread::hardware_concurrency();
+#else
+    const unsigned int maxThreads = 1;
+#endif
+    ParallelForThreads(begin, end, minChunk, maxThreads, func);
+}
+
+} // end of namespace Assimp
+
+#endif // AI_PARALLELFOR_H_INC
@@ -45,7 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_PLYEXPORTER_H_INC
 #define AI_PLYEXPORTER_H_INC
 
-#include <sstream>
+#include "TextStreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -59,13 +59,13 @@ namespace Assimp {
 class PlyExporter {
 public:
     /// The class constructor for a specific scene to export
-    PlyExporter(const char* filename, const aiScene* pScene, bool binary = false);
+    PlyExporter(const char* filename, const aiScene* pScene, IOSystem* pIOSystem, bool binary = false);
     /// The class destructor, empty.
     ~PlyExporter();
 
-public:
-    /// public string-streams to write all output into:
-    std::ostringstream mOutput;
+private:
+    /// buffered writer for all output
+    TextStreamWriter mOutput;
 
 private:
     void WriteMeshVerts(const aiMesh* m, unsigned int components);
@@ -85,6 +85,18 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS
 #   include "ImproveCacheLocality.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+#   include "GenMeshletsProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+#   include "QuantizeVerticesProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_SIMPLIFY_PROCESS
+#   include "SimplifyProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_GENBVH_PROCESS
+#   include "GenBVHProcess.h"
+#endif
 #ifndef ASSIMP_BUILD_NO_FIXINFACINGNORMALS_PROCESS
 #   include "FixNormalsStep.h"
 #endif
@@ -97,6 +109,9 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_FINDDEGENERATES_PROCESS
 #   include "FindDegenerates.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_OPTIMIZEANIMS_PROCESS
+#   include "OptimizeAnimations.h"
+#endif
 #ifndef ASSIMP_BUILD_NO_SORTBYPTYPE_PROCESS
 #   include "SortByPTypeProcess.h"
 #endif
@@ -175,12 +190,22 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_FINDINVALIDDATA_PROCESS)
     out.push_back( new FindInvalidDataProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_OPTIMIZEANIMS_PROCESS)
+    out.push_back( new OptimizeAnimationsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_OPTIMIZEMESHES_PROCESS)
     out.push_back( new OptimizeMeshesProcess());
 #endif
 #if (!defined ASSIMP_BUILD_NO_FIXINFACINGNORMALS_PROCESS)
     out.push_back( new FixInfacingNormalsProcess());
 #endif
+
+    // .........................................................................
+    // The bone weight tables stay valid until the last step which works on
+    // bones. Steps in between must keep them up to date.
+    out.push_back( new ComputeBoneWeightTableProcess());
+    // .........................................................................
+
 #if (!defined ASSIMP_BUILD_NO_SPLITBYBONECOUNT_PROCESS)
     out.push_back( new SplitByBoneCountProcess());
 #endif
@@ -222,9 +247,26 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_LIMITBONEWEIGHTS_PROCESS)
     out.push_back( new LimitBoneWeightsProcess());
 #endif
+
+    // .........................................................................
+    out.push_back( new DestroyBoneWeightTableProcess());
+    // .........................................................................
+
+#if (!defined ASSIMP_BUILD_NO_SIMPLIFY_PROCESS)
+    out.push_back( new SimplifyProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
     out.push_back( new ImproveCacheLocalityProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS)
+    out.push_back( new QuantizeVerticesProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+    out.push_back( new GenMeshletsProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENBVH_PROCESS)
+    out.push_back( new GenBVHProcess());
+#endif
 }
 
 }
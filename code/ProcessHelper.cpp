@@ -210,26 +210,6 @@ unsigned int GetMeshVFormatUnique(const aiMesh* pcMesh)
     return iRet;
 }
 
-// -------------------------------------------------------------------------------
-VertexWeightTable* ComputeVertexBoneWeightTable(const aiMesh* pMesh)
-{
-    if (!pMesh || !pMesh->mNumVertices || !pMesh->mNumBones) {
-        return NULL;
-    }
-
-    VertexWeightTable* avPerVertexWeights = new VertexWeightTable[pMesh->mNumVertices];
-    for (unsigned int i = 0; i < pMesh->mNumBones;++i)  {
-
-        aiBone* bone = pMesh->mBones[i];
-        for (unsigned int a = 0; a < bone->mNumWeights;++a) {
-            const aiVertexWeight& weight = bone->mWeights[a];
-            avPerVertexWeights[weight.mVertexId].push_back( std::pair<unsigned int,float>(i,weight.mWeight) );
-        }
-    }
-    return avPerVertexWeights;
-}
-
-
 // -------------------------------------------------------------------------------
 const char* TextureTypeToString(aiTextureType in)
 {
@@ -47,13 +47,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 #include <assimp/scene.h>
+#include <assimp/ai_assert.h>
 
 #include "SpatialSort.h"
 #include "BaseProcess.h"
 #include "ParsingUtils.h"
 
 #include <list>
+#include <map>
+#include <vector>
+#include <climits>
 
 // -------------------------------------------------------------------------------
 // Some extensions to std namespace. Mainly std::min and std::max for all
@@ -307,13 +313,178 @@ ai_real ComputePositionEpsilon(const aiMesh* const* pMeshes, size_t num);
 unsigned int GetMeshVFormatUnique(const aiMesh* pcMesh);
 
 
-// defs for ComputeVertexBoneWeightTable()
+// bone index and weight of a vertex, see BoneWeightTable
 typedef std::pair <unsigned int,float> PerVertexWeight;
-typedef std::vector <PerVertexWeight> VertexWeightTable;
 
 // -------------------------------------------------------------------------------
-// Compute a per-vertex bone weight table
-VertexWeightTable* ComputeVertexBoneWeightTable(const aiMesh* pMesh);
+/** Flat per-vertex bone weight table of a mesh, i.e. the transpose of the
+ *  weight lists stored in its bones. The weights of vertex i are
+ *  mEntries[mOffsets[i]] ... mEntries[mOffsets[i+1]-1], ordered by bone index.
+ *  The table of a mesh without bones is empty. */
+struct BoneWeightTable
+{
+    std::vector<unsigned int> mOffsets;
+    std::vector<PerVertexWeight> mEntries;
+
+    //! Build the table from the bones of a mesh. Weights referring to
+    //! vertices which don't exist are skipped with a warning.
+    void Build(const aiMesh* pMesh)
+    {
+        mOffsets.clear();
+        mEntries.clear();
+        if (!pMesh->HasBones()) {
+            return;
+        }
+
+        mOffsets.resize(pMesh->mNumVertices + 1,0);
+        unsigned int iInvalid = 0;
+        for (unsigned int k = 0; k < pMesh->mNumBones;++k) {
+            const aiBone* bone = pMesh->mBones[k];
+            for (unsigned int q = 0; q < bone->mNumWeights;++q) {
+                if (bone->mWeights[q].mVertexId >= pMesh->mNumVertices) {
+                    ++iInvalid;
+                    continue;
+                }
+                ++mOffsets[bone->mWeights[q].mVertexId + 1];
+            }
+        }
+        if (iInvalid) {
+            DefaultLogger::get()->warn("BoneWeightTable: skipping bone weights with an invalid vertex index");
+        }
+        for (unsigned int i = 0; i < pMesh->mNumVertices;++i) {
+            mOffsets[i+1] += mOffsets[i];
+        }
+
+        mEntries.resize(mOffsets.back());
+        std::vector<unsigned int> aiCursor(mOffsets.begin(),mOffsets.end()-1);
+        for (unsigned int k = 0; k < pMesh->mNumBones;++k) {
+            const aiBone* bone = pMesh->mBones[k];
+            for (unsigned int q = 0; q < bone->mNumWeights;++q) {
+                const aiVertexWeight& weight = bone->mWeights[q];
+                if (weight.mVertexId < pMesh->mNumVertices) {
+                    mEntries[aiCursor[weight.mVertexId]++] = PerVertexWeight(k,weight.mWeight);
+                }
+            }
+        }
+    }
+
+    //! Build the table of a submesh whose vertex i is vertex piSource[i] of
+    //! the mesh described by src. piBoneRemap maps the source bone indices
+    //! to those of the submesh and must preserve their order, weights of
+    //! bones mapped to UINT_MAX are dropped. Pass NULL to keep the indices.
+    void Gather(const BoneWeightTable& src, const unsigned int* piSource,
+        unsigned int iNumVertices, const unsigned int* piBoneRemap)
+    {
+        mOffsets.clear();
+        mEntries.clear();
+        if (src.Empty()) {
+            return;
+        }
+
+        mOffsets.resize(iNumVertices + 1);
+        mOffsets[0] = 0;
+        for (unsigned int v = 0; v < iNumVertices;++v) {
+            for (const PerVertexWeight* it = src.Begin(piSource[v]), *end = src.End(piSource[v]); it != end;++it) {
+                const unsigned int iBone = piBoneRemap ? piBoneRemap[it->first] : it->first;
+                if (UINT_MAX != iBone) {
+                    mEntries.push_back(PerVertexWeight(iBone,it->second));
+                }
+            }
+            mOffsets[v+1] = (unsigned int)mEntries.size();
+        }
+    }
+
+    bool Empty() const {
+        return mOffsets.empty();
+    }
+
+    const PerVertexWeight* Begin(unsigned int v) const {
+        return mEntries.data() + mOffsets[v];
+    }
+
+    const PerVertexWeight* End(unsigned int v) const {
+        return mEntries.data() + mOffsets[v+1];
+    }
+};
+
+// -------------------------------------------------------------------------------
+/** Bone weight tables shared between the bone-related steps, stored in
+ *  SharedPostProcessInfo as AI_SPP_BONE_WEIGHTS. A table is built the first
+ *  time it is requested. Steps which change the bones or vertices of a mesh
+ *  or delete it must update or remove its table. */
+class BoneWeightTableCache
+{
+public:
+    ~BoneWeightTableCache()
+    {
+        for (TableMap::iterator it = mTables.begin(); it != mTables.end();++it) {
+            delete (*it).second;
+        }
+    }
+
+    //! Get the table of a mesh, build it if necessary
+    const BoneWeightTable& Get(const aiMesh* pMesh)
+    {
+        BoneWeightTable*& table = mTables[pMesh];
+        if (!table) {
+            table = new BoneWeightTable();
+            table->Build(pMesh);
+        }
+        return *table;
+    }
+
+    //! Check whether the table of a mesh has been built or set
+    bool Has(const aiMesh* pMesh) const
+    {
+        return mTables.find(pMesh) != mTables.end();
+    }
+
+    //! Replace the table of a mesh, takes ownership of the table
+    void Set(const aiMesh* pMesh, BoneWeightTable* table)
+    {
+        BoneWeightTable*& entry = mTables[pMesh];
+        delete entry;
+        entry = table;
+    }
+
+    //! Drop the table of a mesh
+    void Remove(const aiMesh* pMesh)
+    {
+        TableMap::iterator it = mTables.find(pMesh);
+        if (it != mTables.end()) {
+            delete (*it).second;
+            mTables.erase(it);
+        }
+    }
+
+private:
+    typedef std::map<const aiMesh*, BoneWeightTable*> TableMap;
+    TableMap mTables;
+};
+
+// -------------------------------------------------------------------------------
+// Get the shared bone weight tables, NULL if there are none
+inline BoneWeightTableCache* GetBoneWeightTableCache(const SharedPostProcessInfo* shared)
+{
+    BoneWeightTableCache* cache = NULL;
+    if (shared) {
+        shared->GetProperty(AI_SPP_BONE_WEIGHTS,cache);
+    }
+    return cache;
+}
+
+// -------------------------------------------------------------------------------
+// Get the bone weight table of a mesh from the cache or, if there is no
+// cache, build it into local
+inline const BoneWeightTable& GetBoneWeightTable(BoneWeightTableCache* cache,
+    const aiMesh* pMesh, BoneWeightTable& local)
+{
+    if (cache) {
+        return cache->Get(pMesh);
+    }
+    local.Build(pMesh);
+    return local;
+}
 
 
 // -------------------------------------------------------------------------------
@@ -338,12 +509,23 @@ aiMesh* MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &su
 // all steps which use it to speedup its computations.
 class ComputeSpatialSortProcess : public BaseProcess
 {
+public:
+    ComputeSpatialSortProcess()
+        : configSpatialSortGrid(false)
+    {}
+
+private:
     bool IsActive( unsigned int pFlags) const
     {
         return NULL != shared && 0 != (pFlags & (aiProcess_CalcTangentSpace |
             aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
+    void SetupProperties(const Importer* pImp)
+    {
+        configSpatialSortGrid = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_GRID,0));
+    }
+
     void Execute( aiScene* pScene)
     {
         typedef std::pair<SpatialSort, ai_real> _Type;
@@ -355,12 +537,15 @@ class ComputeSpatialSortProcess : public BaseProcess
         for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it) {
             aiMesh* mesh = pScene->mMeshes[i];
             _Type& blubb = *it;
+            blubb.first.SetGridEnabled(configSpatialSortGrid);
             blubb.first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
             blubb.second = ComputePositionEpsilon(mesh);
         }
 
         shared->AddProperty(AI_SPP_SPATIAL_SORT,p);
     }
+
+    bool configSpatialSortGrid;
 };
 
 // -------------------------------------------------------------------------------
@@ -379,6 +564,40 @@ class DestroySpatialSortProcess : public BaseProcess
     }
 };
 
+// -------------------------------------------------------------------------------
+// Utility postprocess step to share the per-vertex bone weight tables between
+// all steps which work on bones. The tables themselves are built on demand.
+class ComputeBoneWeightTableProcess : public BaseProcess
+{
+    bool IsActive( unsigned int pFlags) const
+    {
+        return NULL != shared && 0 != (pFlags & (aiProcess_SplitByBoneCount |
+            aiProcess_SplitLargeMeshes | aiProcess_Debone | aiProcess_LimitBoneWeights));
+    }
+
+    void Execute( aiScene* /*pScene*/)
+    {
+        DefaultLogger::get()->debug("Share per-vertex bone weight tables");
+        shared->AddProperty(AI_SPP_BONE_WEIGHTS,new BoneWeightTableCache());
+    }
+};
+
+// -------------------------------------------------------------------------------
+// ... and the same again to cleanup the whole stuff
+class DestroyBoneWeightTableProcess : public BaseProcess
+{
+    bool IsActive( unsigned int pFlags) const
+    {
+        return NULL != shared && 0 != (pFlags & (aiProcess_SplitByBoneCount |
+            aiProcess_SplitLargeMeshes | aiProcess_Debone | aiProcess_LimitBoneWeights));
+    }
+
+    void Execute( aiScene* /*pScene*/)
+    {
+        shared->RemoveProperty(AI_SPP_BONE_WEIGHTS);
+    }
+};
+
 
 
 } // ! namespace Assimp
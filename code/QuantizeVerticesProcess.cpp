@@ -0,0 +1,272 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file QuantizeVerticesProcess.cpp
+ *  @brief Implementation of the aiProcess_QuantizeVertices step
+ */
+
+#ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+
+#include "QuantizeVerticesProcess.h"
+#include "ParallelFor.h"
+#include "StringUtils.h"
+#include "VertexQuantization.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <stdio.h>
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+QuantizeVerticesProcess::QuantizeVerticesProcess()
+: mPositionBits(PP_QV_POSITION_BITS)
+, mNormalBits(PP_QV_NORMAL_BITS)
+, mTexCoordMaxError(PP_QV_TEXCOORD_MAX_ERROR)
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+QuantizeVerticesProcess::~QuantizeVerticesProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool QuantizeVerticesProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_QuantizeVertices) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void QuantizeVerticesProcess::SetupProperties(const Importer* pImp)
+{
+    SetParameters(pImp->GetPropertyInteger(AI_CONFIG_PP_QV_POSITION_BITS,PP_QV_POSITION_BITS),
+        pImp->GetPropertyInteger(AI_CONFIG_PP_QV_NORMAL_BITS,PP_QV_NORMAL_BITS),
+        pImp->GetPropertyFloat(AI_CONFIG_PP_QV_TEXCOORD_MAX_ERROR,PP_QV_TEXCOORD_MAX_ERROR));
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::SetParameters(unsigned int positionBits, unsigned int normalBits, float texCoordMaxError)
+{
+    mPositionBits = std::min(std::max(positionBits, 2u), 16u);
+    mNormalBits = std::min(std::max(normalBits, 2u), 16u);
+    mTexCoordMaxError = std::max(texCoordMaxError, 0.f);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void QuantizeVerticesProcess::Execute( aiScene* pScene)
+{
+    DefaultLogger::get()->debug("QuantizeVerticesProcess begin");
+
+    // the meshes are independent of each other
+    std::vector<Error> errors(pScene->mNumMeshes);
+    ParallelFor(0, pScene->mNumMeshes, 1, [this, pScene, &errors](unsigned int first, unsigned int last) {
+        for (unsigned int a = first; a < last; ++a) {
+            ProcessMesh(pScene->mMeshes[a], errors[a]);
+        }
+    });
+
+    if (!DefaultLogger::isNullLogger()) {
+        // compare the size of the quantized streams to the float streams they replace
+        size_t floatSize = 0, quantizedSize = 0;
+        Error maxError;
+        for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+            const aiMesh* mesh = pScene->mMeshes[a];
+            const aiQuantizedVertices* qv = mesh->mQuantizedVertices;
+            if (!qv) {
+                continue;
+            }
+            if (qv->mPositions) {
+                floatSize += sizeof(aiVector3D) * mesh->mNumVertices;
+                quantizedSize += 3 * sizeof(unsigned short) * mesh->mNumVertices;
+            }
+            if (qv->mNormals) {
+                floatSize += sizeof(aiVector3D) * mesh->mNumVertices;
+                quantizedSize += 2 * sizeof(short) * mesh->mNumVertices;
+            }
+            for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+                if (qv->mTextureCoords[n]) {
+                    floatSize += sizeof(ai_real) * mesh->mNumUVComponents[n] * mesh->mNumVertices;
+                    quantizedSize += sizeof(unsigned short) * mesh->mNumUVComponents[n] * mesh->mNumVertices;
+                }
+            }
+            maxError.mPosition = std::max(maxError.mPosition, errors[a].mPosition);
+            maxError.mNormal = std::max(maxError.mNormal, errors[a].mNormal);
+            maxError.mTexCoord = std::max(maxError.mTexCoord, errors[a].mTexCoord);
+        }
+
+        char szBuff[256];
+        ai_snprintf(szBuff, 256, "QuantizeVerticesProcess finished. Vertex streams take %u instead of %u bytes. "
+            "Max. errors: position %f, normal %f degrees, texture coordinates %f",
+            static_cast<unsigned int>(quantizedSize), static_cast<unsigned int>(floatSize),
+            maxError.mPosition, maxError.mNormal * ai_real(180.0 / AI_MATH_PI), maxError.mTexCoord);
+        DefaultLogger::get()->info(szBuff);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Quantizes the streams of a single mesh
+void QuantizeVerticesProcess::ProcessMesh( aiMesh* pMesh, Error& pError) const
+{
+    ai_assert(NULL != pMesh);
+
+    delete pMesh->mQuantizedVertices;
+    pMesh->mQuantizedVertices = NULL;
+    pError = Error();
+    if (!pMesh->mNumVertices) {
+        return;
+    }
+
+    aiQuantizedVertices* qv = new aiQuantizedVertices();
+    const unsigned int numVertices = pMesh->mNumVertices;
+
+    // positions are mapped to the bounding box, unless it isn't finite
+    if (pMesh->mVertices) {
+        aiVector3D min = pMesh->mVertices[0], max = min;
+        for (unsigned int i = 1; i < numVertices; ++i) {
+            const aiVector3D& v = pMesh->mVertices[i];
+            min.x = std::min(min.x, v.x);
+            min.y = std::min(min.y, v.y);
+            min.z = std::min(min.z, v.z);
+            max.x = std::max(max.x, v.x);
+            max.y = std::max(max.y, v.y);
+            max.z = std::max(max.z, v.z);
+        }
+
+        const aiVector3D extent = max - min;
+        if (std::isfinite(extent.x) && std::isfinite(extent.y) && std::isfinite(extent.z)) {
+            const unsigned int maxValue = (1u << mPositionBits) - 1;
+            qv->mPositionBits = mPositionBits;
+            qv->mPositionOffset = min;
+            qv->mPositionScale = extent / static_cast<ai_real>(maxValue);
+            qv->mPositions = new unsigned short[3 * numVertices];
+
+            aiVector3D invScale;
+            for (unsigned int c = 0; c < 3; ++c) {
+                invScale[c] = qv->mPositionScale[c] > 0 ? 1 / qv->mPositionScale[c] : 0;
+            }
+            for (unsigned int i = 0; i < numVertices; ++i) {
+                aiVector3D& v = pMesh->mVertices[i];
+                unsigned short* q = qv->mPositions + 3 * i;
+                for (unsigned int c = 0; c < 3; ++c) {
+                    const unsigned int value = static_cast<unsigned int>((v[c] - min[c]) * invScale[c] + ai_real(0.5));
+                    q[c] = static_cast<unsigned short>(std::min(value, maxValue));
+                }
+                const aiVector3D decoded = DequantizePosition(*qv, q);
+                pError.mPosition = std::max(pError.mPosition, (decoded - v).Length());
+                v = decoded;
+            }
+        }
+    }
+
+    if (pMesh->mNormals) {
+        qv->mNormalBits = mNormalBits;
+        qv->mNormals = new short[2 * numVertices];
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            short* q = qv->mNormals + 2 * i;
+            pError.mNormal = std::max(pError.mNormal, EncodeOctahedral(pMesh->mNormals[i], mNormalBits, q));
+
+            // normals without a direction are left as they are
+            if (!IsReservedOctahedral(q, mNormalBits)) {
+                pMesh->mNormals[i] = DecodeOctahedral(q, mNormalBits);
+            }
+        }
+    }
+
+    // half floats are only accurate close to zero, so check each channel against the limit
+    std::vector<unsigned short> halves;
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        const unsigned int numComponents = pMesh->mNumUVComponents[n];
+        if (!pMesh->mTextureCoords[n] || !numComponents || numComponents > 3) {
+            continue;
+        }
+        halves.resize(numComponents * numVertices);
+        ai_real error = 0;
+        bool accurate = true;
+        for (unsigned int i = 0; accurate && i < numVertices; ++i) {
+            const aiVector3D& uv = pMesh->mTextureCoords[n][i];
+            for (unsigned int c = 0; c < numComponents; ++c) {
+                const uint16_t h = FloatToHalf(static_cast<float>(uv[c]));
+                halves[numComponents * i + c] = h;
+                const ai_real e = std::fabs(HalfToFloat(h) - uv[c]);
+                // also catches infinite and NaN coordinates
+                accurate = accurate && e <= mTexCoordMaxError;
+                error = std::max(error, e);
+            }
+        }
+        if (!accurate) {
+            continue;
+        }
+
+        qv->mTextureCoords[n] = new unsigned short[halves.size()];
+        std::copy(halves.begin(), halves.end(), qv->mTextureCoords[n]);
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            aiVector3D& uv = pMesh->mTextureCoords[n][i];
+            for (unsigned int c = 0; c < numComponents; ++c) {
+                uv[c] = HalfToFloat(halves[numComponents * i + c]);
+            }
+        }
+        pError.mTexCoord = std::max(pError.mTexCoord, error);
+    }
+
+    bool quantized = qv->mPositions || qv->mNormals;
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        quantized = quantized || qv->mTextureCoords[n];
+    }
+    if (!quantized) {
+        delete qv;
+        return;
+    }
+    pMesh->mQuantizedVertices = qv;
+}
+
+#endif // !! ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
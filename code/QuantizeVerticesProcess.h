@@ -0,0 +1,122 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file QuantizeVerticesProcess.h
+ *  @brief Declares a post processing step to store compact vertex streams
+ */
+#ifndef AI_QUANTIZEVERTICESPROCESS_H_INC
+#define AI_QUANTIZEVERTICESPROCESS_H_INC
+
+#include "BaseProcess.h"
+#include <assimp/types.h>
+
+struct aiMesh;
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** The QuantizeVerticesProcess stores quantized copies of the positions,
+ *  normals and texture coordinates of every mesh in
+ *  aiMesh::mQuantizedVertices and replaces the float streams by the
+ *  dequantized values, see #aiProcess_QuantizeVertices. The meshes are
+ *  processed in parallel.
+ */
+class ASSIMP_API QuantizeVerticesProcess : public BaseProcess
+{
+public:
+
+    QuantizeVerticesProcess();
+    ~QuantizeVerticesProcess();
+
+public:
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is active
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    // Executes the pp step on a given scene
+    void Execute( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    // Configures the pp step
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    /** Set the quantization parameters. The values are clamped as
+     *  documented for the config properties. */
+    void SetParameters(unsigned int positionBits, unsigned int normalBits, float texCoordMaxError);
+
+    // -------------------------------------------------------------------
+    /** Maximum errors introduced into a mesh */
+    struct Error {
+        //! Largest distance of a position to its dequantized value
+        ai_real mPosition;
+        //! Largest angle between a normal and its dequantized value, in radians
+        ai_real mNormal;
+        //! Largest difference of a texture coordinate to its dequantized value
+        ai_real mTexCoord;
+
+        Error() : mPosition(0), mNormal(0), mTexCoord(0) {}
+    };
+
+    // -------------------------------------------------------------------
+    /** Quantizes the vertex streams of a mesh. Replaces existing quantized
+     *  streams.
+     * @param pMesh The mesh to process.
+     * @param pError Receives the errors introduced.
+     */
+    void ProcessMesh( aiMesh* pMesh, Error& pError) const;
+
+private:
+    //! Configuration parameter: bits per position component
+    unsigned int mPositionBits;
+
+    //! Configuration parameter: bits per normal component
+    unsigned int mNormalBits;
+
+    //! Configuration parameter: error limit for texture coordinates
+    float mTexCoordMaxError;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_QUANTIZEVERTICESPROCESS_H_INC
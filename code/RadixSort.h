@@ -0,0 +1,203 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file RadixSort.h
+ *  @brief Stable LSD radix sort on floating-point and unsigned integer keys
+ */
+#ifndef AI_RADIXSORT_H_INC
+#define AI_RADIXSORT_H_INC
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <stdint.h>
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** Maps a float to an unsigned integer with the same ordering. Negative
+ *  zero is mapped to the key of positive zero, as both compare equal. */
+inline uint32_t GetRadixSortKey(float f)
+{
+    f += 0.0f;  // -0 + 0 = +0
+    uint32_t bits;
+    ::memcpy(&bits, &f, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// ---------------------------------------------------------------------------
+/** @copydoc GetRadixSortKey(float) */
+inline uint64_t GetRadixSortKey(double d)
+{
+    d += 0.0;
+    uint64_t bits;
+    ::memcpy(&bits, &d, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+}
+
+// ---------------------------------------------------------------------------
+/** Unsigned integers are their own keys. */
+inline uint32_t GetRadixSortKey(uint32_t u)
+{
+    return u;
+}
+
+// ---------------------------------------------------------------------------
+/** @copydoc GetRadixSortKey(uint32_t) */
+inline uint64_t GetRadixSortKey(uint64_t u)
+{
+    return u;
+}
+
+// ---------------------------------------------------------------------------
+/** @brief Sort a vector ascending by a numeric key, keeping equal
+ *  keys in their original order.
+ *
+ *  The result is identical to std::stable_sort() comparing the keys with
+ *  operator <, except that NaNs are sorted to the front (negative NaNs)
+ *  or to the back instead of yielding an undefined order. It neither
+ *  depends on the number of threads nor on how the work is split up.
+ *
+ *  Large arrays are sorted by a least-significant-digit radix sort over
+ *  the bits of the key. The array is cut into blocks which are counted
+ *  and scattered independently, see ParallelFor().
+ *
+ *  @param data Elements to sort
+ *  @param getKey Callable returning the float, double, uint32_t or
+ *    uint64_t key of an element
+ */
+template <typename T, typename GetKey>
+inline void StableRadixSort(std::vector<T>& data, GetKey getKey)
+{
+    // Arrays below this size are passed on to std::stable_sort
+    static const size_t MinRadixSortSize = 1024;
+    // Elements per block the radix passes are split into, and upper bound of blocks
+    static const unsigned int BlockSize = 1 << 16, MaxBlocks = 64;
+    static const unsigned int RadixBits = 11, Radix = 1 << RadixBits;
+
+    typedef decltype(GetRadixSortKey(getKey(data[0]))) Key;
+
+    const size_t size = data.size();
+    if (size < MinRadixSortSize || size > 0xffffffffu) {
+        std::stable_sort(data.begin(), data.end(), [&getKey](const T& a, const T& b) {
+            return GetRadixSortKey(getKey(a)) < GetRadixSortKey(getKey(b));
+        });
+        return;
+    }
+
+    const unsigned int num = static_cast<unsigned int>(size);
+    const unsigned int numBlocks = std::max(1u, std::min(MaxBlocks, num / BlockSize));
+    const auto blockBegin = [num, numBlocks](unsigned int block) {
+        return static_cast<unsigned int>(uint64_t(num) * block / numBlocks);
+    };
+
+    // sort (key, index) pairs first and move the elements only once at the end
+    std::vector<Key> keys(num), keysTemp(num);
+    std::vector<unsigned int> indices(num), indicesTemp(num);
+    ParallelFor(0, num, BlockSize, [&](unsigned int first, unsigned int last) {
+        for (unsigned int i = first; i < last; ++i) {
+            keys[i] = GetRadixSortKey(getKey(data[i]));
+            indices[i] = i;
+        }
+    });
+
+    std::vector<unsigned int> counts(numBlocks * Radix);
+    for (unsigned int shift = 0; shift < sizeof(Key) * 8; shift += RadixBits) {
+        // count the digits per block
+        std::fill(counts.begin(), counts.end(), 0u);
+        ParallelFor(0, numBlocks, 1, [&](unsigned int firstBlock, unsigned int lastBlock) {
+            for (unsigned int b = firstBlock; b < lastBlock; ++b) {
+                unsigned int* blockCounts = &counts[b * Radix];
+                for (unsigned int i = blockBegin(b), end = blockBegin(b + 1); i < end; ++i) {
+                    ++blockCounts[(keys[i] >> shift) & (Radix - 1)];
+                }
+            }
+        });
+
+        // turn the counts into output offsets, digit by digit and block by block
+        unsigned int offset = 0;
+        bool skip = false;
+        for (unsigned int d = 0; d < Radix; ++d) {
+            unsigned int digitTotal = 0;
+            for (unsigned int b = 0; b < numBlocks; ++b) {
+                const unsigned int c = counts[b * Radix + d];
+                counts[b * Radix + d] = offset + digitTotal;
+                digitTotal += c;
+            }
+            if (digitTotal == num) {
+                // all keys share this digit, the pass wouldn't change anything
+                skip = true;
+                break;
+            }
+            offset += digitTotal;
+        }
+        if (skip) {
+            continue;
+        }
+
+        ParallelFor(0, numBlocks, 1, [&](unsigned int firstBlock, unsigned int lastBlock) {
+            for (unsigned int b = firstBlock; b < lastBlock; ++b) {
+                unsigned int* blockOffsets = &counts[b * Radix];
+                for (unsigned int i = blockBegin(b), end = blockBegin(b + 1); i < end; ++i) {
+                    const unsigned int dest = blockOffsets[(keys[i] >> shift) & (Radix - 1)]++;
+                    keysTemp[dest] = keys[i];
+                    indicesTemp[dest] = indices[i];
+                }
+            }
+        });
+        keys.swap(keysTemp);
+        indices.swap(indicesTemp);
+    }
+
+    std::vector<T> sorted(num);
+    ParallelFor(0, num, BlockSize, [&](unsigned int first, unsigned int last) {
+        for (unsigned int i = first; i < last; ++i) {
+            sorted[i] = data[indices[i]];
+        }
+    });
+    data.swap(sorted);
+}
+
+} // end of namespace Assimp
+
+#endif // AI_RADIXSORT_H_INC
@@ -45,6 +45,7 @@ vertices close to a given position. Special implementation for
 the 3ds loader handling smooth groups correctly  */
 
 #include "SGSpatialSort.h"
+#include "RadixSort.h"
 
 using namespace Assimp;
 
@@ -74,8 +75,9 @@ void SGSpatialSort::Add(const aiVector3D& vPosition, unsigned int index,
 // ------------------------------------------------------------------------------------------------
 void SGSpatialSort::Prepare()
 {
-    // now sort the array ascending by distance.
-    std::sort( this->mPositions.begin(), this->mPositions.end());
+    // now sort the array ascending by distance. Entries at the same distance
+    // keep the order they were added in.
+    StableRadixSort(mPositions, [](const Entry& e) { return e.mDistance; });
 }
 // ------------------------------------------------------------------------------------------------
 // Returns an iterator for all positions close to the given position.
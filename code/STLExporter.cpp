@@ -60,47 +60,28 @@ namespace Assimp    {
 void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
     // invoke the exporter
-    STLExporter exporter(pFile, pScene);
-
-    // we're still here - export successfully completed. Write the file.
-    std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-    if(outfile == NULL) {
-        throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
-    }
-
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    STLExporter exporter(pFile, pScene, pIOSystem);
 }
 void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
     // invoke the exporter
-    STLExporter exporter(pFile, pScene, true);
-
-    // we're still here - export successfully completed. Write the file.
-    std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
-    if(outfile == NULL) {
-        throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
-    }
-
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    STLExporter exporter(pFile, pScene, pIOSystem, true);
 }
 
 } // end of namespace Assimp
 
 
 // ------------------------------------------------------------------------------------------------
-STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, bool binary)
-: filename(_filename)
+STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, IOSystem* pIOSystem, bool binary)
+: mOutput(pIOSystem, _filename, binary ? "wb" : "wt")
+, filename(_filename)
 , endl("\n")
 {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(16);
     if (binary) {
         char buf[80] = {0} ;
         buf[0] = 'A'; buf[1] = 's'; buf[2] = 's'; buf[3] = 'i'; buf[4] = 'm'; buf[5] = 'p';
         buf[6] = 'S'; buf[7] = 'c'; buf[8] = 'e'; buf[9] = 'n'; buf[10] = 'e';
-        mOutput.write(buf, 80);
+        mOutput.Write(buf, 80);
         unsigned int meshnum = 0;
         for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
             for (unsigned int j = 0; j < pScene->mMeshes[i]->mNumFaces; ++j) {
@@ -108,7 +89,7 @@ STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, bool bi
             }
         }
         AI_SWAP4(meshnum);
-        mOutput.write((char *)&meshnum, 4);
+        mOutput.Write(&meshnum, 4);
         for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
             WriteMeshBinary(pScene->mMeshes[i]);
         }
@@ -121,6 +102,8 @@ STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, bool bi
         }
         mOutput << "endsolid " << name << endl;
     }
+
+    mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -165,15 +148,15 @@ void STLExporter :: WriteMeshBinary(const aiMesh* m)
         }
         ai_real nx = nor.x, ny = nor.y, nz = nor.z;
         AI_SWAP4(nx); AI_SWAP4(ny); AI_SWAP4(nz);
-        mOutput.write((char *)&nx, 4); mOutput.write((char *)&ny, 4); mOutput.write((char *)&nz, 4);
+        mOutput.Write(&nx, 4); mOutput.Write(&ny, 4); mOutput.Write(&nz, 4);
         for(unsigned int a = 0; a < f.mNumIndices; ++a) {
             const aiVector3D& v  = m->mVertices[f.mIndices[a]];
             ai_real vx = v.x, vy = v.y, vz = v.z;
             AI_SWAP4(vx); AI_SWAP4(vy); AI_SWAP4(vz);
-            mOutput.write((char *)&vx, 4); mOutput.write((char *)&vy, 4); mOutput.write((char *)&vz, 4);
+            mOutput.Write(&vx, 4); mOutput.Write(&vy, 4); mOutput.Write(&vz, 4);
         }
         char dummy[2] = {0};
-        mOutput.write(dummy, 2);
+        mOutput.Write(dummy, 2);
     }
 }
 
@@ -45,7 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STLEXPORTER_H_INC
 #define AI_STLEXPORTER_H_INC
 
-#include <sstream>
+#include "TextStreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -61,12 +61,12 @@ class STLExporter
 {
 public:
     /// Constructor for a specific scene to export
-    STLExporter(const char* filename, const aiScene* pScene, bool binary = false);
+    STLExporter(const char* filename, const aiScene* pScene, IOSystem* pIOSystem, bool binary = false);
 
-public:
+private:
 
-    /// public stringstreams to write all output into
-    std::ostringstream mOutput;
+    /// buffered writer for all output
+    TextStreamWriter mOutput;
 
 private:
 
@@ -59,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include <stdio.h>
+#include <map>
 #include "ScenePrivate.h"
 
 namespace Assimp {
@@ -969,6 +970,15 @@ inline void GetArrayCopy (Type*& dest, ai_uint num )
     ::memcpy(dest, old, sizeof(Type) * num);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Maps the nodes of a hierarchy to the nodes of its copy
+inline void MapNodeCopies (const aiNode* src, aiNode* dest, std::map<const aiNode*, aiNode*>& nodes)
+{
+    nodes[src] = dest;
+    for (unsigned int i = 0; i < src->mNumChildren;++i)
+        MapNodeCopies(src->mChildren[i],dest->mChildren[i],nodes);
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::CopySceneFlat(aiScene** _dest,const aiScene* src)
 {
@@ -1026,6 +1036,23 @@ void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
     // now - copy the root node of the scene (deep copy, too)
     Copy( &dest->mRootNode, src->mRootNode);
 
+    // copy the bounding volume hierarchy, its instances refer to the new nodes
+    if (src->mNumBVHNodes && src->mRootNode)
+    {
+        dest->mNumBVHNodes = src->mNumBVHNodes;
+        dest->mBVHNodes = src->mBVHNodes;
+        GetArrayCopy(dest->mBVHNodes,dest->mNumBVHNodes);
+
+        dest->mNumBVHInstances = src->mNumBVHInstances;
+        dest->mBVHInstances = src->mBVHInstances;
+        GetArrayCopy(dest->mBVHInstances,dest->mNumBVHInstances);
+
+        std::map<const aiNode*, aiNode*> nodes;
+        MapNodeCopies(src->mRootNode,dest->mRootNode,nodes);
+        for (unsigned int i = 0; i < dest->mNumBVHInstances;++i)
+            dest->mBVHInstances[i].mNode = nodes[dest->mBVHInstances[i].mNode];
+    }
+
     // and keep the flags ...
     dest->mFlags = src->mFlags;
 
@@ -1069,6 +1096,66 @@ void SceneCombiner::Copy     (aiMesh** _dest, const aiMesh* src)
         aiFace& f = dest->mFaces[i];
         GetArrayCopy(f.mIndices,f.mNumIndices);
     }
+
+    // and of the meshlets
+    GetArrayCopy(dest->mMeshlets,dest->mNumMeshlets);
+    GetArrayCopy(dest->mMeshletVertices,dest->mNumMeshletVertices);
+
+    // and of the bounding volume hierarchy
+    GetArrayCopy(dest->mBVHNodes,dest->mNumBVHNodes);
+    GetArrayCopy(dest->mBVHFaces,dest->mNumFaces);
+
+    // and of the quantized vertex streams
+    if (src->mQuantizedVertices)
+    {
+        const aiQuantizedVertices* sqv = src->mQuantizedVertices;
+        aiQuantizedVertices* qv = dest->mQuantizedVertices = new aiQuantizedVertices();
+        qv->mPositionBits = sqv->mPositionBits;
+        qv->mPositionOffset = sqv->mPositionOffset;
+        qv->mPositionScale = sqv->mPositionScale;
+        qv->mNormalBits = sqv->mNormalBits;
+
+        const unsigned int num = dest->mNumVertices;
+        if (sqv->mPositions)
+        {
+            qv->mPositions = new unsigned short[3*num];
+            ::memcpy(qv->mPositions,sqv->mPositions,3*num*sizeof(unsigned short));
+        }
+        if (sqv->mNormals)
+        {
+            qv->mNormals = new short[2*num];
+            ::memcpy(qv->mNormals,sqv->mNormals,2*num*sizeof(short));
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS;++i)
+        {
+            if (sqv->mTextureCoords[i])
+            {
+                const unsigned int size = dest->mNumUVComponents[i]*num;
+                qv->mTextureCoords[i] = new unsigned short[size];
+                ::memcpy(qv->mTextureCoords[i],sqv->mTextureCoords[i],size*sizeof(unsigned short));
+            }
+        }
+    }
+
+    // make a deep copy of all morph targets
+    if (dest->mNumAnimMeshes)
+    {
+        dest->mAnimMeshes = new aiAnimMesh*[dest->mNumAnimMeshes];
+        for (unsigned int i = 0; i < dest->mNumAnimMeshes;++i)
+        {
+            aiAnimMesh* anim = dest->mAnimMeshes[i] = new aiAnimMesh();
+            ::memcpy(anim,src->mAnimMeshes[i],sizeof(aiAnimMesh));
+
+            GetArrayCopy( anim->mVertices,   anim->mNumVertices );
+            GetArrayCopy( anim->mNormals ,   anim->mNumVertices );
+            GetArrayCopy( anim->mTangents,   anim->mNumVertices );
+            GetArrayCopy( anim->mBitangents, anim->mNumVertices );
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c)
+                GetArrayCopy( anim->mTextureCoords[c], anim->mNumVertices );
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS;++c)
+                GetArrayCopy( anim->mColors[c], anim->mNumVertices );
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -0,0 +1,935 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file SimplifyProcess.cpp
+ *  @brief Implementation of the aiProcess_Simplify step
+ */
+
+#ifndef ASSIMP_BUILD_NO_SIMPLIFY_PROCESS
+
+#include "SimplifyProcess.h"
+#include "RadixSort.h"
+#include "StringUtils.h"
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <cmath>
+#include <stdio.h>
+
+using namespace Assimp;
+
+namespace {
+
+    // Marks unused entries in the index tables
+    const unsigned int Unused = ~0u;
+
+    // Weight of the planes which keep open borders in place, relative to
+    // the squared length of the border edge
+    const double BorderWeight = 10.0;
+
+    // Largest sum of the absolute bone weight differences of two vertices
+    // which may still be joined
+    const float MaxBoneWeightDelta = 0.25f;
+
+    // Upper bound for the number of LOD levels
+    const unsigned int MaxLodLevels = 8;
+
+    typedef aiVector3t<double> Vec3d;
+
+    enum VertexKind {
+        Kind_Manifold,  // interior point with a single vertex, may collapse along any edge
+        Kind_Border,    // point on an open border, may only collapse along the border
+        Kind_Locked     // seam, non-manifold or corner point, never moves
+    };
+
+    // --------------------------------------------------------------------------------------------
+    // Error quadric of Garland and Heckbert: the sum of the weighted squared
+    // distances to a set of planes, stored as symmetric 4x4 matrix.
+    struct Quadric {
+        double a00, a11, a22, a01, a02, a12, b0, b1, b2, c, w;
+
+        Quadric()
+        : a00(), a11(), a22(), a01(), a02(), a12(), b0(), b1(), b2(), c(), w() {
+            // empty
+        }
+
+        void AddPlane(const Vec3d& n, double d, double weight) {
+            a00 += weight * n.x * n.x;
+            a11 += weight * n.y * n.y;
+            a22 += weight * n.z * n.z;
+            a01 += weight * n.x * n.y;
+            a02 += weight * n.x * n.z;
+            a12 += weight * n.y * n.z;
+            b0 += weight * n.x * d;
+            b1 += weight * n.y * d;
+            b2 += weight * n.z * d;
+            c += weight * d * d;
+            w += weight;
+        }
+
+        Quadric& operator += (const Quadric& o) {
+            a00 += o.a00; a11 += o.a11; a22 += o.a22;
+            a01 += o.a01; a02 += o.a02; a12 += o.a12;
+            b0 += o.b0; b1 += o.b1; b2 += o.b2;
+            c += o.c;
+            w += o.w;
+            return *this;
+        }
+
+        // Weighted sum of the squared distances of p to the planes
+        double Evaluate(const aiVector3D& p) const {
+            const double x = p.x, y = p.y, z = p.z;
+            return a00 * x * x + a11 * y * y + a22 * z * z
+                + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        }
+    };
+
+    // --------------------------------------------------------------------------------------------
+    // Weighted mean of the squared distances of p to the planes of both quadrics
+    inline double CombinedError(const Quadric& a, const Quadric& b, const aiVector3D& p) {
+        const double w = a.w + b.w;
+        if (w <= 0.0) {
+            return 0.0;
+        }
+        return std::max(a.Evaluate(p) + b.Evaluate(p), 0.0) / w;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    inline uint64_t EdgeKey(unsigned int a, unsigned int b) {
+        return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    inline Vec3d ToDouble(const aiVector3D& v) {
+        return Vec3d(v.x, v.y, v.z);
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Orders vertex indices by position, ties by index
+    struct PositionLess {
+        const aiVector3D* mPositions;
+
+        explicit PositionLess(const aiVector3D* positions) : mPositions(positions) {}
+
+        bool operator()(unsigned int a, unsigned int b) const {
+            const aiVector3D& pa = mPositions[a], &pb = mPositions[b];
+            if (pa.x != pb.x) return pa.x < pb.x;
+            if (pa.y != pb.y) return pa.y < pb.y;
+            if (pa.z != pb.z) return pa.z < pb.z;
+            return a < b;
+        }
+    };
+
+    // --------------------------------------------------------------------------------------------
+    // A candidate for collapsing point u onto point v
+    struct Collapse {
+        unsigned int u, v;
+        double error;
+    };
+
+    // --------------------------------------------------------------------------------------------
+    // Moves the entries of a vertex stream to their new indices
+    template <typename T>
+    void CompactStream(T*& data, const std::vector<unsigned int>& newIndex, unsigned int newCount) {
+        if (!data) {
+            return;
+        }
+        T* out = new T[newCount];
+        for (unsigned int i = 0; i < newIndex.size(); ++i) {
+            if (newIndex[i] != Unused) {
+                out[newIndex[i]] = data[i];
+            }
+        }
+        delete[] data;
+        data = out;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    inline unsigned int TargetFaces(unsigned int numFaces, double ratio) {
+        return static_cast<unsigned int>(numFaces * ratio + 0.5);
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Adds the metadata entries referencing the LOD levels to a node and its children
+    void AddLodMetaData(aiNode* node, const std::vector< std::vector<unsigned int> >& lods) {
+        for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+            const std::vector<unsigned int>& levels = lods[node->mMeshes[i]];
+            for (unsigned int k = 0; k < levels.size(); ++k) {
+                if (!node->mMetaData) {
+                    node->mMetaData = new aiMetadata();
+                }
+                char key[64];
+                ai_snprintf(key, 64, "$LOD.%u.%u", i, k + 1);
+                node->mMetaData->Add(key, static_cast<int32_t>(levels[k]));
+            }
+        }
+        for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+            AddLodMetaData(node->mChildren[i], lods);
+        }
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Edge collapse state of a single mesh. Vertices with the same position
+    // are merged into points, the collapses operate on these points.
+    class Simplifier {
+    public:
+        Simplifier(const aiMesh* mesh, unsigned int targetFaces, double maxErrorSq);
+
+        // Runs the collapses and returns the largest squared error introduced
+        double Run();
+
+        // Triangle corners, three vertex indices per triangle
+        const std::vector<unsigned int>& Corners() const {
+            return mCorners;
+        }
+
+    private:
+        void SetupPoints();
+        void ClassifyPoints(std::vector<uint64_t>& borders);
+        void SetupQuadrics(const std::vector<uint64_t>& borders);
+        void SetupBoneWeights();
+        void BuildAdjacency();
+
+        bool CanCollapse(unsigned int u, unsigned int v) const;
+        bool CheckCollapse(unsigned int u, unsigned int v, unsigned int numTriangles,
+            unsigned int& removed, unsigned int& vertexV);
+        float BoneWeightDelta(unsigned int a, unsigned int b) const;
+
+        unsigned int NumTriangles() const {
+            return static_cast<unsigned int>(mCorners.size() / 3);
+        }
+
+        const aiMesh* mMesh;
+        unsigned int mTargetFaces;
+        double mMaxErrorSq;
+
+        std::vector<unsigned int> mCorners;
+        std::vector<unsigned int> mPointOfVertex;
+        std::vector<aiVector3D> mPoints;
+        std::vector<unsigned int> mVertexOfPoint;
+        std::vector<unsigned char> mKind;
+        std::vector<Quadric> mQuadrics;
+
+        // bone weights per vertex, sorted by bone
+        std::vector<unsigned int> mBoneOffsets;
+        std::vector< std::pair<unsigned int, float> > mBoneWeights;
+
+        // triangles around each point
+        std::vector<unsigned int> mAdjOffsets;
+        std::vector<unsigned int> mAdjTriangles;
+
+        // collapse targets of the current pass
+        std::vector<unsigned int> mPointRemap;
+
+        // scratch space of CheckCollapse
+        std::vector<unsigned int> mNeighbors, mOpposite;
+    };
+
+    // --------------------------------------------------------------------------------------------
+    Simplifier::Simplifier(const aiMesh* mesh, unsigned int targetFaces, double maxErrorSq)
+    : mMesh(mesh)
+    , mTargetFaces(targetFaces)
+    , mMaxErrorSq(maxErrorSq) {
+        SetupPoints();
+
+        std::vector<uint64_t> borders;
+        ClassifyPoints(borders);
+        SetupQuadrics(borders);
+        SetupBoneWeights();
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Merges vertices with equal positions and drops triangles which are degenerate
+    void Simplifier::SetupPoints() {
+        const unsigned int numVertices = mMesh->mNumVertices;
+        const aiVector3D* const vertices = mMesh->mVertices;
+
+        std::vector<unsigned int> order(numVertices);
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), PositionLess(vertices));
+
+        mPointOfVertex.resize(numVertices);
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            if (!i || vertices[order[i]] != vertices[order[i - 1]]) {
+                mPoints.push_back(vertices[order[i]]);
+            }
+            mPointOfVertex[order[i]] = static_cast<unsigned int>(mPoints.size() - 1);
+        }
+
+        mCorners.reserve(3 * mMesh->mNumFaces);
+        for (unsigned int i = 0; i < mMesh->mNumFaces; ++i) {
+            const unsigned int* idx = mMesh->mFaces[i].mIndices;
+            const unsigned int p0 = mPointOfVertex[idx[0]], p1 = mPointOfVertex[idx[1]], p2 = mPointOfVertex[idx[2]];
+            if (p0 != p1 && p1 != p2 && p0 != p2) {
+                mCorners.insert(mCorners.end(), idx, idx + 3);
+            }
+        }
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Determines the kind of every point and collects the border edges
+    void Simplifier::ClassifyPoints(std::vector<uint64_t>& borders) {
+        const unsigned int numPoints = static_cast<unsigned int>(mPoints.size());
+        mVertexOfPoint.assign(numPoints, Unused);
+        mKind.assign(numPoints, Kind_Manifold);
+
+        // points referenced through several vertices are on a seam
+        for (unsigned int i = 0; i < mCorners.size(); ++i) {
+            const unsigned int p = mPointOfVertex[mCorners[i]];
+            if (mVertexOfPoint[p] == Unused) {
+                mVertexOfPoint[p] = mCorners[i];
+            }
+            else if (mVertexOfPoint[p] != mCorners[i]) {
+                mKind[p] = Kind_Locked;
+            }
+        }
+
+        // edges used by a single triangle are on a border, edges used by
+        // more than two triangles are non-manifold
+        std::vector<uint64_t> edges;
+        edges.reserve(mCorners.size());
+        for (unsigned int t = 0; t < NumTriangles(); ++t) {
+            for (unsigned int k = 0; k < 3; ++k) {
+                edges.push_back(EdgeKey(mPointOfVertex[mCorners[3 * t + k]], mPointOfVertex[mCorners[3 * t + (k + 1) % 3]]));
+            }
+        }
+        StableRadixSort(edges, [](uint64_t e) { return e; });
+
+        std::vector<unsigned int> numBorderEdges(numPoints, 0);
+        for (size_t i = 0; i < edges.size();) {
+            size_t end = i + 1;
+            while (end < edges.size() && edges[end] == edges[i]) {
+                ++end;
+            }
+            const unsigned int a = static_cast<unsigned int>(edges[i] >> 32), b = static_cast<unsigned int>(edges[i]);
+            if (end - i == 1) {
+                borders.push_back(edges[i]);
+                ++numBorderEdges[a];
+                ++numBorderEdges[b];
+            }
+            else if (end - i > 2) {
+                mKind[a] = mKind[b] = Kind_Locked;
+            }
+            i = end;
+        }
+
+        // points on a single border loop may slide along it, corners of
+        // several borders stay in place
+        for (unsigned int p = 0; p < numPoints; ++p) {
+            if (mKind[p] != Kind_Locked && numBorderEdges[p]) {
+                mKind[p] = numBorderEdges[p] == 2 ? Kind_Border : Kind_Locked;
+            }
+        }
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Accumulates the area weighted planes of all triangles at their points.
+    // Border edges get an additional plane perpendicular to the triangle.
+    void Simplifier::SetupQuadrics(const std::vector<uint64_t>& borders) {
+        mQuadrics.resize(mPoints.size());
+
+        for (unsigned int t = 0; t < NumTriangles(); ++t) {
+            unsigned int p[3];
+            Vec3d v[3];
+            for (unsigned int k = 0; k < 3; ++k) {
+                p[k] = mPointOfVertex[mCorners[3 * t + k]];
+                v[k] = ToDouble(mPoints[p[k]]);
+            }
+
+            Vec3d n = (v[1] - v[0]) ^ (v[2] - v[0]);
+            const double length = n.Length();
+            if (length <= 0.0) {
+                continue;
+            }
+            n /= length;
+            const double d = -(n * v[0]);
+            for (unsigned int k = 0; k < 3; ++k) {
+                mQuadrics[p[k]].AddPlane(n, d, 0.5 * length);
+            }
+
+            for (unsigned int k = 0; k < 3 && !borders.empty(); ++k) {
+                const unsigned int a = p[k], b = p[(k + 1) % 3];
+                if (!std::binary_search(borders.begin(), borders.end(), EdgeKey(a, b))) {
+                    continue;
+                }
+                const Vec3d e = v[(k + 1) % 3] - v[k];
+                Vec3d m = e ^ n;
+                const double len = m.Length();
+                if (len <= 0.0) {
+                    continue;
+                }
+                m /= len;
+                const double weight = BorderWeight * (e * e);
+                mQuadrics[a].AddPlane(m, -(m * v[k]), weight);
+                mQuadrics[b].AddPlane(m, -(m * v[k]), weight);
+            }
+        }
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Gathers the bone weights of every vertex
+    void Simplifier::SetupBoneWeights() {
+        if (!mMesh->HasBones()) {
+            return;
+        }
+        const unsigned int numVertices = mMesh->mNumVertices;
+        mBoneOffsets.assign(numVertices + 1, 0);
+        for (unsigned int b = 0; b < mMesh->mNumBones; ++b) {
+            const aiBone* bone = mMesh->mBones[b];
+            for (unsigned int i = 0; i < bone->mNumWeights; ++i) {
+                ++mBoneOffsets[bone->mWeights[i].mVertexId + 1];
+            }
+        }
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            mBoneOffsets[i + 1] += mBoneOffsets[i];
+        }
+
+        mBoneWeights.resize(mBoneOffsets[numVertices]);
+        std::vector<unsigned int> cursor(mBoneOffsets.begin(), mBoneOffsets.end() - 1);
+        for (unsigned int b = 0; b < mMesh->mNumBones; ++b) {
+            const aiBone* bone = mMesh->mBones[b];
+            for (unsigned int i = 0; i < bone->mNumWeights; ++i) {
+                const aiVertexWeight& w = bone->mWeights[i];
+                mBoneWeights[cursor[w.mVertexId]++] = std::make_pair(b, w.mWeight);
+            }
+        }
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Sum of the absolute bone weight differences of two vertices
+    float Simplifier::BoneWeightDelta(unsigned int a, unsigned int b) const {
+        float delta = 0.f;
+        unsigned int i = mBoneOffsets[a], j = mBoneOffsets[b];
+        const unsigned int endA = mBoneOffsets[a + 1], endB = mBoneOffsets[b + 1];
+        while (i < endA || j < endB) {
+            if (j == endB || (i < endA && mBoneWeights[i].first < mBoneWeights[j].first)) {
+                delta += std::fabs(mBoneWeights[i++].second);
+            }
+            else if (i == endA || mBoneWeights[j].first < mBoneWeights[i].first) {
+                delta += std::fabs(mBoneWeights[j++].second);
+            }
+            else {
+                delta += std::fabs(mBoneWeights[i++].second - mBoneWeights[j++].second);
+            }
+        }
+        return delta;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Collects the triangles around every point
+    void Simplifier::BuildAdjacency() {
+        const unsigned int numPoints = static_cast<unsigned int>(mPoints.size());
+        mAdjOffsets.assign(numPoints + 1, 0);
+        for (unsigned int i = 0; i < mCorners.size(); ++i) {
+            ++mAdjOffsets[mPointOfVertex[mCorners[i]] + 1];
+        }
+        for (unsigned int p = 0; p < numPoints; ++p) {
+            mAdjOffsets[p + 1] += mAdjOffsets[p];
+        }
+
+        mAdjTriangles.resize(mCorners.size());
+        std::vector<unsigned int> cursor(mAdjOffsets.begin(), mAdjOffsets.end() - 1);
+        for (unsigned int i = 0; i < mCorners.size(); ++i) {
+            mAdjTriangles[cursor[mPointOfVertex[mCorners[i]]]++] = i / 3;
+        }
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Checks whether the kinds of the points allow collapsing u onto v
+    bool Simplifier::CanCollapse(unsigned int u, unsigned int v) const {
+        if (mKind[u] == Kind_Locked) {
+            return false;
+        }
+        if (mKind[u] == Kind_Border) {
+            // only along the border, i.e. the edge has a single triangle
+            unsigned int shared = 0;
+            for (unsigned int i = mAdjOffsets[u]; i < mAdjOffsets[u + 1]; ++i) {
+                const unsigned int* c = &mCorners[3 * mAdjTriangles[i]];
+                for (unsigned int k = 0; k < 3; ++k) {
+                    if (mPointOfVertex[c[k]] == v) {
+                        ++shared;
+                    }
+                }
+            }
+            return shared == 1;
+        }
+        return true;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Checks that collapsing u onto v flips no triangle and keeps the topology,
+    // given the collapses already done in this pass and the remaining number of
+    // triangles. Returns the number of triangles removed by the collapse and
+    // the vertex of v on the collapsed edge.
+    bool Simplifier::CheckCollapse(unsigned int u, unsigned int v, unsigned int numTriangles,
+        unsigned int& removed, unsigned int& vertexV) {
+        removed = 0;
+        vertexV = Unused;
+        mNeighbors.clear();
+        mOpposite.clear();
+
+        const aiVector3D& pu = mPoints[u];
+        const aiVector3D& pv = mPoints[v];
+        for (unsigned int i = mAdjOffsets[u]; i < mAdjOffsets[u + 1]; ++i) {
+            const unsigned int t = mAdjTriangles[i];
+            unsigned int p[3];
+            for (unsigned int k = 0; k < 3; ++k) {
+                p[k] = mPointRemap[mPointOfVertex[mCorners[3 * t + k]]];
+            }
+            if (p[0] == p[1] || p[1] == p[2] || p[0] == p[2]) {
+                // already removed by another collapse
+                continue;
+            }
+
+            const unsigned int k = p[0] == u ? 0 : (p[1] == u ? 1 : 2);
+            const unsigned int a = p[(k + 1) % 3], b = p[(k + 2) % 3];
+            if (a == v || b == v) {
+                ++removed;
+                mOpposite.push_back(a == v ? b : a);
+                if (vertexV == Unused) {
+                    vertexV = mCorners[3 * t + (a == v ? (k + 1) % 3 : (k + 2) % 3)];
+                }
+                continue;
+            }
+
+            const aiVector3D& pa = mPoints[a];
+            const aiVector3D& pb = mPoints[b];
+            const aiVector3D n0 = (pa - pu) ^ (pb - pu);
+            const aiVector3D n1 = (pa - pv) ^ (pb - pv);
+            if (n0 * n1 <= 0.f && n0.SquareLength() > 0.f) {
+                return false;
+            }
+            mNeighbors.push_back(a);
+            mNeighbors.push_back(b);
+        }
+        if (!removed || removed >= numTriangles) {
+            return false;
+        }
+
+        // link condition: the only points adjacent to both u and v are the
+        // ones opposite of the collapsed edge, otherwise the surface folds
+        for (unsigned int i = mAdjOffsets[v]; i < mAdjOffsets[v + 1]; ++i) {
+            const unsigned int t = mAdjTriangles[i];
+            for (unsigned int k = 0; k < 3; ++k) {
+                const unsigned int p = mPointRemap[mPointOfVertex[mCorners[3 * t + k]]];
+                if (p != u && p != v && std::find(mNeighbors.begin(), mNeighbors.end(), p) != mNeighbors.end() &&
+                    std::find(mOpposite.begin(), mOpposite.end(), p) == mOpposite.end()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Collapses edges in passes. Every pass evaluates all edges, sorts them by
+    // their error and collapses them in that order, touching each point at most once.
+    double Simplifier::Run() {
+        const unsigned int numPoints = static_cast<unsigned int>(mPoints.size());
+        mPointRemap.resize(numPoints);
+        for (unsigned int p = 0; p < numPoints; ++p) {
+            mPointRemap[p] = p;
+        }
+        std::vector<unsigned int> vertexRemap(mMesh->mNumVertices);
+        for (unsigned int i = 0; i < vertexRemap.size(); ++i) {
+            vertexRemap[i] = i;
+        }
+
+        double maxError = 0.0;
+        std::vector<uint64_t> edges;
+        std::vector<Collapse> collapses;
+        std::vector<unsigned char> touched(numPoints);
+
+        while (NumTriangles() > mTargetFaces) {
+            BuildAdjacency();
+
+            edges.clear();
+            for (unsigned int t = 0; t < NumTriangles(); ++t) {
+                for (unsigned int k = 0; k < 3; ++k) {
+                    edges.push_back(EdgeKey(mPointOfVertex[mCorners[3 * t + k]], mPointOfVertex[mCorners[3 * t + (k + 1) % 3]]));
+                }
+            }
+            StableRadixSort(edges, [](uint64_t e) { return e; });
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            // pick the cheaper direction of every edge
+            collapses.clear();
+            for (size_t i = 0; i < edges.size(); ++i) {
+                const unsigned int a = static_cast<unsigned int>(edges[i] >> 32), b = static_cast<unsigned int>(edges[i]);
+                Collapse c;
+                c.error = std::numeric_limits<double>::max();
+                if (CanCollapse(a, b)) {
+                    c.u = a;
+                    c.v = b;
+                    c.error = CombinedError(mQuadrics[a], mQuadrics[b], mPoints[b]);
+                }
+                if (CanCollapse(b, a)) {
+                    const double error = CombinedError(mQuadrics[a], mQuadrics[b], mPoints[a]);
+                    if (error < c.error) {
+                        c.u = b;
+                        c.v = a;
+                        c.error = error;
+                    }
+                }
+                if (c.error <= mMaxErrorSq) {
+                    collapses.push_back(c);
+                }
+            }
+            StableRadixSort(collapses, [](const Collapse& c) { return c.error; });
+
+            std::fill(touched.begin(), touched.end(), 0);
+            unsigned int numTriangles = NumTriangles(), numCollapsed = 0;
+            for (size_t i = 0; i < collapses.size() && numTriangles > mTargetFaces; ++i) {
+                const Collapse& c = collapses[i];
+                if (touched[c.u] || touched[c.v]) {
+                    continue;
+                }
+
+                unsigned int removed, vertexV;
+                if (!CheckCollapse(c.u, c.v, numTriangles, removed, vertexV)) {
+                    continue;
+                }
+                const unsigned int vertexU = mVertexOfPoint[c.u];
+                if (!mBoneOffsets.empty() && BoneWeightDelta(vertexU, vertexV) > MaxBoneWeightDelta) {
+                    continue;
+                }
+
+                mPointRemap[c.u] = c.v;
+                vertexRemap[vertexU] = vertexV;
+                mQuadrics[c.v] += mQuadrics[c.u];
+                touched[c.u] = touched[c.v] = 1;
+                numTriangles -= removed;
+                maxError = std::max(maxError, c.error);
+                ++numCollapsed;
+            }
+            if (!numCollapsed) {
+                break;
+            }
+
+            // move the corners to the remaining vertices and drop the collapsed triangles
+            size_t out = 0;
+            for (size_t i = 0; i < mCorners.size(); i += 3) {
+                const unsigned int v0 = vertexRemap[mCorners[i]], v1 = vertexRemap[mCorners[i + 1]], v2 = vertexRemap[mCorners[i + 2]];
+                const unsigned int p0 = mPointOfVertex[v0], p1 = mPointOfVertex[v1], p2 = mPointOfVertex[v2];
+                if (p0 == p1 || p1 == p2 || p0 == p2) {
+                    continue;
+                }
+                mCorners[out++] = v0;
+                mCorners[out++] = v1;
+                mCorners[out++] = v2;
+            }
+            mCorners.resize(out);
+        }
+        return maxError;
+    }
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+SimplifyProcess::SimplifyProcess()
+: mTargetRatio(PP_SIMPLIFY_TARGET_RATIO)
+, mMaxError(PP_SIMPLIFY_MAX_ERROR)
+, mLodLevels(0)
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+SimplifyProcess::~SimplifyProcess()
+{
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool SimplifyProcess::IsActive( unsigned int pFlags) const
+{
+    return (pFlags & aiProcess_Simplify) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void SimplifyProcess::SetupProperties(const Importer* pImp)
+{
+    SetParameters(pImp->GetPropertyFloat(AI_CONFIG_PP_SIMPLIFY_TARGET_RATIO,PP_SIMPLIFY_TARGET_RATIO),
+        pImp->GetPropertyFloat(AI_CONFIG_PP_SIMPLIFY_MAX_ERROR,PP_SIMPLIFY_MAX_ERROR),
+        pImp->GetPropertyInteger(AI_CONFIG_PP_SIMPLIFY_LOD_LEVELS,0));
+}
+
+// ------------------------------------------------------------------------------------------------
+void SimplifyProcess::SetParameters(float targetRatio, float maxError, unsigned int lodLevels)
+{
+    mTargetRatio = std::min(std::max(targetRatio, 0.f), 1.f);
+    mMaxError = std::max(maxError, 0.f);
+    mLodLevels = std::min(lodLevels, MaxLodLevels);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void SimplifyProcess::Execute( aiScene* pScene)
+{
+    DefaultLogger::get()->debug("SimplifyProcess begin");
+
+    unsigned int numMeshes = 0, facesIn = 0, facesOut = 0;
+    float maxError = 0.f, error;
+    if (!mLodLevels) {
+        for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+            aiMesh* mesh = pScene->mMeshes[a];
+            const unsigned int numFaces = mesh->mNumFaces;
+            if (SimplifyMesh(mesh, TargetFaces(numFaces, mTargetRatio), mMaxError, &error)) {
+                ++numMeshes;
+                facesIn += numFaces;
+                facesOut += mesh->mNumFaces;
+                maxError = std::max(maxError, error);
+            }
+        }
+    }
+    else {
+        // every level is built from the previous one and appended to the mesh list
+        std::vector<aiMesh*> meshes(pScene->mMeshes, pScene->mMeshes + pScene->mNumMeshes);
+        std::vector< std::vector<unsigned int> > lods(pScene->mNumMeshes);
+        for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+            const aiMesh* prev = pScene->mMeshes[a];
+            double ratio = 1.0;
+            for (unsigned int k = 0; k < mLodLevels; ++k) {
+                ratio *= mTargetRatio;
+
+                aiMesh* lod;
+                SceneCombiner::Copy(&lod, prev);
+                if (!SimplifyMesh(lod, TargetFaces(pScene->mMeshes[a]->mNumFaces, ratio), mMaxError, &error) ||
+                    lod->mNumFaces == prev->mNumFaces) {
+                    delete lod;
+                    break;
+                }
+                ++numMeshes;
+                facesIn += prev->mNumFaces;
+                facesOut += lod->mNumFaces;
+                maxError = std::max(maxError, error);
+
+                lods[a].push_back(static_cast<unsigned int>(meshes.size()));
+                meshes.push_back(lod);
+                prev = lod;
+            }
+        }
+
+        if (meshes.size() > pScene->mNumMeshes) {
+            delete[] pScene->mMeshes;
+            pScene->mNumMeshes = static_cast<unsigned int>(meshes.size());
+            pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
+            std::copy(meshes.begin(), meshes.end(), pScene->mMeshes);
+
+            AddLodMetaData(pScene->mRootNode, lods);
+        }
+    }
+
+    if (!DefaultLogger::isNullLogger()) {
+        if (numMeshes) {
+            char szBuff[256];
+            ai_snprintf(szBuff, 256, "SimplifyProcess finished. Reduced %u meshes from %u to %u faces, "
+                "largest error %f", numMeshes, facesIn, facesOut, maxError);
+            DefaultLogger::get()->info(szBuff);
+        }
+        else {
+            DefaultLogger::get()->debug("SimplifyProcess finished. There are no triangle meshes");
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Simplifies a single mesh
+bool SimplifyProcess::SimplifyMesh( aiMesh* pMesh, unsigned int targetFaces, float maxError, float* pOutError)
+{
+    ai_assert(NULL != pMesh);
+
+    if (pOutError) {
+        *pOutError = 0.f;
+    }
+    if (!pMesh->HasFaces() || !pMesh->HasPositions()) {
+        return false;
+    }
+    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        DefaultLogger::get()->debug("SimplifyProcess: skipping mesh with non-triangle primitives");
+        return false;
+    }
+    if (pMesh->mNumFaces <= targetFaces) {
+        return true;
+    }
+
+    // the error limit is relative to the size of the mesh
+    aiVector3D min = pMesh->mVertices[0], max = pMesh->mVertices[0];
+    for (unsigned int i = 1; i < pMesh->mNumVertices; ++i) {
+        const aiVector3D& v = pMesh->mVertices[i];
+        min.x = std::min(min.x, v.x);
+        min.y = std::min(min.y, v.y);
+        min.z = std::min(min.z, v.z);
+        max.x = std::max(max.x, v.x);
+        max.y = std::max(max.y, v.y);
+        max.z = std::max(max.z, v.z);
+    }
+    const double diagonal = (max - min).Length();
+    const double limit = maxError * diagonal;
+
+    Simplifier simplifier(pMesh, targetFaces, limit * limit);
+    const double error = std::sqrt(simplifier.Run());
+    if (pOutError && diagonal > 0.0) {
+        *pOutError = static_cast<float>(error / diagonal);
+    }
+
+    const std::vector<unsigned int>& corners = simplifier.Corners();
+    const unsigned int numFaces = static_cast<unsigned int>(corners.size() / 3);
+
+    // meshlets and the bounding volume hierarchy refer to the old faces,
+    // the quantized streams to the old vertices
+    delete[] pMesh->mMeshlets;
+    delete[] pMesh->mMeshletVertices;
+    pMesh->mMeshlets = NULL;
+    pMesh->mMeshletVertices = NULL;
+    pMesh->mNumMeshlets = pMesh->mNumMeshletVertices = 0;
+
+    delete[] pMesh->mBVHNodes;
+    delete[] pMesh->mBVHFaces;
+    pMesh->mBVHNodes = NULL;
+    pMesh->mBVHFaces = NULL;
+    pMesh->mNumBVHNodes = 0;
+
+    delete pMesh->mQuantizedVertices;
+    pMesh->mQuantizedVertices = NULL;
+
+    // drop unreferenced vertices, keeping the order of the others
+    const unsigned int numVertices = pMesh->mNumVertices;
+    std::vector<unsigned int> newIndex(numVertices, Unused);
+    for (unsigned int i = 0; i < corners.size(); ++i) {
+        newIndex[corners[i]] = 0;
+    }
+    unsigned int numUsed = 0;
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        if (newIndex[i] != Unused) {
+            newIndex[i] = numUsed++;
+        }
+    }
+
+    // reuse the index arrays of the first faces
+    aiFace* faces = new aiFace[numFaces];
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        aiFace& face = faces[i];
+        face.mNumIndices = 3;
+        face.mIndices = pMesh->mFaces[i].mIndices;
+        pMesh->mFaces[i].mIndices = NULL;
+        for (unsigned int k = 0; k < 3; ++k) {
+            face.mIndices[k] = newIndex[corners[3 * i + k]];
+        }
+    }
+    delete[] pMesh->mFaces;
+    pMesh->mFaces = faces;
+    pMesh->mNumFaces = numFaces;
+
+    if (numUsed == numVertices) {
+        return true;
+    }
+
+    CompactStream(pMesh->mVertices, newIndex, numUsed);
+    CompactStream(pMesh->mNormals, newIndex, numUsed);
+    CompactStream(pMesh->mTangents, newIndex, numUsed);
+    CompactStream(pMesh->mBitangents, newIndex, numUsed);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        CompactStream(pMesh->mColors[i], newIndex, numUsed);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        CompactStream(pMesh->mTextureCoords[i], newIndex, numUsed);
+    }
+    pMesh->mNumVertices = numUsed;
+
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+        aiAnimMesh* anim = pMesh->mAnimMeshes[a];
+        if (anim->mNumVertices != numVertices) {
+            continue;
+        }
+        CompactStream(anim->mVertices, newIndex, numUsed);
+        CompactStream(anim->mNormals, newIndex, numUsed);
+        CompactStream(anim->mTangents, newIndex, numUsed);
+        CompactStream(anim->mBitangents, newIndex, numUsed);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            CompactStream(anim->mColors[i], newIndex, numUsed);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            CompactStream(anim->mTextureCoords[i], newIndex, numUsed);
+        }
+        anim->mNumVertices = numUsed;
+    }
+
+    // remap the bone weights, bones without weights are removed
+    unsigned int numBones = 0;
+    for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+        aiBone* bone = pMesh->mBones[a];
+        unsigned int numWeights = 0;
+        for (unsigned int i = 0; i < bone->mNumWeights; ++i) {
+            const aiVertexWeight& w = bone->mWeights[i];
+            if (newIndex[w.mVertexId] != Unused) {
+                bone->mWeights[numWeights++] = aiVertexWeight(newIndex[w.mVertexId], w.mWeight);
+            }
+        }
+        bone->mNumWeights = numWeights;
+        if (numWeights) {
+            pMesh->mBones[numBones++] = bone;
+        }
+        else {
+            delete bone;
+        }
+    }
+    if (pMesh->mNumBones && !numBones) {
+        delete[] pMesh->mBones;
+        pMesh->mBones = NULL;
+    }
+    pMesh->mNumBones = numBones;
+    return true;
+}
+
+#endif // !! ASSIMP_BUILD_NO_SIMPLIFY_PROCESS
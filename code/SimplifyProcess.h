@@ -0,0 +1,119 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file SimplifyProcess.h
+ *  @brief Declares a post processing step to reduce the triangle count of meshes
+ */
+#ifndef AI_SIMPLIFYPROCESS_H_INC
+#define AI_SIMPLIFYPROCESS_H_INC
+
+#include "BaseProcess.h"
+#include <assimp/types.h>
+
+struct aiMesh;
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** The SimplifyProcess reduces the number of triangles of meshes by
+ *  collapsing edges in the order of their quadric error, see
+ *  #aiProcess_Simplify.
+ *
+ *  Vertices with the same position are treated as one point of the surface.
+ *  Points where several vertices meet (seams in the UV, normal or color
+ *  data) and non-manifold points are never moved, points on open borders
+ *  only slide along the border. Collapses which would flip a triangle or
+ *  which join vertices with differing bone weights are rejected.
+ *
+ *  @note This step expects triangulated input data with shared vertices,
+ *  i.e. #aiProcess_JoinIdenticalVertices should be enabled.
+ */
+class ASSIMP_API SimplifyProcess : public BaseProcess
+{
+public:
+
+    SimplifyProcess();
+    ~SimplifyProcess();
+
+public:
+
+    // -------------------------------------------------------------------
+    // Check whether the pp step is active
+    bool IsActive( unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    // Executes the pp step on a given scene
+    void Execute( aiScene* pScene);
+
+    // -------------------------------------------------------------------
+    // Configures the pp step
+    void SetupProperties(const Importer* pImp);
+
+    // -------------------------------------------------------------------
+    /** Set the face ratio to reduce to, the maximum error and the number
+     *  of LOD levels. The values are clamped as documented for the config
+     *  properties. */
+    void SetParameters(float targetRatio, float maxError, unsigned int lodLevels);
+
+    // -------------------------------------------------------------------
+    /** Simplifies a single mesh in place.
+     * @param pMesh The mesh to process.
+     * @param targetFaces Number of faces to reduce the mesh to.
+     * @param maxError Maximum error, relative to the diagonal of the
+     *   bounding box of the mesh.
+     * @param pOutError Receives the error of the result, relative to
+     *   the diagonal of the bounding box. Optional.
+     * @return false if the mesh was skipped
+     */
+    static bool SimplifyMesh( aiMesh* pMesh, unsigned int targetFaces,
+        float maxError, float* pOutError = NULL);
+
+private:
+    //! Configuration parameters
+    float mTargetRatio;
+    float mMaxError;
+    unsigned int mLodLevels;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_SIMPLIFYPROCESS_H_INC
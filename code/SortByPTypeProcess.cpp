@@ -211,7 +211,9 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
             }
         }
 
-        VertexWeightTable* avw = ComputeVertexBoneWeightTable(mesh);
+        // the step runs before the bone weight tables are shared, so build a local one
+        BoneWeightTable weights;
+        weights.Build(mesh);
         for (unsigned int real = 0; real < 4; ++real,++meshIdx)
         {
             if ( !aiNumPerPType[real] || configRemoveMeshes & (1u << real))
@@ -294,10 +296,9 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
                     unsigned int idx = in.mIndices[q];
 
                     // process all bones of this index
-                    if (avw)
+                    if (!weights.Empty())
                     {
-                        VertexWeightTable& tbl = avw[idx];
-                        for (VertexWeightTable::const_iterator it = tbl.begin(), end = tbl.end();
+                        for (const PerVertexWeight* it = weights.Begin(idx), *end = weights.End(idx);
                              it != end; ++it)
                         {
                             tempBones[ (*it).first ].push_back( aiVertexWeight(outIdx, (*it).second) );
@@ -364,9 +365,6 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
             }
         }
 
-        // delete the per-vertex bone weights table
-        delete[] avw;
-
         // delete the input mesh
         delete mesh;
 
@@ -43,8 +43,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /** @file Implementation of the helper class to quickly find vertices close to a given position */
 
 #include "SpatialSort.h"
+#include "ParallelFor.h"
+#include "RadixSort.h"
 #include <assimp/ai_assert.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace Assimp;
 
 // CHAR_BIT seems to be defined under MVSC, but not under GCC. Pray that the correct value is 8.
@@ -60,16 +66,22 @@ SpatialSort::SpatialSort( const aiVector3D* pPositions, unsigned int pNumPositio
     // define the reference plane. We choose some arbitrary vector away from all basic axises
     // in the hope that no model spreads all its vertices along this plane.
     : mPlaneNormal(0.8523f, 0.34321f, 0.5736f)
+    , mGridEnabled(false)
+    , mGridInvCellSize()
 {
     mPlaneNormal.Normalize();
+    mGridSize[0] = mGridSize[1] = mGridSize[2] = 0;
     Fill(pPositions,pNumPositions,pElementOffset);
 }
 
 // ------------------------------------------------------------------------------------------------
 SpatialSort :: SpatialSort()
 : mPlaneNormal(0.8523f, 0.34321f, 0.5736f)
+, mGridEnabled(false)
+, mGridInvCellSize()
 {
     mPlaneNormal.Normalize();
+    mGridSize[0] = mGridSize[1] = mGridSize[2] = 0;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -88,10 +100,196 @@ void SpatialSort::Fill( const aiVector3D* pPositions, unsigned int pNumPositions
     Append(pPositions,pNumPositions,pElementOffset,pFinalize);
 }
 
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::SetGridEnabled(bool pEnable)
+{
+    mGridEnabled = pEnable;
+}
+
 // ------------------------------------------------------------------------------------------------
 void SpatialSort :: Finalize()
 {
-    std::sort( mPositions.begin(), mPositions.end());
+    // Sort ascending by distance. Entries at the same distance keep the order they
+    // were added in, so the results don't depend on the sorting algorithm.
+    StableRadixSort(mPositions, [](const Entry& e) { return e.mDistance; });
+
+    mGridCells.clear();
+    mGridEntries.clear();
+    if (mGridEnabled) {
+        BuildGrid();
+    }
+}
+
+namespace {
+
+    // Cells of the query range above which a query falls back to scanning the sorted positions
+    const unsigned int MaxGridCellsPerQuery = 64;
+
+    // --------------------------------------------------------------------------------------------
+    inline unsigned int HashGridCell(int x, int y, int z) {
+        return (static_cast<unsigned int>(x) * 73856093u) ^ (static_cast<unsigned int>(y) * 19349663u)
+            ^ (static_cast<unsigned int>(z) * 83492791u);
+    }
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Builds a hashed uniform grid over the sorted positions, aiming at about two positions per cell
+void SpatialSort::BuildGrid()
+{
+    if (mPositions.empty()) {
+        return;
+    }
+
+    aiVector3D minVec = mPositions[0].mPosition, maxVec = minVec;
+    for (std::vector<Entry>::const_iterator it = mPositions.begin(); it != mPositions.end(); ++it) {
+        minVec.x = std::min(minVec.x, it->mPosition.x);
+        minVec.y = std::min(minVec.y, it->mPosition.y);
+        minVec.z = std::min(minVec.z, it->mPosition.z);
+        maxVec.x = std::max(maxVec.x, it->mPosition.x);
+        maxVec.y = std::max(maxVec.y, it->mPosition.y);
+        maxVec.z = std::max(maxVec.z, it->mPosition.z);
+    }
+    double extent[3] = { double(maxVec.x) - minVec.x, double(maxVec.y) - minVec.y, double(maxVec.z) - minVec.z };
+    if (!std::isfinite(extent[0] + extent[1] + extent[2])) {
+        // let queries fall back to the sorted positions
+        return;
+    }
+
+    // Pick the cell size so that the cells in the subspace spanned by the dominant axes
+    // hold two positions on average. Flat or elongated data thus doesn't end up with a
+    // single layer of huge cells.
+    double sorted[3] = { extent[0], extent[1], extent[2] };
+    std::sort(sorted, sorted + 3);
+    const double targetCells = std::max(1.0, mPositions.size() / 2.0);
+    double cellSize = 0.0;
+    for (unsigned int dims = 3; dims > 0; --dims) {
+        double volume = 1.0;
+        for (unsigned int i = 3 - dims; i < 3; ++i) {
+            volume *= sorted[i];
+        }
+        cellSize = std::pow(volume / targetCells, 1.0 / dims);
+        if (cellSize <= sorted[3 - dims]) {
+            break;
+        }
+    }
+    if (!(cellSize > 0.0)) {
+        cellSize = 1.0;
+    }
+
+    // limit the grid to 2^20 cells along each axis
+    cellSize = std::max(cellSize, std::max(sorted[2], 1e-30) / (1 << 20));
+
+    mGridOrigin = minVec;
+    mGridInvCellSize = static_cast<ai_real>(1.0 / cellSize);
+    for (unsigned int i = 0; i < 3; ++i) {
+        mGridSize[i] = static_cast<int>(std::min(extent[i] / cellSize, double(1 << 20))) + 1;
+    }
+
+    // hash all positions into their cells, counting the entries of each cell in mEnd
+    unsigned int tableSize = 16;
+    while (tableSize < mPositions.size() * 2) {
+        tableSize *= 2;
+    }
+    GridCell emptyCell = { 0, 0, 0, 0, 0 };
+    mGridCells.assign(tableSize, emptyCell);
+
+    std::vector<unsigned int> slots(mPositions.size());
+    for (size_t i = 0; i < mPositions.size(); ++i) {
+        const aiVector3D& pos = mPositions[i].mPosition;
+        const int x = GetGridCoord(pos.x, 0), y = GetGridCoord(pos.y, 1), z = GetGridCoord(pos.z, 2);
+
+        unsigned int slot = HashGridCell(x, y, z) & (tableSize - 1);
+        for (;; slot = (slot + 1) & (tableSize - 1)) {
+            GridCell& cell = mGridCells[slot];
+            if (!cell.mEnd) {
+                cell.mX = x;
+                cell.mY = y;
+                cell.mZ = z;
+                break;
+            }
+            if (cell.mX == x && cell.mY == y && cell.mZ == z) {
+                break;
+            }
+        }
+        ++mGridCells[slot].mEnd;
+        slots[i] = slot;
+    }
+
+    // turn the counts into ranges and distribute the entries, keeping their sort order
+    unsigned int offset = 0;
+    for (std::vector<GridCell>::iterator it = mGridCells.begin(); it != mGridCells.end(); ++it) {
+        it->mBegin = offset;
+        offset += it->mEnd;
+        it->mEnd = it->mBegin;
+    }
+    mGridEntries.resize(mPositions.size());
+    for (size_t i = 0; i < mPositions.size(); ++i) {
+        mGridEntries[mGridCells[slots[i]].mEnd++] = static_cast<unsigned int>(i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the grid coordinate of a value along an axis, clamped to the grid. Monotonic in the
+// value, so the cells of a range are found by looking up the coordinates of its bounds.
+int SpatialSort::GetGridCoord(ai_real pValue, unsigned int pAxis) const
+{
+    const ai_real f = std::floor((pValue - mGridOrigin[pAxis]) * mGridInvCellSize);
+    if (!(f > 0)) {
+        return 0;
+    }
+    return f < mGridSize[pAxis] ? static_cast<int>(f) : mGridSize[pAxis] - 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+const SpatialSort::GridCell* SpatialSort::FindGridCell(int pX, int pY, int pZ) const
+{
+    const unsigned int mask = static_cast<unsigned int>(mGridCells.size()) - 1;
+    for (unsigned int slot = HashGridCell(pX, pY, pZ) & mask;; slot = (slot + 1) & mask) {
+        const GridCell& cell = mGridCells[slot];
+        if (cell.mBegin == cell.mEnd) {
+            // unused slot, cells in use hold at least one entry
+            return NULL;
+        }
+        if (cell.mX == pX && cell.mY == pY && cell.mZ == pZ) {
+            return &cell;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collects the indices into mPositions of all entries in the cells overlapping the given box,
+// in ascending order. Returns false if there is no grid or the box is too large for it.
+bool SpatialSort::CollectGridEntries(const aiVector3D& pMin, const aiVector3D& pMax,
+    std::vector<unsigned int>& poEntries) const
+{
+    if (mGridCells.empty()) {
+        return false;
+    }
+
+    const int x0 = GetGridCoord(pMin.x, 0), x1 = GetGridCoord(pMax.x, 0);
+    const int y0 = GetGridCoord(pMin.y, 1), y1 = GetGridCoord(pMax.y, 1);
+    const int z0 = GetGridCoord(pMin.z, 2), z1 = GetGridCoord(pMax.z, 2);
+    if (static_cast<double>(x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1) > MaxGridCellsPerQuery) {
+        return false;
+    }
+
+    size_t numCells = 0;
+    for (int z = z0; z <= z1; ++z) {
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                if (const GridCell* cell = FindGridCell(x, y, z)) {
+                    poEntries.insert(poEntries.end(), mGridEntries.begin() + cell->mBegin,
+                        mGridEntries.begin() + cell->mEnd);
+                    ++numCells;
+                }
+            }
+        }
+    }
+    if (numCells > 1) {
+        std::sort(poEntries.begin(), poEntries.end());
+    }
+    return true;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -102,15 +300,19 @@ void SpatialSort::Append( const aiVector3D* pPositions, unsigned int pNumPositio
     // store references to all given positions along with their distance to the reference plane
     const size_t initial = mPositions.size();
     mPositions.reserve(initial + (pFinalize?pNumPositions:pNumPositions*2));
-    for( unsigned int a = 0; a < pNumPositions; a++)
-    {
+    mPositions.resize(initial + pNumPositions);
+
+    ParallelFor(0, pNumPositions, 1 << 16, [&](unsigned int first, unsigned int last) {
         const char* tempPointer = reinterpret_cast<const char*> (pPositions);
-        const aiVector3D* vec   = reinterpret_cast<const aiVector3D*> (tempPointer + a * pElementOffset);
+        for( unsigned int a = first; a < last; a++)
+        {
+            const aiVector3D* vec   = reinterpret_cast<const aiVector3D*> (tempPointer + a * pElementOffset);
 
-        // store position by index and distance
-        ai_real distance = *vec * mPlaneNormal;
-        mPositions.push_back( Entry( static_cast<unsigned int>(a+initial), *vec, distance));
-    }
+            // store position by index and distance
+            ai_real distance = *vec * mPlaneNormal;
+            mPositions[initial + a] = Entry( static_cast<unsigned int>(a+initial), *vec, distance);
+        }
+    });
 
     if (pFinalize) {
         // now sort the array ascending by distance.
@@ -137,6 +339,21 @@ void SpatialSort::FindPositions( const aiVector3D& pPosition,
     if( minDist > mPositions.back().mDistance)
         return;
 
+    // with the grid, just test the entries of the cells overlapping the search radius
+    const aiVector3D radius( pRadius, pRadius, pRadius);
+    if( CollectGridEntries( pPosition - radius, pPosition + radius, poResults)) {
+        const ai_real pSquared = pRadius*pRadius;
+        size_t numResults = 0;
+        for( size_t i = 0; i < poResults.size(); ++i) {
+            const Entry& entry = mPositions[poResults[i]];
+            if( entry.mDistance >= minDist && entry.mDistance < maxDist &&
+                (entry.mPosition - pPosition).SquareLength() < pSquared)
+                poResults[numResults++] = entry.mIndex;
+        }
+        poResults.resize( numResults);
+        return;
+    }
+
     // do a binary search for the minimal distance to start the iteration there
     unsigned int index = (unsigned int)mPositions.size() / 2;
     unsigned int binaryStepSize = (unsigned int)mPositions.size() / 4;
@@ -271,6 +488,23 @@ void SpatialSort::FindIdenticalPositions( const aiVector3D& pPosition,
     // the array which we want to avoid
     poResults.resize( 0 );
 
+    // with the grid, just test the entries of the cells overlapping the tolerance. Positions
+    // passing the 3D test below differ by less than that in each coordinate.
+    const ai_real tolerance = std::sqrt( std::numeric_limits<ai_real>::denorm_min() * 16);
+    const aiVector3D toleranceVec( tolerance, tolerance, tolerance);
+    if( CollectGridEntries( pPosition - toleranceVec, pPosition + toleranceVec, poResults)) {
+        size_t numResults = 0;
+        for( size_t i = 0; i < poResults.size(); ++i) {
+            const Entry& entry = mPositions[poResults[i]];
+            const BinFloat distBinary = ToBinary( entry.mDistance);
+            if( distBinary >= minDistBinary && distBinary < maxDistBinary &&
+                distance3DToleranceInULPs >= ToBinary( (entry.mPosition - pPosition).SquareLength()))
+                poResults[numResults++] = entry.mIndex;
+        }
+        poResults.resize( numResults);
+        return;
+    }
+
     // do a binary search for the minimal distance to start the iteration there
     unsigned int index = (unsigned int)mPositions.size() / 2;
     unsigned int binaryStepSize = (unsigned int)mPositions.size() / 4;
@@ -55,7 +55,11 @@ namespace Assimp
  * by their indices and sorts them by their distance to an arbitrary chosen plane.
  * You can then query the instance for all vertices close to a given position in an average O(log n)
  * time, with O(n) worst case complexity when all vertices lay on the plane. The plane is chosen
- * so that it avoids common planes in usual data sets. */
+ * so that it avoids common planes in usual data sets.
+ *
+ * Optionally, a hashed uniform grid can be built on top of the sorted positions (see
+ * #SetGridEnabled()). Queries then only look at the grid cells overlapping the search radius,
+ * which keeps them O(1) expected even for planar or axis-aligned data. */
 // ------------------------------------------------------------------------------------------------
 class SpatialSort
 {
@@ -104,6 +108,16 @@ public:
         bool pFinalize = true);
 
 
+    // ------------------------------------------------------------------------------------
+    /** Enables or disables the grid index, which is built by the next #Finalize().
+     *  #FindPositions() and #FindIdenticalPositions() return exactly the same results
+     *  with and without the grid, but with the grid they only need to visit the
+     *  positions in the grid cells overlapping the search radius instead of all positions
+     *  with a similar distance to the sorting plane. The grid costs about 8 bytes per
+     *  position. See #AI_CONFIG_PP_SPATIAL_SORT_GRID.
+     * @param pEnable True to build the grid. */
+    void SetGridEnabled(bool pEnable);
+
     // ------------------------------------------------------------------------------------
     /** Finalize the spatial hash data structure. This can be useful after
      *  multiple calls to #Append() with the pFinalize parameter set to false.
@@ -164,6 +178,38 @@ protected:
 
     // all positions, sorted by distance to the sorting plane
     std::vector<Entry> mPositions;
+
+    /** A cell of the grid index, stored in an open-addressing hash table.
+     *  Unused slots have mEnd == 0 */
+    struct GridCell
+    {
+        int mX, mY, mZ; ///< Integer cell coordinates
+        unsigned int mBegin, mEnd; ///< Range of the cell's entries in mGridEntries
+    };
+
+    /** Whether #Finalize() builds the grid index */
+    bool mGridEnabled;
+
+    /** Grid origin and size of the cells, as reciprocal */
+    aiVector3D mGridOrigin;
+    ai_real mGridInvCellSize;
+
+    /** Number of cells along each axis */
+    int mGridSize[3];
+
+    /** Hash table of all non-empty cells, its size is a power of two.
+     *  Empty if there is no grid. */
+    std::vector<GridCell> mGridCells;
+
+    /** Indices into mPositions, grouped by cell and ascending within each cell */
+    std::vector<unsigned int> mGridEntries;
+
+private:
+    void BuildGrid();
+    int GetGridCoord(ai_real pValue, unsigned int pAxis) const;
+    const GridCell* FindGridCell(int pX, int pY, int pZ) const;
+    bool CollectGridEntries(const aiVector3D& pMin, const aiVector3D& pMax,
+        std::vector<unsigned int>& poEntries) const;
 };
 
 } // end of namespace Assimp
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers of the post-processing framework
 #include "SplitByBoneCountProcess.h"
+#include "ProcessHelper.h"
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 
@@ -126,6 +127,8 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
             }
 
             // and destroy the source mesh. It should be completely contained inside the new submeshes
+            if (BoneWeightTableCache* cache = GetBoneWeightTableCache(shared))
+                cache->Remove(srcMesh);
             delete srcMesh;
         }
         else
@@ -156,16 +159,11 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
     if( pMesh->mNumBones <= mMaxBoneCount )
         return;
 
-    // necessary optimisation: build a list of all affecting bones for each vertex
-    // TODO: (thom) maybe add a custom allocator here to avoid allocating tens of thousands of small arrays
-    typedef std::pair<unsigned int, float> BoneWeight;
-    std::vector< std::vector<BoneWeight> > vertexBones( pMesh->mNumVertices);
-    for( unsigned int a = 0; a < pMesh->mNumBones; ++a)
-    {
-        const aiBone* bone = pMesh->mBones[a];
-        for( unsigned int b = 0; b < bone->mNumWeights; ++b)
-            vertexBones[ bone->mWeights[b].mVertexId ].push_back( BoneWeight( a, bone->mWeights[b].mWeight));
-    }
+    // necessary optimisation: get the list of all affecting bones for each vertex,
+    // shared with the other bone steps if possible
+    BoneWeightTableCache* cache = GetBoneWeightTableCache(shared);
+    BoneWeightTable localTable;
+    const BoneWeightTable& vertexBones = GetBoneWeightTable( cache, pMesh, localTable);
 
     unsigned int numFacesHandled = 0;
     std::vector<bool> isFaceHandled( pMesh->mNumFaces, false);
@@ -194,10 +192,9 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
             // check every vertex if its bones would still fit into the current submesh
             for( unsigned int b = 0; b < face.mNumIndices; ++b )
             {
-                const std::vector<BoneWeight>& vb = vertexBones[face.mIndices[b]];
-                for( unsigned int c = 0; c < vb.size(); ++c)
+                for( const PerVertexWeight* vb = vertexBones.Begin( face.mIndices[b]), *end = vertexBones.End( face.mIndices[b]); vb != end; ++vb)
                 {
-                    unsigned int boneIndex = vb[c].first;
+                    unsigned int boneIndex = vb->first;
                     // if the bone is already used in this submesh, it's ok
                     if( isBoneUsed[boneIndex] )
                         continue;
@@ -329,21 +326,16 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
 
         ai_assert( newMesh->mNumBones == numBones );
 
-        // iterate over all new vertices and count which bones affected its old vertex in the source mesh
-        for( unsigned int a = 0; a < numSubMeshVertices; ++a )
-        {
-            unsigned int oldIndex = previousVertexIndices[a];
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[oldIndex];
+        // gather the weights of the new vertices, remapped to the new bone indices. All of the
+        // bones affecting them should be present in the new submesh, or else the faces they
+        // comprise shouldn't be present
+        BoneWeightTable* subTable = new BoneWeightTable;
+        subTable->Gather( vertexBones, previousVertexIndices.data(), numSubMeshVertices, mappedBoneIndex.data());
 
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b )
-            {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
-                if( newBoneIndex != std::numeric_limits<unsigned int>::max() )
-                    newMesh->mBones[newBoneIndex]->mNumWeights++;
-            }
-        }
+        // count the weights per bone and allocate all bone weight arrays accordingly
+        for( std::vector<PerVertexWeight>::const_iterator it = subTable->mEntries.begin(); it != subTable->mEntries.end(); ++it )
+            newMesh->mBones[it->first]->mNumWeights++;
 
-        // allocate all bone weight arrays accordingly
         for( unsigned int a = 0; a < newMesh->mNumBones; ++a )
         {
             aiBone* bone = newMesh->mBones[a];
@@ -355,24 +347,21 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
         // now copy all the bone vertex weights for all the vertices which made it into the new submesh
         for( unsigned int a = 0; a < numSubMeshVertices; ++a)
         {
-            // find the source vertex for it in the source mesh
-            unsigned int previousIndex = previousVertexIndices[a];
-            // these bones were affecting it
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[previousIndex];
-            // all of the bones affecting it should be present in the new submesh, or else
-            // the face it comprises shouldn't be present
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b)
+            for( const PerVertexWeight* it = subTable->Begin( a), *end = subTable->End( a); it != end; ++it)
             {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
-                ai_assert( newBoneIndex != std::numeric_limits<unsigned int>::max() );
-                aiVertexWeight* dstWeight = newMesh->mBones[newBoneIndex]->mWeights + newMesh->mBones[newBoneIndex]->mNumWeights;
-                newMesh->mBones[newBoneIndex]->mNumWeights++;
-
+                aiBone* bone = newMesh->mBones[it->first];
+                aiVertexWeight* dstWeight = bone->mWeights + bone->mNumWeights++;
                 dstWeight->mVertexId = a;
-                dstWeight->mWeight = bonesOnThisVertex[b].second;
+                dstWeight->mWeight = it->second;
             }
         }
 
+        // the sub table is exactly what the following bone steps need for the new mesh
+        if( cache )
+            cache->Set( newMesh, subTable);
+        else
+            delete subTable;
+
         // I have the strange feeling that this will break apart at some point in time...
     }
 }
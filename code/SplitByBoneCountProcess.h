@@ -60,7 +60,7 @@ namespace Assimp
  * Applied BEFORE the JoinVertices-Step occurs.
  * Returns NON-UNIQUE vertices, splits by bone count.
 */
-class SplitByBoneCountProcess : public BaseProcess
+class ASSIMP_API SplitByBoneCountProcess : public BaseProcess
 {
 public:
 
@@ -48,9 +48,143 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers of the post-processing framework
 #include "SplitLargeMeshes.h"
 #include "ProcessHelper.h"
+#include "ParallelFor.h"
 
 using namespace Assimp;
 
+namespace {
+
+// Minimum number of faces or vertices a worker copies in one go
+const unsigned int SplitChunkSize = 4096;
+
+// ------------------------------------------------------------------------------------------------
+unsigned int GetPrimitiveType(unsigned int iNumIndices)
+{
+    switch (iNumIndices)
+    {
+    case 1:
+        return aiPrimitiveType_POINT;
+    case 2:
+        return aiPrimitiveType_LINE;
+    case 3:
+        return aiPrimitiveType_TRIANGLE;
+    default:
+        return aiPrimitiveType_POLYGON;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Allocate the same set of vertex streams in pcOut as present in pcIn
+void AllocateStreams(const aiMesh* pcIn, aiMesh* pcOut, unsigned int iNumVertices)
+{
+    pcOut->mNumVertices = iNumVertices;
+    if (pcIn->HasPositions()) {
+        pcOut->mVertices = new aiVector3D[iNumVertices];
+    }
+    if (pcIn->HasNormals()) {
+        pcOut->mNormals = new aiVector3D[iNumVertices];
+    }
+    if (pcIn->HasTangentsAndBitangents()) {
+        pcOut->mTangents = new aiVector3D[iNumVertices];
+        pcOut->mBitangents = new aiVector3D[iNumVertices];
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c) {
+        pcOut->mNumUVComponents[c] = pcIn->mNumUVComponents[c];
+        if (pcIn->HasTextureCoords(c)) {
+            pcOut->mTextureCoords[c] = new aiVector3D[iNumVertices];
+        }
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS;++c) {
+        if (pcIn->HasVertexColors(c)) {
+            pcOut->mColors[c] = new aiColor4D[iNumVertices];
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void GatherStream(const T* pIn, T* pOut, const unsigned int* piSource, unsigned int iNumVertices)
+{
+    if (!pIn) {
+        return;
+    }
+    ParallelFor(0,iNumVertices,SplitChunkSize,[=](unsigned int first, unsigned int last) {
+        for (unsigned int v = first; v < last;++v) {
+            pOut[v] = pIn[piSource[v]];
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copy all vertex streams, vertex i of pcOut is vertex piSource[i] of pcIn
+void GatherVertices(const aiMesh* pcIn, aiMesh* pcOut, const unsigned int* piSource)
+{
+    const unsigned int iNum = pcOut->mNumVertices;
+    GatherStream(pcIn->mVertices,pcOut->mVertices,piSource,iNum);
+    GatherStream(pcIn->mNormals,pcOut->mNormals,piSource,iNum);
+    GatherStream(pcIn->mTangents,pcOut->mTangents,piSource,iNum);
+    GatherStream(pcIn->mBitangents,pcOut->mBitangents,piSource,iNum);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c) {
+        GatherStream(pcIn->mTextureCoords[c],pcOut->mTextureCoords[c],piSource,iNum);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS;++c) {
+        GatherStream(pcIn->mColors[c],pcOut->mColors[c],piSource,iNum);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Build the bones of pcOut from the weight table of pcIn, vertex i of pcOut
+// is vertex piSource[i] of pcIn. The weights are counted first so every
+// output bone gets an exactly sized array, bones without any weights in this
+// submesh are dropped. Returns the weight table of pcOut.
+BoneWeightTable* GatherBones(const aiMesh* pcIn, aiMesh* pcOut, const BoneWeightTable& table,
+    const unsigned int* piSource)
+{
+    std::vector<unsigned int> aiRemap(pcIn->mNumBones,0);
+    for (unsigned int v = 0; v < pcOut->mNumVertices;++v) {
+        for (const PerVertexWeight* it = table.Begin(piSource[v]), *end = table.End(piSource[v]); it != end;++it) {
+            ++aiRemap[it->first];
+        }
+    }
+
+    // bone counts are turned into the new bone indices as we go
+    std::vector<aiBone*> apcBones;
+    for (unsigned int k = 0; k < pcIn->mNumBones;++k) {
+        if (!aiRemap[k]) {
+            aiRemap[k] = UINT_MAX;
+            continue;
+        }
+        const aiBone* pcOldBone = pcIn->mBones[k];
+        aiBone* pc = new aiBone();
+        pc->mName = pcOldBone->mName;
+        pc->mOffsetMatrix = pcOldBone->mOffsetMatrix;
+        pc->mWeights = new aiVertexWeight[aiRemap[k]];
+
+        aiRemap[k] = (unsigned int)apcBones.size();
+        apcBones.push_back(pc);
+    }
+
+    BoneWeightTable* pcTable = new BoneWeightTable();
+    pcTable->Gather(table,piSource,pcOut->mNumVertices,aiRemap.data());
+    if (apcBones.empty()) {
+        return pcTable;
+    }
+    pcOut->mNumBones = (unsigned int)apcBones.size();
+    pcOut->mBones = new aiBone*[pcOut->mNumBones];
+    std::copy(apcBones.begin(),apcBones.end(),pcOut->mBones);
+
+    // mNumWeights doubles as fill cursor
+    for (unsigned int v = 0; v < pcOut->mNumVertices;++v) {
+        for (const PerVertexWeight* it = pcTable->Begin(v), *end = pcTable->End(v); it != end;++it) {
+            aiBone* pc = pcOut->mBones[it->first];
+            pc->mWeights[pc->mNumWeights++] = aiVertexWeight(v,it->second);
+        }
+    }
+    return pcTable;
+}
+
+} // namespace
+
 
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Triangle::SplitLargeMeshesProcess_Triangle()
@@ -151,205 +285,97 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
     aiMesh* pMesh,
     std::vector<std::pair<aiMesh*, unsigned int> >& avList)
 {
-    if (pMesh->mNumFaces > SplitLargeMeshesProcess_Triangle::LIMIT)
+    if (pMesh->mNumFaces <= SplitLargeMeshesProcess_Triangle::LIMIT)
     {
-        DefaultLogger::get()->info("Mesh exceeds the triangle limit. It will be split ...");
-
-        // we need to split this mesh into sub meshes
-        // determine the size of a submesh
-        const unsigned int iSubMeshes = (pMesh->mNumFaces / LIMIT) + 1;
-
-        const unsigned int iOutFaceNum = pMesh->mNumFaces / iSubMeshes;
-        const unsigned int iOutVertexNum = iOutFaceNum * 3;
-
-        // now generate all submeshes
-        for (unsigned int i = 0; i < iSubMeshes;++i)
+        avList.push_back(std::pair<aiMesh*, unsigned int>(pMesh,a));
+        return;
+    }
+    DefaultLogger::get()->info("Mesh exceeds the triangle limit. It will be split ...");
+
+    // we need to split this mesh into sub meshes
+    // determine the size of a submesh
+    const unsigned int iSubMeshes = (pMesh->mNumFaces / LIMIT) + 1;
+    const unsigned int iOutFaceNum = pMesh->mNumFaces / iSubMeshes;
+
+    // first pass: the submesh boundaries are fixed, so all we need is a prefix
+    // sum over the face sizes. Every face corner becomes a vertex of its own.
+    std::vector<unsigned int> aiCornerOffset(pMesh->mNumFaces + 1);
+    std::vector<unsigned int> aiPrimitiveTypes(iSubMeshes,0);
+    aiCornerOffset[0] = 0;
+    for (unsigned int i = 0, p = 0; i < iSubMeshes;++i)
+    {
+        const unsigned int iEnd = (i == iSubMeshes-1 ? pMesh->mNumFaces : p + iOutFaceNum);
+        for (; p < iEnd;++p)
         {
-            aiMesh* pcMesh          = new aiMesh;
-            pcMesh->mNumFaces       = iOutFaceNum;
-            pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
-
-            // the name carries the adjacency information between the meshes
-            pcMesh->mName = pMesh->mName;
-
-            if (i == iSubMeshes-1)
-            {
-                pcMesh->mNumFaces = iOutFaceNum + (
-                    pMesh->mNumFaces - iOutFaceNum * iSubMeshes);
-            }
-            // copy the list of faces
-            pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
-
-            const unsigned int iBase = iOutFaceNum * i;
-
-            // get the total number of indices
-            unsigned int iCnt = 0;
-            for (unsigned int p = iBase; p < pcMesh->mNumFaces + iBase;++p)
-            {
-                iCnt += pMesh->mFaces[p].mNumIndices;
-            }
-            pcMesh->mNumVertices = iCnt;
-
-            // allocate storage
-            if (pMesh->mVertices != NULL)
-                pcMesh->mVertices = new aiVector3D[iCnt];
-
-            if (pMesh->HasNormals())
-                pcMesh->mNormals = new aiVector3D[iCnt];
-
-            if (pMesh->HasTangentsAndBitangents())
-            {
-                pcMesh->mTangents = new aiVector3D[iCnt];
-                pcMesh->mBitangents = new aiVector3D[iCnt];
-            }
-
-            // texture coordinates
-            for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c)
-            {
-                pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
-                if (pMesh->HasTextureCoords( c))
-                {
-                    pcMesh->mTextureCoords[c] = new aiVector3D[iCnt];
-                }
-            }
-
-            // vertex colors
-            for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c)
-            {
-                if (pMesh->HasVertexColors( c))
-                {
-                    pcMesh->mColors[c] = new aiColor4D[iCnt];
-                }
-            }
+            const unsigned int iNumIndices = pMesh->mFaces[p].mNumIndices;
+            aiCornerOffset[p+1] = aiCornerOffset[p] + iNumIndices;
+            aiPrimitiveTypes[i] |= GetPrimitiveType(iNumIndices);
+        }
+    }
 
-            if (pMesh->HasBones())
-            {
-                // assume the number of bones won't change in most cases
-                pcMesh->mBones = new aiBone*[pMesh->mNumBones];
+    // output corner -> source vertex
+    std::vector<unsigned int> aiSource(aiCornerOffset.back());
+    ParallelFor(0,pMesh->mNumFaces,SplitChunkSize,[&](unsigned int first, unsigned int last) {
+        for (unsigned int p = first; p < last;++p) {
+            const aiFace& face = pMesh->mFaces[p];
+            ::memcpy(aiSource.data() + aiCornerOffset[p],face.mIndices,face.mNumIndices*sizeof(unsigned int));
+        }
+    });
 
-                // iterate through all bones of the mesh and find those which
-                // need to be copied to the split mesh
-                std::vector<aiVertexWeight> avTempWeights;
-                for (unsigned int p = 0; p < pcMesh->mNumBones;++p)
-                {
-                    aiBone* const bone = pcMesh->mBones[p];
-                    avTempWeights.clear();
-                    avTempWeights.reserve(bone->mNumWeights / iSubMeshes);
-
-                    for (unsigned int q = 0; q < bone->mNumWeights;++q)
-                    {
-                        aiVertexWeight& weight = bone->mWeights[q];
-                        if(weight.mVertexId >= iBase && weight.mVertexId < iBase + iOutVertexNum)
-                        {
-                            avTempWeights.push_back(weight);
-                            weight = avTempWeights.back();
-                            weight.mVertexId -= iBase;
-                        }
-                    }
-
-                    if (!avTempWeights.empty())
-                    {
-                        // we'll need this bone. Copy it ...
-                        aiBone* pc = new aiBone();
-                        pcMesh->mBones[pcMesh->mNumBones++] = pc;
-                        pc->mName = aiString(bone->mName);
-                        pc->mNumWeights = (unsigned int)avTempWeights.size();
-                        pc->mOffsetMatrix = bone->mOffsetMatrix;
-
-                        // no need to reallocate the array for the last submesh.
-                        // Here we can reuse the (large) source array, although
-                        // we'll waste some memory
-                        if (iSubMeshes-1 == i)
-                        {
-                            pc->mWeights = bone->mWeights;
-                            bone->mWeights = NULL;
-                        }
-                        else pc->mWeights = new aiVertexWeight[pc->mNumWeights];
-
-                        // copy the weights
-                        ::memcpy(pc->mWeights,&avTempWeights[0],sizeof(aiVertexWeight)*pc->mNumWeights);
-                    }
+    // second pass: generate all submeshes
+    BoneWeightTableCache* cache = GetBoneWeightTableCache(shared);
+    BoneWeightTable localTable;
+    const BoneWeightTable& table = GetBoneWeightTable(cache,pMesh,localTable);
+    for (unsigned int i = 0; i < iSubMeshes;++i)
+    {
+        const unsigned int iBase = iOutFaceNum * i;
+
+        aiMesh* pcMesh          = new aiMesh;
+        pcMesh->mNumFaces       = (i == iSubMeshes-1 ? pMesh->mNumFaces - iBase : iOutFaceNum);
+        pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
+        pcMesh->mPrimitiveTypes = aiPrimitiveTypes[i];
+
+        // the name carries the adjacency information between the meshes
+        pcMesh->mName = pMesh->mName;
+
+        const unsigned int iFirstCorner = aiCornerOffset[iBase];
+        AllocateStreams(pMesh,pcMesh,aiCornerOffset[iBase + pcMesh->mNumFaces] - iFirstCorner);
+
+        // copy the list of faces, their indices simply enumerate the corners
+        pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+        ParallelFor(0,pcMesh->mNumFaces,SplitChunkSize,[&](unsigned int first, unsigned int last) {
+            for (unsigned int p = first; p < last;++p) {
+                aiFace& face = pcMesh->mFaces[p];
+                face.mNumIndices = pMesh->mFaces[iBase + p].mNumIndices;
+                face.mIndices = new unsigned int[face.mNumIndices];
+
+                const unsigned int iCorner = aiCornerOffset[iBase + p] - iFirstCorner;
+                for (unsigned int v = 0; v < face.mNumIndices;++v) {
+                    face.mIndices[v] = iCorner + v;
                 }
             }
-
-            // (we will also need to copy the array of indices)
-            unsigned int iCurrent = 0;
-            for (unsigned int p = 0; p < pcMesh->mNumFaces;++p)
-            {
-                pcMesh->mFaces[p].mNumIndices = 3;
-                // allocate a new array
-                const unsigned int iTemp = p + iBase;
-                const unsigned int iNumIndices = pMesh->mFaces[iTemp].mNumIndices;
-
-                // setup face type and number of indices
-                pcMesh->mFaces[p].mNumIndices = iNumIndices;
-                unsigned int* pi = pMesh->mFaces[iTemp].mIndices;
-                unsigned int* piOut = pcMesh->mFaces[p].mIndices = new unsigned int[iNumIndices];
-
-                // need to update the output primitive types
-                switch (iNumIndices)
-                {
-                case 1:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
-                    break;
-                case 2:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-                    break;
-                case 3:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-                    break;
-                default:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-                }
-
-                // and copy the contents of the old array, offset by current base
-                for (unsigned int v = 0; v < iNumIndices;++v)
-                {
-                    unsigned int iIndex = pi[v];
-                    unsigned int iIndexOut = iCurrent++;
-                    piOut[v] = iIndexOut;
-
-                    // copy positions
-                    if (pMesh->mVertices != NULL)
-                        pcMesh->mVertices[iIndexOut] = pMesh->mVertices[iIndex];
-
-                    // copy normals
-                    if (pMesh->HasNormals())
-                        pcMesh->mNormals[iIndexOut] = pMesh->mNormals[iIndex];
-
-                    // copy tangents/bitangents
-                    if (pMesh->HasTangentsAndBitangents())
-                    {
-                        pcMesh->mTangents[iIndexOut] = pMesh->mTangents[iIndex];
-                        pcMesh->mBitangents[iIndexOut] = pMesh->mBitangents[iIndex];
-                    }
-
-                    // texture coordinates
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c)
-                    {
-                        if (pMesh->HasTextureCoords( c))
-                            pcMesh->mTextureCoords[c][iIndexOut] = pMesh->mTextureCoords[c][iIndex];
-                    }
-                    // vertex colors
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c)
-                    {
-                        if (pMesh->HasVertexColors( c))
-                            pcMesh->mColors[c][iIndexOut] = pMesh->mColors[c][iIndex];
-                    }
-                }
+        });
+
+        const unsigned int* piSource = aiSource.data() + iFirstCorner;
+        GatherVertices(pMesh,pcMesh,piSource);
+        if (!table.Empty()) {
+            BoneWeightTable* pcTable = GatherBones(pMesh,pcMesh,table,piSource);
+            if (cache) {
+                cache->Set(pcMesh,pcTable);
             }
-
-            // add the newly created mesh to the list
-            avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
+            else delete pcTable;
         }
 
-        // now delete the old mesh data
-        delete pMesh;
+        // add the newly created mesh to the list
+        avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
     }
-    else avList.push_back(std::pair<aiMesh*, unsigned int>(pMesh,a));
-    return;
-}
 
+    // now delete the old mesh data
+    if (cache) {
+        cache->Remove(pMesh);
+    }
+    delete pMesh;
+}
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Vertex::SplitLargeMeshesProcess_Vertex()
 {
@@ -413,264 +439,133 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
     aiMesh* pMesh,
     std::vector<std::pair<aiMesh*, unsigned int> >& avList)
 {
-    if (pMesh->mNumVertices > SplitLargeMeshesProcess_Vertex::LIMIT)
+    if (pMesh->mNumVertices <= SplitLargeMeshesProcess_Vertex::LIMIT)
     {
-        typedef std::vector< std::pair<unsigned int,float> > VertexWeightTable;
-
-        // build a per-vertex weight list if necessary
-        VertexWeightTable* avPerVertexWeights = ComputeVertexBoneWeightTable(pMesh);
-
-        // we need to split this mesh into sub meshes
-        // determine the estimated size of a submesh
-        // (this could be too large. Max waste is a single digit percentage)
-        const unsigned int iSubMeshes = (pMesh->mNumVertices / SplitLargeMeshesProcess_Vertex::LIMIT) + 1;
-        //const unsigned int iOutVertexNum2 = pMesh->mNumVertices /iSubMeshes;
-
-        // create a std::vector<unsigned int> to indicate which vertices
-        // have already been copied
-        std::vector<unsigned int> avWasCopied;
-        avWasCopied.resize(pMesh->mNumVertices,0xFFFFFFFF);
-
-        // try to find a good estimate for the number of output faces
-        // per mesh. Add 12.5% as buffer
-        unsigned int iEstimatedSize = pMesh->mNumFaces / iSubMeshes;
-        iEstimatedSize += iEstimatedSize >> 3;
-
-        // now generate all submeshes
-        unsigned int iBase = 0;
-        while (true)
-        {
-            const unsigned int iOutVertexNum = SplitLargeMeshesProcess_Vertex::LIMIT;
+        avList.push_back(std::pair<aiMesh*, unsigned int>(pMesh,a));
+        return;
+    }
+    const unsigned int iOutVertexNum = SplitLargeMeshesProcess_Vertex::LIMIT;
 
-            aiMesh* pcMesh          = new aiMesh;
-            pcMesh->mNumVertices    = 0;
-            pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
+    std::vector<unsigned int> aiCornerOffset(pMesh->mNumFaces + 1);
+    aiCornerOffset[0] = 0;
+    for (unsigned int p = 0; p < pMesh->mNumFaces;++p) {
+        aiCornerOffset[p+1] = aiCornerOffset[p] + pMesh->mFaces[p].mNumIndices;
+    }
 
-            // the name carries the adjacency information between the meshes
-            pcMesh->mName = pMesh->mName;
+    // first pass: walk the faces and decide which submesh each of them goes
+    // to. aiLocal receives the remapped index of every face corner, aiSource
+    // the list of source vertices of each submesh, one after another.
+    std::vector<unsigned int> aiLocal(aiCornerOffset.back());
+    std::vector<unsigned int> aiSource;
+    aiSource.reserve(pMesh->mNumVertices + (pMesh->mNumVertices >> 3));
 
-            typedef std::vector<aiVertexWeight> BoneWeightList;
-            if (pMesh->HasBones())
-            {
-                pcMesh->mBones = new aiBone*[pMesh->mNumBones];
-                ::memset(pcMesh->mBones,0,sizeof(void*)*pMesh->mNumBones);
-            }
+    std::vector<unsigned int> aiFirstFace(1,0), aiFirstVertex(1,0), aiPrimitiveTypes;
 
-            // clear the temporary helper array
-            if (iBase)
-            {
-                // we can't use memset here we unsigned int needn' be 32 bits
-                for (auto &elem : avWasCopied)
-                {
-                    elem = 0xffffffff;
-                }
-            }
+    // submesh a vertex was last copied to and its index there. Tagging the
+    // entries with the submesh index saves clearing the table for each submesh.
+    std::vector<unsigned int> aiTag(pMesh->mNumVertices,0xffffffff);
+    std::vector<unsigned int> aiWasCopied(pMesh->mNumVertices);
 
-            // output vectors
-            std::vector<aiFace> vFaces;
+    unsigned int iBase = 0;
+    for (unsigned int iSubMesh = 0; true;++iSubMesh)
+    {
+        unsigned int iNumVertices = 0, iPrimitiveTypes = 0;
+        const unsigned int iFirst = iBase;
+        while (iBase < pMesh->mNumFaces)
+        {
+            const aiFace& face = pMesh->mFaces[iBase];
 
-            // reserve enough storage for most cases
-            if (pMesh->HasPositions())
-            {
-                pcMesh->mVertices = new aiVector3D[iOutVertexNum];
-            }
-            if (pMesh->HasNormals())
-            {
-                pcMesh->mNormals = new aiVector3D[iOutVertexNum];
-            }
-            if (pMesh->HasTangentsAndBitangents())
-            {
-                pcMesh->mTangents = new aiVector3D[iOutVertexNum];
-                pcMesh->mBitangents = new aiVector3D[iOutVertexNum];
-            }
-            for (unsigned int c = 0; pMesh->HasVertexColors(c);++c)
-            {
-                pcMesh->mColors[c] = new aiColor4D[iOutVertexNum];
-            }
-            for (unsigned int c = 0; pMesh->HasTextureCoords(c);++c)
+            // doesn't catch degenerates but is quite fast
+            unsigned int iNeed = 0;
+            for (unsigned int v = 0; v < face.mNumIndices;++v)
             {
-                pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
-                pcMesh->mTextureCoords[c] = new aiVector3D[iOutVertexNum];
+                if (aiTag[face.mIndices[v]] != iSubMesh)
+                    iNeed++;
             }
-            vFaces.reserve(iEstimatedSize);
-
-            // (we will also need to copy the array of indices)
-            while (iBase < pMesh->mNumFaces)
-            {
-                // allocate a new array
-                const unsigned int iNumIndices = pMesh->mFaces[iBase].mNumIndices;
-
-                // doesn't catch degenerates but is quite fast
-                unsigned int iNeed = 0;
-                for (unsigned int v = 0; v < iNumIndices;++v)
-                {
-                    unsigned int iIndex = pMesh->mFaces[iBase].mIndices[v];
 
-                    // check whether we do already have this vertex
-                    if (0xFFFFFFFF == avWasCopied[iIndex])
-                    {
-                        iNeed++;
-                    }
-                }
-                if (pcMesh->mNumVertices + iNeed > iOutVertexNum)
-                {
-                    // don't use this face
-                    break;
-                }
-
-                vFaces.push_back(aiFace());
-                aiFace& rFace = vFaces.back();
-
-                // setup face type and number of indices
-                rFace.mNumIndices = iNumIndices;
-                rFace.mIndices = new unsigned int[iNumIndices];
+            // don't use this face, unless it wouldn't fit into any submesh
+            if (iNumVertices + iNeed > iOutVertexNum && iBase != iFirst)
+                break;
 
-                // need to update the output primitive types
-                switch (rFace.mNumIndices)
-                {
-                case 1:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
-                    break;
-                case 2:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-                    break;
-                case 3:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-                    break;
-                default:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-                }
+            iPrimitiveTypes |= GetPrimitiveType(face.mNumIndices);
 
-                // and copy the contents of the old array, offset by current base
-                for (unsigned int v = 0; v < iNumIndices;++v)
-                {
-                    unsigned int iIndex = pMesh->mFaces[iBase].mIndices[v];
-
-                    // check whether we do already have this vertex
-                    if (0xFFFFFFFF != avWasCopied[iIndex])
-                    {
-                        rFace.mIndices[v] = avWasCopied[iIndex];
-                        continue;
-                    }
-
-                    // copy positions
-                    pcMesh->mVertices[pcMesh->mNumVertices] = (pMesh->mVertices[iIndex]);
-
-                    // copy normals
-                    if (pMesh->HasNormals())
-                    {
-                        pcMesh->mNormals[pcMesh->mNumVertices] = (pMesh->mNormals[iIndex]);
-                    }
-
-                    // copy tangents/bitangents
-                    if (pMesh->HasTangentsAndBitangents())
-                    {
-                        pcMesh->mTangents[pcMesh->mNumVertices] = (pMesh->mTangents[iIndex]);
-                        pcMesh->mBitangents[pcMesh->mNumVertices] = (pMesh->mBitangents[iIndex]);
-                    }
-
-                    // texture coordinates
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c)
-                    {
-                        if (pMesh->HasTextureCoords( c))
-                        {
-                            pcMesh->mTextureCoords[c][pcMesh->mNumVertices] = pMesh->mTextureCoords[c][iIndex];
-                        }
-                    }
-                    // vertex colors
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c)
-                    {
-                        if (pMesh->HasVertexColors( c))
-                        {
-                            pcMesh->mColors[c][pcMesh->mNumVertices] = pMesh->mColors[c][iIndex];
-                        }
-                    }
-                    // check whether we have bone weights assigned to this vertex
-                    rFace.mIndices[v] = pcMesh->mNumVertices;
-                    if (avPerVertexWeights)
-                    {
-                        VertexWeightTable& table = avPerVertexWeights[ pcMesh->mNumVertices ];
-                        if( !table.empty() )
-                        {
-                            for (VertexWeightTable::const_iterator
-                                iter =  table.begin();
-                                iter != table.end();++iter)
-                            {
-                                // allocate the bone weight array if necessary
-                                BoneWeightList* pcWeightList = (BoneWeightList*)pcMesh->mBones[(*iter).first];
-                                if (!pcWeightList)
-                                {
-                                    pcMesh->mBones[(*iter).first] = (aiBone*)(pcWeightList = new BoneWeightList());
-                                }
-                                pcWeightList->push_back(aiVertexWeight(pcMesh->mNumVertices,(*iter).second));
-                            }
-                        }
-                    }
-
-                    avWasCopied[iIndex] = pcMesh->mNumVertices;
-                    pcMesh->mNumVertices++;
-                }
-                iBase++;
-                if(pcMesh->mNumVertices == iOutVertexNum)
+            unsigned int* piOut = aiLocal.data() + aiCornerOffset[iBase];
+            for (unsigned int v = 0; v < face.mNumIndices;++v)
+            {
+                const unsigned int iIndex = face.mIndices[v];
+                if (aiTag[iIndex] != iSubMesh)
                 {
-                    // break here. The face is only added if it was complete
-                    break;
+                    aiTag[iIndex] = iSubMesh;
+                    aiWasCopied[iIndex] = iNumVertices++;
+                    aiSource.push_back(iIndex);
                 }
+                piOut[v] = aiWasCopied[iIndex];
             }
-
-            // check which bones we'll need to create for this submesh
-            if (pMesh->HasBones())
+            iBase++;
+            if (iNumVertices == iOutVertexNum)
             {
-                aiBone** ppCurrent = pcMesh->mBones;
-                for (unsigned int k = 0; k < pMesh->mNumBones;++k)
-                {
-                    // check whether the bone is existing
-                    BoneWeightList* pcWeightList;
-                    if ((pcWeightList = (BoneWeightList*)pcMesh->mBones[k]))
-                    {
-                        aiBone* pcOldBone = pMesh->mBones[k];
-                        aiBone* pcOut;
-                        *ppCurrent++ = pcOut = new aiBone();
-                        pcOut->mName = aiString(pcOldBone->mName);
-                        pcOut->mOffsetMatrix = pcOldBone->mOffsetMatrix;
-                        pcOut->mNumWeights = (unsigned int)pcWeightList->size();
-                        pcOut->mWeights = new aiVertexWeight[pcOut->mNumWeights];
-
-                        // copy the vertex weights
-                        ::memcpy(pcOut->mWeights,&pcWeightList->operator[](0),
-                            pcOut->mNumWeights * sizeof(aiVertexWeight));
-
-                        // delete the temporary bone weight list
-                        delete pcWeightList;
-                        pcMesh->mNumBones++;
-                    }
-                }
+                // break here. The face is only added if it was complete
+                break;
             }
+        }
 
-            // copy the face list to the mesh
-            pcMesh->mFaces = new aiFace[vFaces.size()];
-            pcMesh->mNumFaces = (unsigned int)vFaces.size();
-
-            for (unsigned int p = 0; p < pcMesh->mNumFaces;++p)
-                pcMesh->mFaces[p] = vFaces[p];
+        aiFirstFace.push_back(iBase);
+        aiFirstVertex.push_back((unsigned int)aiSource.size());
+        aiPrimitiveTypes.push_back(iPrimitiveTypes);
 
-            // add the newly created mesh to the list
-            avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
+        if (iBase == pMesh->mNumFaces)
+        {
+            // have all faces ... finish the outer loop, too
+            break;
+        }
+    }
 
-            if (iBase == pMesh->mNumFaces)
-            {
-                // have all faces ... finish the outer loop, too
-                break;
+    // second pass: generate all submeshes
+    BoneWeightTableCache* cache = GetBoneWeightTableCache(shared);
+    BoneWeightTable localTable;
+    const BoneWeightTable& table = GetBoneWeightTable(cache,pMesh,localTable);
+    for (unsigned int i = 0; i < aiPrimitiveTypes.size();++i)
+    {
+        const unsigned int iFaceBase = aiFirstFace[i];
+
+        aiMesh* pcMesh          = new aiMesh;
+        pcMesh->mNumFaces       = aiFirstFace[i+1] - iFaceBase;
+        pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
+        pcMesh->mPrimitiveTypes = aiPrimitiveTypes[i];
+
+        // the name carries the adjacency information between the meshes
+        pcMesh->mName = pMesh->mName;
+
+        AllocateStreams(pMesh,pcMesh,aiFirstVertex[i+1] - aiFirstVertex[i]);
+
+        pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+        ParallelFor(0,pcMesh->mNumFaces,SplitChunkSize,[&](unsigned int first, unsigned int last) {
+            for (unsigned int p = first; p < last;++p) {
+                aiFace& face = pcMesh->mFaces[p];
+                face.mNumIndices = pMesh->mFaces[iFaceBase + p].mNumIndices;
+                face.mIndices = new unsigned int[face.mNumIndices];
+                ::memcpy(face.mIndices,aiLocal.data() + aiCornerOffset[iFaceBase + p],
+                    face.mNumIndices*sizeof(unsigned int));
             }
+        });
+
+        const unsigned int* piSource = aiSource.data() + aiFirstVertex[i];
+        GatherVertices(pMesh,pcMesh,piSource);
+        if (!table.Empty()) {
+            BoneWeightTable* pcTable = GatherBones(pMesh,pcMesh,table,piSource);
+            if (cache) {
+                cache->Set(pcMesh,pcTable);
+            }
+            else delete pcTable;
         }
 
-        // delete the per-vertex weight list again
-        delete[] avPerVertexWeights;
+        // add the newly created mesh to the list
+        avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
+    }
 
-        // now delete the old mesh data
-        delete pMesh;
-        return;
+    // now delete the old mesh data
+    if (cache) {
+        cache->Remove(pMesh);
     }
-    avList.push_back(std::pair<aiMesh*, unsigned int>(pMesh,a));
-    return;
+    delete pMesh;
 }
@@ -43,12 +43,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/SceneCombiner.h>
 #include "SpatialSort.h"
 #include "ProcessHelper.h"
+#include "ParallelFor.h"
 #include "Vertex.h"
 #include <assimp/ai_assert.h>
+#include <algorithm>
 #include <stdio.h>
 
 using namespace Assimp;
-void mydummy() {}
 
 // ------------------------------------------------------------------------------------------------
 /** Subdivider stub class to implement the Catmull-Clarke subdivision algorithm. The
@@ -62,43 +63,13 @@ public:
     void Subdivide (aiMesh** smesh, size_t nmesh,
         aiMesh** out, unsigned int num, bool discard_input);
 
-    // ---------------------------------------------------------------------------
-    /** Intermediate description of an edge between two corners of a polygon*/
-    // ---------------------------------------------------------------------------
-    struct Edge
-    {
-        Edge()
-            : ref(0)
-        {}
-        Vertex edge_point, midpoint;
-        unsigned int ref;
-    };
-
     typedef std::vector<unsigned int> UIntVector;
-    typedef std::map<uint64_t,Edge> EdgeMap;
-
-    // ---------------------------------------------------------------------------
-    // Hashing function to derive an index into an #EdgeMap from two given
-    // 'unsigned int' vertex coordinates (!!distinct coordinates - same
-    // vertex position == same index!!).
-    // NOTE - this leads to rare hash collisions if a) sizeof(unsigned int)>4
-    // and (id[0]>2^32-1 or id[0]>2^32-1).
-    // MAKE_EDGE_HASH() uses temporaries, so INIT_EDGE_HASH() needs to be put
-    // at the head of every function which is about to use MAKE_EDGE_HASH().
-    // Reason is that the hash is that hash construction needs to hold the
-    // invariant id0<id1 to identify an edge - else two hashes would refer
-    // to the same edge.
-    // ---------------------------------------------------------------------------
-#define MAKE_EDGE_HASH(id0,id1) (eh_tmp0__=id0,eh_tmp1__=id1,\
-    (eh_tmp0__<eh_tmp1__?std::swap(eh_tmp0__,eh_tmp1__):mydummy()),(uint64_t)eh_tmp0__^((uint64_t)eh_tmp1__<<32u))
-
-
-#define INIT_EDGE_HASH_TEMPORARIES()\
-    unsigned int eh_tmp0__, eh_tmp1__;
 
 private:
     void InternSubdivide (const aiMesh* const * smesh,
         size_t nmesh,aiMesh** out, unsigned int num);
+
+    void SubdivideOnce (const aiMesh* const * smesh, size_t nmesh, aiMesh** out);
 };
 
 
@@ -215,14 +186,11 @@ void CatmullClarkSubdivider::Subdivide (
 
 // ------------------------------------------------------------------------------------------------
 // Note - this is an implementation of the standard (recursive) Cm-Cl algorithm without further
-// optimizations (except we're using some nice LUTs). A description of the algorithm can be found
-// here: http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
+// optimizations. A description of the algorithm can be found here:
+// http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
 //
-// The code is mostly O(n), however parts are O(nlogn) which is therefore the algorithm's
-// expected total runtime complexity. The implementation is able to work in-place on the same
-// mesh arrays. Calling #InternSubdivide() directly is not encouraged. The code can operate
-// in-place unless 'smesh' and 'out' are equal (no strange overlaps or reorderings).
-// Previous data is replaced/deleted then.
+// The refinement is applied level by level, dropping the intermediate meshes as we go. Calling
+// #InternSubdivide() directly is not encouraged. 'smesh' and 'out' may not overlap.
 // ------------------------------------------------------------------------------------------------
 void CatmullClarkSubdivider::InternSubdivide (
     const aiMesh* const * smesh,
@@ -232,109 +200,207 @@ void CatmullClarkSubdivider::InternSubdivide (
     )
 {
     ai_assert(NULL != smesh && NULL != out);
-    INIT_EDGE_HASH_TEMPORARIES();
 
-    // no subdivision requested or end of recursive refinement
-    if (!num) {
-        return;
+    std::vector<aiMesh*> cur, next(nmesh);
+    for (unsigned int level = 0; level < num; ++level) {
+        const bool last = level == num-1;
+        SubdivideOnce(level ? &cur.front() : smesh,nmesh,last ? out : &next.front());
+
+        for (size_t i = 0; i < cur.size(); ++i) {
+            delete cur[i];
+        }
+        if (!last) {
+            cur.assign(next.begin(),next.end());
+        }
     }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Performs a single subdivision step on a set of meshes. The code is mostly O(n), only the
+// spatial sort to identify equal vertices is O(nlogn).
+//
+// Edges are derived from flat half-edge tables and all points are computed in parallel. The
+// output is written to ranges which are known in advance from the corner counts of the faces.
+// ------------------------------------------------------------------------------------------------
+void CatmullClarkSubdivider::SubdivideOnce (
+    const aiMesh* const * smesh,
+    size_t nmesh,
+    aiMesh** out
+    )
+{
+    // Minimum number of points per task when computing points in parallel
+    const unsigned int MinChunk = 512;
 
+    // ---------------------------------------------------------------------
+    // 0. Generate a spatially sorted representation of all vertices in all
+    // meshes to map them to distinct indices.
+    // ---------------------------------------------------------------------
     UIntVector maptbl;
-    SpatialSort spatial;
+    unsigned int num_unique;
+    {
+        SpatialSort spatial;
+        for (size_t t = 0; t < nmesh; ++t) {
+            spatial.Append(smesh[t]->mVertices,smesh[t]->mNumVertices,sizeof(aiVector3D),false);
+        }
+        spatial.Finalize();
+        num_unique = spatial.GenerateMappingTable(maptbl,ComputePositionEpsilon(smesh,nmesh));
+    }
 
     // ---------------------------------------------------------------------
-    // 0. Offset table to index all meshes continuously, generate a spatially
-    // sorted representation of all vertices in all meshes.
+    // 1. Offset tables to index the faces and vertices of all meshes
+    // continuously. Corners are numbered continuously as well, corner c
+    // starts the half-edge to the next corner of its face.
     // ---------------------------------------------------------------------
-    typedef std::pair<unsigned int,unsigned int> IntPair;
-    std::vector<IntPair> moffsets(nmesh);
-    unsigned int totfaces = 0, totvert = 0;
+    UIntVector meshface(nmesh+1,0), meshvert(nmesh,0);
+    unsigned int totvert = 0;
     for (size_t t = 0; t < nmesh; ++t) {
-        const aiMesh* mesh = smesh[t];
-
-        spatial.Append(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D),false);
-        moffsets[t] = IntPair(totfaces,totvert);
-
-        totfaces += mesh->mNumFaces;
-        totvert  += mesh->mNumVertices;
+        meshface[t+1] = meshface[t] + smesh[t]->mNumFaces;
+        meshvert[t] = totvert;
+        totvert += smesh[t]->mNumVertices;
     }
+    ai_assert(maptbl.size() == totvert);
 
-    spatial.Finalize();
-    const unsigned int num_unique = spatial.GenerateMappingTable(maptbl,ComputePositionEpsilon(smesh,nmesh));
+    const unsigned int totfaces = meshface[nmesh];
+    UIntVector facemesh(totfaces), facecorner(totfaces+1,0);
+    for (size_t t = 0, n = 0; t < nmesh; ++t) {
+        const aiMesh* mesh = smesh[t];
+        for (unsigned int i = 0; i < mesh->mNumFaces;++i,++n) {
+            facemesh[n] = static_cast<unsigned int>(t);
+            facecorner[n+1] = facecorner[n] + mesh->mFaces[i].mNumIndices;
+        }
+    }
 
+    const unsigned int totcorners = facecorner[totfaces];
+    UIntVector cornerface(totcorners), cornervert(totcorners), cornernext(totcorners);
+    ParallelFor(0,totfaces,MinChunk,[&](unsigned int first, unsigned int last) {
+        for (unsigned int f = first; f < last; ++f) {
+            const unsigned int t = facemesh[f];
+            const aiFace& face = smesh[t]->mFaces[f-meshface[t]];
+            for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+                const unsigned int c = facecorner[f]+a;
+                cornerface[c] = f;
+                cornervert[c] = maptbl[meshvert[t]+face.mIndices[a]];
+                cornernext[c] = a == face.mNumIndices-1 ? facecorner[f] : c+1;
+            }
+        }
+    });
 
-#define FLATTEN_VERTEX_IDX(mesh_idx, vert_idx) (moffsets[mesh_idx].second+vert_idx)
-#define   FLATTEN_FACE_IDX(mesh_idx, face_idx) (moffsets[mesh_idx].first+face_idx)
+    const auto prevCorner = [&](unsigned int c) {
+        return c == facecorner[cornerface[c]] ? facecorner[cornerface[c]+1]-1 : c-1;
+    };
+    const auto cornerVertex = [&](unsigned int c) {
+        const unsigned int f = cornerface[c], t = facemesh[f];
+        return Vertex(smesh[t],smesh[t]->mFaces[f-meshface[t]].mIndices[c-facecorner[f]]);
+    };
 
     // ---------------------------------------------------------------------
-    // 1. Compute the centroid point for all faces
+    // 2. Compute the centroid point for all faces
     // ---------------------------------------------------------------------
     std::vector<Vertex> centroids(totfaces);
-    unsigned int nfacesout = 0;
-    for (size_t t = 0, n = 0; t < nmesh; ++t) {
-        const aiMesh* mesh = smesh[t];
-        for (unsigned int i = 0; i < mesh->mNumFaces;++i,++n)
-        {
-            const aiFace& face = mesh->mFaces[i];
-            Vertex& c = centroids[n];
-
-            for (unsigned int a = 0; a < face.mNumIndices;++a) {
-                c += Vertex(mesh,face.mIndices[a]);
+    ParallelFor(0,totfaces,MinChunk,[&](unsigned int first, unsigned int last) {
+        for (unsigned int f = first; f < last; ++f) {
+            Vertex& c = centroids[f];
+            for (unsigned int a = facecorner[f]; a < facecorner[f+1]; ++a) {
+                c += cornerVertex(a);
             }
-
-            c /= static_cast<float>(face.mNumIndices);
-            nfacesout += face.mNumIndices;
+            c /= static_cast<float>(facecorner[f+1]-facecorner[f]);
         }
-    }
-
-    {
-    // we want edges to go away before the recursive calls so begin a new scope
-    EdgeMap edges;
+    });
 
     // ---------------------------------------------------------------------
-    // 2. Set each edge point to be the average of all neighbouring
-    // face points and original points. Every edge exists twice
-    // if there is a neighboring face.
+    // 3. Identify the edges. The half-edges are grouped by their lower
+    // distinct vertex index and, within each group, sorted by the upper
+    // one. Half-edges of the same edge keep the order of their corners,
+    // so the first one is the first in the input.
     // ---------------------------------------------------------------------
-    for (size_t t = 0; t < nmesh; ++t) {
-        const aiMesh* mesh = smesh[t];
+    const auto lowerVertex = [&](unsigned int c) {
+        return std::min(cornervert[c],cornervert[cornernext[c]]);
+    };
+    const auto upperVertex = [&](unsigned int c) {
+        return std::max(cornervert[c],cornervert[cornernext[c]]);
+    };
 
-        for (unsigned int i = 0; i < mesh->mNumFaces;++i)   {
-            const aiFace& face = mesh->mFaces[i];
-
-            for (unsigned int p =0; p< face.mNumIndices; ++p) {
-                const unsigned int id[] = {
-                    face.mIndices[p],
-                    face.mIndices[p==face.mNumIndices-1?0:p+1]
-                };
-                const unsigned int mp[] = {
-                    maptbl[FLATTEN_VERTEX_IDX(t,id[0])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,id[1])]
-                };
-
-                Edge& e = edges[MAKE_EDGE_HASH(mp[0],mp[1])];
-                e.ref++;
-                if (e.ref<=2) {
-                    if (e.ref==1) { // original points (end points) - add only once
-                        e.edge_point = e.midpoint = Vertex(mesh,id[0])+Vertex(mesh,id[1]);
-                        e.midpoint *= 0.5f;
-                    }
-                    e.edge_point += centroids[FLATTEN_FACE_IDX(t,i)];
-                }
+    UIntVector ofslower(num_unique+1,0), halfedges(totcorners);
+    for (unsigned int c = 0; c < totcorners; ++c) {
+        ++ofslower[lowerVertex(c)+1];
+    }
+    for (unsigned int i = 0; i < num_unique; ++i) {
+        ofslower[i+1] += ofslower[i];
+    }
+    {
+        UIntVector cur(ofslower.begin(),ofslower.end()-1);
+        for (unsigned int c = 0; c < totcorners; ++c) {
+            halfedges[cur[lowerVertex(c)]++] = c;
+        }
+    }
+
+    UIntVector ofsedges(num_unique+1,0);
+    ParallelFor(0,num_unique,MinChunk,[&](unsigned int first, unsigned int last) {
+        for (unsigned int v = first; v < last; ++v) {
+            const UIntVector::iterator begin = halfedges.begin()+ofslower[v], end = halfedges.begin()+ofslower[v+1];
+            std::sort(begin,end,[&](unsigned int a, unsigned int b) {
+                const unsigned int ua = upperVertex(a), ub = upperVertex(b);
+                return ua < ub || (ua == ub && a < b);
+            });
+
+            unsigned int cnt = 0;
+            for (UIntVector::iterator it = begin; it != end; ++it) {
+                cnt += it == begin || upperVertex(*it) != upperVertex(*(it-1));
             }
+            ofsedges[v+1] = cnt;
         }
+    });
+    for (unsigned int i = 0; i < num_unique; ++i) {
+        ofsedges[i+1] += ofsedges[i];
     }
 
+    const unsigned int numedges = ofsedges[num_unique];
+    UIntVector corneredge(totcorners), edgefirst(numedges), edgesecond(numedges), edgeref(numedges,0);
+    ParallelFor(0,num_unique,MinChunk,[&](unsigned int first, unsigned int last) {
+        for (unsigned int v = first; v < last; ++v) {
+            unsigned int e = ofsedges[v];
+            for (unsigned int i = ofslower[v]; i < ofslower[v+1]; ++i) {
+                const unsigned int c = halfedges[i];
+                if (i != ofslower[v] && upperVertex(c) != upperVertex(halfedges[i-1])) {
+                    ++e;
+                }
+                corneredge[c] = e;
+                if (!edgeref[e]++) {
+                    edgefirst[e] = c;
+                }
+                else if (edgeref[e] == 2) {
+                    edgesecond[e] = c;
+                }
+            }
+        }
+    });
+    UIntVector().swap(halfedges);
+
     // ---------------------------------------------------------------------
-    // 3. Normalize edge points
+    // 4. Set each edge point to be the average of the neighbouring face
+    // points and the original points. Only the first two faces are taken
+    // into account, but the weights still count all of them.
     // ---------------------------------------------------------------------
-    {unsigned int bad_cnt = 0;
-    for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
-        if ((*it).second.ref < 2) {
-            ai_assert((*it).second.ref);
-            ++bad_cnt;
+    std::vector<Vertex> edgepoints(numedges), midpoints(numedges);
+    ParallelFor(0,numedges,MinChunk,[&](unsigned int first, unsigned int last) {
+        for (unsigned int e = first; e < last; ++e) {
+            const unsigned int c = edgefirst[e];
+            Vertex& edge_point = edgepoints[e];
+            Vertex& midpoint = midpoints[e];
+
+            edge_point = midpoint = cornerVertex(c)+cornerVertex(cornernext[c]);
+            midpoint *= 0.5f;
+            edge_point += centroids[cornerface[c]];
+            if (edgeref[e] >= 2) {
+                edge_point += centroids[cornerface[edgesecond[e]]];
+            }
+            edge_point *= 1.f/(edgeref[e]+2.f);
         }
-        (*it).second.edge_point *= 1.f/((*it).second.ref+2.f);
+    });
+
+    {unsigned int bad_cnt = 0;
+    for (unsigned int e = 0; e < numedges; ++e) {
+        bad_cnt += edgeref[e] < 2;
     }
 
     if (bad_cnt) {
@@ -343,95 +409,87 @@ void CatmullClarkSubdivider::InternSubdivide (
         // shapes.
         char tmp[512];
         ai_snprintf(tmp, 512, "Catmull-Clark Subdivider: got %u bad edges touching only one face (totally %u edges). ",
-            bad_cnt,static_cast<unsigned int>(edges.size()));
+            bad_cnt,numedges);
 
         DefaultLogger::get()->debug(tmp);
     }}
 
     // ---------------------------------------------------------------------
-    // 4. Compute a vertex-face adjacency table. We can't reuse the code
-    // from VertexTriangleAdjacency because we need the table for multiple
-    // meshes and out vertex indices need to be mapped to distinct values
-    // first.
+    // 5. Compute a vertex-corner adjacency table. The corners of each
+    // distinct vertex are listed in input order.
     // ---------------------------------------------------------------------
-    UIntVector faceadjac(nfacesout), cntadjfac(maptbl.size(),0), ofsadjvec(maptbl.size()+1,0); {
-    for (size_t t = 0; t < nmesh; ++t) {
-        const aiMesh* const minp = smesh[t];
-        for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-
-            const aiFace& f = minp->mFaces[i];
-            for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-                ++cntadjfac[maptbl[FLATTEN_VERTEX_IDX(t,f.mIndices[n])]];
-            }
-        }
+    UIntVector ofsadjvec(num_unique+1,0), corneradjac(totcorners);
+    for (unsigned int c = 0; c < totcorners; ++c) {
+        ++ofsadjvec[cornervert[c]+1];
     }
-    unsigned int cur = 0;
-    for (size_t i = 0; i < cntadjfac.size(); ++i) {
-        ofsadjvec[i+1] = cur;
-        cur += cntadjfac[i];
+    for (unsigned int i = 0; i < num_unique; ++i) {
+        ofsadjvec[i+1] += ofsadjvec[i];
     }
-    for (size_t t = 0; t < nmesh; ++t) {
-        const aiMesh* const minp = smesh[t];
-        for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-
-            const aiFace& f = minp->mFaces[i];
-            for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-                faceadjac[ofsadjvec[1+maptbl[FLATTEN_VERTEX_IDX(t,f.mIndices[n])]]++] = FLATTEN_FACE_IDX(t,i);
-            }
+    {
+        UIntVector cur(ofsadjvec.begin(),ofsadjvec.end()-1);
+        for (unsigned int c = 0; c < totcorners; ++c) {
+            corneradjac[cur[cornervert[c]]++] = c;
         }
     }
 
-    // check the other way round for consistency
-#ifdef ASSIMP_BUILD_DEBUG
-
-    for (size_t t = 0; t < ofsadjvec.size()-1; ++t) {
-        for (unsigned int m = 0; m <  cntadjfac[t]; ++m) {
-            const unsigned int fidx = faceadjac[ofsadjvec[t]+m];
-            ai_assert(fidx < totfaces);
-            for (size_t n = 1; n < nmesh; ++n) {
-
-                if (moffsets[n].first > fidx) {
-                    const aiMesh* msh = smesh[--n];
-                    const aiFace& f = msh->mFaces[fidx-moffsets[n].first];
-
-                    bool haveit = false;
-                    for (unsigned int i = 0; i < f.mNumIndices; ++i) {
-                        if (maptbl[FLATTEN_VERTEX_IDX(n,f.mIndices[i])]==(unsigned int)t) {
-                            haveit = true;
-                            break;
-                        }
-                    }
-                    ai_assert(haveit);
-                    if (!haveit) {
-                        DefaultLogger::get()->debug("Catmull-Clark Subdivider: Index not used");
-                    }
-                    break;
-                }
+    // ---------------------------------------------------------------------
+    // 6. Move each original point P with distinct index i
+    // F := 0
+    // R := 0
+    // n := 0
+    // for each face f containing i
+    //    F := F+ centroid of f
+    //    R := R+ midpoints of both edges of f at i
+    //    n := n+1
+    //
+    // (n-3)P/n + (F+R)/(n*n)
+    //
+    // In a closed shape every edge is added twice to R, so the factor 2 of
+    // the textbook formula is left out. Points with less than three faces
+    // stay in place. The attributes of P are taken from its first corner.
+    // ---------------------------------------------------------------------
+    std::vector<Vertex> new_points(num_unique);
+    ParallelFor(0,num_unique,MinChunk,[&](unsigned int first, unsigned int last) {
+        for (unsigned int v = first; v < last; ++v) {
+            const unsigned int cnt = ofsadjvec[v+1]-ofsadjvec[v];
+            if (!cnt) {
+                continue;
+            }
+            const unsigned int* adj = &corneradjac[ofsadjvec[v]];
+            if (cnt < 3) {
+                new_points[v] = cornerVertex(adj[0]);
+                continue;
             }
-        }
-    }
 
-#endif
-    }
+            Vertex F,R;
+            for (unsigned int o = 0; o < cnt; ++o) {
+                const unsigned int f = cornerface[adj[o]];
+                F += centroids[f];
+
+                // find the first corner of our original point in the face
+                unsigned int m = facecorner[f];
+                while (cornervert[m] != v) {
+                    ++m;
+                }
+                R += midpoints[corneredge[prevCorner(m)]]+midpoints[corneredge[m]];
+            }
 
-#define GET_ADJACENT_FACES_AND_CNT(vidx,fstartout,numout) \
-    fstartout = &faceadjac[ofsadjvec[vidx]], numout = cntadjfac[vidx]
+            const float div = static_cast<float>(cnt), divsq = 1.f/(div*div);
+            new_points[v] = cornerVertex(adj[0])*((div-3.f) / div) + R*divsq + F*divsq;
+        }
+    });
+    UIntVector().swap(corneradjac);
 
-    typedef std::pair<bool,Vertex> TouchedOVertex;
-    std::vector<TouchedOVertex > new_points(num_unique,TouchedOVertex(false,Vertex()));
     // ---------------------------------------------------------------------
-    // 5. Spawn a quad from each face point to the corresponding edge points
+    // 7. Spawn a quad from each face point to the corresponding edge points
     // the original points being the fourth quad points.
     // ---------------------------------------------------------------------
     for (size_t t = 0; t < nmesh; ++t) {
         const aiMesh* const minp = smesh[t];
         aiMesh* const mout = out[t] = new aiMesh();
 
-        for (unsigned int a  = 0; a < minp->mNumFaces; ++a) {
-            mout->mNumFaces += minp->mFaces[a].mNumIndices;
-        }
-
         // We need random access to the old face buffer, so reuse is not possible.
+        mout->mNumFaces = facecorner[meshface[t+1]]-facecorner[meshface[t]];
         mout->mFaces = new aiFace[mout->mNumFaces];
 
         mout->mNumVertices = mout->mNumFaces*4;
@@ -458,133 +516,33 @@ void CatmullClarkSubdivider::InternSubdivide (
         for(unsigned int i = 0; minp->HasVertexColors(i); ++i) {
             mout->mColors[i] = new aiColor4D[mout->mNumVertices];
         }
+    }
 
-        mout->mNumVertices = mout->mNumFaces<<2u;
-        for (unsigned int i = 0, v = 0, n = 0; i < minp->mNumFaces;++i) {
+    ParallelFor(0,totfaces,MinChunk,[&](unsigned int first, unsigned int last) {
+        for (unsigned int f = first; f < last; ++f) {
+            aiMesh* const mout = out[facemesh[f]];
+            const unsigned int base = facecorner[meshface[facemesh[f]]];
 
-            const aiFace& face = minp->mFaces[i];
-            for (unsigned int a = 0; a < face.mNumIndices;++a)  {
+            for (unsigned int c = facecorner[f]; c < facecorner[f+1]; ++c) {
+                const unsigned int v = (c-base)*4;
 
                 // Get a clean new face.
-                aiFace& faceOut = mout->mFaces[n++];
+                aiFace& faceOut = mout->mFaces[c-base];
                 faceOut.mIndices = new unsigned int [faceOut.mNumIndices = 4];
 
                 // Spawn a new quadrilateral (ccw winding) for this original point between:
                 // a) face centroid
-                centroids[FLATTEN_FACE_IDX(t,i)].SortBack(mout,faceOut.mIndices[0]=v++);
+                centroids[f].SortBack(mout,faceOut.mIndices[0]=v);
 
                 // b) adjacent edge on the left, seen from the centroid
-                const Edge& e0 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a==face.mNumIndices-1?0:a+1])
-                    ])];  // fixme: replace with mod face.mNumIndices?
+                edgepoints[corneredge[c]].SortBack(mout,faceOut.mIndices[3]=v+1);
 
                 // c) adjacent edge on the right, seen from the centroid
-                const Edge& e1 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[!a?face.mNumIndices-1:a-1])
-                    ])];  // fixme: replace with mod face.mNumIndices?
-
-                e0.edge_point.SortBack(mout,faceOut.mIndices[3]=v++);
-                e1.edge_point.SortBack(mout,faceOut.mIndices[1]=v++);
-
-                // d= original point P with distinct index i
-                // F := 0
-                // R := 0
-                // n := 0
-                // for each face f containing i
-                //    F := F+ centroid of f
-                //    R := R+ midpoint of edge of f from i to i+1
-                //    n := n+1
-                //
-                // (F+2R+(n-3)P)/n
-                const unsigned int org = maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])];
-                TouchedOVertex& ov = new_points[org];
-
-                if (!ov.first) {
-                    ov.first = true;
-
-                    const unsigned int* adj; unsigned int cnt;
-                    GET_ADJACENT_FACES_AND_CNT(org,adj,cnt);
-
-                    if (cnt < 3) {
-                        ov.second = Vertex(minp,face.mIndices[a]);
-                    }
-                    else {
-
-                        Vertex F,R;
-                        for (unsigned int o = 0; o < cnt; ++o) {
-                            ai_assert(adj[o] < totfaces);
-                            F += centroids[adj[o]];
-
-                            // adj[0] is a global face index - search the face in the mesh list
-                            const aiMesh* mp = NULL;
-                            size_t nidx;
-
-                            if (adj[o] < moffsets[0].first) {
-                                mp = smesh[nidx=0];
-                            }
-                            else {
-                                for (nidx = 1; nidx<= nmesh; ++nidx) {
-                                    if (nidx == nmesh ||moffsets[nidx].first > adj[o]) {
-                                        mp = smesh[--nidx];
-                                        break;
-                                    }
-                                }
-                            }
-
-                            ai_assert(adj[o]-moffsets[nidx].first < mp->mNumFaces);
-                            const aiFace& f = mp->mFaces[adj[o]-moffsets[nidx].first];
-                            bool haveit = false;
-
-                            // find our original point in the face
-                            for (unsigned int m = 0; m < f.mNumIndices; ++m) {
-                                if (maptbl[FLATTEN_VERTEX_IDX(nidx,f.mIndices[m])] == org) {
-
-                                    // add *both* edges. this way, we can be sure that we add
-                                    // *all* adjacent edges to R. In a closed shape, every
-                                    // edge is added twice - so we simply leave out the
-                                    // factor 2.f in the amove formula and get the right
-                                    // result.
-
-                                    const Edge& c0 = edges[MAKE_EDGE_HASH(org,maptbl[FLATTEN_VERTEX_IDX(
-                                        nidx,f.mIndices[!m?f.mNumIndices-1:m-1])])];
-                                    // fixme: replace with mod face.mNumIndices?
-
-                                    const Edge& c1 = edges[MAKE_EDGE_HASH(org,maptbl[FLATTEN_VERTEX_IDX(
-                                        nidx,f.mIndices[m==f.mNumIndices-1?0:m+1])])];
-                                    // fixme: replace with mod face.mNumIndices?
-                                    R += c0.midpoint+c1.midpoint;
-
-                                    haveit = true;
-                                    break;
-                                }
-                            }
-
-                            // this invariant *must* hold if the vertex-to-face adjacency table is valid
-                            ai_assert(haveit);
-                            if ( !haveit ) {
-                                DefaultLogger::get()->warn( "OBJ: no name for material library specified." );
-                            }
-                        }
-
-                        const float div = static_cast<float>(cnt), divsq = 1.f/(div*div);
-                        ov.second = Vertex(minp,face.mIndices[a])*((div-3.f) / div) + R*divsq + F*divsq;
-                    }
-                }
-                ov.second.SortBack(mout,faceOut.mIndices[2]=v++);
-            }
-        }
-    }
-    }  // end of scope for edges, freeing its memory
+                edgepoints[corneredge[prevCorner(c)]].SortBack(mout,faceOut.mIndices[1]=v+2);
 
-    // ---------------------------------------------------------------------
-    // 7. Apply the next subdivision step.
-    // ---------------------------------------------------------------------
-    if (num != 1) {
-        std::vector<aiMesh*> tmp(nmesh);
-        InternSubdivide (out,nmesh,&tmp.front(),num-1);
-        for (size_t i = 0; i < nmesh; ++i) {
-            delete out[i];
-            out[i] = tmp[i];
+                // d) the moved original point
+                new_points[cornervert[c]].SortBack(mout,faceOut.mIndices[2]=v+3);
+            }
         }
-    }
+    });
 }
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_SUBDISIVION_H_INC
 #define AI_SUBDISIVION_H_INC
 
+#include <assimp/defs.h>
 #include <cstddef>
 struct aiMesh;
 
@@ -52,7 +53,7 @@ namespace Assimp    {
 /** Helper class to evaluate subdivision surfaces. Different algorithms
  *  are provided for choice. */
 // ------------------------------------------------------------------------------
-class Subdivider
+class ASSIMP_API Subdivider
 {
 public:
 
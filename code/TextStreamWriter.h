@@ -0,0 +1,574 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  TextStreamWriter.h
+ *  @brief Defines the TextStreamWriter class, a buffered writer for textual
+ *    output to an IOStream, together with the locale-independent number
+ *    formatting routines it is built upon.
+ */
+
+#ifndef AI_TEXTSTREAMWRITER_H_INCLUDED
+#define AI_TEXTSTREAMWRITER_H_INCLUDED
+
+#include "Exceptional.h"
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+/** Maximum number of characters written by any of the Format...() functions */
+#define AI_TEXT_NUMBER_MAXLEN 32
+
+namespace TextFormat {
+
+// --------------------------------------------------------------------------------------------
+/** Replace the decimal separator of the current C locale by a dot. Used to fix up the
+ *  output of snprintf(), which honours the global locale. */
+inline void FixDecimalPoint(char* begin, char* end) {
+    for (; begin != end; ++begin) {
+        const char c = *begin;
+        if ((c < '0' || c > '9') && c != '-' && c != '+' && c != 'e' && c != 'E' &&
+                c != 'n' && c != 'a' && c != 'i' && c != 'f') {
+            *begin = '.';
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------------------
+/** Write the decimal representation of an unsigned integer to the given buffer.
+ *  @return Pointer past the last character written, no terminal zero is appended. */
+inline char* FormatUInt(char* out, uint64_t value) {
+    static const char digitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    char tmp[24];
+    char* p = tmp + sizeof(tmp);
+    while (value >= 100) {
+        const unsigned int pair = static_cast<unsigned int>(value % 100) * 2;
+        value /= 100;
+        *--p = digitPairs[pair + 1];
+        *--p = digitPairs[pair];
+    }
+    if (value >= 10) {
+        const unsigned int pair = static_cast<unsigned int>(value) * 2;
+        *--p = digitPairs[pair + 1];
+        *--p = digitPairs[pair];
+    } else {
+        *--p = static_cast<char>('0' + value);
+    }
+
+    const size_t len = tmp + sizeof(tmp) - p;
+    ::memcpy(out, p, len);
+    return out + len;
+}
+
+// --------------------------------------------------------------------------------------------
+/** Write the decimal representation of a signed integer to the given buffer.
+ *  @return Pointer past the last character written, no terminal zero is appended. */
+inline char* FormatInt(char* out, int64_t value) {
+    if (value < 0) {
+        *out++ = '-';
+        return FormatUInt(out, 0u - static_cast<uint64_t>(value));
+    }
+    return FormatUInt(out, static_cast<uint64_t>(value));
+}
+
+// --------------------------------------------------------------------------------------------
+/** Check whether the decimal number n * 10^-q reads back as exactly @c value.
+ *
+ *  n * 10^-q is evaluated in double precision, which is correctly rounded as long as
+ *  |q| <= 22. Converting that double to float is then correct unless it was rounded onto
+ *  the midpoint between two floats (double rounding) - such candidates are rejected, which
+ *  at worst costs an extra digit. */
+inline bool IsRoundTrip(uint64_t n, int q, float value, const double* pow10) {
+    const double d = q >= 0 ? static_cast<double>(n) / pow10[q] : static_cast<double>(n) * pow10[-q];
+    const float f = static_cast<float>(d);
+    if (f != value) {
+        return false;
+    }
+    if (static_cast<double>(f) == d) {
+        return true;
+    }
+    const float g = std::nextafter(f, d > static_cast<double>(f) ? HUGE_VALF : -HUGE_VALF);
+    if ((static_cast<double>(f) + static_cast<double>(g)) * 0.5 != d) {
+        return true;
+    }
+
+    // a tie which is fine as long as the double is the exact decimal value
+    return q >= 0 ? std::fma(d, pow10[q], -static_cast<double>(n)) == 0.0
+        : std::fma(static_cast<double>(n), pow10[-q], -d) == 0.0;
+}
+
+// --------------------------------------------------------------------------------------------
+/** Write the significant digits @c n, scaled by 10^-q, using the layout of printf's %g
+ *  conversion with a precision of 16 (which is what the exporters used to produce). */
+inline char* FormatDecimal(char* out, uint64_t n, int q) {
+    while (n % 10 == 0) {
+        n /= 10;
+        --q;
+    }
+
+    char digits[24];
+    const int len = static_cast<int>(FormatUInt(digits, n) - digits);
+
+    // decimal exponent of the leading digit
+    const int exp = len - 1 - q;
+    if (exp < -4 || exp >= 16) {
+        *out++ = digits[0];
+        if (len > 1) {
+            *out++ = '.';
+            ::memcpy(out, digits + 1, len - 1);
+            out += len - 1;
+        }
+        *out++ = 'e';
+        *out++ = exp < 0 ? '-' : '+';
+        const int absExp = exp < 0 ? -exp : exp;
+        if (absExp < 10) {
+            *out++ = '0';
+        }
+        return FormatUInt(out, absExp);
+    }
+
+    if (exp < 0) {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = -1; i > exp; --i) {
+            *out++ = '0';
+        }
+        ::memcpy(out, digits, len);
+        return out + len;
+    }
+
+    if (len <= exp + 1) {
+        ::memcpy(out, digits, len);
+        out += len;
+        for (int i = len; i <= exp; ++i) {
+            *out++ = '0';
+        }
+        return out;
+    }
+
+    ::memcpy(out, digits, exp + 1);
+    out += exp + 1;
+    *out++ = '.';
+    ::memcpy(out, digits + exp + 1, len - exp - 1);
+    return out + len - exp - 1;
+}
+
+// --------------------------------------------------------------------------------------------
+/** Write the shortest decimal representation of a float that parses back to the very
+ *  same value. The output is independent of the current locale.
+ *
+ *  The digits are searched for directly for all values between ~1e-14 and ~1e21, which
+ *  covers virtually all geometry. Everything else is handled by snprintf().
+ *  @param out Output buffer, must be at least AI_TEXT_NUMBER_MAXLEN characters.
+ *  @return Pointer past the last character written, no terminal zero is appended. */
+inline char* FormatFloat(char* out, float value) {
+    static const double pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    if (value != value) {
+        ::memcpy(out, "nan", 3);
+        return out + 3;
+    }
+    if (std::signbit(value)) {
+        *out++ = '-';
+        value = -value;
+    }
+    if (value == 0.f) {
+        *out++ = '0';
+        return out;
+    }
+    if (value == HUGE_VALF) {
+        ::memcpy(out, "inf", 3);
+        return out + 3;
+    }
+
+    const double v = value;
+    int exp2;
+    std::frexp(v, &exp2);
+
+    // half the distance to the farther neighbour bounds the interval of decimals which read
+    // back as value, so most digit counts can be ruled out without a trial conversion.
+    const double halfGap = std::max(static_cast<double>(std::nextafter(value, HUGE_VALF)) - v,
+        v - static_cast<double>(std::nextafter(value, 0.f))) * 0.5000001;
+
+    // estimate of floor(log10(v)), may be off by one which only costs an iteration
+    const int exp10 = static_cast<int>(std::floor((exp2 - 1) * 0.30102999566398120));
+    for (int k = 1; k <= 10; ++k) {
+        const int q = k - 1 - exp10;
+        if (q > 22 || q < -22) {
+            break;
+        }
+
+        const double scaled = q >= 0 ? v * pow10[q] : v / pow10[-q];
+        const double lower = std::floor(scaled);
+        const double tolerance = q >= 0 ? halfGap * pow10[q] : halfGap / pow10[-q];
+        if (scaled - lower > tolerance && lower + 1.0 - scaled > tolerance) {
+            continue;
+        }
+        uint64_t candidates[2] = { static_cast<uint64_t>(lower), static_cast<uint64_t>(lower) + 1 };
+        if (scaled - lower > 0.5) {
+            std::swap(candidates[0], candidates[1]);
+        }
+        for (unsigned int i = 0; i < 2; ++i) {
+            if (candidates[i] && IsRoundTrip(candidates[i], q, value, pow10)) {
+                return FormatDecimal(out, candidates[i], q);
+            }
+        }
+    }
+
+    // slow path for very small and very large magnitudes
+    char* end = out;
+    for (int precision = 1; precision <= 9; ++precision) {
+        end = out + ::snprintf(out, AI_TEXT_NUMBER_MAXLEN - 1, "%.*g", precision, v);
+        if (static_cast<float>(::strtod(out, nullptr)) == value) {
+            break;
+        }
+    }
+    FixDecimalPoint(out, end);
+    return end;
+}
+
+// --------------------------------------------------------------------------------------------
+/** Write a double with up to 17 significant digits, favouring the 15 digit form whenever
+ *  that reads back to the same value. The output is independent of the current locale.
+ *  @param out Output buffer, must be at least AI_TEXT_NUMBER_MAXLEN characters.
+ *  @return Pointer past the last character written, no terminal zero is appended. */
+inline char* FormatDouble(char* out, double value) {
+    char* end = out + ::snprintf(out, AI_TEXT_NUMBER_MAXLEN - 1, "%.15g", value);
+    if (::strtod(out, nullptr) != value) {
+        end = out + ::snprintf(out, AI_TEXT_NUMBER_MAXLEN - 1, "%.17g", value);
+    }
+    FixDecimalPoint(out, end);
+    return end;
+}
+
+// --------------------------------------------------------------------------------------------
+/** Write a number with a fixed count of decimals, producing exactly the same output as
+ *  printf's "%.*f" conversion. The output is independent of the current locale.
+ *
+ *  Values which are exactly representable as float and below 1e10 are formatted directly:
+ *  their product with 10^decimals is exact in double precision, so rounding it to an
+ *  integer matches the round-half-even of printf.
+ *  @param out Output buffer, must be at least AI_TEXT_NUMBER_MAXLEN characters.
+ *  @param decimals Number of decimals, at most 8.
+ *  @return Pointer past the last character written, no terminal zero is appended. */
+inline char* FormatFixed(char* out, double value, unsigned int decimals) {
+    static const uint32_t pow10[] = {
+        1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u
+    };
+    ai_assert(decimals <= 8);
+
+    const double mag = std::fabs(value);
+    if (!(mag < 1e10) || value != static_cast<double>(static_cast<float>(value))) {
+        char* end = out + ::snprintf(out, AI_TEXT_NUMBER_MAXLEN - 1, "%.*f", decimals, value);
+        FixDecimalPoint(out, end);
+        return end;
+    }
+
+    if (std::signbit(value)) {
+        *out++ = '-';
+    }
+    const uint64_t n = static_cast<uint64_t>(std::nearbyint(mag * pow10[decimals]));
+    out = FormatUInt(out, n / pow10[decimals]);
+    if (decimals) {
+        *out++ = '.';
+        uint64_t frac = n % pow10[decimals];
+        for (unsigned int i = decimals; i > 0; --i) {
+            out[i - 1] = static_cast<char>('0' + frac % 10);
+            frac /= 10;
+        }
+        out += decimals;
+    }
+    return out;
+}
+
+} // namespace TextFormat
+
+// --------------------------------------------------------------------------------------------
+/** Buffered writer for text files. A drop-in replacement for the std::ostringstream based
+ *  output of the text exporters: values are formatted directly into a fixed-size buffer
+ *  which is written to the underlying IOStream whenever it fills up. Numbers are always
+ *  written using the C locale, floats with the shortest representation that round-trips.
+ *
+ *  A writer constructed from a stream does not take ownership of it. Call Flush() once
+ *  all output has been generated - the destructor flushes too, but cannot report errors.
+ *  A writer constructed from a file name opens the file only when the first data is
+ *  written out and closes it on destruction, so an export which fails early leaves no
+ *  file behind.
+ */
+// --------------------------------------------------------------------------------------------
+class TextStreamWriter
+{
+public:
+    enum {
+        DEFAULT_BUFFER_SIZE = 64 * 1024
+    };
+
+    // ---------------------------------------------------------------------
+    /** Construction from a given stream.
+     *  @param stream Output stream. The stream is not re-seeked and writing
+     *    continues at the current position of the stream cursor.
+     *  @param bufferSize Number of bytes to collect before writing to the
+     *    stream.  */
+    explicit TextStreamWriter(IOStream* stream, size_t bufferSize = DEFAULT_BUFFER_SIZE)
+        : mStream(stream)
+        , mIOSystem()
+        , mBuffer(bufferSize < AI_TEXT_NUMBER_MAXLEN ? AI_TEXT_NUMBER_MAXLEN : bufferSize)
+        , mCursor()
+        , mWritten()
+    {
+        ai_assert(nullptr != stream);
+    }
+
+    // ---------------------------------------------------------------------
+    /** Construction from a file name. The file is not opened before the
+     *  buffer fills up or Flush() is called, output still pending when the
+     *  writer is destroyed is dropped unless the file is open already.
+     *  @param io IO system to open and close the file with.
+     *  @param path Name of the output file.
+     *  @param mode Open mode, usually "wt" or "wb".
+     *  @param bufferSize Number of bytes to collect before writing to the
+     *    file.  */
+    TextStreamWriter(IOSystem* io, const std::string& path, const char* mode,
+            size_t bufferSize = DEFAULT_BUFFER_SIZE)
+        : mStream()
+        , mIOSystem(io)
+        , mPath(path)
+        , mMode(mode)
+        , mBuffer(bufferSize < AI_TEXT_NUMBER_MAXLEN ? AI_TEXT_NUMBER_MAXLEN : bufferSize)
+        , mCursor()
+        , mWritten()
+    {
+        ai_assert(nullptr != io);
+    }
+
+    // ---------------------------------------------------------------------
+    ~TextStreamWriter() {
+        if (mCursor && mStream) {
+            mStream->Write(&mBuffer[0], 1, mCursor);
+        }
+        if (mIOSystem && mStream) {
+            mIOSystem->Close(mStream);
+        }
+    }
+
+public:
+
+    // ---------------------------------------------------------------------
+    /** Write all buffered data to the stream.
+     *  @throw DeadlyExportError if the stream does not accept all of it */
+    void Flush() {
+        Spill();
+        Stream().Flush();
+    }
+
+    // ---------------------------------------------------------------------
+    /** Write a sequence of raw bytes */
+    void Write(const void* data, size_t length) {
+        if (length > mBuffer.size() - mCursor) {
+            Spill();
+            if (length >= mBuffer.size()) {
+                if (Stream().Write(data, 1, length) != length) {
+                    throw DeadlyExportError("TextStreamWriter: failed to write to the output stream");
+                }
+                mWritten += length;
+                return;
+            }
+        }
+        ::memcpy(&mBuffer[mCursor], data, length);
+        mCursor += length;
+    }
+
+    // ---------------------------------------------------------------------
+    /** Write a single character */
+    void Put(char c) {
+        if (mCursor == mBuffer.size()) {
+            Spill();
+        }
+        mBuffer[mCursor++] = c;
+    }
+
+    // ---------------------------------------------------------------------
+    /** Get the total number of bytes written so far */
+    size_t Tell() const {
+        return mWritten + mCursor;
+    }
+
+public:
+
+    // ---------------------------------------------------------------------
+    TextStreamWriter& operator << (const char* s) {
+        Write(s, ::strlen(s));
+        return *this;
+    }
+
+    TextStreamWriter& operator << (const std::string& s) {
+        Write(s.data(), s.length());
+        return *this;
+    }
+
+    TextStreamWriter& operator << (char c) {
+        Put(c);
+        return *this;
+    }
+
+    TextStreamWriter& operator << (signed char c) {
+        Put(static_cast<char>(c));
+        return *this;
+    }
+
+    TextStreamWriter& operator << (unsigned char c) {
+        Put(static_cast<char>(c));
+        return *this;
+    }
+
+    // ---------------------------------------------------------------------
+    TextStreamWriter& operator << (short n)              { return PutInt(n); }
+    TextStreamWriter& operator << (int n)                { return PutInt(n); }
+    TextStreamWriter& operator << (long n)               { return PutInt(n); }
+    TextStreamWriter& operator << (long long n)          { return PutInt(n); }
+    TextStreamWriter& operator << (unsigned short n)     { return PutUInt(n); }
+    TextStreamWriter& operator << (unsigned int n)       { return PutUInt(n); }
+    TextStreamWriter& operator << (unsigned long n)      { return PutUInt(n); }
+    TextStreamWriter& operator << (unsigned long long n) { return PutUInt(n); }
+
+    // ---------------------------------------------------------------------
+    TextStreamWriter& operator << (float f) {
+        Reserve(AI_TEXT_NUMBER_MAXLEN);
+        mCursor = TextFormat::FormatFloat(&mBuffer[mCursor], f) - &mBuffer[0];
+        return *this;
+    }
+
+    TextStreamWriter& operator << (double d) {
+        Reserve(AI_TEXT_NUMBER_MAXLEN);
+        mCursor = TextFormat::FormatDouble(&mBuffer[mCursor], d) - &mBuffer[0];
+        return *this;
+    }
+
+    // ---------------------------------------------------------------------
+    /** Write a number with a fixed count of decimals, equivalent to printf's
+     *  "%.*f" conversion */
+    TextStreamWriter& PutFixed(double d, unsigned int decimals) {
+        Reserve(AI_TEXT_NUMBER_MAXLEN);
+        mCursor = TextFormat::FormatFixed(&mBuffer[mCursor], d, decimals) - &mBuffer[0];
+        return *this;
+    }
+
+private:
+
+    // ---------------------------------------------------------------------
+    /** Get the output stream, opening the output file on first use.
+     *  @throw DeadlyExportError if the file cannot be opened */
+    IOStream& Stream() {
+        if (!mStream) {
+            mStream = mIOSystem->Open(mPath, mMode);
+            if (!mStream) {
+                throw DeadlyExportError("could not open output file: " + mPath);
+            }
+        }
+        return *mStream;
+    }
+
+    // ---------------------------------------------------------------------
+    /** Hand the buffered data to the stream to make room for more, unlike
+     *  Flush() this leaves the stream's own buffering alone. */
+    void Spill() {
+        if (mCursor) {
+            const size_t count = mCursor;
+            mCursor = 0;
+            if (Stream().Write(&mBuffer[0], 1, count) != count) {
+                throw DeadlyExportError("TextStreamWriter: failed to write to the output stream");
+            }
+            mWritten += count;
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    void Reserve(size_t length) {
+        if (length > mBuffer.size() - mCursor) {
+            Spill();
+        }
+    }
+
+    TextStreamWriter& PutInt(int64_t n) {
+        Reserve(AI_TEXT_NUMBER_MAXLEN);
+        mCursor = TextFormat::FormatInt(&mBuffer[mCursor], n) - &mBuffer[0];
+        return *this;
+    }
+
+    TextStreamWriter& PutUInt(uint64_t n) {
+        Reserve(AI_TEXT_NUMBER_MAXLEN);
+        mCursor = TextFormat::FormatUInt(&mBuffer[mCursor], n) - &mBuffer[0];
+        return *this;
+    }
+
+private:
+    TextStreamWriter(const TextStreamWriter&);
+    TextStreamWriter& operator = (const TextStreamWriter&);
+
+    IOStream* mStream;
+    IOSystem* mIOSystem;
+    std::string mPath, mMode;
+    std::vector<char> mBuffer;
+    size_t mCursor;
+    size_t mWritten;
+};
+
+} // namespace Assimp
+
+#endif // !! AI_TEXTSTREAMWRITER_H_INCLUDED
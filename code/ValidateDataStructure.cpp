@@ -273,10 +273,66 @@ void ValidateDSProcess::Execute( aiScene* pScene)
         ReportError("aiScene::mMaterials is non-null although there are no materials");
     }
 
+    // validate the bounding volume hierarchy and its instances
+    if (pScene->mNumBVHNodes) {
+        if (!pScene->mBVHNodes || !pScene->mBVHInstances) {
+            ReportError("aiScene::mBVHNodes or aiScene::mBVHInstances is NULL (aiScene::mNumBVHNodes is %i)",
+                pScene->mNumBVHNodes);
+        }
+        Validate(pScene->mBVHNodes,pScene->mNumBVHNodes,pScene->mNumBVHInstances,"aiScene::mBVHNodes");
+        for (unsigned int i = 0; i < pScene->mNumBVHInstances;++i) {
+            const aiBVHInstance& instance = pScene->mBVHInstances[i];
+            if (!instance.mNode) {
+                ReportError("aiScene::mBVHInstances[%i].mNode is NULL",i);
+            }
+            if (instance.mMesh >= pScene->mNumMeshes) {
+                ReportError("aiScene::mBVHInstances[%i].mMesh is out of range",i);
+            }
+        }
+    }
+    else if (pScene->mBVHNodes || pScene->mBVHInstances) {
+        ReportError("aiScene::mBVHNodes is non-null although there is no bounding volume hierarchy");
+    }
+
 //  if (!has)ReportError("The aiScene data structure is empty");
     DefaultLogger::get()->debug("ValidateDataStructureProcess end");
 }
 
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::Validate( const aiBVHNode* pNodes, unsigned int iNumNodes,
+    unsigned int iNumPrimitives, const char* szOwner)
+{
+    // the children follow their parent, the leaves cover all primitives
+    unsigned int numPrimitives = 0;
+    for (unsigned int i = 0; i < iNumNodes;++i)
+    {
+        const aiBVHNode& node = pNodes[i];
+        if (node.mMin.x > node.mMax.x || node.mMin.y > node.mMax.y || node.mMin.z > node.mMax.z)
+        {
+            ReportError("%s[%i] has an empty bounding box",szOwner,i);
+        }
+        if (!node.mCount)
+        {
+            if (node.mFirst <= i || node.mFirst >= iNumNodes - 1)
+            {
+                ReportError("%s[%i]::mFirst is out of range",szOwner,i);
+            }
+        }
+        else
+        {
+            if (node.mFirst > iNumPrimitives || node.mCount > iNumPrimitives - node.mFirst)
+            {
+                ReportError("%s[%i] references primitives out of range",szOwner,i);
+            }
+            numPrimitives += node.mCount;
+        }
+    }
+    if (numPrimitives != iNumPrimitives)
+    {
+        ReportError("The leaves of %s cover %u primitives, but there are %u",szOwner,numPrimitives,iNumPrimitives);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate( const aiLight* pLight)
 {
@@ -509,6 +565,96 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
     {
         ReportError("aiMesh::mBones is non-null although there are no bones");
     }
+
+    // the meshlets must cover all faces in order and reference valid vertices
+    if (pMesh->mNumMeshlets)
+    {
+        if (!pMesh->mMeshlets || !pMesh->mMeshletVertices)
+        {
+            ReportError("aiMesh::mMeshlets or aiMesh::mMeshletVertices is NULL (aiMesh::mNumMeshlets is %i)",
+                pMesh->mNumMeshlets);
+        }
+        unsigned int faceOffset = 0, vertexOffset = 0;
+        for (unsigned int i = 0; i < pMesh->mNumMeshlets;++i)
+        {
+            const aiMeshlet& meshlet = pMesh->mMeshlets[i];
+            if (meshlet.mFaceOffset != faceOffset || !meshlet.mNumFaces)
+            {
+                ReportError("aiMesh::mMeshlets[%i] doesn't start after the faces of the previous meshlet",i);
+            }
+            if (meshlet.mVertexOffset != vertexOffset)
+            {
+                ReportError("aiMesh::mMeshlets[%i] doesn't start after the vertices of the previous meshlet",i);
+            }
+            faceOffset += meshlet.mNumFaces;
+            vertexOffset += meshlet.mNumVertices;
+        }
+        if (faceOffset != pMesh->mNumFaces)
+        {
+            ReportError("The meshlets cover %u faces, but there are %u",faceOffset,pMesh->mNumFaces);
+        }
+        if (vertexOffset != pMesh->mNumMeshletVertices)
+        {
+            ReportError("The meshlets reference %u vertices, but aiMesh::mNumMeshletVertices is %u",
+                vertexOffset,pMesh->mNumMeshletVertices);
+        }
+        for (unsigned int i = 0; i < pMesh->mNumMeshletVertices;++i)
+        {
+            if (pMesh->mMeshletVertices[i] >= pMesh->mNumVertices)
+            {
+                ReportError("aiMesh::mMeshletVertices[%i] is out of range",i);
+            }
+        }
+    }
+    else if (pMesh->mMeshlets)
+    {
+        ReportError("aiMesh::mMeshlets is non-null although there are no meshlets");
+    }
+
+    // the bounding volume hierarchy must reference every face
+    if (pMesh->mNumBVHNodes)
+    {
+        if (!pMesh->mBVHNodes || !pMesh->mBVHFaces)
+        {
+            ReportError("aiMesh::mBVHNodes or aiMesh::mBVHFaces is NULL (aiMesh::mNumBVHNodes is %i)",
+                pMesh->mNumBVHNodes);
+        }
+        Validate(pMesh->mBVHNodes,pMesh->mNumBVHNodes,pMesh->mNumFaces,"aiMesh::mBVHNodes");
+        for (unsigned int i = 0; i < pMesh->mNumFaces;++i)
+        {
+            if (pMesh->mBVHFaces[i] >= pMesh->mNumFaces)
+            {
+                ReportError("aiMesh::mBVHFaces[%i] is out of range",i);
+            }
+        }
+    }
+    else if (pMesh->mBVHNodes || pMesh->mBVHFaces)
+    {
+        ReportError("aiMesh::mBVHNodes is non-null although there is no bounding volume hierarchy");
+    }
+
+    // quantized streams need their float counterparts
+    if (const aiQuantizedVertices* qv = pMesh->mQuantizedVertices)
+    {
+        if (qv->mPositions && (!pMesh->mVertices || qv->mPositionBits < 2 || qv->mPositionBits > 16))
+        {
+            ReportError("aiMesh::mQuantizedVertices->mPositions is invalid (mPositionBits is %i)",
+                qv->mPositionBits);
+        }
+        if (qv->mNormals && (!pMesh->mNormals || qv->mNormalBits < 2 || qv->mNormalBits > 16))
+        {
+            ReportError("aiMesh::mQuantizedVertices->mNormals is invalid (mNormalBits is %i)",
+                qv->mNormalBits);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS;++i)
+        {
+            if (qv->mTextureCoords[i] && !pMesh->mTextureCoords[i])
+            {
+                ReportError("aiMesh::mQuantizedVertices->mTextureCoords[%i] is non-null although "
+                    "there are no texture coordinates in the channel",i);
+            }
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -59,6 +59,7 @@ struct aiNode;
 struct aiString;
 struct aiCamera;
 struct aiLight;
+struct aiBVHNode;
 
 namespace Assimp    {
 
@@ -153,6 +154,15 @@ protected:
      * @param Node Input node*/
     void Validate( const aiNode* pNode);
 
+    // -------------------------------------------------------------------
+    /** Validates a bounding volume hierarchy
+     * @param pNodes The nodes of the hierarchy, root first
+     * @param iNumNodes Number of nodes
+     * @param iNumPrimitives Number of primitives the leaves reference
+     * @param szOwner Name of the node array for error messages */
+    void Validate( const aiBVHNode* pNodes, unsigned int iNumNodes,
+        unsigned int iNumPrimitives, const char* szOwner);
+
     // -------------------------------------------------------------------
     /** Validates a string
      * @param pString Input string*/
@@ -128,6 +128,10 @@ ASSIMP_API aiScene::aiScene()
 , mLights(NULL)
 , mNumCameras(0)
 , mCameras(NULL)
+, mNumBVHNodes(0)
+, mBVHNodes(NULL)
+, mNumBVHInstances(0)
+, mBVHInstances(NULL)
 , mPrivate(new Assimp::ScenePrivateData()) {
 	// empty
 }
@@ -171,5 +175,8 @@ ASSIMP_API aiScene::~aiScene()
             delete mCameras[a];
     delete [] mCameras;
 
+    delete [] mBVHNodes;
+    delete [] mBVHInstances;
+
     delete static_cast<Assimp::ScenePrivateData*>( mPrivate );
 }
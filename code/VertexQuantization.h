@@ -0,0 +1,257 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file VertexQuantization.h
+ *  @brief Encoding and decoding of the quantized vertex streams of aiMesh
+ */
+#ifndef AI_VERTEXQUANTIZATION_H_INC
+#define AI_VERTEXQUANTIZATION_H_INC
+
+#include <assimp/mesh.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdint.h>
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** Converts a float to the nearest IEEE 754 half-precision float. Values
+ *  beyond the half range become infinite, NaNs stay NaNs. */
+inline uint16_t FloatToHalf(float f)
+{
+    uint32_t bits;
+    ::memcpy(&bits, &f, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t abs = bits & 0x7fffffffu;
+
+    if (abs >= 0x7f800000u) {
+        // infinity or NaN, keep NaNs quiet
+        return static_cast<uint16_t>(sign | 0x7c00u | (abs > 0x7f800000u ? 0x200u : 0u));
+    }
+    if (abs >= 0x477ff000u) {
+        // rounds to 65520 or more, which is out of range
+        return static_cast<uint16_t>(sign | 0x7c00u);
+    }
+    if (abs < 0x38800000u) {
+        // denormal half. Adding 0.5 leaves the value in units of 2^-24 in the
+        // low mantissa bits, rounded to nearest even by the FPU.
+        float a;
+        ::memcpy(&a, &abs, sizeof(a));
+        a += 0.5f;
+        uint32_t r;
+        ::memcpy(&r, &a, sizeof(r));
+        return static_cast<uint16_t>(sign | (r - 0x3f000000u));
+    }
+
+    // rebias the exponent from 127 to 15 and round the mantissa to nearest even
+    abs += 0xc8000fffu + ((abs >> 13) & 1u);
+    return static_cast<uint16_t>(sign | (abs >> 13));
+}
+
+// ---------------------------------------------------------------------------
+/** Converts an IEEE 754 half-precision float to a float. */
+inline float HalfToFloat(uint16_t h)
+{
+    const uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    const uint32_t exponent = (h >> 10) & 0x1fu, mantissa = h & 0x3ffu;
+
+    uint32_t bits;
+    if (exponent == 0x1f) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    }
+    else if (exponent == 0) {
+        const float f = mantissa * (1.0f / 16777216.0f);
+        return sign ? -f : f;
+    }
+    else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float f;
+    ::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// ---------------------------------------------------------------------------
+/** Largest value of a signed normalized integer with the given number of bits */
+inline int GetSnormMax(unsigned int bits)
+{
+    return (1 << (bits - 1)) - 1;
+}
+
+// ---------------------------------------------------------------------------
+/** Checks whether a quantized octahedral normal holds one of the reserved
+ *  codes below the valid range [-m, m], which EncodeOctahedral() uses for
+ *  normals that have no direction. */
+inline bool IsReservedOctahedral(const short* q, unsigned int bits)
+{
+    return q[0] < -GetSnormMax(bits);
+}
+
+// ---------------------------------------------------------------------------
+/** Maps octahedral coordinates in [-1, 1] back to a unit vector. */
+inline aiVector3D DecodeOctahedral(ai_real x, ai_real y)
+{
+    aiVector3D n(x, y, 1 - std::fabs(x) - std::fabs(y));
+    if (n.z < 0) {
+        n.x = (1 - std::fabs(y)) * (x >= 0 ? 1 : -1);
+        n.y = (1 - std::fabs(x)) * (y >= 0 ? 1 : -1);
+    }
+    return n.Normalize();
+}
+
+// ---------------------------------------------------------------------------
+/** Decodes a quantized octahedral normal. The reserved codes decode to a
+ *  zero vector and to a quiet NaN vector. */
+inline aiVector3D DecodeOctahedral(const short* q, unsigned int bits)
+{
+    if (IsReservedOctahedral(q, bits)) {
+        return IsReservedOctahedral(q + 1, bits) ? aiVector3D(std::numeric_limits<ai_real>::quiet_NaN()) : aiVector3D();
+    }
+
+    const ai_real m = static_cast<ai_real>(GetSnormMax(bits));
+    return DecodeOctahedral(std::max(q[0] / m, ai_real(-1)), std::max(q[1] / m, ai_real(-1)));
+}
+
+// ---------------------------------------------------------------------------
+/** Quantizes a normal to octahedral coordinates. Of the four grid points
+ *  around the exact mapping, the one decoding closest to the normal is
+ *  chosen. Zero-length normals are stored as (-m-1, 0) and non-finite ones,
+ *  such as the NaNs normal generation leaves on points and lines, as
+ *  (-m-1, -m-1).
+ * @return The angle between the normal and its decoded value, in radians
+ */
+inline ai_real EncodeOctahedral(const aiVector3D& normal, unsigned int bits, short* q)
+{
+    const ai_real len = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (!(len > 0) || !std::isfinite(len)) {
+        const short reserved = static_cast<short>(-GetSnormMax(bits) - 1);
+        q[0] = reserved;
+        q[1] = len == 0 ? 0 : reserved;
+        return 0;
+    }
+
+    ai_real x = normal.x / len, y = normal.y / len;
+    if (normal.z < 0) {
+        const ai_real fx = (1 - std::fabs(y)) * (x >= 0 ? 1 : -1);
+        y = (1 - std::fabs(x)) * (y >= 0 ? 1 : -1);
+        x = fx;
+    }
+
+    const aiVector3D n = normal / normal.Length();
+    const int m = GetSnormMax(bits);
+    const int x0 = static_cast<int>(std::floor(x * m)), y0 = static_cast<int>(std::floor(y * m));
+    // compare distances rather than dot products, which are too close to 1 for single precision
+    ai_real best = 3;
+    for (int i = 0; i < 4; ++i) {
+        const int qx = std::min(std::max(x0 + (i & 1), -m), m);
+        const int qy = std::min(std::max(y0 + (i >> 1), -m), m);
+        const ai_real d = (DecodeOctahedral(static_cast<ai_real>(qx) / m, static_cast<ai_real>(qy) / m) - n).Length();
+        if (d < best) {
+            best = d;
+            q[0] = static_cast<short>(qx);
+            q[1] = static_cast<short>(qy);
+        }
+    }
+    return 2 * std::asin(std::min(best / 2, ai_real(1)));
+}
+
+// ---------------------------------------------------------------------------
+/** Decodes a quantized position. */
+inline aiVector3D DequantizePosition(const aiQuantizedVertices& qv, const unsigned short* q)
+{
+    return aiVector3D(qv.mPositionOffset.x + qv.mPositionScale.x * q[0],
+        qv.mPositionOffset.y + qv.mPositionScale.y * q[1],
+        qv.mPositionOffset.z + qv.mPositionScale.z * q[2]);
+}
+
+// ---------------------------------------------------------------------------
+/** Overwrites the float streams of a mesh with the values decoded from
+ *  aiMesh::mQuantizedVertices, allocating them if necessary. Texture
+ *  coordinate streams with other than 1 to 3 components are skipped. */
+inline void DequantizeVertices(aiMesh* mesh)
+{
+    const aiQuantizedVertices* qv = mesh->mQuantizedVertices;
+    if (!qv) {
+        return;
+    }
+
+    if (qv->mPositions) {
+        if (!mesh->mVertices) {
+            mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        }
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            mesh->mVertices[i] = DequantizePosition(*qv, qv->mPositions + 3 * i);
+        }
+    }
+    if (qv->mNormals) {
+        if (!mesh->mNormals) {
+            mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+        }
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            mesh->mNormals[i] = DecodeOctahedral(qv->mNormals + 2 * i, qv->mNormalBits);
+        }
+    }
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        const unsigned int numComponents = mesh->mNumUVComponents[n];
+        if (!qv->mTextureCoords[n] || numComponents < 1 || numComponents > 3) {
+            continue;
+        }
+        if (!mesh->mTextureCoords[n]) {
+            mesh->mTextureCoords[n] = new aiVector3D[mesh->mNumVertices];
+        }
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            const unsigned short* q = qv->mTextureCoords[n] + numComponents * i;
+            aiVector3D& uv = mesh->mTextureCoords[n][i];
+            uv = aiVector3D();
+            for (unsigned int c = 0; c < numComponents; ++c) {
+                uv[c] = HalfToFloat(q[c]);
+            }
+        }
+    }
+}
+
+} // end of namespace Assimp
+
+#endif // AI_VERTEXQUANTIZATION_H_INC
@@ -408,10 +408,10 @@ bool X3DImporter::XML_SearchNode(const std::string& pNodeName)
 
 bool X3DImporter::XML_ReadNode_GetAttrVal_AsBool(const int pAttrIdx)
 {
-    auto boolValue = std::dynamic_pointer_cast<const FIBoolValue>(mReader->getAttributeEncodedValue(pAttrIdx));
-    if (boolValue) {
-        if (boolValue->value.size() == 1) {
-            return boolValue->value.front();
+    std::vector<bool> boolValue;
+    if (mReader->getAttributeValueAsBoolArray(pAttrIdx, boolValue)) {
+        if (boolValue.size() == 1) {
+            return boolValue.front();
         }
         throw DeadlyImportError("Invalid bool value");
     }
@@ -429,10 +429,10 @@ bool X3DImporter::XML_ReadNode_GetAttrVal_AsBool(const int pAttrIdx)
 
 float X3DImporter::XML_ReadNode_GetAttrVal_AsFloat(const int pAttrIdx)
 {
-    auto floatValue = std::dynamic_pointer_cast<const FIFloatValue>(mReader->getAttributeEncodedValue(pAttrIdx));
-    if (floatValue) {
-        if (floatValue->value.size() == 1) {
-            return floatValue->value.front();
+    std::vector<float> floatValue;
+    if (mReader->getAttributeValueAsFloatArray(pAttrIdx, floatValue)) {
+        if (floatValue.size() == 1) {
+            return floatValue.front();
         }
         throw DeadlyImportError("Invalid float value");
     }
@@ -449,10 +449,10 @@ float X3DImporter::XML_ReadNode_GetAttrVal_AsFloat(const int pAttrIdx)
 
 int32_t X3DImporter::XML_ReadNode_GetAttrVal_AsI32(const int pAttrIdx)
 {
-    auto intValue = std::dynamic_pointer_cast<const FIIntValue>(mReader->getAttributeEncodedValue(pAttrIdx));
-    if (intValue) {
-        if (intValue->value.size() == 1) {
-            return intValue->value.front();
+    std::vector<int32_t> intValue;
+    if (mReader->getAttributeValueAsIntArray(pAttrIdx, intValue)) {
+        if (intValue.size() == 1) {
+            return intValue.front();
         }
         throw DeadlyImportError("Invalid int value");
     }
@@ -504,11 +504,8 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsVec3f(const int pAttrIdx, aiVector3D
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrB(const int pAttrIdx, std::vector<bool>& pValue)
 {
-    auto boolValue = std::dynamic_pointer_cast<const FIBoolValue>(mReader->getAttributeEncodedValue(pAttrIdx));
-    if (boolValue) {
-        pValue = boolValue->value;
-    }
-    else {
+    // values carried by any of the numeric FI encodings are converted directly, only text is parsed.
+    if (!mReader->getAttributeValueAsBoolArray(pAttrIdx, pValue)) {
         const char *val = mReader->getAttributeValue(pAttrIdx);
         pValue.clear();
 
@@ -524,11 +521,7 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsArrB(const int pAttrIdx, std::vector
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrI32(const int pAttrIdx, std::vector<int32_t>& pValue)
 {
-    auto intValue = std::dynamic_pointer_cast<const FIIntValue>(mReader->getAttributeEncodedValue(pAttrIdx));
-    if (intValue) {
-        pValue = intValue->value;
-    }
-    else {
+    if (!mReader->getAttributeValueAsIntArray(pAttrIdx, pValue)) {
         const char *val = mReader->getAttributeValue(pAttrIdx);
         pValue.clear();
 
@@ -544,11 +537,7 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsArrI32(const int pAttrIdx, std::vect
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrF(const int pAttrIdx, std::vector<float>& pValue)
 {
-    auto floatValue = std::dynamic_pointer_cast<const FIFloatValue>(mReader->getAttributeEncodedValue(pAttrIdx));
-    if (floatValue) {
-        pValue = floatValue->value;
-    }
-    else {
+    if (!mReader->getAttributeValueAsFloatArray(pAttrIdx, pValue)) {
         const char *val = mReader->getAttributeValue(pAttrIdx);
         pValue.clear();
 
@@ -603,15 +592,14 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsListCol3f(const int pAttrIdx, std::l
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrCol3f(const int pAttrIdx, std::vector<aiColor3D>& pValue)
 {
-    std::list<aiColor3D> tlist;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListCol3f(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-		for(std::list<aiColor3D>::iterator it = tlist.begin(); it != tlist.end(); it++) pValue.push_back(*it);
-	}
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);// read flat, without an intermediate list
+	if(tlist.size() % 3) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
+
+	// copy data to array
+	pValue.reserve(pValue.size() + tlist.size() / 3);
+	for(size_t i = 0; i < tlist.size(); i += 3) pValue.push_back(aiColor3D(tlist[i], tlist[i + 1], tlist[i + 2]));
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsListCol4f(const int pAttrIdx, std::list<aiColor4D>& pValue)
@@ -636,18 +624,14 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsListCol4f(const int pAttrIdx, std::l
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrCol4f(const int pAttrIdx, std::vector<aiColor4D>& pValue)
 {
-    std::list<aiColor4D> tlist;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListCol4f(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-        for ( std::list<aiColor4D>::iterator it = tlist.begin(); it != tlist.end(); it++ )
-        {
-            pValue.push_back( *it );
-        }
-	}
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);// read flat, without an intermediate list
+	if(tlist.size() % 4) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
+
+	// copy data to array
+	pValue.reserve(pValue.size() + tlist.size() / 4);
+	for(size_t i = 0; i < tlist.size(); i += 4) pValue.push_back(aiColor4D(tlist[i], tlist[i + 1], tlist[i + 2], tlist[i + 3]));
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsListVec2f(const int pAttrIdx, std::list<aiVector2D>& pValue)
@@ -673,18 +657,14 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsListVec2f(const int pAttrIdx, std::l
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrVec2f(const int pAttrIdx, std::vector<aiVector2D>& pValue)
 {
-    std::list<aiVector2D> tlist;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListVec2f(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-        for ( std::list<aiVector2D>::iterator it = tlist.begin(); it != tlist.end(); it++ )
-        {
-            pValue.push_back( *it );
-        }
-	}
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);// read flat, without an intermediate list
+	if(tlist.size() % 2) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
+
+	// copy data to array
+	pValue.reserve(pValue.size() + tlist.size() / 2);
+	for(size_t i = 0; i < tlist.size(); i += 2) pValue.push_back(aiVector2D(tlist[i], tlist[i + 1]));
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsListVec3f(const int pAttrIdx, std::list<aiVector3D>& pValue)
@@ -711,18 +691,14 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsListVec3f(const int pAttrIdx, std::l
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrVec3f(const int pAttrIdx, std::vector<aiVector3D>& pValue)
 {
-    std::list<aiVector3D> tlist;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListVec3f(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-        for ( std::list<aiVector3D>::iterator it = tlist.begin(); it != tlist.end(); it++ )
-        {
-            pValue.push_back( *it );
-        }
-	}
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);// read flat, without an intermediate list
+	if(tlist.size() % 3) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
+
+	// copy data to array
+	pValue.reserve(pValue.size() + tlist.size() / 3);
+	for(size_t i = 0; i < tlist.size(); i += 3) pValue.push_back(aiVector3D(tlist[i], tlist[i + 1], tlist[i + 2]));
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsListS(const int pAttrIdx, std::list<std::string>& pValue)
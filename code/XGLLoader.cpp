@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "StreamReader.h"
 #include "MemoryIOWrapper.h"
 #include <assimp/mesh.h>
+#include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/importerdesc.h>
 #include <cctype>
@@ -105,7 +106,8 @@ static const aiImporterDesc desc = {
 // Constructor to be privately used by Importer
 XGLImporter::XGLImporter()
 : m_reader( nullptr )
-, m_scene( nullptr ) {
+, m_scene( nullptr )
+, m_usePullReader( false ) {
     // empty
 }
 
@@ -145,6 +147,13 @@ const aiImporterDesc* XGLImporter::GetInfo () const
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the loader
+void XGLImporter::SetupProperties(const Importer* pImp)
+{
+    m_usePullReader = pImp->GetPropertyBool(AI_CONFIG_IMPORT_XGL_PULL_READER,pImp->GetPropertyBool(AI_CONFIG_IMPORT_XML_PULL_READER,false));
+}
+
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure.
 void XGLImporter::InternReadFile( const std::string& pFile,
@@ -215,9 +224,8 @@ void XGLImporter::InternReadFile( const std::string& pFile,
 #endif
     }
 
-    // construct the irrXML parser
-    CIrrXML_IOStreamReader st(stream.get());
-    m_reader.reset( createIrrXMLReader( ( IFileReadCallBack* ) &st ) );
+    // construct the XML parser
+    m_reader.reset( CreateXmlReader( stream.get(), m_usePullReader ) );
 
     // parse the XML file
     TempScope scope;
@@ -46,7 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_XGLLOADER_H_INCLUDED
 
 #include "BaseImporter.h"
-#include "irrXMLWrapper.h"
+#include "XmlPullReader.h"
 #include "LogAux.h"
 #include <assimp/material.h>
 #include <assimp/Importer.hpp>
@@ -87,6 +87,12 @@ protected:
      * See #BaseImporter::GetInfo for the details  */
     const aiImporterDesc* GetInfo () const;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ReadFile().
+     * The function is a request to the importer to update its configuration
+     * basing on the Importer's configuration property list.  */
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     /** Imports the given file into the given scene structure.
      * See BaseImporter::InternReadFile() for details */
@@ -208,6 +214,7 @@ private:
 private:
     std::shared_ptr<irr::io::IrrXMLReader> m_reader;
     aiScene* m_scene;
+    bool m_usePullReader;
 };
 
 } // end of namespace Assimp
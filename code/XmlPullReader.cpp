@@ -0,0 +1,595 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  XmlPullReader.cpp
+ *  @brief Implementation of the in-situ XML pull parser.
+ */
+
+#include "XmlPullReader.h"
+#include "fast_atof.h"
+#include "Hash.h"
+#include <string.h>
+
+using namespace Assimp;
+using namespace irr::io;
+
+namespace {
+
+    // ------------------------------------------------------------------------------------------------
+    inline bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Replace the predefined XML entities in [begin,end) in place, returns the new end.
+    // Like irrXML, character references are left untouched.
+    char* DecodeEntities(char* begin, char* end) {
+        char* in = static_cast<char*>(::memchr(begin,'&',end - begin));
+        if (!in) {
+            return end;
+        }
+
+        static const struct {
+            const char* name;
+            size_t length;
+            char c;
+        } entities[] = {
+            {"amp;",4,'&'},
+            {"lt;",3,'<'},
+            {"gt;",3,'>'},
+            {"quot;",5,'\"'},
+            {"apos;",5,'\''}
+        };
+
+        char* out = in;
+        while (in < end) {
+            if (*in == '&') {
+                bool found = false;
+                for (size_t i = 0; i < sizeof(entities) / sizeof(entities[0]); ++i) {
+                    const size_t len = entities[i].length;
+                    if (static_cast<size_t>(end - in - 1) >= len && !::memcmp(in + 1,entities[i].name,len)) {
+                        *out++ = entities[i].c;
+                        in += len + 1;
+                        found = true;
+                        break;
+                    }
+                }
+                if (found) {
+                    continue;
+                }
+            }
+            *out++ = *in++;
+        }
+        return out;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    int ToInt(const char* value) {
+        // irrXML parses integers as floats, so be compatible for non-integral input
+        const char* end = value;
+        const int ret = strtol10(value,&end);
+        if (end == value || *end == '.' || *end == 'e' || *end == 'E') {
+            return static_cast<int>(fast_atof(value));
+        }
+        return ret;
+    }
+
+    const char EmptyString[] = "";
+}
+
+// ------------------------------------------------------------------------------------------------
+XmlPullReader::XmlPullReader(IOStream* stream)
+{
+    CIrrXML_IOStreamReader::ReadAndConvert(stream,data);
+    Setup();
+}
+
+// ------------------------------------------------------------------------------------------------
+XmlPullReader::XmlPullReader(const char* text, size_t length)
+: data(text,text + length)
+{
+    Setup();
+}
+
+// ------------------------------------------------------------------------------------------------
+void XmlPullReader::Setup()
+{
+    // two terminators: one ends the last node, one marks the end of the input
+    data.push_back('\0');
+    data.push_back('\0');
+
+    cursor = &data[0];
+
+    // UTF-16 input has its zero bytes stripped by ReadAndConvert, which leaves
+    // the bare byte order mark in front of otherwise plain 8 bit text. irrXML
+    // misreads such files as UTF-16, skip the mark and parse the text instead.
+    const unsigned char* bom = reinterpret_cast<const unsigned char*>(cursor);
+    if ((bom[0] == 0xff && bom[1] == 0xfe) || (bom[0] == 0xfe && bom[1] == 0xff)) {
+        cursor += 2;
+    }
+    at_tag = false;
+    node_type = EXN_NONE;
+    node_name = EmptyString;
+    empty_element = false;
+    num_interned = 0;
+    interned.resize(64);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool XmlPullReader::read()
+{
+    if (*cursor || at_tag) {
+        ParseCurrentNode();
+        return true;
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void XmlPullReader::ParseCurrentNode()
+{
+    if (!at_tag) {
+        char* start = cursor;
+        while (*cursor != '<' && *cursor) {
+            ++cursor;
+        }
+
+        if (!*cursor) {
+            // trailing text, irrXML keeps reporting the previous node
+            return;
+        }
+
+        if (cursor > start && SetText(start,cursor)) {
+            return;
+        }
+    }
+
+    at_tag = false;
+    ++cursor;
+
+    switch (*cursor) {
+    case '/':
+        ParseClosingElement();
+        break;
+    case '?':
+        IgnoreDefinition();
+        break;
+    case '!':
+        if (!ParseCDATA()) {
+            ParseComment();
+        }
+        break;
+    default:
+        ParseOpeningElement();
+        break;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool XmlPullReader::SetText(char* start, char* end)
+{
+    // short whitespace-only text is not reported
+    if (end - start < 3) {
+        char* p = start;
+        for (; p != end; ++p) {
+            if (!IsSpace(*p)) {
+                break;
+            }
+        }
+        if (p == end) {
+            return false;
+        }
+    }
+
+    // the terminator may overwrite the `<` of the next node
+    *DecodeEntities(start,end) = '\0';
+    at_tag = true;
+
+    node_type = EXN_TEXT;
+    node_name = start;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void XmlPullReader::IgnoreDefinition()
+{
+    node_type = EXN_UNKNOWN;
+
+    // move until end marked with '>' reached
+    while (*cursor != '>' && *cursor) {
+        ++cursor;
+    }
+    if (*cursor) {
+        ++cursor;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void XmlPullReader::ParseComment()
+{
+    node_type = EXN_COMMENT;
+    ++cursor;
+
+    char* begin = cursor;
+
+    // move until end of comment reached
+    int count = 1;
+    while (count && *cursor) {
+        if (*cursor == '>') {
+            --count;
+        }
+        else if (*cursor == '<') {
+            ++count;
+        }
+        ++cursor;
+    }
+
+    // strip `--` on both sides
+    char* end = cursor - 3;
+    if (count || end < begin + 2) {
+        node_name = EmptyString;
+        return;
+    }
+
+    *end = '\0';
+    node_name = begin + 2;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool XmlPullReader::ParseCDATA()
+{
+    if (cursor[1] != '[') {
+        return false;
+    }
+
+    node_type = EXN_CDATA;
+
+    // skip '<![CDATA['
+    for (int count = 0; *cursor && count < 8; ++count) {
+        ++cursor;
+    }
+
+    if (!*cursor) {
+        return true;
+    }
+
+    char* begin = cursor;
+    char* end = NULL;
+
+    // find end of CDATA
+    while (*cursor && !end) {
+        if (*cursor == '>' && cursor[-1] == ']' && cursor[-2] == ']') {
+            end = cursor - 2;
+        }
+        ++cursor;
+    }
+
+    if (end) {
+        *end = '\0';
+        node_name = begin;
+    }
+    else {
+        node_name = EmptyString;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void XmlPullReader::ParseOpeningElement()
+{
+    node_type = EXN_ELEMENT;
+    empty_element = false;
+    attributes.clear();
+
+    // find name
+    char* start_name = cursor;
+    while (*cursor != '>' && !IsSpace(*cursor) && *cursor) {
+        ++cursor;
+    }
+    char* end_name = cursor;
+
+    // find attributes
+    while (*cursor != '>' && *cursor) {
+        if (IsSpace(*cursor)) {
+            ++cursor;
+            continue;
+        }
+
+        if (*cursor == '/') {
+            // tag is closed directly
+            ++cursor;
+            empty_element = true;
+            break;
+        }
+
+        // read the attribute name
+        char* name = cursor;
+        while (!IsSpace(*cursor) && *cursor != '=' && *cursor) {
+            ++cursor;
+        }
+        char* end_attr_name = cursor;
+        if (!*cursor) {
+            break;
+        }
+        ++cursor;
+
+        // read the attribute value, which may be quoted in both ways
+        while (*cursor != '\"' && *cursor != '\'' && *cursor) {
+            ++cursor;
+        }
+        if (!*cursor) {
+            break;
+        }
+
+        const char quote = *cursor++;
+        char* value = cursor;
+        while (*cursor != quote && *cursor) {
+            ++cursor;
+        }
+        if (!*cursor) {
+            break;
+        }
+        char* end_value = cursor++;
+
+        // everything up to here has been scanned, so terminate in place
+        *end_attr_name = '\0';
+        *DecodeEntities(value,end_value) = '\0';
+
+        Attribute attr;
+        attr.name = name;
+        attr.value = value;
+        attributes.push_back(attr);
+    }
+
+    // check if this tag is closing directly
+    if (end_name > start_name && end_name[-1] == '/') {
+        empty_element = true;
+        --end_name;
+    }
+
+    char* next = *cursor ? cursor + 1 : cursor;
+    *end_name = '\0';
+    node_name = Intern(start_name,end_name - start_name);
+    cursor = next;
+}
+
+// ------------------------------------------------------------------------------------------------
+void XmlPullReader::ParseClosingElement()
+{
+    node_type = EXN_ELEMENT_END;
+    empty_element = false;
+    attributes.clear();
+
+    ++cursor;
+    char* begin = cursor;
+    while (*cursor != '>' && *cursor) {
+        ++cursor;
+    }
+
+    // remove trailing whitespace, if any
+    char* end = cursor;
+    while (end > begin && IsSpace(end[-1])) {
+        --end;
+    }
+
+    char* next = *cursor ? cursor + 1 : cursor;
+    *end = '\0';
+    node_name = Intern(begin,end - begin);
+    cursor = next;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::Intern(const char* name)
+{
+    return Intern(name,::strlen(name));
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::Intern(const char* name, size_t length)
+{
+    const uint32_t hash = SuperFastHash(name,static_cast<uint32_t>(length));
+
+    const size_t mask = interned.size() - 1;
+    size_t slot = hash & mask;
+    for (; interned[slot].str; slot = (slot + 1) & mask) {
+        const InternEntry& e = interned[slot];
+        if (e.hash == hash && e.length == length && !::memcmp(e.str,name,length)) {
+            return e.str;
+        }
+    }
+
+    // names from the buffer are stable and zero-terminated,
+    // anything else needs to be copied.
+    const char* str = name;
+    if (name < &data.front() || name >= &data.back()) {
+        pool.push_back(std::string(name,length));
+        str = pool.back().c_str();
+    }
+
+    InternEntry& e = interned[slot];
+    e.str = str;
+    e.length = static_cast<uint32_t>(length);
+    e.hash = hash;
+
+    if (++num_interned * 2 > interned.size()) {
+        std::vector<InternEntry> old(interned.size() * 2);
+        old.swap(interned);
+
+        const size_t new_mask = interned.size() - 1;
+        for (const InternEntry& o : old) {
+            if (o.str) {
+                size_t s = o.hash & new_mask;
+                while (interned[s].str) {
+                    s = (s + 1) & new_mask;
+                }
+                interned[s] = o;
+            }
+        }
+    }
+    return str;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::FindAttribute(const char* name) const
+{
+    if (!name) {
+        return NULL;
+    }
+    for (const Attribute& attr : attributes) {
+        if (!::strcmp(attr.name,name)) {
+            return attr.value;
+        }
+    }
+    return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+EXML_NODE XmlPullReader::getNodeType() const
+{
+    return node_type;
+}
+
+// ------------------------------------------------------------------------------------------------
+int XmlPullReader::getAttributeCount() const
+{
+    return static_cast<int>(attributes.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::getAttributeName(int idx) const
+{
+    if (idx < 0 || idx >= static_cast<int>(attributes.size())) {
+        return NULL;
+    }
+    return attributes[idx].name;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::getAttributeValue(int idx) const
+{
+    if (idx < 0 || idx >= static_cast<int>(attributes.size())) {
+        return NULL;
+    }
+    return attributes[idx].value;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::getAttributeValue(const char* name) const
+{
+    return FindAttribute(name);
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::getAttributeValueSafe(const char* name) const
+{
+    const char* value = FindAttribute(name);
+    return value ? value : EmptyString;
+}
+
+// ------------------------------------------------------------------------------------------------
+int XmlPullReader::getAttributeValueAsInt(const char* name) const
+{
+    const char* value = FindAttribute(name);
+    return value ? ToInt(value) : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+int XmlPullReader::getAttributeValueAsInt(int idx) const
+{
+    const char* value = getAttributeValue(idx);
+    return value ? ToInt(value) : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+float XmlPullReader::getAttributeValueAsFloat(const char* name) const
+{
+    const char* value = FindAttribute(name);
+    return value ? static_cast<float>(fast_atof(value)) : 0.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+float XmlPullReader::getAttributeValueAsFloat(int idx) const
+{
+    const char* value = getAttributeValue(idx);
+    return value ? static_cast<float>(fast_atof(value)) : 0.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::getNodeName() const
+{
+    return node_name;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XmlPullReader::getNodeData() const
+{
+    return node_name;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool XmlPullReader::isEmptyElement() const
+{
+    return empty_element;
+}
+
+// ------------------------------------------------------------------------------------------------
+ETEXT_FORMAT XmlPullReader::getSourceFormat() const
+{
+    // byte order marks have been removed by BaseImporter::ConvertToUTF8
+    return ETF_ASCII;
+}
+
+// ------------------------------------------------------------------------------------------------
+ETEXT_FORMAT XmlPullReader::getParserFormat() const
+{
+    return ETF_UTF8;
+}
+
+// ------------------------------------------------------------------------------------------------
+irr::io::IrrXMLReader* Assimp::CreateXmlReader(IOStream* stream, bool pull)
+{
+    if (pull) {
+        return new XmlPullReader(stream);
+    }
+
+    CIrrXML_IOStreamReader wrapper(stream);
+    return createIrrXMLReader(&wrapper);
+}
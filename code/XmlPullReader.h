@@ -0,0 +1,167 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  XmlPullReader.h
+ *  @brief In-situ XML pull parser implementing the irrXML reader interface.
+ */
+#ifndef INCLUDED_AI_XML_PULL_READER_H
+#define INCLUDED_AI_XML_PULL_READER_H
+
+#include "irrXMLWrapper.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------------
+/** @brief Fast drop-in replacement for the irrXML reader.
+ *
+ *  The reader keeps the whole (UTF-8 converted) file in a single buffer and
+ *  parses it in place: names, attribute values and text are zero-terminated
+ *  and entity-decoded right in the buffer, so all strings returned are views
+ *  into the source and no allocations take place while reading. Node
+ *  sequence and string contents are identical to those produced by irrXML,
+ *  so importers can switch between both readers freely.
+ *
+ *  Element names are interned: getNodeName() returns the same pointer for
+ *  all elements (opening and closing) of the same name, and #Intern yields
+ *  this pointer for a given name, so hot loops may compare names by pointer:
+ *  @code
+ *  const char* mesh = reader.Intern("mesh");
+ *  while (reader.read()) {
+ *      if (reader.getNodeType() == irr::io::EXN_ELEMENT && reader.getNodeName() == mesh) {
+ *          ...
+ *  @endcode
+ */
+class XmlPullReader : public irr::io::IrrXMLReader
+{
+public:
+    // ----------------------------------------------------------------------------------
+    //! Read the whole stream into memory and prepare parsing.
+    explicit XmlPullReader(IOStream* stream);
+
+    // ----------------------------------------------------------------------------------
+    //! Parse an in-memory XML document, which is copied.
+    XmlPullReader(const char* text, size_t length);
+
+    virtual ~XmlPullReader() {}
+
+public:
+    // IIrrXMLReader interface
+    bool read();
+    irr::io::EXML_NODE getNodeType() const;
+    int getAttributeCount() const;
+    const char* getAttributeName(int idx) const;
+    const char* getAttributeValue(int idx) const;
+    const char* getAttributeValue(const char* name) const;
+    const char* getAttributeValueSafe(const char* name) const;
+    int getAttributeValueAsInt(const char* name) const;
+    int getAttributeValueAsInt(int idx) const;
+    float getAttributeValueAsFloat(const char* name) const;
+    float getAttributeValueAsFloat(int idx) const;
+    const char* getNodeName() const;
+    const char* getNodeData() const;
+    bool isEmptyElement() const;
+    irr::io::ETEXT_FORMAT getSourceFormat() const;
+    irr::io::ETEXT_FORMAT getParserFormat() const;
+
+public:
+    // ----------------------------------------------------------------------------------
+    /** Get the interned representation of an element name. The returned
+     *  pointer compares equal to getNodeName() for all elements of this
+     *  name and stays valid as long as the reader exists. */
+    const char* Intern(const char* name);
+
+private:
+    void Setup();
+    void ParseCurrentNode();
+    bool SetText(char* start, char* end);
+    void IgnoreDefinition();
+    void ParseComment();
+    bool ParseCDATA();
+    void ParseOpeningElement();
+    void ParseClosingElement();
+
+    const char* Intern(const char* name, size_t length);
+    const char* FindAttribute(const char* name) const;
+
+private:
+    struct Attribute {
+        const char* name;
+        const char* value;
+    };
+
+    struct InternEntry {
+        const char* str;
+        uint32_t length;
+        uint32_t hash;
+    };
+
+    std::vector<char> data;
+    char* cursor;
+
+    // the `<` of the next node was overwritten by the terminator
+    // of the text node which is current right now
+    bool at_tag;
+
+    irr::io::EXML_NODE node_type;
+    const char* node_name;
+    bool empty_element;
+    std::vector<Attribute> attributes;
+
+    // open-addressing hash table of interned names, names
+    // which do not occur in the buffer are stored in the pool
+    std::vector<InternEntry> interned;
+    size_t num_interned;
+    std::deque<std::string> pool;
+};
+
+// ---------------------------------------------------------------------------------
+/** Create an XML reader for the given stream.
+ *  @param stream Input stream, needs not to outlive the reader
+ *  @param pull Use #XmlPullReader instead of irrXML
+ *  @return Reader instance, to be deleted by the caller. */
+irr::io::IrrXMLReader* CreateXmlReader(IOStream* stream, bool pull);
+
+} // ! Assimp
+
+#endif // !! INCLUDED_AI_XML_PULL_READER_H
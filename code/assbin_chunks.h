@@ -1,7 +1,7 @@
 #ifndef INCLUDED_ASSBIN_CHUNKS_H
 #define INCLUDED_ASSBIN_CHUNKS_H
 
-#define ASSBIN_VERSION_MAJOR 1
+#define ASSBIN_VERSION_MAJOR 2
 #define ASSBIN_VERSION_MINOR 0
 
 /**
@@ -72,7 +72,9 @@ byte[44]    Magic identification string for ASSBIN files.
 
 integer     Major version of the Assimp library which wrote the file
 integer     Minor version of the Assimp library which wrote the file
-                match these against ASSBIN_VERSION_MAJOR and ASSBIN_VERSION_MINOR
+                match these against ASSBIN_VERSION_MAJOR and ASSBIN_VERSION_MINOR,
+                readers reject files written by a newer version. Major version 2
+                added the quantized vertex streams.
 
 integer     SVN revision of the Assimp library (intended for our internal
             debugging - if you write Ass files from your own APPs, set this value to 0.
@@ -146,6 +148,21 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
      the kinds of vertex components actually present in the mesh. This is a
      bitwise combination of the ASSBIN_MESH_HAS_xxx constants.
 
+   - If ASSBIN_MESH_HAS_QUANTIZED_VERTICES is set, aiMesh::mQuantizedVertices
+     follows as:
+
+       integer bitwise combination of ASSBIN_MESH_HAS_POSITIONS,
+               ASSBIN_MESH_HAS_NORMALS and ASSBIN_MESH_HAS_TEXCOORD(n) for
+               the quantized streams
+       integer mPositionBits, float[3] mPositionOffset,
+               float[3] mPositionScale      (if positions are quantized)
+       integer mNormalBits                  (if normals are quantized)
+
+     Quantized streams are stored instead of the float ones, as short[3]
+     per vertex for positions, short[2] for normals and short[n] half floats
+     for texture coordinates with n = mNumUVComponents. Readers restore the
+     float streams from them. Shortened dumps never contain quantized data.
+
 [[aiFace]]
 
    - mNumIndices is stored as short
@@ -186,6 +203,7 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 #define ASSBIN_MESH_HAS_POSITIONS                   0x1
 #define ASSBIN_MESH_HAS_NORMALS                     0x2
 #define ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS     0x4
+#define ASSBIN_MESH_HAS_QUANTIZED_VERTICES          0x8
 #define ASSBIN_MESH_HAS_TEXCOORD_BASE               0x100
 #define ASSBIN_MESH_HAS_COLOR_BASE                  0x10000
 
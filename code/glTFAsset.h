@@ -422,7 +422,12 @@ namespace glTF
         template<class T>
         bool ExtractData(T*& outData);
 
-        void WriteData(size_t count, const void* src_buffer, size_t src_stride);
+        //! Reads all values of an integer scalar accessor (i.e. indices) into one flat array
+        bool ExtractIndices(std::vector<unsigned int>& outData);
+
+        //! Copy the elements to the buffer. A deferred buffer references \p src_buffer instead if
+        //! \p persistent is set, that is if it stays valid until the buffer has been written.
+        void WriteData(size_t count, const void* src_buffer, size_t src_stride, bool persistent = false);
 
         //! Helper class to iterate the data
         class Indexer
@@ -500,6 +505,19 @@ namespace glTF
 			~SEncodedRegion() { delete [] DecodedData; }
 		};
 
+		/// \struct SDeferredRange
+		/// Data appended to a deferred buffer. It is not copied into the buffer, but written straight
+		/// to the output stream when the asset is written.
+		struct SDeferredRange
+		{
+			size_t Offset;///< Offset of the range in the buffer, in bytes.
+			size_t Count;///< Number of elements.
+			const uint8_t* Data;///< Source elements, must stay valid until the buffer has been written.
+			size_t SrcStride;///< Size of one source element, in bytes.
+			size_t DstStride;///< Size of one element in the buffer, in bytes. Shorter source elements are padded with zeros.
+			shared_ptr<uint8_t> Copy;///< Storage of \ref Data if the source was not persistent and had to be copied.
+		};
+
 		/******************* Variables *******************/
 
 		//std::string uri; //!< The uri of the buffer. Can be a filepath, a data uri, etc. (required)
@@ -533,7 +551,13 @@ namespace glTF
 	private:
 
 		shared_ptr<uint8_t> mData; //!< Pointer to the data
+		size_t mCapacity; //!< Allocated size of \ref mData, can exceed byteLength while the buffer is being written
 		bool mIsSpecial; //!< Set to true for special cases (e.g. the body buffer)
+		bool mIsDeferred; //!< Set to true if the data is not kept in \ref mData, see \ref MarkAsDeferred
+
+		/// \var mDeferredRanges
+		/// Ranges appended to a deferred buffer, ordered by their offset.
+		std::vector<SDeferredRange> mDeferredRanges;
 
 		/// \var EncodedRegion_List
 		/// List of encoded regions.
@@ -571,9 +595,13 @@ namespace glTF
 		/// \param [in] pReplace_Data - pointer to array with new data for buffer.
 		/// \param [in] pReplace_Count - count of bytes in new data.
 		/// \return true - if successfully replaced, false if input arguments is out of range.
+		/// Replacing with data which is not larger than the replaced part (e.g. compressed mesh data) works in place.
 		bool ReplaceData(const size_t pBufferData_Offset, const size_t pBufferData_Count, const uint8_t* pReplace_Data, const size_t pReplace_Count);
 
         size_t AppendData(uint8_t* data, size_t length);
+
+        /// Enlarge the buffer by \p amount bytes. The storage grows geometrically, so appending many small
+        /// pieces (one per accessor or image when exporting) does not reallocate and copy the buffer each time.
         void Grow(size_t amount);
 
         uint8_t* GetPointer()
@@ -582,6 +610,29 @@ namespace glTF
         void MarkAsSpecial()
             { mIsSpecial = true; }
 
+        /// Switch an empty buffer to deferred mode, used for the GLB body when exporting. Grow() then only
+        /// reserves space and AppendData() and Accessor::WriteData() record ranges instead of copying the
+        /// data, which the AssetWriter streams to the file. The buffer has no storage, so GetPointer()
+        /// returns nullptr and ReplaceData() fails.
+        void MarkAsDeferred()
+            { ai_assert(byteLength == 0); mIsDeferred = true; }
+
+        bool IsDeferred() const
+            { return mIsDeferred; }
+
+        /// \fn void AppendDeferred(size_t pOffset, size_t pCount, const void* pData, size_t pSrcStride, size_t pDstStride, bool pPersistent)
+        /// Record a range of a deferred buffer, the space for it must already have been reserved by Grow().
+        /// \param [in] pOffset - offset of the range in the buffer, in bytes.
+        /// \param [in] pCount - number of elements.
+        /// \param [in] pData - source elements.
+        /// \param [in] pSrcStride - size of one source element, in bytes.
+        /// \param [in] pDstStride - size of one element in the buffer, in bytes.
+        /// \param [in] pPersistent - true if the source stays valid until the buffer has been written, it is copied otherwise.
+        void AppendDeferred(size_t pOffset, size_t pCount, const void* pData, size_t pSrcStride, size_t pDstStride, bool pPersistent);
+
+        const std::vector<SDeferredRange>& GetDeferredRanges() const
+            { return mDeferredRanges; }
+
         bool IsSpecial() const
             { return mIsSpecial; }
 
@@ -250,9 +250,31 @@ Ref<T> LazyDict<T>::Create(const char* id)
 // glTF dictionary objects methods
 //
 
+namespace {
+    inline void CopyData(size_t count,
+            const uint8_t* src, size_t src_stride,
+                  uint8_t* dst, size_t dst_stride)
+    {
+        if (src_stride == dst_stride) {
+            memcpy(dst, src, count * src_stride);
+        }
+        else {
+            size_t sz = std::min(src_stride, dst_stride);
+            for (size_t i = 0; i < count; ++i) {
+                memcpy(dst, src, sz);
+                if (sz < dst_stride) {
+                    memset(dst + sz, 0, dst_stride - sz);
+                }
+                src += src_stride;
+                dst += dst_stride;
+            }
+        }
+    }
+}
+
 
 inline Buffer::Buffer()
-	: byteLength(0), type(Type_arraybuffer), EncodedRegion_Current(nullptr), mIsSpecial(false)
+	: byteLength(0), type(Type_arraybuffer), EncodedRegion_Current(nullptr), mCapacity(0), mIsSpecial(false), mIsDeferred(false)
 { }
 
 inline Buffer::~Buffer()
@@ -290,7 +312,8 @@ inline void Buffer::Read(Value& obj, Asset& r)
         if (dataURI.base64) {
             uint8_t* data = 0;
             this->byteLength = Util::DecodeBase64(dataURI.data, dataURI.dataLength, data);
-            this->mData.reset(data);
+            this->mData.reset(data, std::default_delete<uint8_t[]>());
+            this->mCapacity = this->byteLength;
 
             if (statedLength > 0 && this->byteLength != statedLength) {
                 throw DeadlyImportError("GLTF: buffer \"" + id + "\", expected " + to_string(statedLength) +
@@ -303,11 +326,15 @@ inline void Buffer::Read(Value& obj, Asset& r)
                                         " bytes, but found " + to_string(dataURI.dataLength));
             }
 
-            this->mData.reset(new uint8_t[dataURI.dataLength]);
+            this->mData.reset(new uint8_t[dataURI.dataLength], std::default_delete<uint8_t[]>());
+            this->mCapacity = dataURI.dataLength;
             memcpy( this->mData.get(), dataURI.data, dataURI.dataLength );
         }
     }
     else { // Local file
+        // Buffers are read one at a time even if ASSIMP_BUILD_MULTITHREADED is set:
+        // all file access goes through the importer's IOSystem, which is not
+        // required to be thread-safe and offers no memory mapping.
         if (byteLength > 0) {
             IOStream* file = r.OpenFile(uri, "rb");
             if (file) {
@@ -332,7 +359,8 @@ inline bool Buffer::LoadFromStream(IOStream& stream, size_t length, size_t baseO
         stream.Seek(baseOffset, aiOrigin_SET);
     }
 
-    mData.reset(new uint8_t[byteLength]);
+    mData.reset(new uint8_t[byteLength], std::default_delete<uint8_t[]>());
+    mCapacity = byteLength;
 
     if (stream.Read(mData.get(), byteLength, 1) != 1) {
         return false;
@@ -393,21 +421,35 @@ inline void Buffer::EncodedRegion_SetCurrent(const std::string& pID)
 
 inline bool Buffer::ReplaceData(const size_t pBufferData_Offset, const size_t pBufferData_Count, const uint8_t* pReplace_Data, const size_t pReplace_Count)
 {
-const size_t new_data_size = byteLength + pReplace_Count - pBufferData_Count;
+	if((pBufferData_Count == 0) || (pReplace_Count == 0) || (pReplace_Data == nullptr) || mIsDeferred) return false;
+	if(pBufferData_Offset + pBufferData_Count > byteLength) return false;
 
-uint8_t* new_data;
+	const size_t tail_size = byteLength - pBufferData_Offset - pBufferData_Count;
+	const size_t new_data_size = byteLength + pReplace_Count - pBufferData_Count;
 
-	if((pBufferData_Count == 0) || (pReplace_Count == 0) || (pReplace_Data == nullptr)) return false;
+	if(new_data_size <= mCapacity)
+	{
+		// Enough storage: move the tail and overwrite the replaced part in place.
+		uint8_t* data = mData.get();
+
+		memmove(&data[pBufferData_Offset + pReplace_Count], &data[pBufferData_Offset + pBufferData_Count], tail_size);
+		memcpy(&data[pBufferData_Offset], pReplace_Data, pReplace_Count);
+	}
+	else
+	{
+		uint8_t* new_data = new uint8_t[new_data_size];
+
+		// Copy data which place before replacing part.
+		memcpy(new_data, mData.get(), pBufferData_Offset);
+		// Copy new data.
+		memcpy(&new_data[pBufferData_Offset], pReplace_Data, pReplace_Count);
+		// Copy data which place after replacing part.
+		memcpy(&new_data[pBufferData_Offset + pReplace_Count], &mData.get()[pBufferData_Offset + pBufferData_Count], tail_size);
+		// Apply new data
+		mData.reset(new_data, std::default_delete<uint8_t[]>());
+		mCapacity = new_data_size;
+	}
 
-	new_data = new uint8_t[new_data_size];
-	// Copy data which place before replacing part.
-	memcpy(new_data, mData.get(), pBufferData_Offset);
-	// Copy new data.
-	memcpy(&new_data[pBufferData_Offset], pReplace_Data, pReplace_Count);
-	// Copy data which place after replacing part.
-	memcpy(&new_data[pBufferData_Offset + pReplace_Count], &mData.get()[pBufferData_Offset + pBufferData_Count], pBufferData_Offset);
-	// Apply new data
-	mData.reset(new_data);
 	byteLength = new_data_size;
 
 	return true;
@@ -417,16 +459,53 @@ inline size_t Buffer::AppendData(uint8_t* data, size_t length)
 {
     size_t offset = this->byteLength;
     Grow(length);
-    memcpy(mData.get() + offset, data, length);
+    if (mIsDeferred) {
+        AppendDeferred(offset, length, data, 1, 1, false);
+    }
+    else {
+        memcpy(mData.get() + offset, data, length);
+    }
     return offset;
 }
 
+inline void Buffer::AppendDeferred(size_t pOffset, size_t pCount, const void* pData, size_t pSrcStride, size_t pDstStride, bool pPersistent)
+{
+    ai_assert(mIsDeferred);
+    ai_assert(pOffset + pCount * pDstStride <= byteLength);
+    ai_assert(mDeferredRanges.empty() || mDeferredRanges.back().Offset + mDeferredRanges.back().Count * mDeferredRanges.back().DstStride <= pOffset);
+
+    SDeferredRange range;
+    range.Offset = pOffset;
+    range.Count = pCount;
+    range.Data = reinterpret_cast<const uint8_t*>(pData);
+    range.SrcStride = pSrcStride;
+    range.DstStride = pDstStride;
+
+    if (!pPersistent) {
+        // take a copy in the layout of the buffer, so converting it while writing is not needed
+        range.Copy.reset(new uint8_t[pCount * pDstStride], std::default_delete<uint8_t[]>());
+        CopyData(pCount, range.Data, pSrcStride, range.Copy.get(), pDstStride);
+        range.Data = range.Copy.get();
+        range.SrcStride = pDstStride;
+    }
+    mDeferredRanges.push_back(range);
+}
+
 inline void Buffer::Grow(size_t amount)
 {
     if (amount <= 0) return;
-    uint8_t* b = new uint8_t[byteLength + amount];
-    if (mData) memcpy(b, mData.get(), byteLength);
-    mData.reset(b);
+    if (mIsDeferred) {
+        // only the space is reserved, the data is streamed out when the buffer is written
+        byteLength += amount;
+        return;
+    }
+    if (byteLength + amount > mCapacity) {
+        size_t capacity = std::max(byteLength + amount, mCapacity + mCapacity / 2);
+        uint8_t* b = new uint8_t[capacity];
+        if (mData) memcpy(b, mData.get(), byteLength);
+        mData.reset(b, std::default_delete<uint8_t[]>());
+        mCapacity = capacity;
+    }
     byteLength += amount;
 }
 
@@ -502,25 +581,27 @@ inline uint8_t* Accessor::GetPointer()
 }
 
 namespace {
-    inline void CopyData(size_t count,
-            const uint8_t* src, size_t src_stride,
-                  uint8_t* dst, size_t dst_stride)
+
+    //! Copies \p count elements of N bytes each out of a strided array, the fixed size allows to inline the copy
+    template<size_t N>
+    inline void CopyStridedElements(uint8_t* out, size_t outStride, const uint8_t* in, size_t inStride, size_t count)
     {
-        if (src_stride == dst_stride) {
-            memcpy(dst, src, count * src_stride);
+        for (size_t i = 0; i < count; ++i, out += outStride, in += inStride) {
+            memcpy(out, in, N);
         }
-        else {
-            size_t sz = std::min(src_stride, dst_stride);
-            for (size_t i = 0; i < count; ++i) {
-                memcpy(dst, src, sz);
-                if (sz < dst_stride) {
-                    memset(dst + sz, 0, dst_stride - sz);
-                }
-                src += src_stride;
-                dst += dst_stride;
-            }
+    }
+
+    //! Widens \p count unsigned integers of type T out of a strided array
+    template<class T>
+    inline void WidenStridedElements(unsigned int* out, const uint8_t* in, size_t inStride, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i, in += inStride) {
+            T value;
+            memcpy(&value, in, sizeof(T));
+            out[i] = value;
         }
     }
+
 }
 
 template<class T>
@@ -543,6 +624,12 @@ bool Accessor::ExtractData(T*& outData)
     if (stride == elemSize && targetElemSize == elemSize) {
         memcpy(outData, data, totalSize);
     }
+    else if (elemSize == 3 * sizeof(float)) { // e.g. interleaved VEC3 float
+        CopyStridedElements<3 * sizeof(float)>(reinterpret_cast<uint8_t*>(outData), targetElemSize, data, stride, count);
+    }
+    else if (elemSize == 2 * sizeof(float)) { // e.g. VEC2 float texture coordinates into aiVector3D
+        CopyStridedElements<2 * sizeof(float)>(reinterpret_cast<uint8_t*>(outData), targetElemSize, data, stride, count);
+    }
     else {
         for (size_t i = 0; i < count; ++i) {
             memcpy(outData + i, data + i*stride, elemSize);
@@ -552,13 +639,50 @@ bool Accessor::ExtractData(T*& outData)
     return true;
 }
 
-inline void Accessor::WriteData(size_t count, const void* src_buffer, size_t src_stride)
+inline bool Accessor::ExtractIndices(std::vector<unsigned int>& outData)
+{
+    uint8_t* data = GetPointer();
+    if (!data) return false;
+
+    const size_t elemSize = GetElementSize();
+    const size_t stride = byteStride ? byteStride : elemSize;
+
+    ai_assert(count*stride <= bufferView->byteLength);
+
+    outData.resize(count);
+    switch (elemSize) {
+        case 1:
+            WidenStridedElements<uint8_t>(outData.data(), data, stride, count);
+            break;
+        case 2:
+            WidenStridedElements<uint16_t>(outData.data(), data, stride, count);
+            break;
+        case 4:
+            WidenStridedElements<uint32_t>(outData.data(), data, stride, count);
+            break;
+        default: {
+            Indexer indexer(*this);
+            for (size_t i = 0; i < count; ++i) {
+                outData[i] = indexer.GetUInt(int(i));
+            }
+        }
+    }
+
+    return true;
+}
+
+inline void Accessor::WriteData(size_t count, const void* src_buffer, size_t src_stride, bool persistent)
 {
     uint8_t* buffer_ptr = bufferView->buffer->GetPointer();
     size_t offset = byteOffset + bufferView->byteOffset;
 
     size_t dst_stride = GetNumComponents() * GetBytesPerComponent();
 
+    if (bufferView->buffer->IsDeferred()) {
+        bufferView->buffer->AppendDeferred(offset, count, src_buffer, src_stride, dst_stride, persistent);
+        return;
+    }
+
     const uint8_t* src = reinterpret_cast<const uint8_t*>(src_buffer);
     uint8_t*       dst = reinterpret_cast<      uint8_t*>(buffer_ptr + offset);
 
@@ -1026,16 +1150,26 @@ Ref<Buffer> buf = pAsset_Root.buffers.Get(pCompression_Open3DGC.Buffer);
 
 	/****************** Set right array regions for decoder ******************/
 
-	auto get_buf_offset = [](Ref<Accessor>& pAccessor) -> size_t { return pAccessor->byteOffset + pAccessor->bufferView->byteOffset; };
+	// The accessors address the buffer, the decoded data starts at the offset of the encoded region.
+	auto get_buf_region = [&](Ref<Accessor>& pAccessor, size_t pSize) -> uint8_t* {
+		const size_t offset = pAccessor->byteOffset + pAccessor->bufferView->byteOffset;
+		if((offset < pCompression_Open3DGC.Offset) || (offset - pCompression_Open3DGC.Offset + pSize > decoded_data_size))
+		{
+			delete [] decoded_data;
+			throw DeadlyImportError("GLTF: Open3DGC. Accessor \"" + pAccessor->id + "\" is outside of the encoded region.");
+		}
+
+		return decoded_data + (offset - pCompression_Open3DGC.Offset);
+	};
 
 	// Indices
-	ifs.SetCoordIndex((IndicesType* const)(decoded_data + get_buf_offset(primitives[0].indices)));
+	ifs.SetCoordIndex((IndicesType* const)get_buf_region(primitives[0].indices, size_coordindex));
 	// Coordinates
-	ifs.SetCoord((o3dgc::Real* const)(decoded_data + get_buf_offset(primitives[0].attributes.position[0])));
+	ifs.SetCoord((o3dgc::Real* const)get_buf_region(primitives[0].attributes.position[0], size_coord));
 	// Normals
 	if(size_normal)
 	{
-		ifs.SetNormal((o3dgc::Real* const)(decoded_data + get_buf_offset(primitives[0].attributes.normal[0])));
+		ifs.SetNormal((o3dgc::Real* const)get_buf_region(primitives[0].attributes.normal[0], size_normal));
 	}
 
 	for(size_t idx = 0, idx_end = size_floatattr.size(), idx_texcoord = 0; idx < idx_end; idx++)
@@ -1046,7 +1180,7 @@ Ref<Buffer> buf = pAsset_Root.buffers.Get(pCompression_Open3DGC.Buffer);
 				if(idx_texcoord < primitives[0].attributes.texcoord.size())
 				{
 					// See above about absent attributes.
-					ifs.SetFloatAttribute(static_cast<unsigned long>(idx), (o3dgc::Real* const)(decoded_data + get_buf_offset(primitives[0].attributes.texcoord[idx])));
+					ifs.SetFloatAttribute(static_cast<unsigned long>(idx), (o3dgc::Real* const)get_buf_region(primitives[0].attributes.texcoord[idx], size_floatattr[idx]));
 					idx_texcoord++;
 				}
 
@@ -1074,6 +1208,7 @@ Ref<Buffer> buf = pAsset_Root.buffers.Get(pCompression_Open3DGC.Buffer);
 	// Decode data
 	//
     if ( decoder.DecodePayload( ifs, bstream ) != o3dgc::O3DGC_OK ) {
+        delete [] decoded_data;
         throw DeadlyImportError( "GLTF: can not decode Open3DGC data." );
     }
 
@@ -1516,19 +1651,28 @@ namespace Util {
     template<bool B>
     struct DATA
     {
-        static const uint8_t tableDecodeBase64[128];
+        static const uint8_t tableDecodeBase64[256];
     };
 
+    // 0x40 marks '=', 0x80 marks characters outside of the base64 alphabet.
     template<bool B>
-    const uint8_t DATA<B>::tableDecodeBase64[128] = {
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 62,  0,  0,  0, 63,
-        52, 53, 54, 55, 56, 57, 58, 59, 60, 61,  0,  0,  0, 64,  0,  0,
-         0,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
-        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,  0,  0,  0,  0,  0,
-         0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,  0,  0,  0,  0,  0
+    const uint8_t DATA<B>::tableDecodeBase64[256] = {
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128, 62,128,128,128, 63,
+         52, 53, 54, 55, 56, 57, 58, 59, 60, 61,128,128,128, 64,128,128,
+        128,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+         15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,128,128,128,128,128,
+        128, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+         41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+        128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128
     };
 
     inline char EncodeCharBase64(uint8_t b)
@@ -1538,53 +1682,61 @@ namespace Util {
 
     inline uint8_t DecodeCharBase64(char c)
     {
-        return DATA<true>::tableDecodeBase64[size_t(c)]; // TODO faster with lookup table or ifs?
-        /*if (c >= 'A' && c <= 'Z') return c - 'A';
-        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
-        if (c >= '0' && c <= '9') return c - '0' + 52;
-        if (c == '+') return 62;
-        if (c == '/') return 63;
-        return 64; // '-' */
+        return DATA<true>::tableDecodeBase64[uint8_t(c)];
     }
 
     inline size_t DecodeBase64(const char* in, size_t inLength, uint8_t*& out)
     {
-        ai_assert(inLength % 4 == 0);
-
         if (inLength < 4) {
             out = 0;
             return 0;
         }
+        if (inLength % 4 != 0) {
+            throw DeadlyImportError("GLTF: invalid base64 data, length is not a multiple of 4");
+        }
 
         int nEquals = int(in[inLength - 1] == '=') +
                       int(in[inLength - 2] == '=');
 
         size_t outLength = (inLength * 3) / 4 - nEquals;
         out = new uint8_t[outLength];
-        memset(out, 0, outLength);
 
-        size_t i, j = 0;
+        // All groups but the last one are complete: decode them into one 24 bit word each and
+        // check the accumulated table flags once at the end instead of per character.
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(in);
+        const uint8_t* table = DATA<true>::tableDecodeBase64;
+        const size_t numFullGroups = inLength / 4 - 1;
+        uint8_t* dst = out;
+        uint32_t invalid = 0;
+
+        for (size_t g = 0; g < numFullGroups; ++g, src += 4, dst += 3) {
+            const uint32_t b0 = table[src[0]], b1 = table[src[1]], b2 = table[src[2]], b3 = table[src[3]];
+            invalid |= b0 | b1 | b2 | b3;
+
+            const uint32_t word = (b0 << 18) | (b1 << 12) | (b2 << 6) | b3;
+            dst[0] = uint8_t(word >> 16);
+            dst[1] = uint8_t(word >> 8);
+            dst[2] = uint8_t(word);
+        }
 
-        for (i = 0; i + 4 < inLength; i += 4) {
-            uint8_t b0 = DecodeCharBase64(in[i]);
-            uint8_t b1 = DecodeCharBase64(in[i + 1]);
-            uint8_t b2 = DecodeCharBase64(in[i + 2]);
-            uint8_t b3 = DecodeCharBase64(in[i + 3]);
+        {
+            // padding is allowed in the last two positions only, and a padded third
+            // character must be followed by another one
+            const uint8_t b0 = table[src[0]], b1 = table[src[1]], b2 = table[src[2]], b3 = table[src[3]];
+            invalid |= b0 | b1 | (b2 & 0x80) | (b3 & 0x80);
+            if (b2 == 64 && b3 != 64) {
+                invalid |= 0x80;
+            }
 
-            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
-            out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
-            out[j++] = (uint8_t)((b2 << 6) | b3);
+            *dst++ = (uint8_t)((b0 << 2) | (b1 >> 4));
+            if (b2 < 64) *dst++ = (uint8_t)((b1 << 4) | (b2 >> 2));
+            if (b3 < 64) *dst++ = (uint8_t)((b2 << 6) | b3);
         }
 
-        {
-            uint8_t b0 = DecodeCharBase64(in[i]);
-            uint8_t b1 = DecodeCharBase64(in[i + 1]);
-            uint8_t b2 = DecodeCharBase64(in[i + 2]);
-            uint8_t b3 = DecodeCharBase64(in[i + 3]);
-
-            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
-            if (b2 < 64) out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
-            if (b3 < 64) out[j++] = (uint8_t)((b2 << 6) | b3);
+        if (invalid & 0xC0) {
+            delete[] out;
+            out = 0;
+            throw DeadlyImportError("GLTF: invalid character in base64 data");
         }
 
         return outLength;
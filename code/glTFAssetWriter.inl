@@ -53,6 +53,93 @@ namespace glTF {
 
     namespace {
 
+        //! rapidjson output stream which forwards the serialized document to an IOStream in fixed
+        //! size blocks, so the JSON text is never held in memory as a whole.
+        class IOStreamWriteAdapter
+        {
+        public:
+            typedef char Ch;
+
+            explicit IOStreamWriteAdapter(IOStream* stream)
+                : mStream(stream), mFill(0), mWritten(0)
+            {}
+
+            void Put(Ch c)
+            {
+                if (mFill == sizeof(mBuffer)) {
+                    Flush();
+                }
+                mBuffer[mFill++] = c;
+            }
+
+            void Flush()
+            {
+                if (mFill > 0) {
+                    if (mStream->Write(mBuffer, mFill, 1) != 1) {
+                        throw DeadlyExportError("Failed to write scene data!");
+                    }
+                    mWritten += mFill;
+                    mFill = 0;
+                }
+            }
+
+            //! Number of characters put so far, including the ones not yet flushed
+            size_t Size() const
+            {
+                return mWritten + mFill;
+            }
+
+        private:
+            IOStream* mStream;
+            char mBuffer[16384];
+            size_t mFill, mWritten;
+        };
+
+        //! Writes the contents of a buffer. The ranges of a deferred buffer are streamed from their
+        //! sources, only elements which need to be converted go through a fixed size block.
+        inline void WriteBufferData(IOStream* stream, Buffer& b)
+        {
+            if (!b.IsDeferred()) {
+                if (b.byteLength > 0 && stream->Write(b.GetPointer(), b.byteLength, 1) != 1) {
+                    throw DeadlyExportError("Failed to write buffer data: " + b.id);
+                }
+                return;
+            }
+
+            uint8_t block[16384];
+            auto write = [&](const void* data, size_t length) {
+                if (length > 0 && stream->Write(data, length, 1) != 1) {
+                    throw DeadlyExportError("Failed to write buffer data: " + b.id);
+                }
+            };
+            auto writeZeros = [&](size_t length) {
+                memset(block, 0, std::min(length, sizeof(block)));
+                for (size_t n; length > 0; length -= n) {
+                    n = std::min(length, sizeof(block));
+                    write(block, n);
+                }
+            };
+
+            size_t pos = 0;
+            for (const Buffer::SDeferredRange& r : b.GetDeferredRanges()) {
+                writeZeros(r.Offset - pos); // alignment padding
+
+                if (r.SrcStride == r.DstStride) {
+                    write(r.Data, r.Count * r.DstStride);
+                }
+                else {
+                    const size_t perBlock = sizeof(block) / r.DstStride;
+                    for (size_t i = 0, n; i < r.Count; i += n) {
+                        n = std::min(perBlock, r.Count - i);
+                        CopyData(n, r.Data + i * r.SrcStride, r.SrcStride, block, r.DstStride);
+                        write(block, n * r.DstStride);
+                    }
+                }
+                pos = r.Offset + r.Count * r.DstStride;
+            }
+            writeZeros(b.byteLength - pos);
+        }
+
         template<size_t N>
         inline Value& MakeValue(Value& val, float(&r)[N], MemoryPoolAllocator<>& al) {
             val.SetArray();
@@ -502,14 +589,11 @@ namespace glTF {
             throw DeadlyExportError("Could not open output file: " + std::string(path));
         }
 
-        StringBuffer docBuffer;
+        IOStreamWriteAdapter docStream(jsonOutFile.get());
 
-        PrettyWriter<StringBuffer> writer(docBuffer);
+        PrettyWriter<IOStreamWriteAdapter> writer(docStream);
         mDoc.Accept(writer);
-
-        if (jsonOutFile->Write(docBuffer.GetString(), docBuffer.GetSize(), 1) != 1) {
-            throw DeadlyExportError("Failed to write scene data!");
-        }
+        docStream.Flush();
 
         // Write buffer data to separate .bin files
         for (unsigned int i = 0; i < mAsset.buffers.Size(); ++i) {
@@ -523,11 +607,7 @@ namespace glTF {
                 throw DeadlyExportError("Could not open output file: " + binPath);
             }
 
-            if (b->byteLength > 0) {
-                if (binOutFile->Write(b->GetPointer(), b->byteLength, 1) != 1) {
-                    throw DeadlyExportError("Failed to write binary file: " + binPath);
-                }
-            }
+            WriteBufferData(binOutFile.get(), *b);
         }
     }
 
@@ -542,15 +622,17 @@ namespace glTF {
         // we will write the header later, skip its size
         outfile->Seek(sizeof(GLB_Header), aiOrigin_SET);
 
-        StringBuffer docBuffer;
-        Writer<StringBuffer> writer(docBuffer);
+        IOStreamWriteAdapter docStream(outfile.get());
+        Writer<IOStreamWriteAdapter> writer(docStream);
         mDoc.Accept(writer);
 
-        if (outfile->Write(docBuffer.GetString(), docBuffer.GetSize(), 1) != 1) {
-            throw DeadlyExportError("Failed to write scene data!");
+        // pad the scene with spaces, so the body starts 4-byte aligned right after it
+        while ((sizeof(GLB_Header) + docStream.Size()) % 4) {
+            docStream.Put(' ');
         }
+        docStream.Flush();
 
-        WriteBinaryData(outfile.get(), docBuffer.GetSize());
+        WriteBinaryData(outfile.get(), docStream.Size());
     }
 
     inline void AssetWriter::WriteBinaryData(IOStream* outfile, size_t sceneLength)
@@ -559,19 +641,16 @@ namespace glTF {
         // write the body data
         //
 
+        size_t bodyOffset = sizeof(GLB_Header) + sceneLength;
+        bodyOffset = (bodyOffset + 3) & ~3; // Round up to next multiple of 4
+
         size_t bodyLength = 0;
         if (Ref<Buffer> b = mAsset.GetBodyBuffer()) {
             bodyLength = b->byteLength;
 
             if (bodyLength > 0) {
-                size_t bodyOffset = sizeof(GLB_Header) + sceneLength;
-                bodyOffset = (bodyOffset + 3) & ~3; // Round up to next multiple of 4
-
                 outfile->Seek(bodyOffset, aiOrigin_SET);
-
-                if (outfile->Write(b->GetPointer(), b->byteLength, 1) != 1) {
-                    throw DeadlyExportError("Failed to write body data!");
-                }
+                WriteBufferData(outfile, *b);
             }
         }
 
@@ -585,7 +664,8 @@ namespace glTF {
         header.version = 1;
         AI_SWAP4(header.version);
 
-        header.length = uint32_t(sizeof(header) + sceneLength + bodyLength);
+        // the reader takes everything behind the aligned scene as body, so count the padding as well
+        header.length = uint32_t(bodyLength > 0 ? bodyOffset + bodyLength : sizeof(header) + sceneLength);
         AI_SWAP4(header.length);
 
         header.sceneLength = uint32_t(sceneLength);
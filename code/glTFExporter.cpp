@@ -116,6 +116,12 @@ glTFExporter::glTFExporter(const char* filename, IOSystem* pIOSystem, const aiSc
 
     if (isBinary) {
         mAsset->SetAsBinary();
+
+        // The body is streamed to the file from the scene data and is not built up in memory, unless
+        // Open3DGC compression is requested, which replaces parts of the body after they were appended.
+        if (!mProperties->GetPropertyBool("extensions.Open3DGC.use", false)) {
+            mAsset->GetBodyBuffer()->MarkAsDeferred();
+        }
     }
 
     ExportMetadata();
@@ -175,8 +181,11 @@ static void IdentityMatrix4(glTF::mat4& o)
     o[12] = 0; o[13] = 0; o[14] = 0; o[15] = 1;
 }
 
+// isPersistent: data stays valid until the asset has been written, a deferred body buffer then
+// references it instead of taking a copy.
 inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
-    unsigned int count, void* data, AttribType::Value typeIn, AttribType::Value typeOut, ComponentType compType, bool isIndices = false)
+    unsigned int count, void* data, AttribType::Value typeIn, AttribType::Value typeOut, ComponentType compType, bool isIndices = false,
+    bool isPersistent = false)
 {
     if (!count || !data) return Ref<Accessor>();
 
@@ -186,10 +195,13 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
 
     size_t offset = buffer->byteLength;
     // make sure offset is correctly byte-aligned, as required by spec
-    size_t padding = offset % bytesPerComp;
+    size_t padding = (bytesPerComp - offset % bytesPerComp) % bytesPerComp;
     offset += padding;
     size_t length = count * numCompsOut * bytesPerComp;
     buffer->Grow(length + padding);
+    if (!buffer->IsDeferred()) {
+        memset(buffer->GetPointer() + offset - padding, 0, padding); // keep the output deterministic
+    }
 
     // bufferView
     Ref<BufferView> bv = a.bufferViews.Create(a.FindUniqueID(meshName, "view"));
@@ -237,7 +249,7 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
     }
 
     // copy the data
-    acc->WriteData(count, data, numCompsIn*bytesPerComp);
+    acc->WriteData(count, data, numCompsIn*bytesPerComp, isPersistent);
 
     return acc;
 }
@@ -555,6 +567,7 @@ void glTFExporter::ExportMeshes()
 
 		if(comp_allow && (aim->mPrimitiveTypes == aiPrimitiveType_TRIANGLE) && (aim->mNumVertices > 0) && (aim->mNumFaces > 0))
 		{
+			idx_srcdata_normal = SIZE_MAX;
 			idx_srcdata_tc.clear();
 			idx_srcdata_tc.reserve(AI_MAX_NUMBER_OF_TEXTURECOORDS);
 		}
@@ -580,16 +593,15 @@ void glTFExporter::ExportMeshes()
 
 		/******************* Vertices ********************/
 		// If compression is used then you need parameters of uncompressed region: begin and size. At this step "begin" is stored.
-		if(comp_allow) idx_srcdata_begin = b->byteLength;
-
-        Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+		// All offsets are taken from the accessors, as ExportData() may pad the buffer to align the data.
+        Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, false, true);
 		if (v) p.attributes.position.push_back(v);
+		if(comp_allow) idx_srcdata_begin = v->bufferView->byteOffset + v->byteOffset;
 
 		/******************** Normals ********************/
-		if(comp_allow && (aim->mNormals != 0)) idx_srcdata_normal = b->byteLength;// Store index of normals array.
-
-		Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+		Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, false, true);
 		if (n) p.attributes.normal.push_back(n);
+		if(comp_allow && n) idx_srcdata_normal = n->bufferView->byteOffset + n->byteOffset;// Store index of normals array.
 
 		/************** Texture coordinates **************/
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
@@ -603,15 +615,13 @@ void glTFExporter::ExportMeshes()
             if (aim->mNumUVComponents[i] > 0) {
                 AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
 
-				if(comp_allow) idx_srcdata_tc.push_back(b->byteLength);// Store index of texture coordinates array.
-
-				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, false);
+				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, false, true);
 				if (tc) p.attributes.texcoord.push_back(tc);
+				if(comp_allow && tc) idx_srcdata_tc.push_back(tc->bufferView->byteOffset + tc->byteOffset);// Store index of texture coordinates array.
 			}
 		}
 
 		/*************** Vertices indices ****************/
-		idx_srcdata_ind = b->byteLength;// Store index of indices array.
 
 		if (aim->mNumFaces > 0) {
 			std::vector<IndicesType> indices;
@@ -624,6 +634,7 @@ void glTFExporter::ExportMeshes()
             }
 
 			p.indices = ExportData(*mAsset, meshId, b, unsigned(indices.size()), &indices[0], AttribType::SCALAR, AttribType::SCALAR, ComponentType_UNSIGNED_SHORT, true);
+			if(comp_allow) idx_srcdata_ind = p.indices->bufferView->byteOffset + p.indices->byteOffset;// Store index of indices array.
 		}
 
         switch (aim->mPrimitiveTypes) {
@@ -637,11 +648,6 @@ void glTFExporter::ExportMeshes()
                 p.mode = PrimitiveMode_TRIANGLES;
         }
 
-    /*************** Skins ****************/
-    if(aim->HasBones()) {
-        ExportSkin(*mAsset, aim, m, b, skinRef, inverseBindMatricesData);
-    }
-
 		/****************** Compression ******************/
 		///TODO: animation: weights, joints.
 		if(comp_allow)
@@ -715,6 +721,7 @@ void glTFExporter::ExportMeshes()
 			//
 			encoder.Encode(comp_o3dgc_params, comp_o3dgc_ifs, bs);
 			// Replace data in buffer.
+			// The mesh data ends with the indices, everything from the coordinates on is replaced.
 			b->ReplaceData(idx_srcdata_begin, b->byteLength - idx_srcdata_begin, bs.GetBuffer(), bs.GetSize());
 			//
 			// Add information about extension to mesh.
@@ -725,7 +732,7 @@ void glTFExporter::ExportMeshes()
 			// Fill it.
 			ext->Buffer = b->id;
 			ext->Offset = idx_srcdata_begin;
-			ext->Count = b->byteLength - idx_srcdata_begin;
+			ext->Count = bs.GetSize();
 			ext->Binary = mProperties->GetPropertyBool("extensions.Open3DGC.binary");
 			ext->IndicesCount = comp_o3dgc_ifs.GetNCoordIndex() * 3;
 			ext->VerticesCount = comp_o3dgc_ifs.GetNCoord();
@@ -733,6 +740,12 @@ void glTFExporter::ExportMeshes()
 			m->Extension.push_back(ext);
 #endif
 		}// if(comp_allow)
+
+		/*************** Skins ****************/
+		// Exported after the compression, which replaces the mesh data up to the end of the buffer.
+		if(aim->HasBones()) {
+			ExportSkin(*mAsset, aim, m, b, skinRef, inverseBindMatricesData);
+		}
 	}// for (unsigned int i = 0; i < mScene->mNumMeshes; ++i)
 
     //----------------------------------------
@@ -354,15 +354,18 @@ void glTFImporter::ImportMeshes(glTF::Asset& r)
 
                 unsigned int count = prim.indices->count;
 
-                Accessor::Indexer data = prim.indices->GetIndexer();
-                ai_assert(data.IsValid());
+                // all indices are widened in one pass, the faces are then built from the flat array
+                std::vector<unsigned int> data;
+                if (!prim.indices->ExtractIndices(data)) {
+                    throw DeadlyImportError("GLTF: unable to read the indices of mesh \"" + mesh.id + "\"");
+                }
 
                 switch (prim.mode) {
                     case PrimitiveMode_POINTS: {
                         nFaces = count;
                         faces = new aiFace[nFaces];
                         for (unsigned int i = 0; i < count; ++i) {
-                            SetFace(faces[i], data.GetUInt(i));
+                            SetFace(faces[i], data[i]);
                         }
                         break;
                     }
@@ -371,7 +374,7 @@ void glTFImporter::ImportMeshes(glTF::Asset& r)
                         nFaces = count / 2;
                         faces = new aiFace[nFaces];
                         for (unsigned int i = 0; i < count; i += 2) {
-                            SetFace(faces[i / 2], data.GetUInt(i), data.GetUInt(i + 1));
+                            SetFace(faces[i / 2], data[i], data[i + 1]);
                         }
                         break;
                     }
@@ -380,9 +383,9 @@ void glTFImporter::ImportMeshes(glTF::Asset& r)
                     case PrimitiveMode_LINE_STRIP: {
                         nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
                         faces = new aiFace[nFaces];
-                        SetFace(faces[0], data.GetUInt(0), data.GetUInt(1));
+                        SetFace(faces[0], data[0], data[1]);
                         for (unsigned int i = 2; i < count; ++i) {
-                            SetFace(faces[i - 1], faces[i - 2].mIndices[1], data.GetUInt(i));
+                            SetFace(faces[i - 1], faces[i - 2].mIndices[1], data[i]);
                         }
                         if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
                             SetFace(faces[count - 1], faces[count - 2].mIndices[1], faces[0].mIndices[0]);
@@ -394,25 +397,25 @@ void glTFImporter::ImportMeshes(glTF::Asset& r)
                         nFaces = count / 3;
                         faces = new aiFace[nFaces];
                         for (unsigned int i = 0; i < count; i += 3) {
-                            SetFace(faces[i / 3], data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
+                            SetFace(faces[i / 3], data[i], data[i + 1], data[i + 2]);
                         }
                         break;
                     }
                     case PrimitiveMode_TRIANGLE_STRIP: {
                         nFaces = count - 2;
                         faces = new aiFace[nFaces];
-                        SetFace(faces[0], data.GetUInt(0), data.GetUInt(1), data.GetUInt(2));
+                        SetFace(faces[0], data[0], data[1], data[2]);
                         for (unsigned int i = 3; i < count; ++i) {
-                            SetFace(faces[i - 2], faces[i - 1].mIndices[1], faces[i - 1].mIndices[2], data.GetUInt(i));
+                            SetFace(faces[i - 2], faces[i - 1].mIndices[1], faces[i - 1].mIndices[2], data[i]);
                         }
                         break;
                     }
                     case PrimitiveMode_TRIANGLE_FAN:
                         nFaces = count - 2;
                         faces = new aiFace[nFaces];
-                        SetFace(faces[0], data.GetUInt(0), data.GetUInt(1), data.GetUInt(2));
+                        SetFace(faces[0], data[0], data[1], data[2]);
                         for (unsigned int i = 3; i < count; ++i) {
-                            SetFace(faces[i - 2], faces[0].mIndices[0], faces[i - 1].mIndices[2], data.GetUInt(i));
+                            SetFace(faces[i - 2], faces[0].mIndices[0], faces[i - 1].mIndices[2], data[i]);
                         }
                         break;
                 }
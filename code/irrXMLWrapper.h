@@ -87,7 +87,13 @@ public:
         // it is not suitable for our purposes and we have to do it BEFORE IrrXML
         // gets the buffer. Sadly, this forces us to map the whole file into
         // memory.
+        ReadAndConvert(stream,data);
+    }
 
+    // ----------------------------------------------------------------------------------
+    //! Read a whole stream into memory, strip null characters and convert it
+    //! to UTF8. This is the input preparation shared by all XML readers.
+    static void ReadAndConvert(IOStream* stream, std::vector<char>& data) {
         data.resize(stream->FileSize());
         stream->Read(&data[0],data.size(),1);
 
@@ -0,0 +1,219 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file AnimationSampler.h
+ *  @brief Declares Assimp::AnimationSampler, a helper to evaluate the node
+ *    transformations of an aiAnimation at arbitrary points in time.
+ */
+#ifndef AI_ANIMATION_SAMPLER_H_INC
+#define AI_ANIMATION_SAMPLER_H_INC
+
+#include <assimp/types.h>
+#include <assimp/anim.h>
+#include <assimp/defs.h>
+
+#include <vector>
+#include <map>
+
+struct aiNode;
+struct aiScene;
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** @brief Samples an aiAnimation and computes the local and global
+ *  transformations of all nodes of the node hierarchy it is applied to.
+ *
+ *  The node hierarchy is flattened once at construction time. All nodes are
+ *  stored in an order in which a parent always precedes its children, output
+ *  matrices are indexed by this order (see #GetNode and #GetNodeIndex).
+ *  Nodes which are not affected by the animation keep their
+ *  aiNode::mTransformation.
+ *
+ *  Keys are located by a binary search which is skipped if the time stamp
+ *  is still inside the key interval of the previous query (or the next one),
+ *  so both monotonic playback and random access are fast. Rotations are
+ *  interpolated using a branch-free polynomial approximation of slerp
+ *  which is evaluated for all channels (or all time stamps of a batch)
+ *  at once, in a form compilers vectorize well. The maximum deviation from
+ *  an exact slerp is below 1e-6.
+ *
+ *  Pre- and post-states of the channels (aiNodeAnim::mPreState,
+ *  aiNodeAnim::mPostState) are honoured.
+ *
+ *  All time values are given in ticks, just as the key times are. To
+ *  sample in seconds, multiply with aiAnimation::mTicksPerSecond.
+ *
+ *  Instances of this class are not thread-safe, but it is fine to use one
+ *  sampler per thread for the same animation.
+ */
+class ASSIMP_API AnimationSampler
+{
+public:
+    // -------------------------------------------------------------------
+    /** @brief Construct a sampler for an animation of a node hierarchy.
+     *
+     *  @param root Root of the node hierarchy the animation is applied to.
+     *  @param anim Animation to be sampled. Channels referring to nodes
+     *    which don't exist in the hierarchy are ignored.
+     *  The sampler keeps pointers to both, so they must stay alive for the
+     *  lifetime of the sampler.
+     */
+    AnimationSampler(const aiNode* root, const aiAnimation* anim);
+
+    // -------------------------------------------------------------------
+    /** @brief Construct a sampler for one of the animations of a scene.
+     *
+     *  @param scene Scene to take the node hierarchy and animation from.
+     *  @param animIndex Index into aiScene::mAnimations.
+     */
+    AnimationSampler(const aiScene* scene, unsigned int animIndex);
+
+    ~AnimationSampler();
+
+    // -------------------------------------------------------------------
+    /** @brief Get the number of nodes in the flattened hierarchy. This is
+     *  the number of matrices written per time stamp. */
+    unsigned int GetNodeCount() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Get a node by its index in the flattened hierarchy. */
+    const aiNode* GetNode(unsigned int index) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Get the index of a node's parent in the flattened hierarchy.
+     *  @return UINT_MAX for the root node. */
+    unsigned int GetParentIndex(unsigned int index) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Look up a node by name.
+     *  @return Index of the node in the flattened hierarchy or UINT_MAX
+     *    if there is no such node. */
+    unsigned int GetNodeIndex(const aiString& name) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Evaluate the animation for a single point in time.
+     *
+     *  @param time Time stamp in ticks.
+     *  @param local Receives the local transformation of each node, an
+     *    array of #GetNodeCount matrices. May be NULL.
+     *  @param global Receives the transformation of each node relative to
+     *    the root node (including the root's own transformation), an array
+     *    of #GetNodeCount matrices. May be NULL.
+     */
+    void Sample(double time, aiMatrix4x4* local, aiMatrix4x4* global = NULL);
+
+    // -------------------------------------------------------------------
+    /** @brief Evaluate the animation for a batch of time stamps, i.e. for
+     *  many instances of an animated object at once.
+     *
+     *  The time stamps need not be sorted, but the key search is fastest
+     *  if they are. Results are written time stamp after time stamp,
+     *  so the matrix of node n at time stamp t is found at index
+     *  t * GetNodeCount() + n.
+     *
+     *  @param times Array of numTimes time stamps, in ticks.
+     *  @param numTimes Number of time stamps.
+     *  @param local Receives numTimes * GetNodeCount() local matrices. May
+     *    be NULL.
+     *  @param global Receives numTimes * GetNodeCount() global matrices.
+     *    May be NULL.
+     */
+    void SampleBatch(const double* times, unsigned int numTimes,
+        aiMatrix4x4* local, aiMatrix4x4* global = NULL);
+
+    // -------------------------------------------------------------------
+    /** @brief Compute global matrices from local ones.
+     *
+     *  @param local Array of #GetNodeCount local matrices.
+     *  @param global Receives #GetNodeCount global matrices. Must not
+     *    alias local.
+     */
+    void ComputeGlobalTransforms(const aiMatrix4x4* local, aiMatrix4x4* global) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Interpolate a batch of quaternion pairs.
+     *
+     *  This is the kernel used for all rotation channels, exposed for
+     *  custom evaluators. The result matches aiQuaternion::Interpolate
+     *  for each pair, but without its linear approximation for close
+     *  rotations and with an error below 1e-6 compared to an exact slerp.
+     *  Input and output arrays may alias.
+     */
+    static void InterpolateQuaternions(const aiQuaternion* start, const aiQuaternion* end,
+        const ai_real* factors, aiQuaternion* out, unsigned int count);
+
+private:
+    void Setup(const aiNode* root, const aiAnimation* anim);
+    void EvaluateChannels(const double* times, unsigned int numTimes, unsigned int channel);
+    void BuildLocalTransforms(unsigned int numTimes, aiMatrix4x4* local);
+
+private:
+    //! Per-channel state
+    struct Channel {
+        const aiNodeAnim* anim;
+        unsigned int node;
+
+        // default components of the node transformation, used for
+        // aiAnimBehaviour_DEFAULT and for channels without keys
+        aiVector3D defPosition, defScaling;
+        aiQuaternion defRotation;
+
+        // key intervals found by the last query
+        unsigned int lastPosition, lastRotation, lastScaling;
+    };
+
+    const aiAnimation* mAnim;
+    std::vector<const aiNode*> mNodes;
+    std::vector<unsigned int> mParents;
+    std::vector<Channel> mChannels;
+    std::map<std::string, unsigned int> mNodesByName;
+
+    // scratch arrays, sized for the largest batch seen so far
+    std::vector<aiVector3D> mPositions, mScalings;
+    std::vector<aiQuaternion> mRotStart, mRotEnd, mRotations;
+    std::vector<ai_real> mRotFactors;
+    std::vector<aiMatrix4x4> mLocalScratch;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_ANIMATION_SAMPLER_H_INC
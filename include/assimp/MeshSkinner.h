@@ -0,0 +1,208 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MeshSkinner.h
+ *  @brief Declares helpers to evaluate skinned meshes on the CPU:
+ *    Assimp::BoneInfluenceTable and Assimp::MeshSkinner.
+ */
+#ifndef AI_MESH_SKINNER_H_INC
+#define AI_MESH_SKINNER_H_INC
+
+#include <assimp/types.h>
+#include <assimp/defs.h>
+
+#include <climits>
+#include <vector>
+
+struct aiMesh;
+
+namespace Assimp    {
+
+class AnimationSampler;
+
+// ---------------------------------------------------------------------------
+/** @brief Per-vertex view on the bone weights of a mesh.
+ *
+ *  aiBone::mWeights stores the influences per bone, which is the wrong way
+ *  round for skinning. This table transposes them into a packed array with
+ *  a fixed number of influences per vertex (the stride), sorted by
+ *  descending weight. Unused slots have bone index 0 and weight 0.
+ *
+ *  If a maximum influence count is given, only the largest weights are
+ *  kept for each vertex and renormalized, just as the
+ *  #aiProcess_LimitBoneWeights step does.
+ */
+class ASSIMP_API BoneInfluenceTable
+{
+public:
+    // -------------------------------------------------------------------
+    /** @brief Build the table for a mesh.
+     *  @param mesh Mesh to take the bones from.
+     *  @param maxInfluences Maximum number of influences to keep per
+     *    vertex. The stride is the minimum of this value and the
+     *    largest number of influences on any vertex of the mesh.
+     */
+    explicit BoneInfluenceTable(const aiMesh* mesh, unsigned int maxInfluences = UINT_MAX);
+
+    /** Number of vertices in the table */
+    unsigned int GetNumVertices() const {
+        return mNumVertices;
+    }
+
+    /** Number of influence slots per vertex */
+    unsigned int GetStride() const {
+        return mStride;
+    }
+
+    /** Bone indices, GetNumVertices() * GetStride() entries. The
+     *  influences of vertex v start at v * GetStride(). */
+    const unsigned int* GetBoneIndices() const {
+        return mBones.empty() ? NULL : &mBones[0];
+    }
+
+    /** Bone weights, laid out just as the bone indices are. */
+    const ai_real* GetWeights() const {
+        return mWeights.empty() ? NULL : &mWeights[0];
+    }
+
+private:
+    unsigned int mNumVertices;
+    unsigned int mStride;
+    std::vector<unsigned int> mBones;
+    std::vector<ai_real> mWeights;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Linear-blend skinning of a single mesh on the CPU.
+ *
+ *  Computes posed vertex positions and normals, and the bounds of a mesh
+ *  for a given pose or over a set of animation frames. All results are
+ *  given in the coordinate space of the node the mesh is attached to.
+ *
+ *  Typical use together with AnimationSampler:
+ *  @code
+ *  AnimationSampler sampler(scene, 0);
+ *  MeshSkinner skinner(mesh);
+ *  std::vector<aiMatrix4x4> global(sampler.GetNodeCount()), bones(mesh->mNumBones);
+ *  std::vector<aiVector3D> positions(mesh->mNumVertices);
+ *
+ *  sampler.Sample(time, NULL, &global[0]);
+ *  skinner.ComputeBoneMatrices(sampler, &global[0], meshNode, &bones[0]);
+ *  skinner.Skin(&bones[0], &positions[0]);
+ *  @endcode
+ */
+class ASSIMP_API MeshSkinner
+{
+public:
+    // -------------------------------------------------------------------
+    /** @brief Prepare a mesh for skinning.
+     *  @param mesh Mesh to be skinned. The skinner keeps a pointer to
+     *    it, so it must stay alive for the lifetime of the skinner.
+     *  @param maxInfluences See BoneInfluenceTable.
+     */
+    explicit MeshSkinner(const aiMesh* mesh, unsigned int maxInfluences = UINT_MAX);
+
+    /** Get the per-vertex bone influences used for skinning. */
+    const BoneInfluenceTable& GetInfluences() const {
+        return mInfluences;
+    }
+
+    // -------------------------------------------------------------------
+    /** @brief Compute the skinning matrices for all bones of the mesh.
+     *
+     *  The matrix of bone b is inverse(global[meshNode]) *
+     *  global[node of b] * aiBone::mOffsetMatrix. Bones whose node can't
+     *  be found in the sampler's hierarchy get an identity matrix.
+     *
+     *  @param sampler Sampler providing the flattened node hierarchy.
+     *  @param global Global node matrices, as computed by
+     *    AnimationSampler::Sample.
+     *  @param meshNode Index of the node the mesh is attached to.
+     *  @param out Receives aiMesh::mNumBones matrices.
+     */
+    void ComputeBoneMatrices(const AnimationSampler& sampler, const aiMatrix4x4* global,
+        unsigned int meshNode, aiMatrix4x4* out) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Skin the vertices of the mesh.
+     *
+     *  Vertices without any bone influences keep their bind pose.
+     *  @param bones aiMesh::mNumBones skinning matrices.
+     *  @param positions Receives aiMesh::mNumVertices positions.
+     *  @param normals Receives aiMesh::mNumVertices normals, which are
+     *    not renormalized. May be NULL, is ignored if the mesh has no
+     *    normals.
+     */
+    void Skin(const aiMatrix4x4* bones, aiVector3D* positions, aiVector3D* normals = NULL) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Compute the axis-aligned bounds of the mesh for a pose.
+     *  @param bones aiMesh::mNumBones skinning matrices.
+     *  @param min Receives the minimum corner.
+     *  @param max Receives the maximum corner.
+     */
+    void ComputeBounds(const aiMatrix4x4* bones, aiVector3D& min, aiVector3D& max) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Compute the axis-aligned bounds of the mesh across a set of
+     *  animation frames.
+     *  @param sampler Sampler for the animation to be evaluated.
+     *  @param times Time stamps to evaluate, in ticks.
+     *  @param numTimes Number of time stamps.
+     *  @param meshNode Index of the node the mesh is attached to.
+     *  @param min Receives the minimum corner.
+     *  @param max Receives the maximum corner.
+     */
+    void ComputeAnimatedBounds(AnimationSampler& sampler, const double* times, unsigned int numTimes,
+        unsigned int meshNode, aiVector3D& min, aiVector3D& max) const;
+
+private:
+    void SkinRange(const aiMatrix4x4* bones, unsigned int begin, unsigned int end,
+        aiVector3D* positions, aiVector3D* normals) const;
+
+private:
+    const aiMesh* mMesh;
+    BoneInfluenceTable mInfluences;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_MESH_SKINNER_H_INC
@@ -221,9 +221,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     //////////////////////////////////////////////////////////////////////////
     /* Define ASSIMP_BUILD_SINGLETHREADED to compile assimp
      * without threading support. The library doesn't utilize
-     * threads then and is itself not threadsafe. */
+     * threads then and is itself not threadsafe. This is the
+     * default unless ASSIMP_BUILD_MULTITHREADED is defined, which
+     * the ASSIMP_BUILD_MULTITHREADED CMake option does. */
     //////////////////////////////////////////////////////////////////////////
-#ifndef ASSIMP_BUILD_SINGLETHREADED
+#if !defined(ASSIMP_BUILD_SINGLETHREADED) && !defined(ASSIMP_BUILD_MULTITHREADED)
 #   define ASSIMP_BUILD_SINGLETHREADED
 #endif
 
@@ -474,6 +474,182 @@ enum aiMorphingMethod
 #endif
 }; //! enum aiMorphingMethod
 
+// ---------------------------------------------------------------------------
+/** @brief A cluster of neighbouring triangles of a mesh, see
+ *  #aiProcess_GenMeshlets.
+ *
+ *  The faces of a meshlet are stored one after the other in aiMesh::mFaces,
+ *  so the index buffer of the mesh can be used to render single meshlets.
+ *  The distinct vertices referenced by the meshlet are listed in
+ *  aiMesh::mMeshletVertices.
+ *
+ *  Each meshlet carries a bounding sphere and a normal cone for culling.
+ *  All triangles of the meshlet face away from a viewer at the position
+ *  P if
+ *  @code
+ *  dot(normalize(mConeApex - P), mConeAxis) >= mConeCutoff
+ *  @endcode
+ *  If the triangles point in too many directions, mConeAxis is the zero
+ *  vector and mConeCutoff is 1, so the test never succeeds.
+ */
+struct aiMeshlet
+{
+    /** Index of the first face of the meshlet in aiMesh::mFaces */
+    unsigned int mFaceOffset;
+
+    /** Number of faces of the meshlet */
+    unsigned int mNumFaces;
+
+    /** Index of the first vertex of the meshlet in
+     *  aiMesh::mMeshletVertices */
+    unsigned int mVertexOffset;
+
+    /** Number of distinct vertices referenced by the faces */
+    unsigned int mNumVertices;
+
+    /** Center of the bounding sphere */
+    C_STRUCT aiVector3D mCenter;
+
+    /** Radius of the bounding sphere */
+    ai_real mRadius;
+
+    /** Apex of the normal cone */
+    C_STRUCT aiVector3D mConeApex;
+
+    /** Normalized axis of the normal cone */
+    C_STRUCT aiVector3D mConeAxis;
+
+    /** Sine of the half opening angle of the normal cone */
+    ai_real mConeCutoff;
+
+#ifdef __cplusplus
+
+    //! Default constructor. Initializes all members to 0
+    aiMeshlet()
+        : mFaceOffset( 0 )
+        , mNumFaces( 0 )
+        , mVertexOffset( 0 )
+        , mNumVertices( 0 )
+        , mRadius( 0 )
+        , mConeCutoff( 0 )
+    {}
+
+#endif // __cplusplus
+};
+
+// ---------------------------------------------------------------------------
+/** @brief A node of a bounding volume hierarchy, see #aiProcess_GenBVH.
+ *
+ *  The nodes of a hierarchy are stored in a flat array with the root
+ *  first. The two children of an inner node are stored next to each
+ *  other, the first one at index mFirst. Leaves reference mCount
+ *  consecutive primitives starting at mFirst: entries of
+ *  aiMesh::mBVHFaces for the hierarchy of a mesh, entries of
+ *  aiScene::mBVHInstances for the hierarchy of a scene.
+ */
+struct aiBVHNode
+{
+    /** Minimum corner of the axis-aligned bounding box */
+    C_STRUCT aiVector3D mMin;
+
+    /** Maximum corner of the axis-aligned bounding box */
+    C_STRUCT aiVector3D mMax;
+
+    /** Index of the first child for inner nodes, index of the first
+     *  primitive for leaves */
+    unsigned int mFirst;
+
+    /** Number of primitives of a leaf, 0 for inner nodes */
+    unsigned int mCount;
+
+#ifdef __cplusplus
+
+    //! Default constructor. Initializes all members to 0
+    aiBVHNode()
+        : mFirst( 0 )
+        , mCount( 0 )
+    {}
+
+#endif // __cplusplus
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Compact copies of the vertex streams of a mesh, see
+ *  #aiProcess_QuantizeVertices.
+ *
+ *  Positions are stored as unsigned normalized integers and map back to
+ *  the bounding box of the mesh:
+ *  @code
+ *  p = mPositionOffset + mPositionScale * q   // component-wise
+ *  @endcode
+ *  Normals are stored as signed normalized integers of an octahedral
+ *  mapping of the unit sphere to a square. With m = 2^(mNormalBits-1)-1
+ *  and (x, y) = q / m:
+ *  @code
+ *  n = (x, y, 1 - |x| - |y|)
+ *  if (n.z < 0) n.xy = (1 - |n.yx|) * sign(n.xy)   // sign(0) is 1
+ *  n = normalize(n)
+ *  @endcode
+ *  The codes below -m are reserved: q = (-m-1, 0) is a zero-length normal
+ *  and q = (-m-1, -m-1) a non-finite one, which decodes to a quiet NaN.
+ *  Texture coordinates are stored as IEEE 754 half-precision floats with
+ *  aiMesh::mNumUVComponents values per vertex.
+ *
+ *  Each stream is NULL if it was not quantized. The arrays hold
+ *  aiMesh::mNumVertices entries of the stated number of values each.
+ */
+struct aiQuantizedVertices
+{
+    /** Number of bits used per position component, 0 if the positions
+     *  weren't quantized */
+    unsigned int mPositionBits;
+
+    /** Offset to add to the dequantized positions */
+    C_STRUCT aiVector3D mPositionOffset;
+
+    /** Factors to multiply the quantized positions with */
+    C_STRUCT aiVector3D mPositionScale;
+
+    /** Quantized positions, three values per vertex */
+    unsigned short* mPositions;
+
+    /** Number of bits used per normal component, 0 if the normals
+     *  weren't quantized */
+    unsigned int mNormalBits;
+
+    /** Octahedral normals, two values per vertex */
+    short* mNormals;
+
+    /** Half-float texture coordinates, one array per channel */
+    unsigned short* mTextureCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+
+#ifdef __cplusplus
+
+    //! Default constructor. Initializes all members to 0
+    aiQuantizedVertices()
+        : mPositionBits( 0 )
+        , mPositions( NULL )
+        , mNormalBits( 0 )
+        , mNormals( NULL )
+    {
+        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
+            mTextureCoords[a] = NULL;
+        }
+    }
+
+    //! Deletes all storage allocated for the streams
+    ~aiQuantizedVertices()
+    {
+        delete [] mPositions;
+        delete [] mNormals;
+        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
+            delete [] mTextureCoords[a];
+        }
+    }
+
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
 *
@@ -640,7 +816,41 @@ struct aiMesh
      *  Method of morphing when animeshes are specified. 
      */
     unsigned int mMethod;
-	
+
+    /** The number of meshlets the faces are partitioned into.
+     *  Is 0 unless #aiProcess_GenMeshlets was applied. */
+    unsigned int mNumMeshlets;
+
+    /** The meshlets of this mesh, NULL if there are none. They cover
+     *  all faces of the mesh in order. */
+    C_STRUCT aiMeshlet* mMeshlets;
+
+    /** The number of entries in mMeshletVertices */
+    unsigned int mNumMeshletVertices;
+
+    /** The vertices referenced by each meshlet, as indices into the
+     *  vertex arrays of the mesh. A vertex shared by multiple meshlets
+     *  is listed once for each of them. NULL if there are no meshlets. */
+    unsigned int* mMeshletVertices;
+
+    /** The number of nodes of the bounding volume hierarchy over the
+     *  faces. Is 0 unless #aiProcess_GenBVH was applied. */
+    unsigned int mNumBVHNodes;
+
+    /** The nodes of the bounding volume hierarchy, root first. The
+     *  bounding box of the root is the bounding box of the mesh. NULL if
+     *  there is no hierarchy. */
+    C_STRUCT aiBVHNode* mBVHNodes;
+
+    /** The face indices referenced by the leaves of the hierarchy, grouped
+     *  by leaf. The array is mNumFaces in size, NULL if there is no
+     *  hierarchy. */
+    unsigned int* mBVHFaces;
+
+    /** Compact copies of the vertex streams. NULL unless
+     *  #aiProcess_QuantizeVertices was applied. */
+    C_STRUCT aiQuantizedVertices* mQuantizedVertices;
+
 #ifdef __cplusplus
 
     //! Default constructor. Initializes all members to 0
@@ -659,6 +869,14 @@ struct aiMesh
         , mNumAnimMeshes( 0 )
         , mAnimMeshes( NULL )
         , mMethod( 0 )
+        , mNumMeshlets( 0 )
+        , mMeshlets( NULL )
+        , mNumMeshletVertices( 0 )
+        , mMeshletVertices( NULL )
+        , mNumBVHNodes( 0 )
+        , mBVHNodes( NULL )
+        , mBVHFaces( NULL )
+        , mQuantizedVertices( NULL )
     {
         for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++)
         {
@@ -699,6 +917,11 @@ struct aiMesh
             delete [] mAnimMeshes;
         }
 
+        delete [] mMeshlets;
+        delete [] mMeshletVertices;
+        delete [] mBVHNodes;
+        delete [] mBVHFaces;
+        delete mQuantizedVertices;
         delete [] mFaces;
     }
 
@@ -763,6 +986,18 @@ struct aiMesh
     inline bool HasBones() const
         { return mBones != NULL && mNumBones > 0; }
 
+    //! Check whether the mesh is partitioned into meshlets
+    bool HasMeshlets() const
+        { return mMeshlets != NULL && mNumMeshlets > 0; }
+
+    //! Check whether the mesh has a bounding volume hierarchy
+    bool HasBVH() const
+        { return mBVHNodes != NULL && mNumBVHNodes > 0; }
+
+    //! Check whether the mesh has quantized vertex streams
+    bool HasQuantizedVertices() const
+        { return mQuantizedVertices != NULL && mNumVertices > 0; }
+
 #endif // __cplusplus
 };
 
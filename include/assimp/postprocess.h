@@ -315,6 +315,30 @@ enum aiPostProcessSteps
     */
     aiProcess_FixInfacingNormals = 0x2000,
 
+    // -------------------------------------------------------------------------
+    /** <hr>Stores compact copies of the vertex streams for streaming and
+     *  GPU upload.
+     *
+     *  Positions are quantized to unsigned normalized integers over the
+     *  bounding box of the mesh, normals to signed normalized integers of
+     *  an octahedral mapping and texture coordinates to half-precision
+     *  floats. The result is stored in aiMesh::mQuantizedVertices along with
+     *  the transform to dequantize the positions. The float streams are
+     *  replaced by the dequantized values, so both representations match.
+     *  The Assbin exporter writes the quantized streams instead of the float
+     *  ones, which shrinks the vertex data about 2-3 times.
+     *
+     *  Use <tt>#AI_CONFIG_PP_QV_POSITION_BITS</tt> and
+     *  <tt>#AI_CONFIG_PP_QV_NORMAL_BITS</tt> to control the precision and
+     *  <tt>#AI_CONFIG_PP_QV_TEXCOORD_MAX_ERROR</tt> to skip texture
+     *  coordinate channels half floats can't represent accurately enough.
+     *  The maximum errors actually introduced are reported in the log.
+     *  Tangents, colors and vertex animations are not quantized. Other steps
+     *  don't update the quantized streams, so run this one in the last post
+     *  processing call.
+    */
+    aiProcess_QuantizeVertices = 0x4000,
+
     // -------------------------------------------------------------------------
     /** <hr>This step splits meshes with more than one primitive type in
      *  homogeneous sub-meshes.
@@ -525,10 +549,89 @@ enum aiPostProcessSteps
      *  Use <tt>#AI_CONFIG_PP_DB_ALL_OR_NONE</tt> if you want bones removed if and
      *  only if all bones within the scene qualify for removal.
     */
-    aiProcess_Debone  = 0x4000000
+    aiProcess_Debone  = 0x4000000,
+
+    // -------------------------------------------------------------------------
+    /** <hr>This step removes redundant animation keys.
+     *
+     *  Baked animations often come with a key on every frame for every
+     *  channel. The step drops all keys which can be reconstructed by linear
+     *  interpolation (slerp for rotations) of the remaining keys within a
+     *  configurable error tolerance. The first and last key of each track
+     *  are always kept.
+     *
+     *  Use <tt>#AI_CONFIG_PP_OA_POSITION_ERROR</tt>,
+     *  <tt>#AI_CONFIG_PP_OA_ROTATION_ERROR</tt> and
+     *  <tt>#AI_CONFIG_PP_OA_SCALING_ERROR</tt> to control the tolerances. The
+     *  maximum error actually introduced is reported in the log.
+    */
+    aiProcess_OptimizeAnimations = 0x8000000,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Partitions triangle meshes into meshlets, small clusters of
+     *  neighbouring triangles for mesh shaders and cluster culling.
+     *
+     *  The faces of each mesh are reordered so that the faces of every
+     *  meshlet are stored consecutively, the index data is otherwise
+     *  unchanged. The result is stored in aiMesh::mMeshlets along with a
+     *  bounding sphere and a normal cone per meshlet. The step runs after
+     *  #aiProcess_ImproveCacheLocality and grows the meshlets along the
+     *  face order produced by it. Meshes with primitives other than triangles are
+     *  left untouched, so you'll probably want to combine it with
+     *  #aiProcess_Triangulate and #aiProcess_SortByPType.
+     *
+     *  Use <tt>#AI_CONFIG_PP_GM_MAX_VERTICES</tt> and
+     *  <tt>#AI_CONFIG_PP_GM_MAX_TRIANGLES</tt> to control the size of the
+     *  meshlets. Other steps don't update meshlets, so run this one in the
+     *  last post processing call.
+    */
+    aiProcess_GenMeshlets = 0x10000000,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Reduces the number of triangles of all meshes by quadric error
+     *  edge collapses.
+     *
+     *  Edges are collapsed in the order of the geometric error they introduce
+     *  until the target face count or the error limit is reached. Vertices on
+     *  seams of the UV, normal or color data and on non-manifold edges stay
+     *  in place, vertices on open borders only move along the border and
+     *  vertices with differing bone weights are never joined. As vertices
+     *  with equal positions but different attributes count as seams, the step
+     *  needs shared vertices from #aiProcess_JoinIdenticalVertices to be
+     *  effective. Meshes with primitives other than triangles are left
+     *  untouched, so you'll probably want to combine it with
+     *  #aiProcess_Triangulate and #aiProcess_SortByPType.
+     *
+     *  Use <tt>#AI_CONFIG_PP_SIMPLIFY_TARGET_RATIO</tt> and
+     *  <tt>#AI_CONFIG_PP_SIMPLIFY_MAX_ERROR</tt> to control the reduction.
+     *  With <tt>#AI_CONFIG_PP_SIMPLIFY_LOD_LEVELS</tt> set, the original
+     *  meshes are kept and a chain of LOD meshes is appended to
+     *  aiScene::mMeshes instead. Every node referencing a mesh then gets an
+     *  int32 metadata entry <tt>"$LOD.<i>.<k>"</tt> holding the index of LOD
+     *  level k (starting at 1) of the i-th mesh of the node. Levels which
+     *  couldn't be reduced further are omitted.
+    */
+    aiProcess_Simplify = 0x20000000,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Builds bounding volume hierarchies for ray casts and collision
+     *  queries.
+     *
+     *  Every mesh gets a binned SAH hierarchy over its faces in
+     *  aiMesh::mBVHNodes, the faces of the leaves are listed in
+     *  aiMesh::mBVHFaces. The root node holds the bounding box of the mesh.
+     *  The face order itself is not changed. In addition, the scene gets a
+     *  hierarchy over all meshes referenced by nodes, with one entry in
+     *  aiScene::mBVHInstances per reference, bounded in the coordinate
+     *  system of the root node.
+     *
+     *  Use <tt>#AI_CONFIG_PP_BVH_MAX_LEAF_SIZE</tt> to control the size of
+     *  the leaves. Other steps don't update the hierarchies, so run this
+     *  one in the last post processing call.
+    */
+    aiProcess_GenBVH = 0x40000000
 
     // aiProcess_GenEntityMeshes = 0x100000,
-    // aiProcess_OptimizeAnimations = 0x200000
     // aiProcess_FixTexturePaths = 0x200000
 };
 
@@ -163,6 +163,32 @@ struct ASSIMP_API aiNode
 #endif // __cplusplus
 };
 
+// -------------------------------------------------------------------------------
+/** A mesh referenced by a node, as stored in the bounding volume hierarchy
+ *  of the scene. See #aiProcess_GenBVH.
+ */
+struct aiBVHInstance
+{
+    /** The transformation from the mesh to the root node, i.e. the
+    * product of the transformations of the node and all its parents.
+    */
+    C_STRUCT aiMatrix4x4 mTransformation;
+
+    /** The node referencing the mesh */
+    C_STRUCT aiNode* mNode;
+
+    /** The index of the mesh in aiScene::mMeshes */
+    unsigned int mMesh;
+
+#ifdef __cplusplus
+    aiBVHInstance()
+    : mNode(NULL)
+    , mMesh(0) {
+        // empty
+    }
+#endif // __cplusplus
+};
+
 
 // -------------------------------------------------------------------------------
 /**
@@ -318,6 +344,25 @@ struct aiScene
     */
     C_STRUCT aiCamera** mCameras;
 
+    /** The number of nodes of the bounding volume hierarchy over the
+    * mesh instances. Is 0 unless #aiProcess_GenBVH was applied.
+    */
+    unsigned int mNumBVHNodes;
+
+    /** The nodes of the bounding volume hierarchy over the mesh
+    * instances, root first. The leaves reference entries of
+    * mBVHInstances.
+    */
+    C_STRUCT aiBVHNode* mBVHNodes;
+
+    /** The number of mesh instances in the scene */
+    unsigned int mNumBVHInstances;
+
+    /** The mesh instances, one per mesh reference of a node, in the
+    * order of the leaves of the bounding volume hierarchy.
+    */
+    C_STRUCT aiBVHInstance* mBVHInstances;
+
 #ifdef __cplusplus
 
     //! Default constructor - set everything to 0/NULL
@@ -358,6 +403,11 @@ struct aiScene
         return mAnimations != NULL && mNumAnimations > 0; 
     }
 
+    //! Check whether the scene has a bounding volume hierarchy
+    inline bool HasBVH() const {
+        return mBVHNodes != NULL && mNumBVHNodes > 0;
+    }
+
 #endif // __cplusplus
 
     /**  Internal data, do not touch */
@@ -45,6 +45,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/material.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
 namespace Assimp {
 
 class TestModelFacttory {
@@ -93,6 +99,84 @@ public:
 
         return scene;
     }
+
+    /// Height of a grid vertex, given its x and y coordinates.
+    typedef std::function<ai_real( ai_real, ai_real )> HeightFunc;
+
+    /// Creates a grid of size x size quads in the xy plane, split into two triangles each and
+    /// facing +z. Grid point (i,j) lies at (i * spacing, j * spacing, height). If shared is false,
+    /// each triangle gets its own vertices in face order. If shuffleSeed is not 0, the shared
+    /// vertices are stored in a random order.
+    static aiMesh *createGridMesh( unsigned int size, bool shared, ai_real spacing = 1,
+            const HeightFunc &height = HeightFunc(), unsigned int shuffleSeed = 0 ) {
+        aiMesh *mesh = new aiMesh;
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumFaces = size * size * 2;
+        mesh->mFaces = new aiFace[ mesh->mNumFaces ];
+        const unsigned int numPoints = ( size + 1 ) * ( size + 1 );
+        mesh->mNumVertices = shared ? numPoints : mesh->mNumFaces * 3;
+        mesh->mVertices = new aiVector3D[ mesh->mNumVertices ];
+
+        // vertex index of each grid point in the shared case
+        std::vector<unsigned int> slot( numPoints );
+        for ( unsigned int i = 0; i < numPoints; ++i ) {
+            slot[ i ] = i;
+        }
+        if ( shuffleSeed ) {
+            std::shuffle( slot.begin(), slot.end(), std::mt19937( shuffleSeed ) );
+        }
+
+        static const unsigned int corners[ 6 ][ 2 ] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 0, 1 } };
+        unsigned int f = 0, v = 0;
+        for ( unsigned int y = 0; y < size; ++y ) {
+            for ( unsigned int x = 0; x < size; ++x ) {
+                for ( unsigned int c = 0; c < 6; ++c ) {
+                    aiFace &face = mesh->mFaces[ f + c / 3 ];
+                    if ( c % 3 == 0 ) {
+                        face.mIndices = new unsigned int[ face.mNumIndices = 3 ];
+                    }
+                    const unsigned int gx = x + corners[ c ][ 0 ], gy = y + corners[ c ][ 1 ];
+                    const ai_real px = ai_real( gx ) * spacing, py = ai_real( gy ) * spacing;
+                    const unsigned int index = shared ? slot[ gy * ( size + 1 ) + gx ] : v++;
+                    face.mIndices[ c % 3 ] = index;
+                    mesh->mVertices[ index ] = aiVector3D( px, py, height ? height( px, py ) : ai_real( 0 ) );
+                }
+                f += 2;
+            }
+        }
+        return mesh;
+    }
+
+    /// Creates a mesh of separate triangles where triangle i only uses the vertices 3i to 3i+2,
+    /// and they are fully weighted to bone i, named "bone<i>".
+    static aiMesh *createSkinnedTriangles( unsigned int numTriangles ) {
+        aiMesh *mesh = new aiMesh;
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = numTriangles * 3;
+        mesh->mVertices = new aiVector3D[ mesh->mNumVertices ];
+        mesh->mNumFaces = numTriangles;
+        mesh->mFaces = new aiFace[ numTriangles ];
+        mesh->mNumBones = numTriangles;
+        mesh->mBones = new aiBone*[ numTriangles ];
+        for ( unsigned int t = 0; t < numTriangles; ++t ) {
+            aiFace &face = mesh->mFaces[ t ];
+            face.mIndices = new unsigned int[ face.mNumIndices = 3 ];
+
+            aiBone *bone = mesh->mBones[ t ] = new aiBone;
+            char name[ 32 ];
+            ::snprintf( name, sizeof( name ), "bone%u", t );
+            bone->mName.Set( name );
+            bone->mNumWeights = 3;
+            bone->mWeights = new aiVertexWeight[ 3 ];
+            for ( unsigned int i = 0; i < 3; ++i ) {
+                const unsigned int v = t * 3 + i;
+                mesh->mVertices[ v ] = aiVector3D( ai_real( t * 2 + ( i == 1 ) ), ai_real( i == 2 ), 0 );
+                face.mIndices[ i ] = v;
+                bone->mWeights[ i ] = aiVertexWeight( v, 1.f );
+            }
+        }
+        return mesh;
+    }
 };
 
 }
@@ -0,0 +1,183 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/AnimationSampler.h>
+#include <assimp/scene.h>
+
+#include <climits>
+#include <cstdlib>
+
+using namespace Assimp;
+
+class utAnimationSampler : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // root -> arm -> hand, the arm is animated
+        mRoot = new aiNode( "root" );
+        mRoot->mTransformation = aiMatrix4x4::Translation( aiVector3D( 0, 1, 0 ), mTmp );
+        aiNode *arm = new aiNode( "arm" );
+        aiNode *hand = new aiNode( "hand" );
+        hand->mTransformation = aiMatrix4x4::Translation( aiVector3D( 2, 0, 0 ), mTmp );
+        mRoot->addChildren( 1, &arm );
+        arm->addChildren( 1, &hand );
+
+        aiNodeAnim *channel = new aiNodeAnim();
+        channel->mNodeName.Set( "arm" );
+        channel->mNumPositionKeys = 2;
+        channel->mPositionKeys = new aiVectorKey[ 2 ];
+        channel->mPositionKeys[ 0 ] = aiVectorKey( 0.0, aiVector3D( 0, 0, 0 ) );
+        channel->mPositionKeys[ 1 ] = aiVectorKey( 10.0, aiVector3D( 10, 0, 0 ) );
+        channel->mNumRotationKeys = 2;
+        channel->mRotationKeys = new aiQuatKey[ 2 ];
+        channel->mRotationKeys[ 0 ] = aiQuatKey( 0.0, aiQuaternion() );
+        channel->mRotationKeys[ 1 ] = aiQuatKey( 10.0, aiQuaternion( aiVector3D( 0, 0, 1 ), ai_real( AI_MATH_PI / 2 ) ) );
+        channel->mNumScalingKeys = 1;
+        channel->mScalingKeys = new aiVectorKey[ 1 ];
+        channel->mScalingKeys[ 0 ] = aiVectorKey( 0.0, aiVector3D( 1, 1, 1 ) );
+        channel->mPostState = aiAnimBehaviour_CONSTANT;
+
+        mAnim = new aiAnimation();
+        mAnim->mDuration = 10.0;
+        mAnim->mNumChannels = 1;
+        mAnim->mChannels = new aiNodeAnim*[ 1 ];
+        mAnim->mChannels[ 0 ] = channel;
+    }
+
+    virtual void TearDown() {
+        delete mRoot;
+        delete mAnim;
+    }
+
+    static void expectMatrixNear( const aiMatrix4x4 &a, const aiMatrix4x4 &b ) {
+        for ( unsigned int i = 0; i < 4; ++i ) {
+            for ( unsigned int j = 0; j < 4; ++j ) {
+                EXPECT_NEAR( a[ i ][ j ], b[ i ][ j ], 1e-4 );
+            }
+        }
+    }
+
+    aiMatrix4x4 mTmp;
+    aiNode *mRoot;
+    aiAnimation *mAnim;
+};
+
+TEST_F( utAnimationSampler, flattenHierarchyTest ) {
+    AnimationSampler sampler( mRoot, mAnim );
+    ASSERT_EQ( 3U, sampler.GetNodeCount() );
+    EXPECT_EQ( mRoot, sampler.GetNode( 0 ) );
+    EXPECT_EQ( UINT_MAX, sampler.GetParentIndex( 0 ) );
+
+    const unsigned int hand = sampler.GetNodeIndex( aiString( "hand" ) );
+    ASSERT_NE( UINT_MAX, hand );
+    EXPECT_EQ( sampler.GetNodeIndex( aiString( "arm" ) ), sampler.GetParentIndex( hand ) );
+    EXPECT_EQ( UINT_MAX, sampler.GetNodeIndex( aiString( "missing" ) ) );
+}
+
+TEST_F( utAnimationSampler, sampleLocalAndGlobalTest ) {
+    AnimationSampler sampler( mRoot, mAnim );
+    std::vector<aiMatrix4x4> local( sampler.GetNodeCount() ), global( sampler.GetNodeCount() );
+    sampler.Sample( 5.0, &local[ 0 ], &global[ 0 ] );
+
+    const unsigned int arm = sampler.GetNodeIndex( aiString( "arm" ) );
+    const unsigned int hand = sampler.GetNodeIndex( aiString( "hand" ) );
+
+    aiMatrix4x4 expected = aiMatrix4x4::Translation( aiVector3D( 5, 0, 0 ), mTmp ) *
+            aiMatrix4x4( aiQuaternion( aiVector3D( 0, 0, 1 ), ai_real( AI_MATH_PI / 4 ) ).GetMatrix() );
+    expectMatrixNear( expected, local[ arm ] );
+    expectMatrixNear( mRoot->mTransformation, local[ 0 ] );
+    expectMatrixNear( local[ 0 ] * local[ arm ] * local[ hand ], global[ hand ] );
+
+    // the post state is constant, so the last key must be held
+    sampler.Sample( 20.0, &local[ 0 ] );
+    expected = aiMatrix4x4::Translation( aiVector3D( 10, 0, 0 ), mTmp ) *
+            aiMatrix4x4( aiQuaternion( aiVector3D( 0, 0, 1 ), ai_real( AI_MATH_PI / 2 ) ).GetMatrix() );
+    expectMatrixNear( expected, local[ arm ] );
+
+    // the pre state is the default, so the node's own transformation must be used
+    sampler.Sample( -5.0, &local[ 0 ] );
+    expectMatrixNear( aiMatrix4x4(), local[ arm ] );
+}
+
+TEST_F( utAnimationSampler, sampleBatchTest ) {
+    AnimationSampler sampler( mRoot, mAnim );
+    const unsigned int numNodes = sampler.GetNodeCount();
+    const double times[] = { 7.5, 1.0, 2.0, 9.99, 0.0, 10.0, 3.3 };
+    const unsigned int numTimes = sizeof( times ) / sizeof( times[ 0 ] );
+
+    std::vector<aiMatrix4x4> batch( numTimes * numNodes );
+    sampler.SampleBatch( times, numTimes, NULL, &batch[ 0 ] );
+
+    AnimationSampler reference( mRoot, mAnim );
+    std::vector<aiMatrix4x4> single( numNodes );
+    for ( unsigned int t = 0; t < numTimes; ++t ) {
+        reference.Sample( times[ t ], NULL, &single[ 0 ] );
+        for ( unsigned int n = 0; n < numNodes; ++n ) {
+            expectMatrixNear( single[ n ], batch[ t * numNodes + n ] );
+        }
+    }
+}
+
+TEST_F( utAnimationSampler, interpolateQuaternionsTest ) {
+    const unsigned int count = 256;
+    std::vector<aiQuaternion> a( count ), b( count ), out( count );
+    std::vector<ai_real> f( count );
+    ::srand( 42 );
+    for ( unsigned int i = 0; i < count; ++i ) {
+        const aiVector3D axisA( ::rand() % 100 + 1.f, ::rand() % 100 - 50.f, ::rand() % 100 - 50.f );
+        const aiVector3D axisB( ::rand() % 100 - 50.f, ::rand() % 100 + 1.f, ::rand() % 100 - 50.f );
+        a[ i ] = aiQuaternion( aiVector3D( axisA ).Normalize(), ( ::rand() % 628 ) / ai_real( 100.0 ) );
+        b[ i ] = aiQuaternion( aiVector3D( axisB ).Normalize(), ( ::rand() % 628 ) / ai_real( 100.0 ) );
+        f[ i ] = ( ::rand() % 1001 ) / ai_real( 1000.0 );
+    }
+
+    // compare against an exact slerp evaluated in double precision
+    AnimationSampler::InterpolateQuaternions( &a[ 0 ], &b[ 0 ], &f[ 0 ], &out[ 0 ], count );
+    for ( unsigned int i = 0; i < count; ++i ) {
+        aiQuaterniont<double> qa( a[ i ].w, a[ i ].x, a[ i ].y, a[ i ].z ), qb( b[ i ].w, b[ i ].x, b[ i ].y, b[ i ].z ), expected;
+        aiQuaterniont<double>::Interpolate( expected, qa, qb, f[ i ] );
+        EXPECT_NEAR( expected.x, out[ i ].x, 2e-6 );
+        EXPECT_NEAR( expected.y, out[ i ].y, 2e-6 );
+        EXPECT_NEAR( expected.z, out[ i ].z, 2e-6 );
+        EXPECT_NEAR( expected.w, out[ i ].w, 2e-6 );
+    }
+}
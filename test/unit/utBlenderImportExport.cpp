@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/scene.h>
 
 using namespace Assimp;
 
@@ -58,3 +60,47 @@ public:
 TEST_F( utBlenderImporterExporter, importBlenFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+static unsigned int CountNodes(const aiNode* node) {
+    unsigned int count = 1;
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        count += CountNodes(node->mChildren[i]);
+    }
+    return count;
+}
+
+static void CompareLazyImport(const char* file) {
+    Assimp::Importer full, lazy;
+    lazy.SetPropertyBool(AI_CONFIG_IMPORT_BLEND_LAZY_BLOCKS, true);
+
+    const aiScene* a = full.ReadFile(file, 0);
+    const aiScene* b = lazy.ReadFile(file, 0);
+    ASSERT_TRUE(nullptr != a);
+    ASSERT_TRUE(nullptr != b);
+
+    EXPECT_EQ(CountNodes(a->mRootNode), CountNodes(b->mRootNode));
+    EXPECT_EQ(a->mNumMaterials, b->mNumMaterials);
+    EXPECT_EQ(a->mNumTextures, b->mNumTextures);
+    EXPECT_EQ(a->mNumLights, b->mNumLights);
+    EXPECT_EQ(a->mNumCameras, b->mNumCameras);
+    ASSERT_EQ(a->mNumMeshes, b->mNumMeshes);
+    for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+        ASSERT_EQ(a->mMeshes[i]->mNumVertices, b->mMeshes[i]->mNumVertices);
+        EXPECT_EQ(a->mMeshes[i]->mNumFaces, b->mMeshes[i]->mNumFaces);
+        EXPECT_EQ(a->mMeshes[i]->mMaterialIndex, b->mMeshes[i]->mMaterialIndex);
+        for (unsigned int v = 0; v < a->mMeshes[i]->mNumVertices; ++v) {
+            EXPECT_EQ(a->mMeshes[i]->mVertices[v], b->mMeshes[i]->mVertices[v]);
+        }
+    }
+}
+
+TEST_F( utBlenderImporterExporter, lazyBlocksMatchFullImportTest ) {
+    CompareLazyImport( ASSIMP_TEST_MODELS_DIR "/BLEND/4Cubes4Mats_248.blend" );
+    CompareLazyImport( ASSIMP_TEST_MODELS_DIR "/BLEND/TexturedPlane_ImageUvPacked_248.blend" );
+    CompareLazyImport( ASSIMP_TEST_MODELS_DIR "/BLEND/BlenderDefault_271.blend" );
+}
+
+TEST_F( utBlenderImporterExporter, lazyBlocksCompressedTest ) {
+    CompareLazyImport( ASSIMP_TEST_MODELS_DIR "/BLEND/BlenderDefault_250_Compressed.blend" );
+    CompareLazyImport( ASSIMP_TEST_MODELS_DIR "/BLEND/TorusLightsCams_250_compressed.blend" );
+}
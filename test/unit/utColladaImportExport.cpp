@@ -43,6 +43,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
 
 using namespace Assimp;
 
@@ -58,3 +63,135 @@ public:
 TEST_F( utColladaImportExport, importBlenFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+// ------------------------------------------------------------------------------------------------
+// Generates a skinned and animated character with a wide joint hierarchy: every joint
+// drives one triangle and has its own animation channel targeting its transform.
+static std::string BuildRiggedCharacter( unsigned int numJoints ) {
+    static const char *identity = "1 0 0 0 0 1 0 0 0 0 1 0 0 0 0 1";
+    const unsigned int numVertices = numJoints * 3;
+    std::ostringstream s;
+
+    s << "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+         "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" version=\"1.4.1\">";
+
+    s << "<library_geometries><geometry id=\"g\"><mesh><source id=\"p\">"
+      << "<float_array id=\"pa\" count=\"" << numVertices * 3 << "\">";
+    for ( unsigned int j = 0; j < numJoints; ++j ) {
+        s << j << " 0 0 " << j + 1 << " 0 0 " << j << " 1 0 ";
+    }
+    s << "</float_array><technique_common><accessor source=\"#pa\" count=\"" << numVertices << "\" stride=\"3\">"
+         "<param name=\"X\" type=\"float\"/><param name=\"Y\" type=\"float\"/><param name=\"Z\" type=\"float\"/>"
+         "</accessor></technique_common></source>"
+         "<vertices id=\"v\"><input semantic=\"POSITION\" source=\"#p\"/></vertices>"
+         "<triangles count=\"" << numJoints << "\"><input semantic=\"VERTEX\" source=\"#v\" offset=\"0\"/><p>";
+    for ( unsigned int v = 0; v < numVertices; ++v ) {
+        s << v << " ";
+    }
+    s << "</p></triangles></mesh></geometry></library_geometries>";
+
+    // skin, joints are referenced by SID
+    s << "<library_controllers><controller id=\"skin\"><skin source=\"#g\">"
+      << "<bind_shape_matrix>" << identity << "</bind_shape_matrix>"
+      << "<source id=\"joints\"><Name_array id=\"ja\" count=\"" << numJoints << "\">";
+    for ( unsigned int j = 0; j < numJoints; ++j ) {
+        s << "j" << j << " ";
+    }
+    s << "</Name_array><technique_common><accessor source=\"#ja\" count=\"" << numJoints << "\" stride=\"1\">"
+         "<param name=\"JOINT\" type=\"name\"/></accessor></technique_common></source>"
+      << "<source id=\"binds\"><float_array id=\"ba\" count=\"" << numJoints * 16 << "\">";
+    for ( unsigned int j = 0; j < numJoints; ++j ) {
+        s << identity << " ";
+    }
+    s << "</float_array><technique_common><accessor source=\"#ba\" count=\"" << numJoints << "\" stride=\"16\">"
+         "<param name=\"TRANSFORM\" type=\"float4x4\"/></accessor></technique_common></source>"
+         "<source id=\"weights\"><float_array id=\"wa\" count=\"1\">1</float_array>"
+         "<technique_common><accessor source=\"#wa\" count=\"1\" stride=\"1\">"
+         "<param name=\"WEIGHT\" type=\"float\"/></accessor></technique_common></source>"
+         "<joints><input semantic=\"JOINT\" source=\"#joints\"/><input semantic=\"INV_BIND_MATRIX\" source=\"#binds\"/></joints>"
+         "<vertex_weights count=\"" << numVertices << "\">"
+         "<input semantic=\"JOINT\" source=\"#joints\" offset=\"0\"/><input semantic=\"WEIGHT\" source=\"#weights\" offset=\"1\"/><vcount>";
+    for ( unsigned int v = 0; v < numVertices; ++v ) {
+        s << "1 ";
+    }
+    s << "</vcount><v>";
+    for ( unsigned int v = 0; v < numVertices; ++v ) {
+        s << v / 3 << " 0 ";
+    }
+    s << "</v></vertex_weights></skin></controller></library_controllers>";
+
+    // one animation per joint, targeting the joint by ID
+    s << "<library_animations>";
+    for ( unsigned int j = 0; j < numJoints; ++j ) {
+        const std::string a = "a" + std::to_string( j );
+        s << "<animation id=\"" << a << "\">"
+          << "<source id=\"" << a << "-in\"><float_array id=\"" << a << "-ia\" count=\"2\">0 1</float_array>"
+          << "<technique_common><accessor source=\"#" << a << "-ia\" count=\"2\" stride=\"1\">"
+             "<param name=\"TIME\" type=\"float\"/></accessor></technique_common></source>"
+          << "<source id=\"" << a << "-out\"><float_array id=\"" << a << "-oa\" count=\"32\">"
+          << identity << " " << identity << "</float_array>"
+          << "<technique_common><accessor source=\"#" << a << "-oa\" count=\"2\" stride=\"16\">"
+             "<param name=\"TRANSFORM\" type=\"float4x4\"/></accessor></technique_common></source>"
+          << "<sampler id=\"" << a << "-s\"><input semantic=\"INPUT\" source=\"#" << a << "-in\"/>"
+          << "<input semantic=\"OUTPUT\" source=\"#" << a << "-out\"/></sampler>"
+          << "<channel source=\"#" << a << "-s\" target=\"J" << j << "/transform\"/></animation>";
+    }
+    s << "</library_animations>";
+
+    // joint hierarchy with four children per joint, written depth first
+    s << "<library_visual_scenes><visual_scene id=\"scene\">";
+    std::vector<unsigned int> stack( 1, 0 );
+    std::vector<unsigned int> open;
+    while ( !stack.empty() ) {
+        const unsigned int j = stack.back();
+        stack.pop_back();
+        while ( !open.empty() && ( j == 0 || ( j - 1 ) / 4 != open.back() ) ) {
+            s << "</node>";
+            open.pop_back();
+        }
+        s << "<node id=\"J" << j << "\" name=\"J" << j << "\" sid=\"j" << j << "\" type=\"JOINT\">"
+          << "<matrix sid=\"transform\">" << identity << "</matrix>";
+        open.push_back( j );
+        for ( unsigned int c = std::min( 4 * j + 4, numJoints - 1 ); c > 4 * j; --c ) {
+            stack.push_back( c );
+        }
+    }
+    for ( size_t i = 0; i < open.size(); ++i ) {
+        s << "</node>";
+    }
+    s << "<node id=\"character\" name=\"character\"><instance_controller url=\"#skin\">"
+         "<skeleton>#J0</skeleton></instance_controller></node>"
+         "</visual_scene></library_visual_scenes>"
+         "<scene><instance_visual_scene url=\"#scene\"/></scene></COLLADA>";
+    return s.str();
+}
+
+TEST_F( utColladaImportExport, heavilyRiggedCharacterTest ) {
+    const unsigned int numJoints = 1500;
+    const std::string file = BuildRiggedCharacter( numJoints );
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory( file.c_str(), file.size(), 0, "dae" );
+    const double ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+    RecordProperty( "importMilliseconds", static_cast<int>( ms ) );
+
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( 1u, scene->mNumMeshes );
+    const aiMesh *mesh = scene->mMeshes[ 0 ];
+    ASSERT_EQ( numJoints, mesh->mNumBones );
+
+    // bones refer to joints by SID, they must have been renamed to the node names
+    for ( unsigned int b = 0; b < mesh->mNumBones; ++b ) {
+        EXPECT_NE( nullptr, scene->mRootNode->FindNode( mesh->mBones[ b ]->mName ) );
+    }
+    EXPECT_STREQ( "J1499", mesh->mBones[ numJoints - 1 ]->mName.C_Str() );
+
+    // all channels must have found their target node
+    ASSERT_EQ( 1u, scene->mNumAnimations );
+    const aiAnimation *anim = scene->mAnimations[ 0 ];
+    ASSERT_EQ( numJoints, anim->mNumChannels );
+    for ( unsigned int c = 0; c < anim->mNumChannels; ++c ) {
+        EXPECT_NE( nullptr, scene->mRootNode->FindNode( anim->mChannels[ c ]->mNodeName ) );
+    }
+}
@@ -0,0 +1,135 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include <assimp/scene.h>
+#include <DeboneProcess.h>
+#include <ProcessHelper.h>
+
+using namespace std;
+using namespace Assimp;
+
+class DeboneTest : public ::testing::Test {
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    DeboneProcess* piProcess;
+    aiScene* pcScene;
+};
+
+// ------------------------------------------------------------------------------------------------
+void DeboneTest::SetUp()
+{
+    piProcess = new DeboneProcess();
+
+    // two triangles, each fully weighted to a bone of its own, so both bones can go
+    pcScene = new aiScene();
+    pcScene->mNumMeshes = 1;
+    pcScene->mMeshes = new aiMesh*[1];
+    pcScene->mMeshes[0] = TestModelFacttory::createSkinnedTriangles(2);
+    pcScene->mRootNode = new aiNode();
+    pcScene->mRootNode->mNumMeshes = 1;
+    pcScene->mRootNode->mMeshes = new unsigned int[1];
+    pcScene->mRootNode->mMeshes[0] = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DeboneTest::TearDown()
+{
+    delete pcScene;
+    delete piProcess;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(DeboneTest, testSharedTable)
+{
+    SharedPostProcessInfo shared;
+    BoneWeightTableCache* cache = new BoneWeightTableCache();
+    shared.AddProperty(AI_SPP_BONE_WEIGHTS, cache);
+    piProcess->SetSharedData(&shared);
+
+    aiMesh* source = pcScene->mMeshes[0];
+    cache->Get(source);
+
+    static_cast<BaseProcess*>(piProcess)->Execute(pcScene);
+
+    // both triangles were split off as meshes without bones, the table of the source is gone
+    ASSERT_EQ(2U, pcScene->mNumMeshes);
+    EXPECT_EQ(2U, pcScene->mRootNode->mNumMeshes);
+    EXPECT_FALSE(cache->Has(source));
+    for (unsigned int m = 0; m < pcScene->mNumMeshes; ++m) {
+        EXPECT_FALSE(pcScene->mMeshes[m]->HasBones());
+        EXPECT_EQ(1U, pcScene->mMeshes[m]->mNumFaces);
+    }
+
+    piProcess->SetSharedData(NULL);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(DeboneTest, testUsesSharedWeights)
+{
+    SharedPostProcessInfo shared;
+    BoneWeightTableCache* cache = new BoneWeightTableCache();
+    shared.AddProperty(AI_SPP_BONE_WEIGHTS, cache);
+    piProcess->SetSharedData(&shared);
+
+    // with the weights below the threshold in the shared table, both bones are needed
+    aiMesh* source = pcScene->mMeshes[0];
+    BoneWeightTable* table = new BoneWeightTable();
+    table->Build(source);
+    for (size_t i = 0; i < table->mEntries.size(); ++i) {
+        table->mEntries[i].second = 0.5f;
+    }
+    cache->Set(source, table);
+
+    static_cast<BaseProcess*>(piProcess)->Execute(pcScene);
+
+    ASSERT_EQ(1U, pcScene->mNumMeshes);
+    EXPECT_EQ(source, pcScene->mMeshes[0]);
+    EXPECT_EQ(2U, source->mNumBones);
+    EXPECT_TRUE(cache->Has(source));
+
+    piProcess->SetSharedData(NULL);
+}
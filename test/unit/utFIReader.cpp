@@ -0,0 +1,254 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include <FIReader.hpp>
+#include <MemoryIOWrapper.h>
+#include <ByteSwapper.h>
+#include <Exceptional.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+class utFIReader : public ::testing::Test {
+protected:
+    // Indices of the built-in Fast Infoset encoding algorithms.
+    enum {
+        FI_SHORT = 2,
+        FI_INT = 3,
+        FI_LONG = 4,
+        FI_BOOLEAN = 5,
+        FI_FLOAT = 6,
+        FI_DOUBLE = 7
+    };
+
+    virtual void SetUp() {
+        // document header, then an element <a> with literal qualified name and attributes
+        const uint8_t header[] = { 0xe0, 0x00, 0x00, 0x01, 0x00, 0x7c, 0x00, 'a' };
+        mData.assign(header, header + sizeof header);
+    }
+
+    void attributeName(const char *name) {
+        mData.push_back(0x78);
+        mData.push_back(static_cast<uint8_t>(strlen(name) - 1));
+        mData.insert(mData.end(), name, name + strlen(name));
+    }
+
+    // Attribute value as a literal character string of at most eight characters.
+    void addText(const char *name, const char *value) {
+        attributeName(name);
+        const size_t len = strlen(value);
+        mData.push_back(static_cast<uint8_t>(len - 1));
+        mData.insert(mData.end(), value, value + len);
+    }
+
+    // Attribute value encoded with one of the built-in algorithms, payload up to 264 octets.
+    void addEncoded(const char *name, unsigned int algorithm, const std::vector<uint8_t> &payload) {
+        attributeName(name);
+        mData.push_back(static_cast<uint8_t>(0x30 | (algorithm >> 4)));
+        const uint8_t low = static_cast<uint8_t>((algorithm & 0x0f) << 4);
+        if (payload.size() <= 8) {
+            mData.push_back(static_cast<uint8_t>(low | (payload.size() - 1)));
+        } else {
+            mData.push_back(low | 0x08);
+            mData.push_back(static_cast<uint8_t>(payload.size() - 9));
+        }
+        mData.insert(mData.end(), payload.begin(), payload.end());
+    }
+
+    template <typename T>
+    static std::vector<uint8_t> bigEndian(const std::vector<T> &values) {
+        std::vector<uint8_t> out;
+        for (T v : values) {
+#ifndef AI_BUILD_BIG_ENDIAN
+            ByteSwap::Swap(&v);
+#endif
+            const uint8_t *bytes = reinterpret_cast<const uint8_t*>(&v);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+        return out;
+    }
+
+    // Booleans are packed after a four bit count of the unused trailing bits.
+    static std::vector<uint8_t> packBools(const std::vector<bool> &values) {
+        const size_t unused = (8 - (4 + values.size()) % 8) % 8;
+        std::vector<uint8_t> out(1, static_cast<uint8_t>(unused << 4));
+        size_t bit = 4;
+        for (bool b : values) {
+            if (bit % 8 == 0) {
+                out.push_back(0);
+            }
+            if (b) {
+                out.back() |= static_cast<uint8_t>(0x80 >> (bit % 8));
+            }
+            ++bit;
+        }
+        return out;
+    }
+
+    // Terminates the element and the document and positions a reader on <a>.
+    std::unique_ptr<FIReader> open() {
+        mData.push_back(0xff);
+        mData.push_back(0xf0);
+        MemoryIOStream stream(mData.data(), mData.size());
+        std::unique_ptr<FIReader> reader = FIReader::create(&stream);
+        while (reader->read()) {
+            if (reader->getNodeType() == irr::io::EXN_ELEMENT) {
+                break;
+            }
+        }
+        return reader;
+    }
+
+    std::vector<uint8_t> mData;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFIReader, testTypedAccessorsConvertNumericPayloads)
+{
+    addEncoded("s", FI_SHORT, bigEndian(std::vector<int16_t>{ -2, 7 }));
+    addEncoded("i", FI_INT, bigEndian(std::vector<int32_t>{ 100000, -1 }));
+    addEncoded("l", FI_LONG, bigEndian(std::vector<int64_t>{ 3 }));
+    addEncoded("f", FI_FLOAT, bigEndian(std::vector<float>{ 1.5f, -0.25f, 0.f }));
+    addEncoded("d", FI_DOUBLE, bigEndian(std::vector<double>{ 2.5 }));
+    std::unique_ptr<FIReader> reader = open();
+    ASSERT_EQ(5, reader->getAttributeCount());
+
+    std::vector<int32_t> ints;
+    std::vector<float> floats;
+    std::vector<bool> bools;
+
+    ASSERT_TRUE(reader->getAttributeValueAsIntArray(0, ints));
+    EXPECT_EQ((std::vector<int32_t>{ -2, 7 }), ints);
+    ASSERT_TRUE(reader->getAttributeValueAsFloatArray(0, floats));
+    EXPECT_EQ((std::vector<float>{ -2.f, 7.f }), floats);
+
+    ASSERT_TRUE(reader->getAttributeValueAsIntArray(1, ints));
+    EXPECT_EQ((std::vector<int32_t>{ 100000, -1 }), ints);
+
+    ASSERT_TRUE(reader->getAttributeValueAsIntArray(2, ints));
+    EXPECT_EQ((std::vector<int32_t>{ 3 }), ints);
+
+    ASSERT_TRUE(reader->getAttributeValueAsFloatArray(3, floats));
+    EXPECT_EQ((std::vector<float>{ 1.5f, -0.25f, 0.f }), floats);
+    ASSERT_TRUE(reader->getAttributeValueAsBoolArray(3, bools));
+    EXPECT_EQ((std::vector<bool>{ true, true, false }), bools);
+
+    ASSERT_TRUE(reader->getAttributeValueAsFloatArray(4, floats));
+    EXPECT_EQ((std::vector<float>{ 2.5f }), floats);
+
+    // the text representation of the same values stays available
+    EXPECT_STREQ("-2 7", reader->getAttributeValue(0));
+    EXPECT_STREQ("1.5 -0.25 0", reader->getAttributeValue(3));
+
+    // out of range indices are rejected
+    EXPECT_FALSE(reader->getAttributeValueAsFloatArray(5, floats));
+    EXPECT_FALSE(reader->getAttributeValueAsIntArray(-1, ints));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFIReader, testTextValuesAreNotTyped)
+{
+    addText("t", "1 2 3");
+    std::unique_ptr<FIReader> reader = open();
+    ASSERT_EQ(1, reader->getAttributeCount());
+
+    std::vector<float> floats;
+    std::vector<int32_t> ints;
+    std::vector<bool> bools;
+    EXPECT_FALSE(reader->getAttributeValueAsFloatArray(0, floats));
+    EXPECT_FALSE(reader->getAttributeValueAsIntArray(0, ints));
+    EXPECT_FALSE(reader->getAttributeValueAsBoolArray(0, bools));
+    EXPECT_STREQ("1 2 3", reader->getAttributeValue(0));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFIReader, testXmlFallbackIsNotTyped)
+{
+    const char xml[] = "<a v=\"1 2 3\"/>";
+    MemoryIOStream stream(reinterpret_cast<const uint8_t*>(xml), sizeof xml - 1);
+    std::unique_ptr<FIReader> reader = FIReader::create(&stream);
+    ASSERT_TRUE(reader->read());
+    ASSERT_EQ(irr::io::EXN_ELEMENT, reader->getNodeType());
+
+    std::vector<float> floats;
+    EXPECT_FALSE(reader->getAttributeValueAsFloatArray(0, floats));
+    EXPECT_STREQ("1 2 3", reader->getAttributeValue(0));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFIReader, testBoolDecoderReadsEveryBit)
+{
+    // spans three octets, so every position of the mask is used at least once
+    const std::vector<bool> expected = { true, false, false, true, true, false, true, false,
+                                         false, true, true, true, false, false, true };
+    addEncoded("b", FI_BOOLEAN, packBools(expected));
+    addEncoded("one", FI_BOOLEAN, packBools(std::vector<bool>{ true }));
+    std::unique_ptr<FIReader> reader = open();
+    ASSERT_EQ(2, reader->getAttributeCount());
+
+    std::vector<bool> bools;
+    ASSERT_TRUE(reader->getAttributeValueAsBoolArray(0, bools));
+    EXPECT_EQ(expected, bools);
+    EXPECT_STREQ("true false false true true false true false false true true true false false true",
+                 reader->getAttributeValue(0));
+
+    std::vector<int32_t> ints;
+    ASSERT_TRUE(reader->getAttributeValueAsIntArray(0, ints));
+    ASSERT_EQ(expected.size(), ints.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i] ? 1 : 0, ints[i]);
+    }
+
+    ASSERT_TRUE(reader->getAttributeValueAsBoolArray(1, bools));
+    EXPECT_EQ(std::vector<bool>{ true }, bools);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFIReader, testBoolDecoderRejectsCorruptPadding)
+{
+    // a single octet holds four booleans, so more than four unused bits is invalid
+    addEncoded("b", FI_BOOLEAN, std::vector<uint8_t>{ 0x50 });
+    EXPECT_THROW(open(), DeadlyImportError);
+}
@@ -0,0 +1,276 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include <GenBVHProcess.h>
+#include <assimp/SceneCombiner.h>
+#include <assimp/scene.h>
+#include <random>
+#include <vector>
+
+using namespace ::std;
+using namespace ::Assimp;
+
+class GenBVHTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    GenBVHProcess* piProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+void GenBVHTest::SetUp()
+{
+    piProcess = new GenBVHProcess();
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenBVHTest::TearDown()
+{
+    delete piProcess;
+}
+
+// ------------------------------------------------------------------------------------------------
+// A soup of small random triangles in the unit cube
+static aiMesh* CreateTriangleSoup(unsigned int numFaces, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(0.f, 1.f), offset(-0.05f, 0.05f);
+
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+    mesh->mNumVertices = numFaces * 3;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        const aiVector3D center(pos(rng), pos(rng), pos(rng));
+        aiFace& face = mesh->mFaces[f];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            face.mIndices[i] = f * 3 + i;
+            mesh->mVertices[f * 3 + i] = center + aiVector3D(offset(rng), offset(rng), offset(rng));
+        }
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool Contains(const aiBVHNode& node, const aiVector3D& p)
+{
+    return p.x >= node.mMin.x && p.y >= node.mMin.y && p.z >= node.mMin.z &&
+        p.x <= node.mMax.x && p.y <= node.mMax.y && p.z <= node.mMax.z;
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool Overlaps(const aiBVHNode& node, const aiVector3D& min, const aiVector3D& max)
+{
+    return node.mMin.x <= max.x && node.mMin.y <= max.y && node.mMin.z <= max.z &&
+        min.x <= node.mMax.x && min.y <= node.mMax.y && min.z <= node.mMax.z;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, testMeshHierarchy)
+{
+    aiMesh* mesh = CreateTriangleSoup(1000, 1);
+    piProcess->SetMaxLeafSize(4);
+    EXPECT_TRUE(piProcess->ProcessMesh(mesh));
+    ASSERT_TRUE(mesh->HasBVH());
+    ASSERT_TRUE(NULL != mesh->mBVHFaces);
+
+    // every face is referenced once, by a leaf containing it
+    std::vector<unsigned int> refs(mesh->mNumFaces, 0);
+    for (unsigned int n = 0; n < mesh->mNumBVHNodes; ++n) {
+        const aiBVHNode& node = mesh->mBVHNodes[n];
+        if (node.mCount) {
+            EXPECT_LE(node.mCount, 4u);
+            ASSERT_LE(node.mFirst + node.mCount, mesh->mNumFaces);
+            for (unsigned int i = node.mFirst; i < node.mFirst + node.mCount; ++i) {
+                const aiFace& face = mesh->mFaces[mesh->mBVHFaces[i]];
+                ++refs[mesh->mBVHFaces[i]];
+                for (unsigned int k = 0; k < 3; ++k) {
+                    EXPECT_TRUE(Contains(node, mesh->mVertices[face.mIndices[k]]));
+                }
+            }
+        }
+        else {
+            ASSERT_GT(node.mFirst, n);
+            ASSERT_LT(node.mFirst + 1, mesh->mNumBVHNodes);
+            for (unsigned int c = node.mFirst; c < node.mFirst + 2; ++c) {
+                EXPECT_TRUE(Contains(node, mesh->mBVHNodes[c].mMin));
+                EXPECT_TRUE(Contains(node, mesh->mBVHNodes[c].mMax));
+            }
+        }
+    }
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        EXPECT_EQ(1u, refs[f]);
+    }
+
+    // the root holds the bounds of the mesh
+    aiVector3D min = mesh->mVertices[0], max = mesh->mVertices[0];
+    for (unsigned int i = 1; i < mesh->mNumVertices; ++i) {
+        min.x = std::min(min.x, mesh->mVertices[i].x);
+        min.y = std::min(min.y, mesh->mVertices[i].y);
+        min.z = std::min(min.z, mesh->mVertices[i].z);
+        max.x = std::max(max.x, mesh->mVertices[i].x);
+        max.y = std::max(max.y, mesh->mVertices[i].y);
+        max.z = std::max(max.z, mesh->mVertices[i].z);
+    }
+    EXPECT_EQ(min, mesh->mBVHNodes[0].mMin);
+    EXPECT_EQ(max, mesh->mBVHNodes[0].mMax);
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, testBoxQuery)
+{
+    aiMesh* mesh = CreateTriangleSoup(2000, 2);
+    EXPECT_TRUE(piProcess->ProcessMesh(mesh));
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> pos(0.f, 1.f);
+    for (unsigned int q = 0; q < 20; ++q) {
+        const aiVector3D center(pos(rng), pos(rng), pos(rng));
+        const aiVector3D min = center - aiVector3D(0.1f), max = center + aiVector3D(0.1f);
+
+        // faces with a vertex in the box, found by brute force and through the hierarchy
+        std::vector<unsigned int> expected, found;
+        aiBVHNode box;
+        box.mMin = min;
+        box.mMax = max;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            for (unsigned int k = 0; k < 3; ++k) {
+                if (Contains(box, mesh->mVertices[mesh->mFaces[f].mIndices[k]])) {
+                    expected.push_back(f);
+                    break;
+                }
+            }
+        }
+
+        unsigned int numVisited = 0;
+        std::vector<unsigned int> stack(1, 0);
+        while (!stack.empty()) {
+            const aiBVHNode& node = mesh->mBVHNodes[stack.back()];
+            stack.pop_back();
+            ++numVisited;
+            if (!Overlaps(node, min, max)) {
+                continue;
+            }
+            if (!node.mCount) {
+                stack.push_back(node.mFirst);
+                stack.push_back(node.mFirst + 1);
+                continue;
+            }
+            for (unsigned int i = node.mFirst; i < node.mFirst + node.mCount; ++i) {
+                const unsigned int f = mesh->mBVHFaces[i];
+                for (unsigned int k = 0; k < 3; ++k) {
+                    if (Contains(box, mesh->mVertices[mesh->mFaces[f].mIndices[k]])) {
+                        found.push_back(f);
+                        break;
+                    }
+                }
+            }
+        }
+        std::sort(found.begin(), found.end());
+        EXPECT_TRUE(expected == found);
+        EXPECT_LT(numVisited, mesh->mNumBVHNodes);
+    }
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, testSceneHierarchy)
+{
+    aiScene* scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    scene->mMeshes[0] = CreateTriangleSoup(100, 4);
+
+    // three instances of the mesh, moved along x
+    scene->mRootNode = new aiNode();
+    aiMatrix4x4::Scaling(aiVector3D(2.f), scene->mRootNode->mTransformation);
+    scene->mRootNode->mNumChildren = 3;
+    scene->mRootNode->mChildren = new aiNode*[3];
+    for (unsigned int i = 0; i < 3; ++i) {
+        aiNode* child = scene->mRootNode->mChildren[i] = new aiNode();
+        child->mParent = scene->mRootNode;
+        aiMatrix4x4::Translation(aiVector3D(ai_real(i * 10), 0, 0), child->mTransformation);
+        child->mNumMeshes = 1;
+        child->mMeshes = new unsigned int[1];
+        child->mMeshes[0] = 0;
+    }
+
+    piProcess->SetMaxLeafSize(1);
+    piProcess->Execute(scene);
+    EXPECT_TRUE(scene->mMeshes[0]->HasBVH());
+    ASSERT_TRUE(scene->HasBVH());
+    ASSERT_EQ(3u, scene->mNumBVHInstances);
+    EXPECT_EQ(5u, scene->mNumBVHNodes);
+
+    const aiBVHNode& root = scene->mBVHNodes[0];
+    const aiBVHNode& meshRoot = scene->mMeshes[0]->mBVHNodes[0];
+    EXPECT_FLOAT_EQ(2.f * meshRoot.mMin.x, root.mMin.x);
+    EXPECT_FLOAT_EQ(2.f * (meshRoot.mMax.x + 20.f), root.mMax.x);
+
+    for (unsigned int i = 0; i < 3; ++i) {
+        const aiBVHInstance& instance = scene->mBVHInstances[i];
+        EXPECT_EQ(0u, instance.mMesh);
+        ASSERT_TRUE(NULL != instance.mNode);
+        EXPECT_EQ(scene->mRootNode, instance.mNode->mParent);
+        EXPECT_EQ(2.f * instance.mNode->mTransformation.a4, instance.mTransformation.a4);
+    }
+
+    // copies refer to their own nodes
+    aiScene* copy = NULL;
+    SceneCombiner::CopyScene(&copy, scene);
+    ASSERT_EQ(3u, copy->mNumBVHInstances);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(copy->mRootNode, copy->mBVHInstances[i].mNode->mParent);
+    }
+    EXPECT_EQ(scene->mMeshes[0]->mNumBVHNodes, copy->mMeshes[0]->mNumBVHNodes);
+    EXPECT_NE(scene->mMeshes[0]->mBVHFaces, copy->mMeshes[0]->mBVHFaces);
+
+    delete copy;
+    delete scene;
+}
@@ -0,0 +1,231 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+#include <GenMeshletsProcess.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <set>
+
+using namespace ::std;
+using namespace ::Assimp;
+
+class GenMeshletsTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    GenMeshletsProcess* piProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsTest::SetUp()
+{
+    piProcess = new GenMeshletsProcess();
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsTest::TearDown()
+{
+    delete piProcess;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks the meshlets of a mesh against the limits and its faces
+static void CheckMeshlets(const aiMesh* mesh, const std::multiset<std::vector<unsigned int> >& faces,
+    unsigned int maxVertices, unsigned int maxTriangles)
+{
+    ASSERT_TRUE(mesh->HasMeshlets());
+
+    // the faces are only reordered
+    std::multiset<std::vector<unsigned int> > reordered;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        const aiFace& face = mesh->mFaces[i];
+        reordered.insert(std::vector<unsigned int>(face.mIndices, face.mIndices + face.mNumIndices));
+    }
+    EXPECT_TRUE(faces == reordered);
+
+    unsigned int faceOffset = 0, vertexOffset = 0;
+    for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+        const aiMeshlet& meshlet = mesh->mMeshlets[m];
+        EXPECT_EQ(faceOffset, meshlet.mFaceOffset);
+        EXPECT_EQ(vertexOffset, meshlet.mVertexOffset);
+        EXPECT_LE(meshlet.mNumFaces, maxTriangles);
+        EXPECT_LE(meshlet.mNumVertices, maxVertices);
+
+        // the vertex list holds exactly the vertices referenced by the faces
+        std::set<unsigned int> referenced, listed(mesh->mMeshletVertices + meshlet.mVertexOffset,
+            mesh->mMeshletVertices + meshlet.mVertexOffset + meshlet.mNumVertices);
+        for (unsigned int i = 0; i < meshlet.mNumFaces; ++i) {
+            const aiFace& face = mesh->mFaces[meshlet.mFaceOffset + i];
+            referenced.insert(face.mIndices, face.mIndices + face.mNumIndices);
+        }
+        EXPECT_TRUE(referenced == listed);
+        EXPECT_EQ(listed.size(), meshlet.mNumVertices);
+
+        for (unsigned int v : listed) {
+            EXPECT_LE((mesh->mVertices[v] - meshlet.mCenter).Length(), meshlet.mRadius * 1.0001f);
+        }
+
+        faceOffset += meshlet.mNumFaces;
+        vertexOffset += meshlet.mNumVertices;
+    }
+    EXPECT_EQ(mesh->mNumFaces, faceOffset);
+    EXPECT_EQ(mesh->mNumMeshletVertices, vertexOffset);
+}
+
+// ------------------------------------------------------------------------------------------------
+static std::multiset<std::vector<unsigned int> > GetFaces(const aiMesh* mesh)
+{
+    std::multiset<std::vector<unsigned int> > faces;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        const aiFace& face = mesh->mFaces[i];
+        faces.insert(std::vector<unsigned int>(face.mIndices, face.mIndices + face.mNumIndices));
+    }
+    return faces;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, testSharedVertices)
+{
+    std::unique_ptr<aiMesh> mesh(TestModelFacttory::createGridMesh(32, true));
+    const std::multiset<std::vector<unsigned int> > faces = GetFaces(mesh.get());
+
+    EXPECT_TRUE(piProcess->ProcessMesh(mesh.get()));
+    CheckMeshlets(mesh.get(), faces, PP_GM_MAX_VERTICES, PP_GM_MAX_TRIANGLES);
+
+    // a 7x7 quad patch fits into 64 vertices, so the 2048 triangles need about 21 meshlets
+    EXPECT_LE(mesh->mNumMeshlets, 30u);
+
+    // all triangles face +z, so the cones are as narrow as they get
+    for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+        const aiMeshlet& meshlet = mesh->mMeshlets[m];
+        EXPECT_NEAR(1.0f, meshlet.mConeAxis.z, 1e-5f);
+        EXPECT_NEAR(0.0f, meshlet.mConeCutoff, 1e-3f);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, testUnsharedVerticesAndLimits)
+{
+    std::unique_ptr<aiMesh> mesh(TestModelFacttory::createGridMesh(8, false));
+    const std::multiset<std::vector<unsigned int> > faces = GetFaces(mesh.get());
+
+    piProcess->SetLimits(16, 4);
+    EXPECT_TRUE(piProcess->ProcessMesh(mesh.get()));
+    CheckMeshlets(mesh.get(), faces, 16, 4);
+
+    // without shared vertices, meshlets are filled in face order
+    EXPECT_EQ(32u, mesh->mNumMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, testNormalCone)
+{
+    // two triangles folded at 90 degrees along a shared edge
+    aiMesh mesh;
+    mesh.mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh.mNumVertices = 4;
+    mesh.mVertices = new aiVector3D[4];
+    mesh.mVertices[0] = aiVector3D(0, 0, 0);
+    mesh.mVertices[1] = aiVector3D(1, 0, 0);
+    mesh.mVertices[2] = aiVector3D(0, 1, 0);
+    mesh.mVertices[3] = aiVector3D(0, 0, -1);
+    mesh.mNumFaces = 2;
+    mesh.mFaces = new aiFace[2];
+    const unsigned int indices[2][3] = { { 0, 1, 2 }, { 0, 1, 3 } };
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh.mFaces[f].mIndices = new unsigned int[mesh.mFaces[f].mNumIndices = 3];
+        std::copy(indices[f], indices[f] + 3, mesh.mFaces[f].mIndices);
+    }
+
+    EXPECT_TRUE(piProcess->ProcessMesh(&mesh));
+    ASSERT_EQ(1u, mesh.mNumMeshlets);
+    const aiMeshlet& meshlet = mesh.mMeshlets[0];
+
+    // the normals are +z and +y, the cone opens by 45 degrees around their bisector
+    EXPECT_NEAR(0.0f, meshlet.mConeAxis.x, 1e-5f);
+    EXPECT_NEAR(std::sqrt(0.5f), meshlet.mConeAxis.y, 1e-5f);
+    EXPECT_NEAR(std::sqrt(0.5f), meshlet.mConeAxis.z, 1e-5f);
+    EXPECT_NEAR(std::sqrt(0.5f), meshlet.mConeCutoff, 1e-5f);
+
+    // a viewer far below and behind both triangles is culled, one in front of them isn't
+    const aiVector3D behind(0.25f, -10, -10), front(0.25f, 10, 10);
+    aiVector3D dir = meshlet.mConeApex - behind;
+    EXPECT_GE(dir.Normalize() * meshlet.mConeAxis, meshlet.mConeCutoff);
+    dir = meshlet.mConeApex - front;
+    EXPECT_LT(dir.Normalize() * meshlet.mConeAxis, meshlet.mConeCutoff);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, testSkipNonTriangleMeshes)
+{
+    std::unique_ptr<aiMesh> mesh(TestModelFacttory::createGridMesh(2, true));
+    mesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
+    EXPECT_FALSE(piProcess->ProcessMesh(mesh.get()));
+    EXPECT_FALSE(mesh->HasMeshlets());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, testImportWithValidation)
+{
+    static const char* ObjModel =
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0 0 1\nv 1 0 1\nv 1 1 1\nv 0 1 1\n"
+        "f 1 4 3 2\nf 5 6 7 8\nf 1 2 6 5\nf 2 3 7 6\nf 3 4 8 7\nf 4 1 5 8\n";
+
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES, 6);
+    const aiScene* scene = importer.ReadFileFromMemory(ObjModel, strlen(ObjModel),
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenMeshlets |
+        aiProcess_ValidateDataStructure, "obj");
+    ASSERT_TRUE(scene != NULL);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+
+    const aiMesh* mesh = scene->mMeshes[0];
+    ASSERT_TRUE(mesh->HasMeshlets());
+    EXPECT_GE(mesh->mNumMeshlets, 2u);
+    EXPECT_EQ(12u, mesh->mMeshlets[mesh->mNumMeshlets - 1].mFaceOffset + mesh->mMeshlets[mesh->mNumMeshlets - 1].mNumFaces);
+}
@@ -40,7 +40,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 #include "UnitTestPCH.h"
+#include "TestModelFactory.h"
 #include <GenVertexNormalsProcess.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <cmath>
 
 using namespace ::std;
 using namespace ::Assimp;
@@ -88,3 +92,107 @@ TEST_F(GenNormalsTest, testSimpleTriangle)
     piProcess->GenMeshVertexNormals(pcMesh, 0);
     EXPECT_TRUE(pcMesh->mNormals != NULL);
 }
+
+// ------------------------------------------------------------------------------------------------
+// Two triangles in verbose format, sharing an edge at a right angle
+static aiMesh* CreateTentMesh()
+{
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 6;
+    mesh->mVertices = new aiVector3D[6];
+    mesh->mVertices[0] = aiVector3D(0.0f,0.0f,0.0f);
+    mesh->mVertices[1] = aiVector3D(1.0f,0.0f,0.0f);
+    mesh->mVertices[2] = aiVector3D(0.0f,1.0f,0.0f);
+    mesh->mVertices[3] = aiVector3D(1.0f,0.0f,0.0f);
+    mesh->mVertices[4] = aiVector3D(0.0f,0.0f,0.0f);
+    mesh->mVertices[5] = aiVector3D(0.0f,0.0f,-1.0f);
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh->mFaces[f].mIndices = new unsigned int[mesh->mFaces[f].mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            mesh->mFaces[f].mIndices[i] = f * 3 + i;
+        }
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testExactPositionsMatchesDefault)
+{
+    std::unique_ptr<aiMesh> reference(CreateTentMesh()), fast(CreateTentMesh());
+    piProcess->GenMeshVertexNormals(reference.get(), 0);
+    piProcess->SetExactPositions(true);
+    piProcess->GenMeshVertexNormals(fast.get(), 0);
+
+    ASSERT_TRUE(fast->mNormals != NULL);
+    for (unsigned int i = 0; i < 6; ++i) {
+        EXPECT_NEAR(reference->mNormals[i].x, fast->mNormals[i].x, 1e-6f);
+        EXPECT_NEAR(reference->mNormals[i].y, fast->mNormals[i].y, 1e-6f);
+        EXPECT_NEAR(reference->mNormals[i].z, fast->mNormals[i].z, 1e-6f);
+    }
+
+    // the shared edge is smoothed
+    EXPECT_NEAR(fast->mNormals[0].z, -fast->mNormals[0].y, 1e-6f);
+    EXPECT_EQ(fast->mNormals[0], fast->mNormals[4]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testExactPositionsWithSmoothingAngle)
+{
+    std::unique_ptr<aiMesh> reference(CreateTentMesh()), fast(CreateTentMesh());
+    piProcess->SetMaxSmoothAngle(AI_DEG_TO_RAD(30.f));
+    piProcess->GenMeshVertexNormals(reference.get(), 0);
+    piProcess->SetExactPositions(true);
+    piProcess->GenMeshVertexNormals(fast.get(), 0);
+
+    // the faces meet at a right angle, so there is nothing to smooth
+    for (unsigned int i = 0; i < 6; ++i) {
+        EXPECT_EQ(reference->mNormals[i], fast->mNormals[i]);
+    }
+    EXPECT_EQ(aiVector3D(0.0f,0.0f,1.0f), fast->mNormals[0]);
+    EXPECT_EQ(aiVector3D(0.0f,-1.0f,0.0f), fast->mNormals[4]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testExactPositionsNotImpliedByFavourSpeed)
+{
+    // vertex 4 is close to, but not at the position of vertex 0
+    std::unique_ptr<aiMesh> speed(CreateTentMesh()), exact(CreateTentMesh());
+    speed->mVertices[4].x = exact->mVertices[4].x = 1e-7f;
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, 1);
+    piProcess->SetupProperties(&importer);
+    piProcess->GenMeshVertexNormals(speed.get(), 0);
+    EXPECT_EQ(speed->mNormals[0], speed->mNormals[4]);
+
+    importer.SetPropertyInteger(AI_CONFIG_PP_GSN_EXACT_POSITIONS, 1);
+    piProcess->SetupProperties(&importer);
+    piProcess->GenMeshVertexNormals(exact.get(), 0);
+    EXPECT_EQ(aiVector3D(0.0f,0.0f,1.0f), exact->mNormals[0]);
+    EXPECT_EQ(aiVector3D(0.0f,-1.0f,0.0f), exact->mNormals[4]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSpatialSortGridMatchesDefault)
+{
+    // a bumpy height field in verbose format
+    const TestModelFacttory::HeightFunc bumps = [](ai_real x, ai_real y) {
+        return 0.1f * std::sin(x * 3.f) * std::cos(y * 2.f);
+    };
+    std::unique_ptr<aiMesh> reference(TestModelFacttory::createGridMesh(32, false, 0.1f, bumps));
+    std::unique_ptr<aiMesh> grid(TestModelFacttory::createGridMesh(32, false, 0.1f, bumps));
+    piProcess->GenMeshVertexNormals(reference.get(), 0);
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_GRID, 1);
+    piProcess->SetupProperties(&importer);
+    piProcess->GenMeshVertexNormals(grid.get(), 0);
+
+    ASSERT_TRUE(grid->mNormals != NULL);
+    for (unsigned int i = 0; i < grid->mNumVertices; ++i) {
+        EXPECT_EQ(reference->mNormals[i], grid->mNormals[i]);
+    }
+}
@@ -43,6 +43,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/LogStream.hpp>
+#include <assimp/scene.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <set>
 
 using namespace Assimp;
 
@@ -60,3 +68,69 @@ public:
 TEST_F( utIFCImportExport, importIFCFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+static void collectMappedItemNodes( const aiNode *node, std::vector<const aiNode*> &mapped ) {
+    if ( 0 == strcmp( node->mName.C_Str(), "IfcMappedItem" ) && node->mNumMeshes ) {
+        mapped.push_back( node );
+    }
+    for ( unsigned int i = 0; i < node->mNumChildren; ++i ) {
+        collectMappedItemNodes( node->mChildren[ i ], mapped );
+    }
+}
+
+TEST_F( utIFCImportExport, mappedItemsShareMeshesTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    std::vector<const aiNode*> mapped;
+    collectMappedItemNodes( scene->mRootNode, mapped );
+    ASSERT_FALSE( mapped.empty() );
+
+    // repeated instances of one representation map must reference the same meshes,
+    // so there have to be fewer distinct meshes than mesh references.
+    std::set<unsigned int> distinct;
+    size_t references = 0;
+    for ( const aiNode *node : mapped ) {
+        distinct.insert( node->mMeshes, node->mMeshes + node->mNumMeshes );
+        references += node->mNumMeshes;
+    }
+    EXPECT_LT( distinct.size(), references );
+}
+
+class RepresentationMapStatsStream : public LogStream {
+public:
+    RepresentationMapStatsStream() : mFound( false ), mConverted( 0 ), mReused( 0 ) {}
+
+    void write( const char *message ) {
+        const char *stats = strstr( message, "IFC: converted " );
+        if ( nullptr != stats ) {
+            mFound = 2 == sscanf( stats, "IFC: converted %u representation maps, took %u", &mConverted, &mReused );
+        }
+    }
+
+    bool mFound;
+    unsigned int mConverted, mReused;
+};
+
+TEST_F( utIFCImportExport, representationMapsConvertedOnceTest ) {
+    std::unique_ptr<RepresentationMapStatsStream> stream( new RepresentationMapStatsStream() );
+    ASSERT_TRUE( DefaultLogger::get()->attachStream( stream.get(), Logger::Debugging ) );
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", 0 );
+
+    DefaultLogger::get()->detatchStream( stream.get(), Logger::Debugging );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_TRUE( stream->mFound );
+
+    std::vector<const aiNode*> mapped;
+    collectMappedItemNodes( scene->mRootNode, mapped );
+
+    // every IfcMappedItem node is either the first instance of its representation map,
+    // which has to be converted, or one taken from the per-map cache without converting
+    // any of its items again.
+    EXPECT_EQ( mapped.size(), static_cast<size_t>( stream->mConverted + stream->mReused ) );
+    EXPECT_GT( stream->mReused, 0u );
+    EXPECT_LT( stream->mConverted, stream->mReused );
+}
@@ -40,4 +40,140 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 
-#include "UnitTestPCH.h"
\ No newline at end of file
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include <ImproveCacheLocality.h>
+#include <assimp/scene.h>
+#include <algorithm>
+
+using namespace ::Assimp;
+
+class ImproveCacheLocalityTest : public ::testing::Test
+{
+public:
+    virtual void SetUp() { piProcess = new ImproveCacheLocalityProcess(); }
+    virtual void TearDown() { delete piProcess; }
+
+protected:
+    ImproveCacheLocalityProcess* piProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+static void SetTriangle(aiFace& face, unsigned int a, unsigned int b, unsigned int c)
+{
+    face.mIndices = new unsigned int[face.mNumIndices = 3];
+    face.mIndices[0] = a;
+    face.mIndices[1] = b;
+    face.mIndices[2] = c;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImproveCacheLocalityTest, testVertexFetchRemapsAllStreams)
+{
+    aiMesh mesh;
+    mesh.mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh.mNumVertices = 5;
+    mesh.mVertices = new aiVector3D[5];
+    mesh.mNormals = new aiVector3D[5];
+    mesh.mTextureCoords[0] = new aiVector3D[5];
+    for (unsigned int i = 0; i < 5; ++i) {
+        mesh.mVertices[i] = aiVector3D(ai_real(i), 0, 0);
+        mesh.mNormals[i] = aiVector3D(0, ai_real(i), 0);
+        mesh.mTextureCoords[0][i] = aiVector3D(0, 0, ai_real(i));
+    }
+    mesh.mNumFaces = 2;
+    mesh.mFaces = new aiFace[2];
+    SetTriangle(mesh.mFaces[0], 4, 2, 3);
+    SetTriangle(mesh.mFaces[1], 3, 2, 0);
+
+    mesh.mNumBones = 1;
+    mesh.mBones = new aiBone*[1];
+    mesh.mBones[0] = new aiBone();
+    mesh.mBones[0]->mNumWeights = 2;
+    mesh.mBones[0]->mWeights = new aiVertexWeight[2];
+    mesh.mBones[0]->mWeights[0] = aiVertexWeight(0, 0.5f);
+    mesh.mBones[0]->mWeights[1] = aiVertexWeight(1, 0.5f);
+
+    mesh.mNumAnimMeshes = 1;
+    mesh.mAnimMeshes = new aiAnimMesh*[1];
+    mesh.mAnimMeshes[0] = new aiAnimMesh();
+    mesh.mAnimMeshes[0]->mNumVertices = 5;
+    mesh.mAnimMeshes[0]->mVertices = new aiVector3D[5];
+    for (unsigned int i = 0; i < 5; ++i) {
+        mesh.mAnimMeshes[0]->mVertices[i] = aiVector3D(ai_real(i), 1, 0);
+    }
+
+    ImproveCacheLocalityProcess::OptimizeVertexFetch(&mesh);
+
+    // first-use order 4 2 3 0, the unreferenced vertex 1 goes last
+    const unsigned int order[5] = { 4, 2, 3, 0, 1 };
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(i, mesh.mFaces[0].mIndices[i]);
+    }
+    EXPECT_EQ(2u, mesh.mFaces[1].mIndices[0]);
+    EXPECT_EQ(1u, mesh.mFaces[1].mIndices[1]);
+    EXPECT_EQ(3u, mesh.mFaces[1].mIndices[2]);
+    for (unsigned int i = 0; i < 5; ++i) {
+        EXPECT_EQ(aiVector3D(ai_real(order[i]), 0, 0), mesh.mVertices[i]);
+        EXPECT_EQ(aiVector3D(0, ai_real(order[i]), 0), mesh.mNormals[i]);
+        EXPECT_EQ(aiVector3D(0, 0, ai_real(order[i])), mesh.mTextureCoords[0][i]);
+        EXPECT_EQ(aiVector3D(ai_real(order[i]), 1, 0), mesh.mAnimMeshes[0]->mVertices[i]);
+    }
+    EXPECT_EQ(3u, mesh.mBones[0]->mWeights[0].mVertexId);
+    EXPECT_EQ(4u, mesh.mBones[0]->mWeights[1].mVertexId);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImproveCacheLocalityTest, testVertexFetchReducesOverfetch)
+{
+    // a planar grid with the vertices in random order
+    std::unique_ptr<aiMesh> mesh(TestModelFacttory::createGridMesh(64, true, 1, TestModelFacttory::HeightFunc(), 42));
+    const float before = piProcess->ComputeOverfetch(mesh.get());
+    ImproveCacheLocalityProcess::OptimizeVertexFetch(mesh.get());
+    const float after = piProcess->ComputeOverfetch(mesh.get());
+
+    EXPECT_GT(before, 2.f);
+    EXPECT_LT(after, 1.5f);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImproveCacheLocalityTest, testOverdrawDrawsOuterClustersFirst)
+{
+    // two separate triangles facing +z, the inner one at z = -1 is listed first
+    aiMesh mesh;
+    mesh.mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh.mNumVertices = 6;
+    mesh.mVertices = new aiVector3D[6];
+    for (unsigned int i = 0; i < 6; ++i) {
+        const ai_real z = i < 3 ? ai_real(-1) : ai_real(1);
+        mesh.mVertices[i] = aiVector3D(ai_real(i % 3 == 1), ai_real(i % 3 == 2), z);
+    }
+    mesh.mNumFaces = 2;
+    mesh.mFaces = new aiFace[2];
+    SetTriangle(mesh.mFaces[0], 0, 1, 2);
+    SetTriangle(mesh.mFaces[1], 3, 4, 5);
+
+    EXPECT_EQ(2u, piProcess->OptimizeOverdraw(&mesh, 1.05f));
+    EXPECT_EQ(3u, mesh.mFaces[0].mIndices[0]);
+    EXPECT_EQ(0u, mesh.mFaces[1].mIndices[0]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImproveCacheLocalityTest, testOverdrawKeepsFaces)
+{
+    std::unique_ptr<aiMesh> mesh(TestModelFacttory::createGridMesh(16, true, 1, TestModelFacttory::HeightFunc(), 42));
+    std::vector<std::vector<unsigned int> > before, after;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        before.push_back(std::vector<unsigned int>(mesh->mFaces[f].mIndices, mesh->mFaces[f].mIndices + 3));
+    }
+
+    EXPECT_GE(piProcess->OptimizeOverdraw(mesh.get(), 1.05f), 1u);
+
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        after.push_back(std::vector<unsigned int>(mesh->mFaces[f].mIndices, mesh->mFaces[f].mIndices + 3));
+    }
+    std::sort(before.begin(), before.end());
+    std::sort(after.begin(), after.end());
+    EXPECT_TRUE(before == after);
+}
@@ -42,6 +42,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 #include <JoinVerticesProcess.h>
 
 
@@ -142,3 +144,23 @@ TEST_F(JoinVerticesTest, testProcess)
     EXPECT_EQ(150.f*299.f*3.f, fSum); // gaussian sum equation
 }
 
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(JoinVerticesTest, testProcessWithSpatialSortGrid)
+{
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_SPATIAL_SORT_GRID, 1);
+    piProcess->SetupProperties(&importer);
+    piProcess->ProcessMesh(pcMesh,0);
+
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+
+    float fSum = 0.f;
+    for (unsigned int i = 0; i < 300;++i)
+    {
+        aiVector3D& v = pcMesh->mVertices[i];
+        fSum += v.x + v.y + v.z;
+    }
+    EXPECT_EQ(150.f*299.f*3.f, fSum);
+}
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/scene.h>
 #include <LimitBoneWeightsProcess.h>
+#include <ProcessHelper.h>
 
 using namespace std;
 using namespace Assimp;
@@ -137,3 +138,47 @@ TEST_F(LimitBoneWeightsTest, testProcess)
 
     // everything seems to be OK
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(LimitBoneWeightsTest, testSharedTable)
+{
+    // the step must use the shared per-vertex table and leave an up to date one behind
+    SharedPostProcessInfo shared;
+    BoneWeightTableCache* cache = new BoneWeightTableCache();
+    shared.AddProperty(AI_SPP_BONE_WEIGHTS, cache);
+    piProcess->SetSharedData(&shared);
+
+    const BoneWeightTable& before = cache->Get(pcMesh);
+    EXPECT_EQ(7500U, before.mEntries.size());
+    EXPECT_EQ(15U, (unsigned int)(before.End(0) - before.Begin(0)));
+
+    piProcess->mMaxWeights = 1;
+    piProcess->ProcessMesh(pcMesh);
+
+    BoneWeightTable expected;
+    expected.Build(pcMesh);
+
+    const BoneWeightTable& after = cache->Get(pcMesh);
+    EXPECT_EQ(500U, after.mEntries.size());
+    EXPECT_TRUE(expected.mOffsets == after.mOffsets);
+    ASSERT_EQ(expected.mEntries.size(), after.mEntries.size());
+    for (size_t i = 0; i < after.mEntries.size(); ++i) {
+        EXPECT_EQ(expected.mEntries[i].first, after.mEntries[i].first);
+        EXPECT_EQ(1.0f, after.mEntries[i].second);
+    }
+
+    piProcess->SetSharedData(NULL);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(LimitBoneWeightsTest, testInvalidVertexIdIsSkipped)
+{
+    pcMesh->mBones[0]->mWeights[0].mVertexId = 1000;
+
+    BoneWeightTable table;
+    table.Build(pcMesh);
+    ASSERT_EQ(501U, table.mOffsets.size());
+    EXPECT_EQ(7499U, table.mEntries.size());
+    EXPECT_EQ(14U, (unsigned int)(table.End(0) - table.Begin(0)));
+    EXPECT_EQ(15U, (unsigned int)(table.End(1) - table.Begin(1)));
+}
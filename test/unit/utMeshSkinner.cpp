@@ -0,0 +1,153 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/MeshSkinner.h>
+#include <assimp/AnimationSampler.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utMeshSkinner : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // three vertices along the x axis, skinned to two bones
+        mMesh = new aiMesh();
+        mMesh->mNumVertices = 3;
+        mMesh->mVertices = new aiVector3D[ 3 ];
+        mMesh->mVertices[ 0 ] = aiVector3D( 0, 0, 0 );
+        mMesh->mVertices[ 1 ] = aiVector3D( 1, 0, 0 );
+        mMesh->mVertices[ 2 ] = aiVector3D( 2, 0, 0 );
+
+        mMesh->mNumBones = 2;
+        mMesh->mBones = new aiBone*[ 2 ];
+        mMesh->mBones[ 0 ] = new aiBone();
+        mMesh->mBones[ 0 ]->mName.Set( "bone0" );
+        mMesh->mBones[ 0 ]->mNumWeights = 2;
+        mMesh->mBones[ 0 ]->mWeights = new aiVertexWeight[ 2 ];
+        mMesh->mBones[ 0 ]->mWeights[ 0 ] = aiVertexWeight( 0, 1.0f );
+        mMesh->mBones[ 0 ]->mWeights[ 1 ] = aiVertexWeight( 1, 0.25f );
+        mMesh->mBones[ 1 ] = new aiBone();
+        mMesh->mBones[ 1 ]->mName.Set( "bone1" );
+        mMesh->mBones[ 1 ]->mNumWeights = 2;
+        mMesh->mBones[ 1 ]->mWeights = new aiVertexWeight[ 2 ];
+        mMesh->mBones[ 1 ]->mWeights[ 0 ] = aiVertexWeight( 1, 0.75f );
+        mMesh->mBones[ 1 ]->mWeights[ 1 ] = aiVertexWeight( 2, 1.0f );
+
+        // root -> mesh, root -> bone0, bone1
+        mRoot = new aiNode( "root" );
+        aiNode *children[] = { new aiNode( "mesh" ), new aiNode( "bone0" ), new aiNode( "bone1" ) };
+        mRoot->addChildren( 3, children );
+
+        // bone1 moves up by 4 units over 10 ticks
+        aiNodeAnim *channel = new aiNodeAnim();
+        channel->mNodeName.Set( "bone1" );
+        channel->mNumPositionKeys = 2;
+        channel->mPositionKeys = new aiVectorKey[ 2 ];
+        channel->mPositionKeys[ 0 ] = aiVectorKey( 0.0, aiVector3D( 0, 0, 0 ) );
+        channel->mPositionKeys[ 1 ] = aiVectorKey( 10.0, aiVector3D( 0, 4, 0 ) );
+        mAnim = new aiAnimation();
+        mAnim->mNumChannels = 1;
+        mAnim->mChannels = new aiNodeAnim*[ 1 ];
+        mAnim->mChannels[ 0 ] = channel;
+    }
+
+    virtual void TearDown() {
+        delete mMesh;
+        delete mRoot;
+        delete mAnim;
+    }
+
+    aiMesh *mMesh;
+    aiNode *mRoot;
+    aiAnimation *mAnim;
+};
+
+TEST_F( utMeshSkinner, influenceTableTest ) {
+    BoneInfluenceTable table( mMesh );
+    ASSERT_EQ( 3U, table.GetNumVertices() );
+    ASSERT_EQ( 2U, table.GetStride() );
+
+    // vertex 1 has both bones, the larger weight comes first
+    EXPECT_EQ( 1U, table.GetBoneIndices()[ 2 ] );
+    EXPECT_FLOAT_EQ( 0.75f, table.GetWeights()[ 2 ] );
+    EXPECT_EQ( 0U, table.GetBoneIndices()[ 3 ] );
+    EXPECT_FLOAT_EQ( 0.25f, table.GetWeights()[ 3 ] );
+
+    // unused slots are zero
+    EXPECT_FLOAT_EQ( 0.0f, table.GetWeights()[ 1 ] );
+
+    // limiting to a single influence renormalizes the weights
+    BoneInfluenceTable limited( mMesh, 1 );
+    ASSERT_EQ( 1U, limited.GetStride() );
+    EXPECT_EQ( 1U, limited.GetBoneIndices()[ 1 ] );
+    EXPECT_FLOAT_EQ( 1.0f, limited.GetWeights()[ 1 ] );
+}
+
+TEST_F( utMeshSkinner, skinTest ) {
+    MeshSkinner skinner( mMesh );
+    aiMatrix4x4 bones[ 2 ];
+    aiMatrix4x4::Translation( aiVector3D( 0, 4, 0 ), bones[ 1 ] );
+
+    aiVector3D positions[ 3 ];
+    skinner.Skin( bones, positions );
+    EXPECT_EQ( aiVector3D( 0, 0, 0 ), positions[ 0 ] );
+    EXPECT_EQ( aiVector3D( 1, 3, 0 ), positions[ 1 ] );
+    EXPECT_EQ( aiVector3D( 2, 4, 0 ), positions[ 2 ] );
+
+    aiVector3D min, max;
+    skinner.ComputeBounds( bones, min, max );
+    EXPECT_EQ( aiVector3D( 0, 0, 0 ), min );
+    EXPECT_EQ( aiVector3D( 2, 4, 0 ), max );
+}
+
+TEST_F( utMeshSkinner, animatedBoundsTest ) {
+    AnimationSampler sampler( mRoot, mAnim );
+    MeshSkinner skinner( mMesh );
+    const unsigned int meshNode = sampler.GetNodeIndex( aiString( "mesh" ) );
+
+    const double times[] = { 0.0, 5.0 };
+    aiVector3D min, max;
+    skinner.ComputeAnimatedBounds( sampler, times, 2, meshNode, min, max );
+    EXPECT_EQ( aiVector3D( 0, 0, 0 ), min );
+    EXPECT_EQ( aiVector3D( 2, 2, 0 ), max );
+}
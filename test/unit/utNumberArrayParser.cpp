@@ -0,0 +1,147 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <NumberArrayParser.h>
+#include <ParsingUtils.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+class NumberArrayParserTest : public ::testing::Test {
+protected:
+    // Tokens that hit both the fast paths and the fallbacks. The list is
+    // repeated so that the tail of the input is handled as well.
+    static std::string MakeRealInput() {
+        static const char* tokens[] = { "0", "1.354", "-1054E-3", "1,5", ".25", "-.5", "3.",
+            "12345678.5", "0.1234567890123456789", "-0", "nan", "-inf", "+7", "99.999999",
+            "-1234567.1234567", "4e2" };
+        std::string s;
+        for ( int rep = 0; rep < 4; ++rep ) {
+            for ( const char* t : tokens ) {
+                s += t;
+                s += rep % 2 ? "\r\n\t" : " ";
+            }
+        }
+        return s;
+    }
+};
+
+TEST_F( NumberArrayParserTest, realsMatchFastAtof ) {
+    const std::string input = MakeRealInput();
+
+    std::vector<float> expected;
+    for ( const char* p = input.c_str(); *p; ) {
+        float f;
+        p = fast_atoreal_move<float>( p, f );
+        expected.push_back( f );
+        SkipSpacesAndLineEnd( &p );
+    }
+
+    std::vector<float> values( expected.size() );
+    const char* p = input.c_str();
+    EXPECT_EQ( expected.size(), ReadRealArray( p, &values[ 0 ], values.size() ) );
+    EXPECT_EQ( '\0', *p );
+    for ( size_t i = 0; i < expected.size(); ++i ) {
+        if ( expected[ i ] != expected[ i ] ) {
+            EXPECT_NE( values[ i ], values[ i ] );
+        } else {
+            EXPECT_EQ( 0, std::memcmp( &expected[ i ], &values[ i ], sizeof( float ) ) ) << i;
+        }
+    }
+}
+
+TEST_F( NumberArrayParserTest, realsStopAtCount ) {
+    float values[ 3 ];
+    const char* p = " 1 2 3 4";
+    EXPECT_EQ( 3u, ReadRealArray( p, values, 3 ) );
+    EXPECT_EQ( 3.f, values[ 2 ] );
+    EXPECT_STREQ( "4", p );
+
+    p = "1 2";
+    EXPECT_EQ( 2u, ReadRealArray( p, values, 3 ) );
+}
+
+TEST_F( NumberArrayParserTest, integersMatchStrtol10 ) {
+    const std::string input = "0 7 -3 +12 1234567 12345678 123456789 4294967295 "
+        "00000000012 -0 42\n\t17 1 2 3 4 5 6 7 8 9 10 ";
+
+    std::vector<int> expected;
+    for ( const char* p = input.c_str(); *p; ) {
+        expected.push_back( strtol10( p, &p ) );
+        SkipSpacesAndLineEnd( &p );
+    }
+
+    std::vector<int> values;
+    const char* p = input.c_str();
+    ReadIntegerArray( p, values );
+    EXPECT_EQ( '\0', *p );
+    EXPECT_EQ( expected, values );
+}
+
+TEST_F( NumberArrayParserTest, allWhiteSpaceSeparates ) {
+    std::vector<int> indices;
+    const char* p = "\f1\v2\f\f3\r\n4\t5 \v";
+    ReadIntegerArray( p, indices );
+    EXPECT_EQ( '\0', *p );
+    ASSERT_EQ( 5u, indices.size() );
+    EXPECT_EQ( 3, indices[ 2 ] );
+    EXPECT_EQ( 5, indices[ 4 ] );
+
+    float values[ 3 ];
+    p = "0.5\f1.25\v-2e1\f";
+    EXPECT_EQ( 3u, ReadRealArray( p, values, 3 ) );
+    EXPECT_EQ( 1.25f, values[ 1 ] );
+    EXPECT_EQ( -20.f, values[ 2 ] );
+}
+
+TEST_F( NumberArrayParserTest, integersClampAndStop ) {
+    std::vector<size_t> indices;
+    const char* p = "4 -2 5 x 6";
+    ReadIntegerArray( p, indices, 3 );
+    ASSERT_EQ( 3u, indices.size() );
+    EXPECT_EQ( 0u, indices[ 1 ] );
+    EXPECT_STREQ( "x 6", p );
+}
@@ -0,0 +1,149 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <OptimizeAnimations.h>
+#include <assimp/anim.h>
+
+#include <cmath>
+
+using namespace std;
+using namespace Assimp;
+
+class OptimizeAnimationsProcessTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    aiNodeAnim* pcChannel;
+    OptimizeAnimationsProcess* piProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcessTest::SetUp()
+{
+    piProcess = new OptimizeAnimationsProcess();
+    pcChannel = new aiNodeAnim();
+
+    // linear motion: a key per frame, all but the first and the last are redundant
+    pcChannel->mNumPositionKeys = 101;
+    pcChannel->mPositionKeys = new aiVectorKey[101];
+    for (unsigned int i = 0; i < 101; ++i) {
+        pcChannel->mPositionKeys[i] = aiVectorKey(i, aiVector3D((ai_real)i, (ai_real)i * 2, 0));
+    }
+
+    // constant angular velocity around a fixed axis: slerp reconstructs this exactly
+    pcChannel->mNumRotationKeys = 101;
+    pcChannel->mRotationKeys = new aiQuatKey[101];
+    for (unsigned int i = 0; i < 101; ++i) {
+        pcChannel->mRotationKeys[i] = aiQuatKey(i, aiQuaternion(aiVector3D(0, 1, 0), (ai_real)(i * 0.01)));
+    }
+
+    // a sine wave, which can only be approximated
+    pcChannel->mNumScalingKeys = 101;
+    pcChannel->mScalingKeys = new aiVectorKey[101];
+    for (unsigned int i = 0; i < 101; ++i) {
+        pcChannel->mScalingKeys[i] = aiVectorKey(i, aiVector3D(1 + std::sin(i * 0.1f), 1, 1));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcessTest::TearDown()
+{
+    delete piProcess;
+    delete pcChannel;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(OptimizeAnimationsProcessTest, testReduceKeys)
+{
+    piProcess->SetTolerances(1e-3f, 0.01f, 1e-2f);
+    const OptimizeAnimationsProcess::Stats stats = piProcess->ProcessChannel(pcChannel);
+
+    EXPECT_EQ(303U, stats.mKeysIn);
+    EXPECT_EQ(stats.mKeysOut, pcChannel->mNumPositionKeys + pcChannel->mNumRotationKeys + pcChannel->mNumScalingKeys);
+
+    ASSERT_EQ(2U, pcChannel->mNumPositionKeys);
+    EXPECT_EQ(aiVector3D(100, 200, 0), pcChannel->mPositionKeys[1].mValue);
+    EXPECT_EQ(2U, pcChannel->mNumRotationKeys);
+    EXPECT_DOUBLE_EQ(100.0, pcChannel->mRotationKeys[1].mTime);
+
+    EXPECT_LT(pcChannel->mNumScalingKeys, 101U);
+    EXPECT_GT(pcChannel->mNumScalingKeys, 2U);
+    EXPECT_DOUBLE_EQ(0.0, pcChannel->mScalingKeys[0].mTime);
+    EXPECT_DOUBLE_EQ(100.0, pcChannel->mScalingKeys[pcChannel->mNumScalingKeys - 1].mTime);
+
+    EXPECT_LE(stats.mPositionError, 1e-3f);
+    EXPECT_LE(stats.mRotationError, 0.01f);
+    EXPECT_LE(stats.mScalingError, 1e-2f);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(OptimizeAnimationsProcessTest, testZeroToleranceKeepsCurves)
+{
+    piProcess->SetTolerances(0.f, 0.f, 0.f);
+    piProcess->ProcessChannel(pcChannel);
+    EXPECT_EQ(101U, pcChannel->mNumScalingKeys);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(OptimizeAnimationsProcessTest, testMaxKeySpan)
+{
+    piProcess->SetTolerances(1e-3f, 0.01f, 1e-2f);
+    piProcess->SetMaxKeySpan(30);
+    const OptimizeAnimationsProcess::Stats stats = piProcess->ProcessChannel(pcChannel);
+
+    // the linear tracks keep a key every 30 frames
+    ASSERT_EQ(5U, pcChannel->mNumPositionKeys);
+    for (unsigned int i = 0; i < 4; ++i) {
+        EXPECT_DOUBLE_EQ(30.0 * i, pcChannel->mPositionKeys[i].mTime);
+    }
+    EXPECT_DOUBLE_EQ(100.0, pcChannel->mPositionKeys[4].mTime);
+    EXPECT_EQ(5U, pcChannel->mNumRotationKeys);
+    for (unsigned int i = 1; i < pcChannel->mNumScalingKeys; ++i) {
+        EXPECT_LE(pcChannel->mScalingKeys[i].mTime - pcChannel->mScalingKeys[i - 1].mTime, 30.0);
+    }
+    EXPECT_LE(stats.mPositionError, 1e-3f);
+    EXPECT_LE(stats.mScalingError, 1e-2f);
+}
@@ -0,0 +1,121 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include <ParallelFor.h>
+#include <Exceptional.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace Assimp;
+
+class ParallelForTest : public ::testing::Test {
+    // empty
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ParallelForTest, testChunksCoverRange)
+{
+    // each index is owned by exactly one chunk, so it can be written without locking
+    const unsigned int count = 1000;
+    std::vector<unsigned int> hits(count, 0);
+    std::vector<std::thread::id> threads(count);
+    std::atomic<unsigned int> chunks(0);
+    ParallelForThreads(0, count, 10, 4, [&](unsigned int first, unsigned int last) {
+        ++chunks;
+        for (unsigned int i = first; i < last; ++i) {
+            ++hits[i];
+            threads[i] = std::this_thread::get_id();
+        }
+    });
+
+    for (unsigned int i = 0; i < count; ++i) {
+        EXPECT_EQ(1u, hits[i]);
+    }
+
+    const std::set<std::thread::id> distinct(threads.begin(), threads.end());
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    EXPECT_EQ(4u, chunks);
+    EXPECT_EQ(4u, distinct.size());
+    EXPECT_EQ(1u, distinct.count(std::this_thread::get_id()));
+#else
+    EXPECT_EQ(1u, chunks);
+    EXPECT_EQ(1u, distinct.size());
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ParallelForTest, testSmallRangesAreNotSplit)
+{
+    std::atomic<unsigned int> chunks(0);
+    ParallelForThreads(5, 24, 10, 4, [&](unsigned int first, unsigned int last) {
+        EXPECT_EQ(5u, first);
+        EXPECT_EQ(24u, last);
+        ++chunks;
+    });
+    EXPECT_EQ(1u, chunks);
+
+    ParallelForThreads(7, 7, 1, 4, [&](unsigned int, unsigned int) {
+        ++chunks;
+    });
+    EXPECT_EQ(1u, chunks);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ParallelForTest, testExceptionsAreRethrown)
+{
+    // thrown from the last chunk, which runs on a worker thread if the range is split
+    std::atomic<unsigned int> done(0);
+    EXPECT_THROW(ParallelForThreads(0, 1000, 10, 4, [&](unsigned int first, unsigned int last) {
+        if (last == 1000) {
+            throw DeadlyImportError("failed");
+        }
+        done += last - first;
+    }), DeadlyImportError);
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    // all other chunks still ran to completion
+    EXPECT_EQ(750u, done);
+#endif
+}
@@ -0,0 +1,318 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include <QuantizeVerticesProcess.h>
+#include <VertexQuantization.h>
+#include <assbin_chunks.h>
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace ::std;
+using namespace ::Assimp;
+
+class QuantizeVerticesTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    QuantizeVerticesProcess* piProcess;
+    aiMesh* pcMesh;
+};
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesTest::SetUp()
+{
+    piProcess = new QuantizeVerticesProcess();
+
+    // random positions, normals and two texture coordinate channels
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    pcMesh = new aiMesh();
+    pcMesh->mPrimitiveTypes = aiPrimitiveType_POINT;
+    pcMesh->mNumVertices = pcMesh->mNumFaces = 1000;
+    pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+    pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+    pcMesh->mNormals = new aiVector3D[pcMesh->mNumVertices];
+    for (unsigned int i = 0; i < 2; ++i) {
+        pcMesh->mTextureCoords[i] = new aiVector3D[pcMesh->mNumVertices];
+        pcMesh->mNumUVComponents[i] = 2;
+    }
+    for (unsigned int i = 0; i < pcMesh->mNumVertices; ++i) {
+        aiFace& face = pcMesh->mFaces[i];
+        face.mIndices = new unsigned int[face.mNumIndices = 1];
+        face.mIndices[0] = i;
+
+        pcMesh->mVertices[i] = aiVector3D(dist(rng) * 10, dist(rng) * 5, dist(rng));
+        do {
+            pcMesh->mNormals[i] = aiVector3D(dist(rng), dist(rng), dist(rng));
+        } while (pcMesh->mNormals[i].SquareLength() < 0.01f);
+        pcMesh->mNormals[i].Normalize();
+
+        pcMesh->mTextureCoords[0][i] = aiVector3D(dist(rng) * 0.5f + 0.5f, dist(rng) * 0.5f + 0.5f, 0);
+        pcMesh->mTextureCoords[1][i] = aiVector3D(dist(rng) * 100, dist(rng) * 100, 0);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesTest::TearDown()
+{
+    delete piProcess;
+    delete pcMesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testHalfConversion)
+{
+    // every half except NaNs survives the round trip
+    for (unsigned int h = 0; h < 0x10000; ++h) {
+        if ((h & 0x7c00) == 0x7c00 && (h & 0x3ff)) {
+            continue;
+        }
+        EXPECT_EQ(h, FloatToHalf(HalfToFloat(static_cast<uint16_t>(h))));
+    }
+
+    EXPECT_EQ(0x3c00, FloatToHalf(1.f));
+    EXPECT_EQ(0xc000, FloatToHalf(-2.f));
+    EXPECT_EQ(0x7bff, FloatToHalf(65504.f));
+    EXPECT_EQ(0x7c00, FloatToHalf(65520.f));
+    EXPECT_EQ(0x0001, FloatToHalf(std::ldexp(1.f, -24)));
+    EXPECT_EQ(0x0000, FloatToHalf(std::ldexp(1.f, -26)));
+    EXPECT_TRUE(std::isnan(HalfToFloat(FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+
+    // ties round to even
+    EXPECT_EQ(0x3c00, FloatToHalf(1.f + std::ldexp(1.f, -11)));
+    EXPECT_EQ(0x3c02, FloatToHalf(1.f + 3 * std::ldexp(1.f, -11)));
+    EXPECT_EQ(0x3c01, FloatToHalf(1.f + std::ldexp(1.f, -11) + std::ldexp(1.f, -20)));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testStreams)
+{
+    std::vector<aiVector3D> positions(pcMesh->mVertices, pcMesh->mVertices + pcMesh->mNumVertices);
+    std::vector<aiVector3D> normals(pcMesh->mNormals, pcMesh->mNormals + pcMesh->mNumVertices);
+    std::vector<aiVector3D> uvs(pcMesh->mTextureCoords[1], pcMesh->mTextureCoords[1] + pcMesh->mNumVertices);
+
+    QuantizeVerticesProcess::Error error;
+    piProcess->SetParameters(16, 16, 0.001f);
+    piProcess->ProcessMesh(pcMesh, error);
+    ASSERT_TRUE(pcMesh->HasQuantizedVertices());
+    const aiQuantizedVertices* qv = pcMesh->mQuantizedVertices;
+    ASSERT_TRUE(NULL != qv->mPositions);
+    ASSERT_TRUE(NULL != qv->mNormals);
+    ASSERT_TRUE(NULL != qv->mTextureCoords[0]);
+    EXPECT_EQ(16u, qv->mPositionBits);
+    EXPECT_EQ(16u, qv->mNormalBits);
+
+    // the coarse channel is kept as floats only
+    EXPECT_TRUE(NULL == qv->mTextureCoords[1]);
+    for (unsigned int i = 0; i < pcMesh->mNumVertices; ++i) {
+        EXPECT_EQ(uvs[i], pcMesh->mTextureCoords[1][i]);
+    }
+
+    // the float streams hold the dequantized values, within the errors reported
+    const ai_real maxPositionError = qv->mPositionScale.Length() * 0.5f * 1.01f;
+    EXPECT_GT(error.mPosition, 0.f);
+    EXPECT_LE(error.mPosition, maxPositionError);
+    EXPECT_LT(error.mNormal, 0.01 * AI_MATH_PI / 180);
+    EXPECT_LE(error.mTexCoord, 0.001f);
+    for (unsigned int i = 0; i < pcMesh->mNumVertices; ++i) {
+        const aiVector3D p = DequantizePosition(*qv, qv->mPositions + 3 * i);
+        EXPECT_EQ(p, pcMesh->mVertices[i]);
+        EXPECT_LE((p - positions[i]).Length(), error.mPosition);
+
+        const aiVector3D n = DecodeOctahedral(qv->mNormals + 2 * i, qv->mNormalBits);
+        EXPECT_EQ(n, pcMesh->mNormals[i]);
+        EXPECT_LE((n - normals[i]).Length(), 2 * std::sin(error.mNormal / 2) * 1.001f);
+
+        EXPECT_FLOAT_EQ(HalfToFloat(qv->mTextureCoords[0][2 * i]), pcMesh->mTextureCoords[0][i].x);
+        EXPECT_FLOAT_EQ(HalfToFloat(qv->mTextureCoords[0][2 * i + 1]), pcMesh->mTextureCoords[0][i].y);
+    }
+
+    // fewer bits, larger errors
+    QuantizeVerticesProcess::Error coarse;
+    piProcess->SetParameters(8, 10, 1000.f);
+    std::copy(positions.begin(), positions.end(), pcMesh->mVertices);
+    std::copy(normals.begin(), normals.end(), pcMesh->mNormals);
+    piProcess->ProcessMesh(pcMesh, coarse);
+    EXPECT_TRUE(NULL != pcMesh->mQuantizedVertices->mTextureCoords[1]);
+    EXPECT_GT(coarse.mPosition, error.mPosition);
+    EXPECT_GT(coarse.mNormal, error.mNormal);
+    EXPECT_LT(coarse.mNormal, 0.2 * AI_MATH_PI / 180);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testNormalsWithoutDirection)
+{
+    // normal generation stores qNaNs for point and line vertices
+    const ai_real qnan = std::numeric_limits<ai_real>::quiet_NaN();
+    const ai_real inf = std::numeric_limits<ai_real>::infinity();
+    pcMesh->mNormals[0] = aiVector3D(qnan);
+    pcMesh->mNormals[1] = aiVector3D(inf, 0, 0);
+    pcMesh->mNormals[2] = aiVector3D();
+    const aiVector3D normal = pcMesh->mNormals[3];
+
+    QuantizeVerticesProcess::Error error;
+    piProcess->SetParameters(12, 12, 0.001f);
+    piProcess->ProcessMesh(pcMesh, error);
+    const aiQuantizedVertices* qv = pcMesh->mQuantizedVertices;
+    ASSERT_TRUE(NULL != qv);
+    ASSERT_TRUE(NULL != qv->mNormals);
+
+    // the float normals are left alone, the stream holds the reserved codes
+    EXPECT_TRUE(std::isnan(pcMesh->mNormals[0].x));
+    EXPECT_EQ(aiVector3D(inf, 0, 0), pcMesh->mNormals[1]);
+    EXPECT_EQ(aiVector3D(), pcMesh->mNormals[2]);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(IsReservedOctahedral(qv->mNormals + 2 * i, qv->mNormalBits));
+    }
+    EXPECT_TRUE(std::isnan(DecodeOctahedral(qv->mNormals, qv->mNormalBits).x));
+    EXPECT_TRUE(std::isnan(DecodeOctahedral(qv->mNormals + 2, qv->mNormalBits).y));
+    EXPECT_EQ(aiVector3D(), DecodeOctahedral(qv->mNormals + 4, qv->mNormalBits));
+
+    // all other normals are quantized as usual
+    EXPECT_TRUE(std::isfinite(error.mNormal));
+    EXPECT_LT(error.mNormal, 0.1 * AI_MATH_PI / 180);
+    for (unsigned int i = 3; i < pcMesh->mNumVertices; ++i) {
+        ASSERT_FALSE(IsReservedOctahedral(qv->mNormals + 2 * i, qv->mNormalBits));
+        EXPECT_EQ(DecodeOctahedral(qv->mNormals + 2 * i, qv->mNormalBits), pcMesh->mNormals[i]);
+    }
+    EXPECT_LE((pcMesh->mNormals[3] - normal).Length(), 2 * std::sin(error.mNormal / 2) * 1.001f);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testAssbinRoundTrip)
+{
+    QuantizeVerticesProcess::Error error;
+    piProcess->ProcessMesh(pcMesh, error);
+
+    aiScene* scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    scene->mMeshes[0] = pcMesh;
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial*[1];
+    scene->mMaterials[0] = new aiMaterial();
+    scene->mRootNode = new aiNode();
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[1];
+    scene->mRootNode->mMeshes[0] = 0;
+
+    Exporter exporter;
+    const aiExportDataBlob* blob = exporter.ExportToBlob(scene, "assbin");
+    ASSERT_TRUE(NULL != blob);
+
+    Importer importer;
+    const aiScene* loaded = importer.ReadFileFromMemory(blob->data, blob->size, aiProcess_ValidateDataStructure, "assbin");
+    ASSERT_TRUE(NULL != loaded);
+    ASSERT_EQ(1u, loaded->mNumMeshes);
+    const aiMesh* mesh = loaded->mMeshes[0];
+    ASSERT_TRUE(mesh->HasQuantizedVertices());
+    EXPECT_TRUE(NULL == mesh->mQuantizedVertices->mTextureCoords[1]);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(pcMesh->mVertices[i], mesh->mVertices[i]);
+        EXPECT_EQ(pcMesh->mNormals[i], mesh->mNormals[i]);
+        EXPECT_EQ(pcMesh->mTextureCoords[0][i], mesh->mTextureCoords[0][i]);
+        EXPECT_EQ(pcMesh->mTextureCoords[1][i], mesh->mTextureCoords[1][i]);
+    }
+
+    // the mesh is owned by the fixture
+    scene->mMeshes[0] = NULL;
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testAssbinRejectsNewerVersion)
+{
+    aiScene* scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    scene->mMeshes[0] = pcMesh;
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial*[1];
+    scene->mMaterials[0] = new aiMaterial();
+    scene->mRootNode = new aiNode();
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[1];
+    scene->mRootNode->mMeshes[0] = 0;
+
+    Exporter exporter;
+    const aiExportDataBlob* blob = exporter.ExportToBlob(scene, "assbin");
+    ASSERT_TRUE(NULL != blob);
+
+    // the major version follows the 44 byte signature
+    std::vector<char> data(static_cast<const char*>(blob->data), static_cast<const char*>(blob->data) + blob->size);
+    const unsigned int major = ASSBIN_VERSION_MAJOR + 1;
+    ::memcpy(&data[44], &major, sizeof(major));
+
+    Importer importer;
+    EXPECT_TRUE(NULL == importer.ReadFileFromMemory(&data[0], data.size(), 0, "assbin"));
+
+    // the mesh is owned by the fixture
+    scene->mMeshes[0] = NULL;
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(QuantizeVerticesTest, testDequantizeSkipsInvalidComponentCount)
+{
+    QuantizeVerticesProcess::Error error;
+    piProcess->ProcessMesh(pcMesh, error);
+    ASSERT_TRUE(NULL != pcMesh->mQuantizedVertices->mTextureCoords[0]);
+
+    const aiVector3D uv = pcMesh->mTextureCoords[0][0];
+    pcMesh->mTextureCoords[0][0] = aiVector3D(5, 5, 5);
+    pcMesh->mNumUVComponents[0] = 4;
+    DequantizeVertices(pcMesh);
+    EXPECT_EQ(aiVector3D(5, 5, 5), pcMesh->mTextureCoords[0][0]);
+
+    pcMesh->mNumUVComponents[0] = 2;
+    DequantizeVertices(pcMesh);
+    EXPECT_EQ(uv, pcMesh->mTextureCoords[0][0]);
+}
@@ -0,0 +1,138 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <RadixSort.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using namespace Assimp;
+
+class RadixSortTest : public ::testing::Test {
+    // empty
+};
+
+namespace {
+
+struct Item {
+    float mKey;
+    unsigned int mId;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Sorts items with many duplicate keys, both signs of zero and some infinities
+void CheckMatchesStableSort(unsigned int num) {
+    std::mt19937 rng(num);
+    std::uniform_int_distribution<int> dist(-500, 500);
+
+    std::vector<Item> items(num);
+    for (unsigned int i = 0; i < num; ++i) {
+        items[i].mId = i;
+        switch (i % 7) {
+        case 0:
+            items[i].mKey = 0.0f;
+            break;
+        case 1:
+            items[i].mKey = -0.0f;
+            break;
+        case 2:
+            items[i].mKey = (i & 8) ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity();
+            break;
+        default:
+            items[i].mKey = dist(rng) * 0.125f;
+        }
+    }
+
+    std::vector<Item> expected = items;
+    std::stable_sort(expected.begin(), expected.end(), [](const Item& a, const Item& b) {
+        return a.mKey < b.mKey;
+    });
+
+    StableRadixSort(items, [](const Item& item) { return item.mKey; });
+
+    ASSERT_EQ(expected.size(), items.size());
+    for (unsigned int i = 0; i < num; ++i) {
+        EXPECT_EQ(expected[i].mId, items[i].mId);
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RadixSortTest, testKeysAreOrdered) {
+    EXPECT_LT(GetRadixSortKey(-std::numeric_limits<float>::infinity()), GetRadixSortKey(-1.0f));
+    EXPECT_LT(GetRadixSortKey(-1.0f), GetRadixSortKey(-1e-30f));
+    EXPECT_LT(GetRadixSortKey(-1e-30f), GetRadixSortKey(0.0f));
+    EXPECT_EQ(GetRadixSortKey(-0.0f), GetRadixSortKey(0.0f));
+    EXPECT_LT(GetRadixSortKey(0.0f), GetRadixSortKey(1e-45f));
+    EXPECT_LT(GetRadixSortKey(1.0f), GetRadixSortKey(std::numeric_limits<float>::infinity()));
+    EXPECT_LT(GetRadixSortKey(-2.0), GetRadixSortKey(2.0));
+    EXPECT_EQ(GetRadixSortKey(-0.0), GetRadixSortKey(0.0));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RadixSortTest, testSmallArrayMatchesStableSort) {
+    CheckMatchesStableSort(0);
+    CheckMatchesStableSort(1);
+    CheckMatchesStableSort(100);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RadixSortTest, testLargeArrayMatchesStableSort) {
+    CheckMatchesStableSort(5000);
+    CheckMatchesStableSort(300000);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RadixSortTest, testIntegerKeys) {
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> keys(100000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = (i & 1) ? rng() : rng() & 0xffff;
+    }
+    std::vector<uint64_t> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    StableRadixSort(keys, [](uint64_t key) { return key; });
+    EXPECT_TRUE(expected == keys);
+}
@@ -0,0 +1,303 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+#include <GenBVHProcess.h>
+#include <QuantizeVerticesProcess.h>
+#include <SimplifyProcess.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <cmath>
+#include <stdio.h>
+#include <vector>
+
+using namespace ::std;
+using namespace ::Assimp;
+
+class SimplifyTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    SimplifyProcess* piProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+void SimplifyTest::SetUp()
+{
+    piProcess = new SimplifyProcess();
+}
+
+// ------------------------------------------------------------------------------------------------
+void SimplifyTest::TearDown()
+{
+    delete piProcess;
+}
+
+// ------------------------------------------------------------------------------------------------
+static aiVector3D FaceNormal(const aiMesh* mesh, unsigned int f)
+{
+    const unsigned int* idx = mesh->mFaces[f].mIndices;
+    const aiVector3D* v = mesh->mVertices;
+    return (v[idx[1]] - v[idx[0]]) ^ (v[idx[2]] - v[idx[0]]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SimplifyTest, testPlanarGrid)
+{
+    aiMesh* mesh = TestModelFacttory::createGridMesh(20, true);
+    EXPECT_TRUE(SimplifyProcess::SimplifyMesh(mesh, 200, 0.01f));
+    EXPECT_LE(mesh->mNumFaces, 200u);
+    EXPECT_LT(mesh->mNumVertices, 441u);
+
+    // the area is preserved and no triangle flipped
+    ai_real area = 0;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        const aiVector3D n = FaceNormal(mesh, f);
+        EXPECT_GT(n.z, 0);
+        area += n.z / 2;
+    }
+    EXPECT_NEAR(400, area, 1e-3);
+
+    for (unsigned int i = 0; i < mesh->mNumFaces * 3; ++i) {
+        EXPECT_LT(mesh->mFaces[i / 3].mIndices[i % 3], mesh->mNumVertices);
+    }
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SimplifyTest, testDerivedDataIsDropped)
+{
+    aiMesh* mesh = TestModelFacttory::createGridMesh(20, true);
+    ASSERT_TRUE(GenBVHProcess().ProcessMesh(mesh));
+    QuantizeVerticesProcess::Error error;
+    QuantizeVerticesProcess().ProcessMesh(mesh, error);
+    ASSERT_TRUE(mesh->mBVHNodes != NULL);
+    ASSERT_TRUE(mesh->HasQuantizedVertices());
+
+    // the hierarchy refers to the old faces, the quantized streams to the old vertices
+    EXPECT_TRUE(SimplifyProcess::SimplifyMesh(mesh, 200, 0.01f));
+    EXPECT_EQ(0u, mesh->mNumBVHNodes);
+    EXPECT_TRUE(mesh->mBVHNodes == NULL);
+    EXPECT_TRUE(mesh->mBVHFaces == NULL);
+    EXPECT_TRUE(mesh->mQuantizedVertices == NULL);
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SimplifyTest, testSeamsAreLocked)
+{
+    // without shared vertices every point is a seam
+    aiMesh* mesh = TestModelFacttory::createGridMesh(8, false);
+    EXPECT_TRUE(SimplifyProcess::SimplifyMesh(mesh, 0, 0.01f));
+    EXPECT_EQ(128u, mesh->mNumFaces);
+    EXPECT_EQ(384u, mesh->mNumVertices);
+    delete mesh;
+
+    // a UV seam along x = 4 keeps its vertices
+    mesh = TestModelFacttory::createGridMesh(8, true);
+    mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumUVComponents[0] = 2;
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        mesh->mTextureCoords[0][i] = aiVector3D(mesh->mVertices[i].x, mesh->mVertices[i].y, 0);
+    }
+    aiVector3D* vertices = new aiVector3D[mesh->mNumVertices + 9];
+    aiVector3D* uvs = new aiVector3D[mesh->mNumVertices + 9];
+    std::copy(mesh->mVertices, mesh->mVertices + mesh->mNumVertices, vertices);
+    std::copy(mesh->mTextureCoords[0], mesh->mTextureCoords[0] + mesh->mNumVertices, uvs);
+    for (unsigned int y = 0; y <= 8; ++y) {
+        vertices[mesh->mNumVertices + y] = vertices[y * 9 + 4];
+        uvs[mesh->mNumVertices + y] = aiVector3D(10, ai_real(y), 0);
+    }
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiFace& face = mesh->mFaces[f];
+        const bool right = mesh->mVertices[face.mIndices[0]].x + mesh->mVertices[face.mIndices[1]].x +
+            mesh->mVertices[face.mIndices[2]].x > 12;
+        for (unsigned int i = 0; right && i < 3; ++i) {
+            if (face.mIndices[i] % 9 == 4) {
+                face.mIndices[i] = mesh->mNumVertices + face.mIndices[i] / 9;
+            }
+        }
+    }
+    delete[] mesh->mVertices;
+    delete[] mesh->mTextureCoords[0];
+    mesh->mVertices = vertices;
+    mesh->mTextureCoords[0] = uvs;
+    mesh->mNumVertices += 9;
+
+    EXPECT_TRUE(SimplifyProcess::SimplifyMesh(mesh, 0, 1.f));
+    EXPECT_LT(mesh->mNumFaces, 128u);
+    unsigned int numSeam = 0;
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        if (mesh->mVertices[i].x == 4) {
+            ++numSeam;
+        }
+    }
+    EXPECT_EQ(18u, numSeam);
+
+    // triangles on either side keep using the vertices of their side
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        EXPECT_GT(FaceNormal(mesh, f).z, 0);
+        const unsigned int* idx = mesh->mFaces[f].mIndices;
+        const bool right = mesh->mVertices[idx[0]].x + mesh->mVertices[idx[1]].x + mesh->mVertices[idx[2]].x > 12;
+        for (unsigned int i = 0; i < 3; ++i) {
+            if (mesh->mVertices[idx[i]].x == 4) {
+                EXPECT_EQ(right ? 10 : 4, mesh->mTextureCoords[0][idx[i]].x);
+            }
+        }
+    }
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SimplifyTest, testErrorLimit)
+{
+    // two planes meeting at x = 8, collapses across the ridge are too expensive
+    const TestModelFacttory::HeightFunc ridge = [](ai_real x, ai_real) { return std::fabs(x - 8); };
+    aiMesh* mesh = TestModelFacttory::createGridMesh(16, true, 1, ridge);
+    float error = 1.f;
+    EXPECT_TRUE(SimplifyProcess::SimplifyMesh(mesh, 0, 1e-4f, &error));
+    EXPECT_LE(error, 1e-4f);
+    EXPECT_LT(mesh->mNumFaces, 512u);
+    EXPECT_GT(mesh->mNumFaces, 0u);
+
+    // the centroid of every triangle lies on the surface
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiVector3D c;
+        for (unsigned int i = 0; i < 3; ++i) {
+            c += mesh->mVertices[mesh->mFaces[f].mIndices[i]] / ai_real(3);
+        }
+        EXPECT_NEAR(std::fabs(c.x - 8), c.z, 1e-4);
+    }
+    delete mesh;
+
+    // without limit, the ridge goes away
+    mesh = TestModelFacttory::createGridMesh(16, true, 1, ridge);
+    EXPECT_TRUE(SimplifyProcess::SimplifyMesh(mesh, 2, 1.f, &error));
+    EXPECT_GT(error, 1e-4f);
+    EXPECT_LT(mesh->mNumFaces, 16u);
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SimplifyTest, testBoneWeights)
+{
+    // bone 0 drives x <= 4, bone 1 the rest
+    aiMesh* mesh = TestModelFacttory::createGridMesh(10, true);
+    mesh->mNumBones = 2;
+    mesh->mBones = new aiBone*[2];
+    for (unsigned int b = 0; b < 2; ++b) {
+        aiBone* bone = mesh->mBones[b] = new aiBone();
+        bone->mWeights = new aiVertexWeight[mesh->mNumVertices];
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            if ((mesh->mVertices[i].x > 4) == (b == 1)) {
+                bone->mWeights[bone->mNumWeights++] = aiVertexWeight(i, 1.f);
+            }
+        }
+    }
+
+    EXPECT_TRUE(SimplifyProcess::SimplifyMesh(mesh, 0, 1.f));
+    EXPECT_LT(mesh->mNumFaces, 200u);
+    ASSERT_EQ(2u, mesh->mNumBones);
+
+    std::vector<int> bone(mesh->mNumVertices, -1);
+    for (unsigned int b = 0; b < 2; ++b) {
+        const aiBone* pBone = mesh->mBones[b];
+        for (unsigned int i = 0; i < pBone->mNumWeights; ++i) {
+            ASSERT_LT(pBone->mWeights[i].mVertexId, mesh->mNumVertices);
+            EXPECT_EQ(-1, bone[pBone->mWeights[i].mVertexId]);
+            bone[pBone->mWeights[i].mVertexId] = b;
+        }
+    }
+
+    // every vertex kept the weights of its side, so vertices of different
+    // bones were never joined
+    unsigned int numMixed = 0;
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(mesh->mVertices[i].x > 4 ? 1 : 0, bone[i]);
+    }
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        const unsigned int* idx = mesh->mFaces[f].mIndices;
+        if (bone[idx[0]] != bone[idx[1]] || bone[idx[1]] != bone[idx[2]]) {
+            ++numMixed;
+        }
+    }
+    EXPECT_GT(numMixed, 0u);
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SimplifyTest, testLodChain)
+{
+    aiScene* scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    scene->mMeshes[0] = TestModelFacttory::createGridMesh(16, true);
+    scene->mRootNode = new aiNode();
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[1];
+    scene->mRootNode->mMeshes[0] = 0;
+
+    piProcess->SetParameters(0.5f, 1.f, 3);
+    piProcess->Execute(scene);
+
+    ASSERT_EQ(4u, scene->mNumMeshes);
+    EXPECT_EQ(512u, scene->mMeshes[0]->mNumFaces);
+    for (unsigned int k = 1; k < 4; ++k) {
+        EXPECT_LE(scene->mMeshes[k]->mNumFaces, 512u >> k);
+        EXPECT_LT(scene->mMeshes[k]->mNumFaces, scene->mMeshes[k - 1]->mNumFaces);
+    }
+
+    const aiMetadata* meta = scene->mRootNode->mMetaData;
+    ASSERT_TRUE(NULL != meta);
+    ASSERT_EQ(3u, meta->mNumProperties);
+    for (unsigned int k = 0; k < 3; ++k) {
+        char key[32];
+        ::sprintf(key, "$LOD.0.%u", k + 1);
+        EXPECT_STREQ(key, meta->mKeys[k].C_Str());
+        EXPECT_EQ(AI_INT32, meta->mValues[k].mType);
+        EXPECT_EQ(int32_t(k + 1), *static_cast<const int32_t*>(meta->mValues[k].mData));
+    }
+    delete scene;
+}
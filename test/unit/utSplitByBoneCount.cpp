@@ -0,0 +1,143 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include <assimp/scene.h>
+#include <SplitByBoneCountProcess.h>
+#include <ProcessHelper.h>
+
+using namespace std;
+using namespace Assimp;
+
+class SplitByBoneCountTest : public ::testing::Test {
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    SplitByBoneCountProcess* piProcess;
+    aiScene* pcScene;
+};
+
+// ------------------------------------------------------------------------------------------------
+void SplitByBoneCountTest::SetUp()
+{
+    piProcess = new SplitByBoneCountProcess();
+    piProcess->mMaxBoneCount = 2;
+
+    // four triangles with a bone each, which fit into two submeshes
+    pcScene = new aiScene();
+    pcScene->mNumMeshes = 1;
+    pcScene->mMeshes = new aiMesh*[1];
+    pcScene->mMeshes[0] = TestModelFacttory::createSkinnedTriangles(4);
+    pcScene->mRootNode = new aiNode();
+    pcScene->mRootNode->mNumMeshes = 1;
+    pcScene->mRootNode->mMeshes = new unsigned int[1];
+    pcScene->mRootNode->mMeshes[0] = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SplitByBoneCountTest::TearDown()
+{
+    delete pcScene;
+    delete piProcess;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, testSplit)
+{
+    static_cast<BaseProcess*>(piProcess)->Execute(pcScene);
+
+    ASSERT_EQ(2U, pcScene->mNumMeshes);
+    EXPECT_EQ(2U, pcScene->mRootNode->mNumMeshes);
+    for (unsigned int m = 0; m < pcScene->mNumMeshes; ++m) {
+        const aiMesh* mesh = pcScene->mMeshes[m];
+        EXPECT_EQ(2U, mesh->mNumBones);
+        EXPECT_EQ(2U, mesh->mNumFaces);
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            ASSERT_EQ(3U, mesh->mBones[b]->mNumWeights);
+            EXPECT_EQ(1.f, mesh->mBones[b]->mWeights[0].mWeight);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, testSharedTable)
+{
+    SharedPostProcessInfo shared;
+    BoneWeightTableCache* cache = new BoneWeightTableCache();
+    shared.AddProperty(AI_SPP_BONE_WEIGHTS, cache);
+    piProcess->SetSharedData(&shared);
+
+    // the step must take the weights from the shared table instead of the bones
+    aiMesh* source = pcScene->mMeshes[0];
+    BoneWeightTable* table = new BoneWeightTable();
+    table->Build(source);
+    for (size_t i = 0; i < table->mEntries.size(); ++i) {
+        table->mEntries[i].second = 0.5f;
+    }
+    cache->Set(source, table);
+
+    static_cast<BaseProcess*>(piProcess)->Execute(pcScene);
+    ASSERT_EQ(2U, pcScene->mNumMeshes);
+
+    // the table of the deleted mesh is gone, the submeshes come with theirs
+    EXPECT_FALSE(cache->Has(source));
+    for (unsigned int m = 0; m < pcScene->mNumMeshes; ++m) {
+        const aiMesh* mesh = pcScene->mMeshes[m];
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            for (unsigned int w = 0; w < mesh->mBones[b]->mNumWeights; ++w) {
+                EXPECT_EQ(0.5f, mesh->mBones[b]->mWeights[w].mWeight);
+            }
+        }
+
+        ASSERT_TRUE(cache->Has(mesh));
+        BoneWeightTable expected;
+        expected.Build(mesh);
+        const BoneWeightTable& stored = cache->Get(mesh);
+        EXPECT_TRUE(expected.mOffsets == stored.mOffsets);
+        EXPECT_TRUE(expected.mEntries == stored.mEntries);
+    }
+
+    piProcess->SetSharedData(NULL);
+}
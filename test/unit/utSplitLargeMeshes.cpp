@@ -167,3 +167,105 @@ TEST_F(SplitLargeMeshesTest, testTriangleSplit)
     }
     EXPECT_EQ(0, iOldFaceNum);
 }
+
+// ------------------------------------------------------------------------------------------------
+static aiMesh* CreateSkinnedStrip(unsigned int numFaces)
+{
+    // a strip of triangles sharing vertices, every vertex is weighted to
+    // bone (v % 3) with weight v
+    aiMesh* mesh = new aiMesh();
+    mesh->mNumVertices = numFaces + 2;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        mesh->mVertices[v] = aiVector3D((ai_real)v, 0, 0);
+    }
+
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        aiFace& face = mesh->mFaces[i];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        face.mIndices[0] = i;
+        face.mIndices[1] = i + 1;
+        face.mIndices[2] = i + 2;
+    }
+
+    mesh->mNumBones = 3;
+    mesh->mBones = new aiBone*[3];
+    for (unsigned int b = 0; b < 3; ++b) {
+        aiBone* bone = mesh->mBones[b] = new aiBone();
+        bone->mName.Set(std::string(1, (char)('a' + b)));
+        bone->mNumWeights = 0;
+        bone->mWeights = new aiVertexWeight[mesh->mNumVertices / 3 + 1];
+    }
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        aiBone* bone = mesh->mBones[v % 3];
+        bone->mWeights[bone->mNumWeights++] = aiVertexWeight(v, (float)v);
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void CheckBoneWeights(const aiMesh* mesh)
+{
+    // each output vertex must carry exactly the weight of its source vertex
+    std::vector<unsigned int> count(mesh->mNumVertices, 0);
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        const aiBone* bone = mesh->mBones[b];
+        ASSERT_GT(bone->mNumWeights, 0U);
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight& weight = bone->mWeights[w];
+            ASSERT_LT(weight.mVertexId, mesh->mNumVertices);
+
+            const unsigned int source = (unsigned int)mesh->mVertices[weight.mVertexId].x;
+            EXPECT_EQ((float)source, weight.mWeight);
+            EXPECT_EQ(std::string(1, (char)('a' + source % 3)), std::string(bone->mName.C_Str()));
+            ++count[weight.mVertexId];
+        }
+    }
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        EXPECT_EQ(1U, count[v]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testVertexSplitBones)
+{
+    std::vector< std::pair<aiMesh*, unsigned int> > avOut;
+    piProcessVertex->SplitMesh(0, CreateSkinnedStrip(2500), avOut);
+
+    EXPECT_EQ(3U, avOut.size());
+    unsigned int numFaces = 0;
+    for (size_t i = 0; i < avOut.size(); ++i) {
+        aiMesh* mesh = avOut[i].first;
+        EXPECT_LE(mesh->mNumVertices, 1000U);
+        EXPECT_EQ(3U, mesh->mNumBones);
+        EXPECT_EQ(aiPrimitiveType_TRIANGLE, mesh->mPrimitiveTypes);
+        CheckBoneWeights(mesh);
+
+        numFaces += mesh->mNumFaces;
+        delete mesh;
+    }
+    EXPECT_EQ(2500U, numFaces);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testTriangleSplitBones)
+{
+    std::vector< std::pair<aiMesh*, unsigned int> > avOut;
+    piProcessTriangle->SplitMesh(0, CreateSkinnedStrip(2500), avOut);
+
+    EXPECT_EQ(3U, avOut.size());
+    unsigned int numFaces = 0;
+    for (size_t i = 0; i < avOut.size(); ++i) {
+        aiMesh* mesh = avOut[i].first;
+        EXPECT_EQ(mesh->mNumFaces * 3, mesh->mNumVertices);
+        EXPECT_EQ(3U, mesh->mNumBones);
+        CheckBoneWeights(mesh);
+
+        numFaces += mesh->mNumFaces;
+        delete mesh;
+    }
+    EXPECT_EQ(2500U, numFaces);
+}
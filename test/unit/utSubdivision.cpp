@@ -0,0 +1,180 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include <Subdivision.h>
+#include <assimp/mesh.h>
+#include <memory>
+#include <vector>
+
+using namespace ::std;
+using namespace ::Assimp;
+
+class SubdivisionTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    Subdivider* piSubdivider;
+};
+
+// ------------------------------------------------------------------------------------------------
+void SubdivisionTest::SetUp()
+{
+    piSubdivider = Subdivider::Create(Subdivider::CATMULL_CLARKE);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SubdivisionTest::TearDown()
+{
+    delete piSubdivider;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Faces [first,last) of the cube [-1,1]^3 as a verbose quad mesh
+static aiMesh* CreateCubeFaces(unsigned int first, unsigned int last)
+{
+    static const int faces[6][4][3] = {
+        { {-1,-1,-1}, {-1, 1,-1}, { 1, 1,-1}, { 1,-1,-1} },
+        { {-1,-1, 1}, { 1,-1, 1}, { 1, 1, 1}, {-1, 1, 1} },
+        { {-1,-1,-1}, { 1,-1,-1}, { 1,-1, 1}, {-1,-1, 1} },
+        { {-1, 1,-1}, {-1, 1, 1}, { 1, 1, 1}, { 1, 1,-1} },
+        { {-1,-1,-1}, {-1,-1, 1}, {-1, 1, 1}, {-1, 1,-1} },
+        { { 1,-1,-1}, { 1, 1,-1}, { 1, 1, 1}, { 1,-1, 1} },
+    };
+
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+    mesh->mNumFaces = last - first;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    mesh->mNumVertices = mesh->mNumFaces * 4;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiFace& face = mesh->mFaces[f];
+        face.mIndices = new unsigned int[face.mNumIndices = 4];
+        for (unsigned int i = 0; i < 4; ++i) {
+            const int* p = faces[first + f][i];
+            face.mIndices[i] = f * 4 + i;
+            mesh->mVertices[f * 4 + i] = aiVector3D(ai_real(p[0]), ai_real(p[1]), ai_real(p[2]));
+        }
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks a point against the result of subdividing the cube once
+static bool IsCubePoint(const aiVector3D& p)
+{
+    // face points have a single non-zero coordinate of magnitude 1, edge points
+    // two of magnitude 3/4, moved corners three of magnitude 5/9
+    unsigned int zero = 0, one = 0, edge = 0, corner = 0;
+    for (unsigned int i = 0; i < 3; ++i) {
+        const ai_real c = std::fabs(p[i]);
+        zero += c < 1e-5f;
+        one += std::fabs(c - 1) < 1e-5f;
+        edge += std::fabs(c - 0.75f) < 1e-5f;
+        corner += std::fabs(c - 5.f / 9.f) < 1e-5f;
+    }
+    return (zero == 2 && one == 1) || (zero == 1 && edge == 2) || corner == 3;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SubdivisionTest, testCube)
+{
+    aiMesh* mesh = CreateCubeFaces(0, 6);
+    aiMesh* out = NULL;
+    piSubdivider->Subdivide(mesh, out, 1, true);
+    ASSERT_TRUE(NULL != out);
+    std::unique_ptr<aiMesh> guard(out);
+
+    EXPECT_EQ(24u, out->mNumFaces);
+    EXPECT_EQ(96u, out->mNumVertices);
+    for (unsigned int i = 0; i < out->mNumFaces; ++i) {
+        ASSERT_EQ(4u, out->mFaces[i].mNumIndices);
+    }
+    for (unsigned int i = 0; i < out->mNumVertices; ++i) {
+        EXPECT_TRUE(IsCubePoint(out->mVertices[i]));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SubdivisionTest, testMultipleMeshes)
+{
+    // two halves of the cube are smoothed together, so the result is the same
+    aiMesh* whole = CreateCubeFaces(0, 6);
+    aiMesh* wholeOut = NULL;
+    piSubdivider->Subdivide(whole, wholeOut, 2, true);
+    std::unique_ptr<aiMesh> guard(wholeOut);
+
+    aiMesh* halves[2] = { CreateCubeFaces(0, 3), CreateCubeFaces(3, 6) };
+    aiMesh* halvesOut[2] = { NULL, NULL };
+    piSubdivider->Subdivide(halves, 2, halvesOut, 2, true);
+    ASSERT_TRUE(NULL != halvesOut[0] && NULL != halvesOut[1]);
+    std::unique_ptr<aiMesh> guard0(halvesOut[0]), guard1(halvesOut[1]);
+
+    ASSERT_EQ(wholeOut->mNumVertices, halvesOut[0]->mNumVertices + halvesOut[1]->mNumVertices);
+    for (unsigned int i = 0; i < wholeOut->mNumVertices; ++i) {
+        const aiMesh* half = i < halvesOut[0]->mNumVertices ? halvesOut[0] : halvesOut[1];
+        const unsigned int idx = i < halvesOut[0]->mNumVertices ? i : i - halvesOut[0]->mNumVertices;
+        EXPECT_EQ(wholeOut->mVertices[i], half->mVertices[idx]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SubdivisionTest, testOpenMesh)
+{
+    // corners of a single quad have less than three faces and stay in place
+    aiMesh* mesh = CreateCubeFaces(0, 1);
+    aiMesh* out = NULL;
+    piSubdivider->Subdivide(mesh, out, 1, true);
+    std::unique_ptr<aiMesh> guard(out);
+
+    EXPECT_EQ(4u, out->mNumFaces);
+    for (unsigned int i = 0; i < out->mNumFaces; ++i) {
+        const aiFace& face = out->mFaces[i];
+        EXPECT_EQ(aiVector3D(0, 0, -1), out->mVertices[face.mIndices[0]]);
+        const aiVector3D& corner = out->mVertices[face.mIndices[2]];
+        EXPECT_EQ(ai_real(1), std::fabs(corner.x));
+        EXPECT_EQ(ai_real(1), std::fabs(corner.y));
+    }
+}
@@ -0,0 +1,244 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <TextStreamWriter.h>
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+using namespace Assimp;
+
+class TextStreamWriterTest : public ::testing::Test {
+    // empty
+};
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Collects everything written to it in a string
+class StringIOStream : public IOStream {
+public:
+    StringIOStream() : mNumWrites(), mNumFlushes() {}
+
+    size_t Read(void*, size_t, size_t) { return 0; }
+    size_t Write(const void* pvBuffer, size_t pSize, size_t pCount) {
+        ++mNumWrites;
+        mData.append(static_cast<const char*>(pvBuffer), pSize * pCount);
+        return pCount;
+    }
+    aiReturn Seek(size_t, aiOrigin) { return aiReturn_FAILURE; }
+    size_t Tell() const { return mData.size(); }
+    size_t FileSize() const { return mData.size(); }
+    void Flush() { ++mNumFlushes; }
+
+    std::string mData;
+    unsigned int mNumWrites, mNumFlushes;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Hands out a single StringIOStream and counts how often it is opened and closed
+class StringIOSystem : public IOSystem {
+public:
+    StringIOSystem() : mNumOpens(), mNumCloses() {}
+
+    bool Exists(const char*) const { return mNumOpens > 0; }
+    char getOsSeparator() const { return '/'; }
+    IOStream* Open(const char*, const char*) {
+        ++mNumOpens;
+        return &mStream;
+    }
+    void Close(IOStream* pFile) {
+        EXPECT_EQ(&mStream, pFile);
+        ++mNumCloses;
+    }
+
+    StringIOStream mStream;
+    unsigned int mNumOpens, mNumCloses;
+};
+
+// ------------------------------------------------------------------------------------------------
+std::string Format(float f) {
+    char buffer[AI_TEXT_NUMBER_MAXLEN];
+    return std::string(buffer, TextFormat::FormatFloat(buffer, f));
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TextStreamWriterTest, formatFloatShortestTest) {
+    EXPECT_EQ("0", Format(0.f));
+    EXPECT_EQ("-0", Format(-0.f));
+    EXPECT_EQ("0.1", Format(0.1f));
+    EXPECT_EQ("-1.5", Format(-1.5f));
+    EXPECT_EQ("100", Format(100.f));
+    EXPECT_EQ("0.0001", Format(0.0001f));
+    EXPECT_EQ("1e-05", Format(0.00001f));
+    EXPECT_EQ("16777216", Format(16777216.f));
+    EXPECT_EQ("123456790", Format(123456789.f));
+    EXPECT_EQ("1e+20", Format(1e20f));
+    EXPECT_EQ("3.4028235e+38", Format(3.4028235e38f));
+    EXPECT_EQ("1e-45", Format(1e-45f));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TextStreamWriterTest, formatFloatRoundTripTest) {
+    std::mt19937 rng(42);
+    for (unsigned int i = 0; i < 20000; ++i) {
+        const uint32_t bits = rng();
+        float f;
+        ::memcpy(&f, &bits, sizeof(f));
+        if (f != f) {
+            continue;
+        }
+        const std::string s = Format(f);
+        EXPECT_EQ(f, ::strtof(s.c_str(), nullptr)) << s;
+
+        // no shorter representation may exist
+        char buffer[AI_TEXT_NUMBER_MAXLEN];
+        for (int precision = 1; precision <= 9; ++precision) {
+            ::snprintf(buffer, sizeof(buffer), "%.*g", precision, f);
+            if (::strtof(buffer, nullptr) == f) {
+                std::string digits(s.substr(0, s.find('e')));
+                digits.erase(std::remove(digits.begin(), digits.end(), '-'), digits.end());
+                digits.erase(std::remove(digits.begin(), digits.end(), '.'), digits.end());
+                digits.erase(0, digits.find_first_not_of('0'));
+                digits.erase(digits.find_last_not_of('0') + 1);
+                EXPECT_LE(digits.length(), static_cast<size_t>(precision)) << s << " vs " << buffer;
+                break;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TextStreamWriterTest, formatFixedTest) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+    char buffer[AI_TEXT_NUMBER_MAXLEN + 1], expected[64];
+    for (unsigned int i = 0; i < 20000; ++i) {
+        const float f = i < 4 ? (i & 1 ? 0.5f : 0.0000005f) * (i & 2 ? -1.f : 1.f) : dist(rng);
+        for (unsigned int decimals = 0; decimals <= 8; decimals += 2) {
+            *TextFormat::FormatFixed(buffer, f, decimals) = '\0';
+            ::snprintf(expected, sizeof(expected), "%.*f", decimals, f);
+            EXPECT_STREQ(expected, buffer);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TextStreamWriterTest, formatIntTest) {
+    char buffer[AI_TEXT_NUMBER_MAXLEN];
+    EXPECT_EQ("0", std::string(buffer, TextFormat::FormatInt(buffer, 0)));
+    EXPECT_EQ("-1", std::string(buffer, TextFormat::FormatInt(buffer, -1)));
+    EXPECT_EQ("99", std::string(buffer, TextFormat::FormatInt(buffer, 99)));
+    EXPECT_EQ("100", std::string(buffer, TextFormat::FormatInt(buffer, 100)));
+    EXPECT_EQ("-9223372036854775808", std::string(buffer, TextFormat::FormatInt(buffer, INT64_MIN)));
+    EXPECT_EQ("18446744073709551615", std::string(buffer, TextFormat::FormatUInt(buffer, UINT64_MAX)));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TextStreamWriterTest, bufferedWriteTest) {
+    StringIOStream stream;
+    std::ostringstream expected;
+    expected.precision(16);
+    {
+        TextStreamWriter writer(&stream, 64);
+        for (unsigned int i = 0; i < 100; ++i) {
+            writer << "v " << i << ' ' << -static_cast<int>(i) << ' ' << 0.25f << ' ' << std::string("x") << '\n';
+            expected << "v " << i << ' ' << -static_cast<int>(i) << ' ' << 0.25f << ' ' << std::string("x") << '\n';
+        }
+        const std::string big(200, 'a');
+        writer.Write(big.data(), big.size());
+        expected << big;
+        writer << 0.5;
+        expected << 0.5;
+
+        EXPECT_EQ(expected.str().size(), writer.Tell());
+        writer.Flush();
+    }
+    EXPECT_EQ(expected.str(), stream.mData);
+    EXPECT_LT(1U, stream.mNumWrites);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TextStreamWriterTest, spillDoesNotFlushTest) {
+    StringIOStream stream;
+    TextStreamWriter writer(&stream, 64);
+    for (unsigned int i = 0; i < 100; ++i) {
+        writer << "f " << i << '\n';
+    }
+    EXPECT_LT(0U, stream.mNumWrites);
+    EXPECT_EQ(0U, stream.mNumFlushes);
+
+    writer.Flush();
+    EXPECT_EQ(1U, stream.mNumFlushes);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TextStreamWriterTest, lazyOpenTest) {
+    StringIOSystem io;
+    {
+        // an export failing before the buffer fills up never creates the file
+        TextStreamWriter writer(&io, "out.obj", "wt", 64);
+        writer << "v " << 1 << '\n';
+    }
+    EXPECT_EQ(0U, io.mNumOpens);
+    EXPECT_EQ(0U, io.mNumCloses);
+
+    {
+        TextStreamWriter writer(&io, "out.obj", "wt", 64);
+        writer << "v " << 1 << '\n';
+        writer.Flush();
+    }
+    EXPECT_EQ(1U, io.mNumOpens);
+    EXPECT_EQ(1U, io.mNumCloses);
+    EXPECT_EQ("v 1\n", io.mStream.mData);
+
+    {
+        // an empty file is still created by Flush()
+        TextStreamWriter writer(&io, "empty.obj", "wt");
+        writer.Flush();
+    }
+    EXPECT_EQ(2U, io.mNumOpens);
+    EXPECT_EQ(2U, io.mNumCloses);
+}
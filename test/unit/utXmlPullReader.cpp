@@ -0,0 +1,130 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utXmlPullReader : public ::testing::Test {
+protected:
+    // Import a file once with irrXML and once with the pull reader and
+    // check that both produce the same geometry.
+    void compareReaders( const char *file ) {
+        Importer irr, pull;
+        pull.SetPropertyBool( AI_CONFIG_IMPORT_XML_PULL_READER, true );
+
+        const aiScene *a = irr.ReadFile( file, 0 );
+        const aiScene *b = pull.ReadFile( file, 0 );
+        ASSERT_NE( nullptr, a );
+        ASSERT_NE( nullptr, b );
+
+        ASSERT_EQ( a->mNumMeshes, b->mNumMeshes );
+        EXPECT_EQ( a->mNumMaterials, b->mNumMaterials );
+        EXPECT_EQ( a->mNumAnimations, b->mNumAnimations );
+        EXPECT_EQ( countNodes( a->mRootNode ), countNodes( b->mRootNode ) );
+        EXPECT_STREQ( a->mRootNode->mName.C_Str(), b->mRootNode->mName.C_Str() );
+
+        for ( unsigned int i = 0; i < a->mNumMeshes; ++i ) {
+            const aiMesh *ma = a->mMeshes[ i ], *mb = b->mMeshes[ i ];
+            EXPECT_STREQ( ma->mName.C_Str(), mb->mName.C_Str() );
+            ASSERT_EQ( ma->mNumVertices, mb->mNumVertices );
+            ASSERT_EQ( ma->mNumFaces, mb->mNumFaces );
+            for ( unsigned int v = 0; v < ma->mNumVertices; ++v ) {
+                EXPECT_EQ( ma->mVertices[ v ], mb->mVertices[ v ] );
+            }
+            for ( unsigned int f = 0; f < ma->mNumFaces; ++f ) {
+                ASSERT_EQ( ma->mFaces[ f ].mNumIndices, mb->mFaces[ f ].mNumIndices );
+                for ( unsigned int n = 0; n < ma->mFaces[ f ].mNumIndices; ++n ) {
+                    EXPECT_EQ( ma->mFaces[ f ].mIndices[ n ], mb->mFaces[ f ].mIndices[ n ] );
+                }
+            }
+        }
+    }
+
+    static unsigned int countNodes( const aiNode *node ) {
+        unsigned int count = 1;
+        for ( unsigned int i = 0; i < node->mNumChildren; ++i ) {
+            count += countNodes( node->mChildren[ i ] );
+        }
+        return count;
+    }
+};
+
+TEST_F( utXmlPullReader, colladaTest ) {
+    compareReaders( ASSIMP_TEST_MODELS_DIR "/Collada/duck.dae" );
+    compareReaders( ASSIMP_TEST_MODELS_DIR "/Collada/COLLADA.dae" );
+}
+
+TEST_F( utXmlPullReader, amfTest ) {
+    compareReaders( ASSIMP_TEST_MODELS_DIR "/AMF/test1.amf" );
+}
+
+TEST_F( utXmlPullReader, d3mfTest ) {
+    compareReaders( ASSIMP_TEST_MODELS_DIR "/3MF/box.3mf" );
+}
+
+TEST_F( utXmlPullReader, irrUtf16Test ) {
+    // UTF-16 encoded, irrXML fails to make sense of the converted input
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_XML_PULL_READER, true );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/IRR/box.irr", 0 );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_EQ( 1u, scene->mNumMeshes );
+}
+
+TEST_F( utXmlPullReader, importerKeyOverridesGlobalKeyTest ) {
+    // the IRR key alone enables the pull reader for the IRR loader
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_XML_PULL_READER, false );
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_IRR_PULL_READER, true );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/IRR/box.irr", 0 );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_EQ( 1u, scene->mNumMeshes );
+}
+
+TEST_F( utXmlPullReader, xglTest ) {
+    compareReaders( ASSIMP_TEST_MODELS_DIR "/XGL/sample_official.xgl" );
+    compareReaders( ASSIMP_TEST_MODELS_DIR "/XGL/Wuson.zgl" );
+}
@@ -43,6 +43,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
 
 using namespace Assimp;
 
@@ -58,3 +65,196 @@ public:
 TEST_F( utglTFImportExport, importglTFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utglTFImportExport, importEmbeddedBuffersTest ) {
+    // the same asset once with a separate .bin and once with base64 data uris
+    Assimp::Importer external, embedded;
+    const aiScene *ext = external.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF/BoxTextured.gltf", 0 );
+    const aiScene *emb = embedded.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF-Embedded/BoxTextured.gltf", 0 );
+    ASSERT_NE( nullptr, ext );
+    ASSERT_NE( nullptr, emb );
+    ASSERT_EQ( ext->mNumMeshes, emb->mNumMeshes );
+    for ( unsigned int i = 0; i < ext->mNumMeshes; ++i ) {
+        const aiMesh *a = ext->mMeshes[ i ], *b = emb->mMeshes[ i ];
+        ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+        ASSERT_EQ( a->mNumFaces, b->mNumFaces );
+        EXPECT_EQ( 0, memcmp( a->mVertices, b->mVertices, a->mNumVertices * sizeof( aiVector3D ) ) );
+        EXPECT_EQ( 0, memcmp( a->mTextureCoords[ 0 ], b->mTextureCoords[ 0 ], a->mNumVertices * sizeof( aiVector3D ) ) );
+        for ( unsigned int f = 0; f < a->mNumFaces; ++f ) {
+            EXPECT_EQ( 0, memcmp( a->mFaces[ f ].mIndices, b->mFaces[ f ].mIndices, a->mFaces[ f ].mNumIndices * sizeof( unsigned int ) ) );
+        }
+    }
+}
+
+TEST_F( utglTFImportExport, importMisplacedBase64PaddingTest ) {
+    std::FILE *file = std::fopen( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF-Embedded/BoxTextured.gltf", "rb" );
+    ASSERT_NE( nullptr, file );
+    std::string json;
+    char chunk[ 4096 ];
+    for ( size_t read; ( read = std::fread( chunk, 1, sizeof( chunk ), file ) ) > 0; ) {
+        json.append( chunk, read );
+    }
+    std::fclose( file );
+
+    // the buffer data ends with an unpadded group, put a '=' into its third position
+    const std::string prefix = "data:application/octet-stream;base64,";
+    const size_t begin = json.find( prefix );
+    ASSERT_NE( std::string::npos, begin );
+    const size_t end = json.find( '"', begin );
+    ASSERT_NE( '=', json[ end - 1 ] );
+    json[ end - 2 ] = '=';
+
+    Assimp::Importer importer;
+    EXPECT_EQ( nullptr, importer.ReadFileFromMemory( json.data(), json.size(), 0, "gltf" ) );
+}
+
+TEST_F( utglTFImportExport, exportBinaryTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF/CesiumMilkTruck/CesiumMilkTruck.gltf", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    // all accessors are appended to the single body buffer
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob( scene, "glb" );
+    ASSERT_NE( nullptr, blob );
+    const size_t plainSize = blob->size;
+
+    Assimp::Importer reimporter;
+    const aiScene *result = reimporter.ReadFileFromMemory( blob->data, blob->size, 0, "glb" );
+    ASSERT_NE( nullptr, result );
+    ASSERT_EQ( scene->mNumMeshes, result->mNumMeshes );
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        const aiMesh *a = scene->mMeshes[ i ], *b = result->mMeshes[ i ];
+        ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+        EXPECT_EQ( a->mNumFaces, b->mNumFaces );
+        EXPECT_EQ( 0, memcmp( a->mVertices, b->mVertices, a->mNumVertices * sizeof( aiVector3D ) ) );
+    }
+
+    // with Open3DGC the compressed data of each mesh replaces its source range in the body buffer
+    Assimp::ExportProperties props;
+    props.SetPropertyBool( "extensions.Open3DGC.use", true );
+    blob = exporter.ExportToBlob( scene, "glb", 0, &props );
+    ASSERT_NE( nullptr, blob );
+    EXPECT_LT( blob->size, plainSize );
+
+    Assimp::Importer decompressor;
+    result = decompressor.ReadFileFromMemory( blob->data, blob->size, 0, "glb" );
+    ASSERT_NE( nullptr, result );
+    ASSERT_EQ( scene->mNumMeshes, result->mNumMeshes );
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        EXPECT_EQ( scene->mMeshes[ i ]->mNumFaces, result->mMeshes[ i ]->mNumFaces );
+    }
+}
+
+static aiScene *createTexturedTriangleScene() {
+    aiScene *scene = new aiScene();
+    scene->mRootNode = new aiNode();
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[ 1 ];
+    scene->mRootNode->mMeshes[ 0 ] = 0;
+
+    // an embedded image of odd size, so the accessors behind it in the body need padding
+    scene->mNumTextures = 1;
+    scene->mTextures = new aiTexture*[ 1 ];
+    scene->mTextures[ 0 ] = new aiTexture();
+    scene->mTextures[ 0 ]->mWidth = 5;
+    scene->mTextures[ 0 ]->mHeight = 0;
+    scene->mTextures[ 0 ]->pcData = new aiTexel[ 2 ];
+    memcpy( scene->mTextures[ 0 ]->pcData, "\x89PNG\r", 5 );
+    strcpy( scene->mTextures[ 0 ]->achFormatHint, "png" );
+
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial*[ 1 ];
+    scene->mMaterials[ 0 ] = new aiMaterial();
+    aiString path( "*0" );
+    scene->mMaterials[ 0 ]->AddProperty( &path, AI_MATKEY_TEXTURE_DIFFUSE( 0 ) );
+
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[ 1 ];
+    aiMesh *mesh = scene->mMeshes[ 0 ] = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 3;
+    mesh->mVertices = new aiVector3D[ 3 ];
+    mesh->mNormals = new aiVector3D[ 3 ];
+    mesh->mTextureCoords[ 0 ] = new aiVector3D[ 3 ];
+    mesh->mNumUVComponents[ 0 ] = 2;
+    for ( unsigned int i = 0; i < 3; ++i ) {
+        mesh->mVertices[ i ] = aiVector3D( float( i == 1 ), float( i == 2 ), 0.5f );
+        mesh->mNormals[ i ] = aiVector3D( 0.f, 0.f, 1.f );
+        mesh->mTextureCoords[ 0 ][ i ] = aiVector3D( float( i == 1 ), float( i == 2 ), 0.f );
+    }
+    mesh->mNumFaces = 1;
+    mesh->mFaces = new aiFace[ 1 ];
+    mesh->mFaces[ 0 ].mNumIndices = 3;
+    mesh->mFaces[ 0 ].mIndices = new unsigned int[ 3 ];
+    for ( unsigned int i = 0; i < 3; ++i ) {
+        mesh->mFaces[ 0 ].mIndices[ i ] = i;
+    }
+    return scene;
+}
+
+static uint32_t readUInt32( const uint8_t *data ) {
+    return uint32_t( data[ 0 ] ) | ( uint32_t( data[ 1 ] ) << 8 ) | ( uint32_t( data[ 2 ] ) << 16 ) | ( uint32_t( data[ 3 ] ) << 24 );
+}
+
+TEST_F( utglTFImportExport, exportBinaryLayoutTest ) {
+    std::unique_ptr<aiScene> scene( createTexturedTriangleScene() );
+
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob( scene.get(), "glb" );
+    ASSERT_NE( nullptr, blob );
+    ASSERT_GE( blob->size, 20u );
+
+    // the header length covers the whole file, the scene is padded so the body starts aligned
+    const uint8_t *data = static_cast<const uint8_t*>( blob->data );
+    EXPECT_EQ( 0, memcmp( data, "glTF", 4 ) );
+    EXPECT_EQ( 1u, readUInt32( data + 4 ) );
+    EXPECT_EQ( blob->size, readUInt32( data + 8 ) );
+    const uint32_t sceneLength = readUInt32( data + 12 );
+    EXPECT_EQ( 0u, ( 20 + sceneLength ) % 4 );
+    ASSERT_LE( 20 + sceneLength, blob->size );
+
+    const std::string json( reinterpret_cast<const char*>( data + 20 ), sceneLength );
+    const unsigned long bodyLength = static_cast<unsigned long>( blob->size - 20 - sceneLength );
+
+    // vertex attributes behind the 5 byte image must start at a multiple of 4, indices at a multiple of 2
+    unsigned int numViews = 0;
+    unsigned long bodyEnd = 0;
+    for ( size_t pos = json.find( "{\"buffer\":" ); pos != std::string::npos; pos = json.find( "{\"buffer\":", pos + 1 ) ) {
+        unsigned long offset = 0, length = 0;
+        int target = 0;
+        if ( 3 != sscanf( json.c_str() + pos, "{\"buffer\":\"binary_glTF\",\"byteOffset\":%lu,\"byteLength\":%lu,\"target\":%d", &offset, &length, &target ) ) {
+            continue;
+        }
+        bodyEnd = std::max( bodyEnd, offset + length );
+        if ( 34962 == target ) {
+            EXPECT_EQ( 0u, offset % 4 );
+            ++numViews;
+        } else if ( 34963 == target ) {
+            EXPECT_EQ( 0u, offset % 2 );
+            ++numViews;
+        }
+    }
+    EXPECT_EQ( 4u, numViews );
+    EXPECT_EQ( bodyLength, bodyEnd );
+
+    // the body streamed from the scene data has to read back as the scene
+    Assimp::Importer importer;
+    const aiScene *result = importer.ReadFileFromMemory( blob->data, blob->size, 0, "glb" );
+    ASSERT_NE( nullptr, result );
+    ASSERT_EQ( 1u, result->mNumMeshes );
+    const aiMesh *a = scene->mMeshes[ 0 ], *b = result->mMeshes[ 0 ];
+    ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+    ASSERT_TRUE( b->HasNormals() );
+    ASSERT_TRUE( b->HasTextureCoords( 0 ) );
+    for ( unsigned int i = 0; i < a->mNumVertices; ++i ) {
+        EXPECT_EQ( a->mVertices[ i ], b->mVertices[ i ] );
+        EXPECT_EQ( a->mNormals[ i ], b->mNormals[ i ] );
+        EXPECT_FLOAT_EQ( a->mTextureCoords[ 0 ][ i ].x, b->mTextureCoords[ 0 ][ i ].x );
+        EXPECT_FLOAT_EQ( a->mTextureCoords[ 0 ][ i ].y, b->mTextureCoords[ 0 ][ i ].y );
+    }
+    ASSERT_EQ( 1u, b->mNumFaces );
+    EXPECT_EQ( 0u, b->mFaces[ 0 ].mIndices[ 0 ] );
+    EXPECT_EQ( 1u, b->mFaces[ 0 ].mIndices[ 1 ] );
+    EXPECT_EQ( 2u, b->mFaces[ 0 ].mIndices[ 2 ] );
+}